@@ -39,11 +39,18 @@
 
 #include "hdf5.h"
 
+#include <algorithm>
+#include <memory>
+
 #include <QtCore/QtDebug>
 
+#include "H5Support/QH5Lite.h"
+
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
 
+class EbsdReader;
+
 /**
  * @class EbsdImporter EbsdImporter.h EbsdLib/EbsdImporter.h
  * @brief  This class is a pure virtual class that defines the interface that
@@ -75,6 +82,30 @@ class EbsdLib_EXPORT EbsdImporter
      */
     EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, Cancel)
 
+    /**
+     * @brief Allow the reader to parse a single large file with several threads. This
+     * should be turned off when several files are being read at the same time.
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, ParallelParsing)
+
+    /**
+     * @brief Store the data columns as chunked data sets instead of contiguous ones. Chunked
+     * data sets can be compressed and let readers pull a range of rows without reading the
+     * whole slice.
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(bool, ChunkedDatasets)
+
+    /**
+     * @brief The number of scan rows that make up one chunk of a chunked data set
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(int, ChunkRows)
+
+    /**
+     * @brief The deflate (gzip) level from 0 to 9 for chunked data sets. A value of 0
+     * stores the chunks uncompressed.
+     */
+    EBSD_VIRTUAL_INSTANCE_PROPERTY(int, CompressionLevel)
+
     /**
      * @brief Either prints a message or sends the message to the User Interface
      * @param message The message to print
@@ -105,6 +136,26 @@ class EbsdLib_EXPORT EbsdImporter
      */
     virtual int importFile(hid_t fileId, int64_t index, const QString& ebsd) = 0;
 
+    /**
+     * @brief Reads the raw data file into memory without touching any HDF5 file. This
+     * does not change the state of the importer so different files can be read from
+     * several threads at the same time. importFile() is readFile() followed by writeFile().
+     * @param ebsdFile The raw data file from the manufacturere (.ang, .ctf)
+     * @param err The error code from the reader (out)
+     * @return The reader holding the parsed data
+     */
+    virtual std::shared_ptr<EbsdReader> readFile(const QString& ebsdFile, int& err) = 0;
+
+    /**
+     * @brief Checks the result of readFile() and stores the parsed data into the HDF5
+     * file. All calls for the same HDF5 file have to come from one thread at a time.
+     * @param fildId HDF5 fileId of an open HDF5 file that the data will be stored into
+     * @param index The integer index value of this EBSD data file
+     * @param reader The reader returned from readFile()
+     * @param readError The error code returned from readFile()
+     */
+    virtual int writeFile(hid_t fileId, int64_t index, EbsdReader* reader, int readError) = 0;
+
     /**
      * @brief Returns the dimensions for the EBSD Data set
      * @param x Number of X Voxels (out)
@@ -135,11 +186,99 @@ class EbsdLib_EXPORT EbsdImporter
   protected:
     EbsdImporter() :
       m_ErrorCondition(0),
-      m_Cancel(false)
+      m_Cancel(false),
+      m_ParallelParsing(true),
+      m_ChunkedDatasets(false),
+      m_ChunkRows(64),
+      m_CompressionLevel(6)
     {
       m_PipelineMessage = "";
     }
 
+    /**
+     * @brief Writes a single data column using the layout selected with setChunkedDatasets().
+     * The byte shuffle filter is applied ahead of deflate as it improves the compression of
+     * float columns considerably.
+     * @param gid The HDF5 group to write the data set into
+     * @param name The name of the data set
+     * @param numElements The number of values in the column
+     * @param rowLength The number of values in one scan row
+     * @param data The values to write
+     * @return Negative value on error
+     */
+    template<typename T>
+    int writeDataColumn(hid_t gid, const QString& name, hsize_t numElements, hsize_t rowLength, T* data)
+    {
+      int32_t rank = 1;
+      hsize_t dims[1] = { numElements };
+      if (getChunkedDatasets() == false || numElements == 0)
+      {
+        return QH5Lite::writePointerDataset(gid, name, rank, dims, data);
+      }
+
+      hsize_t chunkDims[1] = { std::min(numElements, std::max(rowLength, static_cast<hsize_t>(1)) * static_cast<hsize_t>(std::max(getChunkRows(), 1))) };
+      hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+      if (dcpl < 0)
+      {
+        reportLayoutError(name, "create the data set creation property list", -1);
+        return -1;
+      }
+      herr_t err = H5Pset_chunk(dcpl, rank, chunkDims);
+      if (err < 0)
+      {
+        reportLayoutError(name, "set the chunk size", err);
+        H5Pclose(dcpl);
+        return -1;
+      }
+      if (getCompressionLevel() > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+      {
+        err = H5Pset_shuffle(dcpl);
+        if (err < 0)
+        {
+          reportLayoutError(name, "enable the shuffle filter", err);
+          H5Pclose(dcpl);
+          return -1;
+        }
+        err = H5Pset_deflate(dcpl, static_cast<unsigned int>(std::min(getCompressionLevel(), 9)));
+        if (err < 0)
+        {
+          reportLayoutError(name, "enable the deflate filter", err);
+          H5Pclose(dcpl);
+          return -1;
+        }
+      }
+
+      hid_t dataType = QH5Lite::HDFTypeForPrimitive(data[0]);
+      hid_t sid = H5Screate_simple(rank, dims, nullptr);
+      hid_t did = H5Dcreate(gid, name.toLatin1().data(), dataType, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+      if (did < 0)
+      {
+        err = -1;
+      }
+      else
+      {
+        err = H5Dwrite(did, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+        H5Dclose(did);
+      }
+      H5Sclose(sid);
+      H5Pclose(dcpl);
+      return err;
+    }
+
+    /**
+     * @brief Sets the error message and condition for a data set whose chunked layout could not be set up
+     * @param name The name of the data set
+     * @param step The HDF5 step that failed
+     * @param err The HDF5 error code
+     */
+    void reportLayoutError(const QString& name, const QString& step, herr_t err)
+    {
+      QString msg = QString("EbsdImporter Error: Could not %1 for data set '%2' (HDF5 error %3)").arg(step).arg(name).arg(err);
+      setPipelineMessage(msg);
+      setErrorCondition(-800);
+      progressMessage(msg, 100);
+    }
+
   private:
     EbsdImporter(const EbsdImporter&) = delete;   // Copy Constructor Not Implemented
     void operator=(const EbsdImporter&) = delete; // Move assignment Not Implemented
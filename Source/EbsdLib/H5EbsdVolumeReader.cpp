@@ -36,6 +36,14 @@
 
 #include "H5EbsdVolumeReader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "H5Support/QH5Utilities.h"
 
 
 #if defined (H5Support_NAMESPACE)
@@ -51,6 +59,9 @@ H5EbsdVolumeReader::H5EbsdVolumeReader() :
   m_SliceEnd(0),
   m_ManageMemory(true),
   m_NumberOfElements(0),
+  m_ParallelSliceReads(true),
+  m_RowStart(0),
+  m_RowCount(0),
   m_ReadAllArrays(true)
 {
 
@@ -134,3 +145,286 @@ void H5EbsdVolumeReader::readAllArrays(bool b)
 {
   m_ReadAllArrays = b;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5EbsdVolumeReader::setDestinationPointer(const QString& arrayName, void* ptr, int numComponents, int componentIndex)
+{
+  DestinationArray dest;
+  dest.ptr = ptr;
+  dest.type = getPointerType(arrayName);
+  dest.numComponents = numComponents;
+  dest.componentIndex = componentIndex;
+  m_Destinations[arrayName] = dest;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5EbsdVolumeReader::clearDestinationPointers()
+{
+  m_Destinations.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const H5EbsdVolumeReader::DestinationArray* H5EbsdVolumeReader::getDestinationArray(const QString& arrayName) const
+{
+  QMap<QString, DestinationArray>::const_iterator iter = m_Destinations.find(arrayName);
+  if(iter == m_Destinations.end())
+  {
+    return nullptr;
+  }
+  return &(iter.value());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EbsdVolumeReader::readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells)
+{
+  // This class should be subclassed and this method implemented.
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5EbsdVolumeReader::sliceLoaded(int64_t zval, int64_t xstart, int64_t ystart, int64_t xCells, int64_t yCells, int64_t xpoints, int64_t ypoints)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EbsdVolumeReader::loadDataDirect(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
+{
+  int err = readVolumeInfo();
+  if(err < 0)
+  {
+    return err;
+  }
+  for(QMap<QString, DestinationArray>::const_iterator iter = m_Destinations.begin(); iter != m_Destinations.end(); ++iter)
+  {
+    if(iter.value().ptr == nullptr || (iter.value().type != Ebsd::Int32 && iter.value().type != Ebsd::Float))
+    {
+      setErrorCode(-90600);
+      setErrorMessage(QString("H5EbsdVolumeReader Error: The array '%1' can not be read directly into the given destination.").arg(iter.key()));
+      return getErrorCode();
+    }
+  }
+  int64_t rowStart = getRowStart();
+  int64_t rowCount = (getRowCount() > 0) ? getRowCount() : ypoints - rowStart;
+  if(rowStart < 0 || rowCount < 1 || rowStart + rowCount > ypoints)
+  {
+    setErrorCode(-90608);
+    setErrorMessage(QString("H5EbsdVolumeReader Error: The rows %1 to %2 are not inside a volume with %3 rows").arg(rowStart).arg(rowStart + rowCount - 1).arg(ypoints));
+    return getErrorCode();
+  }
+  if(zpoints < 1 || m_Destinations.size() == 0)
+  {
+    return 0;
+  }
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
+  {
+    setErrorCode(-90601);
+    setErrorMessage(QString("H5EbsdVolumeReader Error: Could not open HDF5 file '%1'").arg(getFileName()));
+    return getErrorCode();
+  }
+
+  // Only a thread safe build of the HDF5 library may be called from several threads at once
+  hbool_t threadSafe = 0;
+  H5is_library_threadsafe(&threadSafe);
+  size_t numThreads = 1;
+  if(getParallelSliceReads() == true && threadSafe > 0)
+  {
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    numThreads = std::min(numThreads, static_cast<size_t>(zpoints));
+  }
+
+  // Slices are handed out one at a time. If several slices fail the error of the lowest
+  // slice is reported so the result matches a serial read.
+  std::atomic<int> nextSlice(0);
+  std::mutex errorMutex;
+  int errorSlice = static_cast<int>(zpoints);
+  int errorCode = 0;
+  QString errorMessage;
+
+  auto readSlices = [&]() {
+    for(int slice = nextSlice++; slice < zpoints; slice = nextSlice++)
+    {
+      if(getCancel() == true)
+      {
+        break;
+      }
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if(slice > errorSlice)
+        {
+          break;
+        }
+      }
+      int64_t zval = slice;
+      if(ZDir == SIMPL::RefFrameZDir::HightoLow)
+      {
+        zval = (zpoints - 1) - slice;
+      }
+      QString message;
+      int sliceErr = readSliceDirect(fileId, slice, zval, xpoints, ypoints, rowStart, rowCount, message);
+      if(sliceErr < 0)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if(slice < errorSlice)
+        {
+          errorSlice = slice;
+          errorCode = sliceErr;
+          errorMessage = message;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for(size_t t = 1; t < numThreads; t++)
+  {
+    workers.push_back(std::thread(readSlices));
+  }
+  readSlices();
+  for(size_t t = 0; t < workers.size(); t++)
+  {
+    workers[t].join();
+  }
+
+  QH5Utilities::closeFile(fileId);
+
+  if(errorCode < 0)
+  {
+    setErrorCode(errorCode);
+    setErrorMessage(errorMessage);
+    return errorCode;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5EbsdVolumeReader::readSliceDirect(hid_t fileId, int slice, int64_t zval, int64_t xpoints, int64_t ypoints, int64_t rowStart, int64_t rowCount, QString& errorMessage)
+{
+  QString index = QString::number(slice + getSliceStart());
+  hid_t gid = H5Gopen(fileId, index.toLatin1().data(), H5P_DEFAULT);
+  if(gid < 0)
+  {
+    errorMessage = QString("H5EbsdVolumeReader Error: Could not open slice '%1'").arg(index);
+    return -90602;
+  }
+
+  int64_t xCells = 0;
+  int64_t yCells = 0;
+  int err = readSliceDimensions(gid, xCells, yCells);
+  if(err < 0 || xCells < 1 || yCells < 1 || xCells > xpoints || yCells > ypoints)
+  {
+    errorMessage = QString("H5EbsdVolumeReader Error: Slice '%1' has invalid dimensions %2 x %3 for a volume of %4 x %5").arg(index).arg(xCells).arg(yCells).arg(xpoints).arg(ypoints);
+    H5Gclose(gid);
+    return -90603;
+  }
+  int64_t xstart = (xpoints - xCells) / 2;
+  int64_t ystart = (ypoints - yCells) / 2;
+
+  // The rows of the volume that are both requested and covered by the slice
+  int64_t firstRow = std::max(rowStart, ystart);
+  int64_t endRow = std::min(rowStart + rowCount, ystart + yCells);
+  int64_t readRows = std::max(endRow - firstRow, static_cast<int64_t>(0));
+
+  hid_t dataGid = H5Gopen(gid, Ebsd::H5::Data.toLatin1().data(), H5P_DEFAULT);
+  if(dataGid < 0)
+  {
+    errorMessage = QString("H5EbsdVolumeReader Error: Could not open the 'Data' group of slice '%1'").arg(index);
+    H5Gclose(gid);
+    return -90604;
+  }
+
+  size_t slicePoints = static_cast<size_t>(xpoints * rowCount);
+  for(QMap<QString, DestinationArray>::const_iterator iter = m_Destinations.begin(); iter != m_Destinations.end(); ++iter)
+  {
+    const DestinationArray& dest = iter.value();
+    size_t typeSize = (dest.type == Ebsd::Int32) ? sizeof(int32_t) : sizeof(float);
+    hid_t memType = (dest.type == Ebsd::Int32) ? H5T_NATIVE_INT32 : H5T_NATIVE_FLOAT;
+    uint8_t* slicePtr = static_cast<uint8_t*>(dest.ptr) + zval * slicePoints * dest.numComponents * typeSize;
+
+    // Anything outside of the centered slice stays zero just like loadData()
+    if(xCells != xpoints || readRows != rowCount)
+    {
+      for(size_t i = 0; i < slicePoints; i++)
+      {
+        ::memset(slicePtr + (i * dest.numComponents + dest.componentIndex) * typeSize, 0, typeSize);
+      }
+    }
+
+    hid_t did = H5Dopen(dataGid, iter.key().toLatin1().data(), H5P_DEFAULT);
+    if(did < 0)
+    {
+      errorMessage = QString("H5EbsdVolumeReader Error: Could not open data set '%1' of slice '%2'").arg(iter.key()).arg(index);
+      err = -90605;
+      break;
+    }
+    hid_t fileSpace = H5Dget_space(did);
+    if(H5Sget_simple_extent_npoints(fileSpace) != xCells * yCells)
+    {
+      errorMessage = QString("H5EbsdVolumeReader Error: Data set '%1' of slice '%2' does not hold %3 values").arg(iter.key()).arg(index).arg(xCells * yCells);
+      H5Sclose(fileSpace);
+      H5Dclose(did);
+      err = -90606;
+      break;
+    }
+
+    if(readRows == 0)
+    {
+      H5Sclose(fileSpace);
+      H5Dclose(did);
+      continue;
+    }
+
+    // Only the requested rows are selected in the file. In memory they go into the centered
+    // rectangle of the slice and the requested component of each tuple.
+    hsize_t fileStart[1] = {static_cast<hsize_t>((firstRow - ystart) * xCells)};
+    hsize_t fileCount[1] = {static_cast<hsize_t>(readRows * xCells)};
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, fileCount, nullptr);
+
+    hsize_t memDims[3] = {static_cast<hsize_t>(rowCount), static_cast<hsize_t>(xpoints), static_cast<hsize_t>(dest.numComponents)};
+    hsize_t memStart[3] = {static_cast<hsize_t>(firstRow - rowStart), static_cast<hsize_t>(xstart), static_cast<hsize_t>(dest.componentIndex)};
+    hsize_t memCount[3] = {static_cast<hsize_t>(readRows), static_cast<hsize_t>(xCells), 1};
+    hid_t memSpace = H5Screate_simple(3, memDims, nullptr);
+    H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, nullptr, memCount, nullptr);
+
+    herr_t readErr = H5Dread(did, memType, memSpace, fileSpace, H5P_DEFAULT, slicePtr);
+    H5Sclose(memSpace);
+    H5Sclose(fileSpace);
+    H5Dclose(did);
+    if(readErr < 0)
+    {
+      errorMessage = QString("H5EbsdVolumeReader Error: Could not read data set '%1' of slice '%2'").arg(iter.key()).arg(index);
+      err = -90607;
+      break;
+    }
+  }
+  H5Gclose(dataGid);
+  H5Gclose(gid);
+  if(err < 0)
+  {
+    return err;
+  }
+
+  sliceLoaded(zval, xstart, std::max(firstRow - rowStart, static_cast<int64_t>(0)), xCells, readRows, xpoints, rowCount);
+  return 0;
+}
@@ -36,6 +36,9 @@
 
 #pragma once
 
+#include <hdf5.h>
+
+#include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QVector>
 #include <QtCore/QSet>
@@ -142,12 +145,105 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
     virtual void readAllArrays(bool b);
     virtual bool getReadAllArrays();
 
+    /**
+     * @brief Allows loadDataDirect() to read several slices at the same time. This only has an
+     * effect if the HDF5 library was built thread safe.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, ParallelSliceReads)
+
+    /**
+     * @brief The first row of the volume that loadDataDirect() reads out of each slice.
+     */
+    EBSD_INSTANCE_PROPERTY(int64_t, RowStart)
+
+    /**
+     * @brief The number of rows of the volume that loadDataDirect() reads out of each slice. A value
+     * of zero reads every row starting at RowStart.
+     */
+    EBSD_INSTANCE_PROPERTY(int64_t, RowCount)
+
+    /**
+     * @brief Registers caller owned memory that loadDataDirect() will read the named array into. The
+     * memory must hold xpoints * rows * zpoints tuples of numComponents values, where rows is the
+     * number of rows selected with RowStart and RowCount, and must be of the type returned by getPointerType().
+     * @param arrayName The name of the array as it appears in the Data group of each slice
+     * @param ptr The destination memory
+     * @param numComponents The number of components of each tuple in the destination
+     * @param componentIndex The component of each tuple that the array is stored into
+     */
+    virtual void setDestinationPointer(const QString& arrayName, void* ptr, int numComponents = 1, int componentIndex = 0);
+
+    /**
+     * @brief Removes all the destinations that were registered with setDestinationPointer()
+     */
+    virtual void clearDestinationPointers();
+
+    /**
+     * @brief Loads the arrays registered with setDestinationPointer() directly out of the HDF5 file
+     * into their destinations using hyperslab selections. No intermediate buffers are allocated and
+     * arrays without a destination are never read. Slices smaller than the volume are centered the
+     * same way that loadData() centers them. Only the rows selected with RowStart and RowCount are
+     * read from the file and they are stored starting at the first row of each destination slice.
+     * @param xpoints The number of x voxels
+     * @param ypoints The number of y voxels
+     * @param zpoints The number of z voxels
+     * @param ZDir The stacking order to use
+     * @return Error code, negative on failure
+     */
+    virtual int loadDataDirect(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir);
+
   protected:
     H5EbsdVolumeReader();
 
+    /**
+     * @brief Describes the caller owned memory for a single array
+     */
+    struct DestinationArray
+    {
+      void* ptr;
+      Ebsd::NumType type;
+      int numComponents;
+      int componentIndex;
+    };
+
+    /**
+     * @brief Returns the destination registered for the given array or nullptr
+     */
+    const DestinationArray* getDestinationArray(const QString& arrayName) const;
+
+    /**
+     * @brief Reads the number of columns and rows of a single slice from its header. Subclasses
+     * need to implement this in order to support loadDataDirect().
+     * @param sliceGid The HDF5 group of the slice
+     * @param xCells The number of columns in the slice
+     * @param yCells The number of rows in the slice
+     * @return Error code, negative on failure
+     */
+    virtual int readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells);
+
+    /**
+     * @brief Called by loadDataDirect() after all arrays of a slice were read. This may be called
+     * from several threads at once but never twice for the same slice. All values describe the
+     * destination memory, so ypoints is the number of rows that were selected for reading.
+     * @param zval The z index that the slice was stored at
+     * @param xstart First column of the destination that holds slice data
+     * @param ystart First row of the destination that holds slice data
+     * @param xCells The number of columns of slice data that were read
+     * @param yCells The number of rows of slice data that were read
+     * @param xpoints The number of x voxels in the destination
+     * @param ypoints The number of y voxels in the destination
+     */
+    virtual void sliceLoaded(int64_t zval, int64_t xstart, int64_t ystart, int64_t xCells, int64_t yCells, int64_t xpoints, int64_t ypoints);
+
   private:
     QSet<QString>         m_ArrayNames;
     bool                  m_ReadAllArrays;
+    QMap<QString, DestinationArray> m_Destinations;
+
+    /**
+     * @brief Reads every destination array of one slice
+     */
+    int readSliceDirect(hid_t fileId, int slice, int64_t zval, int64_t xpoints, int64_t ypoints, int64_t rowStart, int64_t rowCount, QString& errorMessage);
 
     H5EbsdVolumeReader(const H5EbsdVolumeReader&) = delete; // Copy Constructor Not Implemented
     void operator=(const H5EbsdVolumeReader&) = delete;     // Move assignment Not Implemented
@@ -44,9 +44,12 @@
 #include <sstream>
 #include <algorithm>
 
+#include <string.h>
+
 #include "CtfPhase.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/Utilities/EbsdTextScanner.h"
 
 
 
@@ -60,6 +63,7 @@
 // -----------------------------------------------------------------------------
 CtfReader::CtfReader() :
   EbsdReader(),
+  m_ParallelParsing(true),
   m_SingleSliceRead(-1)
 {
 
@@ -239,9 +243,9 @@ int CtfReader::readHeaderOnly()
 {
   int err = 1;
   QByteArray buf;
-  QFile in(getFileName());
+  EbsdTextScanner in;
   setHeaderIsComplete(false);
-  if (!in.open(QIODevice::ReadOnly | QIODevice::Text))
+  if (!in.open(getFileName()))
   {
     QString msg = QString("Ctf file could not be opened: ") + getFileName();
     setErrorCode(-100);
@@ -269,9 +273,9 @@ int CtfReader::readFile()
   setErrorCode(0);
   setErrorMessage("");
   QByteArray buf;
-  QFile in(getFileName());
+  EbsdTextScanner in;
   setHeaderIsComplete(false);
-  if (!in.open(QIODevice::ReadOnly | QIODevice::Text))
+  if (!in.open(getFileName()))
   {
     QString msg = QString("Ctf file could not be opened: ") + getFileName();
     setErrorCode(-100);
@@ -318,7 +322,7 @@ void CtfReader::readOnlySliceIndex(int slice)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int CtfReader::readData(QFile& in)
+int CtfReader::readData(EbsdTextScanner& in)
 {
   // Delete any currently existing pointers
   deletePointers();
@@ -404,46 +408,115 @@ int CtfReader::readData(QFile& in)
 
   }
 
-  // Now start reading the data line by line
-  int err = 0;
-  size_t counter = 0;
-  for (int slice = zStart; slice < zEnd; ++slice)
+  // Build a table of destinations indexed by the tab delimited column so each
+  // token is converted straight into its array without going through the parsers
+  std::vector<DataColumn> columns(size);
+  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
+  while (iter.hasNext())
+  {
+    iter.next();
+    DataParser::Pointer dparser = iter.value();
+    DataColumn& column = columns[dparser->getColumnIndex()];
+    column.type = getPointerType(dparser->getColumnName());
+    column.ptr = dparser->getVoidPointer();
+  }
+  size_t numColumns = m_NamePointerMap.size();
+
+  // Work out which lines of the data section belong to the slice(s) being read. Every
+  // line of every slice before the requested one is skipped.
+  size_t sliceSize = xCells * yCells;
+  size_t firstLine = 0;
+  bool haveTarget = (zEnd > zStart);
+  if(m_SingleSliceRead >= 0)
+  {
+    firstLine = static_cast<size_t>(m_SingleSliceRead) * sliceSize;
+    haveTarget = haveTarget && (m_SingleSliceRead < zEnd);
+  }
+  size_t lastLine = haveTarget ? firstLine + totalScanPoints : 0;
+
+  const char* dataBegin = in.data() + in.getPosition();
+  const char* dataEnd = in.data() + in.size();
+  size_t numChunks = EbsdTextScanner::suggestedChunkCount(dataEnd - dataBegin, m_ParallelParsing);
+  std::vector<EbsdTextScanner::LineChunk> chunks = EbsdTextScanner::splitLines(dataBegin, dataEnd, numChunks, numChunks > 1);
+  size_t numLines = 0;
+  for(size_t c = 0; c < chunks.size(); ++c)
+  {
+    numLines += chunks[c].numLines;
+  }
+
+  // A blank last line is the end of the file and not a line of data
+  bool lastLineIsBlank = false;
+  if(numLines > 0)
   {
-    for (size_t row = 0; row < yCells; ++row)
+    const char* p = dataEnd;
+    if(dataEnd[-1] == '\n')
     {
-      for (size_t col = 0; col < xCells; ++col)
-      {
-        buf = in.readLine(); // Read the line into a QByteArray including the newline
-        buf = buf.trimmed(); // Remove leading and trailing whitespace
+      --p;
+    }
+    lastLineIsBlank = true;
+    while(p > dataBegin && p[-1] != '\n')
+    {
+      --p;
+      lastLineIsBlank = lastLineIsBlank && EbsdTextScanner::isSpace(*p);
+    }
+  }
+  size_t availableLines = std::min(lastLine, numLines);
+  size_t endLine = availableLines;
+  if(lastLineIsBlank && endLine == numLines)
+  {
+    --endLine;
+  }
 
-        if ( (m_SingleSliceRead < 0) || (m_SingleSliceRead >= 0 && slice == m_SingleSliceRead) )
+  // Lowest failing line of each chunk
+  std::vector<size_t> errorLine(chunks.size(), endLine);
+  std::vector<int> errorTokens(chunks.size(), 0);
+  auto parseChunk = [&](size_t c) {
+    const char* p = chunks[c].begin;
+    const char* end = chunks[c].end;
+    for(size_t line = chunks[c].firstLine; p < end && line < endLine; ++line)
+    {
+      const char* newline = static_cast<const char*>(::memchr(p, '\n', end - p));
+      const char* lineEnd = (nullptr == newline) ? end : newline;
+      if(line >= firstLine)
+      {
+        int numTokens = 0;
+        if(parseDataLine(p, lineEnd, line - firstLine, columns, numColumns, numTokens) < 0)
         {
-
-          if(in.atEnd() == true && buf.isEmpty() == true) // We have to have read to the end of the file AND the buffer is empty
-            // otherwise we read EXACTLY the last line and we still need to parse the line.
-          {
-            //  ++counter; // We need to make sure this gets incremented before leaving
-            break;
-          }
-          err = parseDataLine(buf, row, col, counter, xCells, yCells);
-          if (err < 0) { return err; }
-          ++counter;
+          errorLine[c] = line;
+          errorTokens[c] = numTokens;
+          break;
         }
-
-      }
-      if(in.atEnd() == true)
-      {
-        break;
       }
+      p = lineEnd + 1;
     }
-    //   std::cout << ".ctf Z Slice " << slice << " Reading complete." << std::endl;
-    if(m_SingleSliceRead >= 0 && slice == m_SingleSliceRead)
+  };
+  EbsdTextScanner::forEachChunk(chunks.size(), parseChunk);
+
+  for(size_t c = 0; c < chunks.size(); ++c)
+  {
+    if(errorLine[c] < endLine)
     {
-      break;
+      size_t row = (errorLine[c] % sliceSize) / xCells;
+      setErrorCode(-107);
+      QString msg;
+      QTextStream ss(&msg);
+      ss << "The number of tab delimited data columns (" << errorTokens[c] << ") does not match the number of tab delimited header columns (";
+      ss << numColumns << "). Please check the CTF file for mistakes.";
+      ss << "The error occurred at data row " << row << " which is " << row << " past ";
+      ss << "the column header row.";
+      ss << "\nThe CTF Reader will now abort reading any further in the file.";
+
+      setErrorMessage(msg);
+      return -106;
     }
   }
 
-  if(counter != getNumberOfElements() && in.atEnd() == true)
+  size_t counter = (endLine > firstLine) ? endLine - firstLine : 0;
+  // How far a line by line read would have gotten through the file
+  size_t linesConsumed = haveTarget ? availableLines : static_cast<size_t>(std::max(zEnd, 0)) * sliceSize;
+  bool atEnd = (linesConsumed >= numLines);
+
+  if(counter != getNumberOfElements() && atEnd == true)
   {
     ss.string()->clear();
     ss << "Premature End Of File reached.\n" << getFileName() << "\nNumRows=" << getNumberOfElements() << "\ncounter=" << counter
@@ -579,47 +652,53 @@ int CtfReader::parseHeaderLines(QList<QByteArray>& headerLines)
 // -----------------------------------------------------------------------------
 //  Read the data part of the .ctf file
 // -----------------------------------------------------------------------------
-int CtfReader::parseDataLine(QByteArray& line, size_t row, size_t col, size_t offset, size_t xCells, size_t yCells )
+int CtfReader::parseDataLine(const char* lineBegin, const char* lineEnd, size_t offset, const std::vector<DataColumn>& columns, size_t numColumns, int& numTokens)
 {
   /* When reading the data there should be at least 11 cols of data.
+   * European style decimal commas are converted to points as each value is parsed.
+   * This is called from several threads at once and only writes into its own slot of each array.
    */
-  //  float x, y,  p1, p, p2, mad;
-  //  int phase, bCount, error, bc, bs;
-  //  size_t offset = i;
-
-  // Filter the line to convert European command style decimals to US/UK style points
-  //  QVector<char> cLine(line.size()+1);
-  //  ::memcpy( &(cLine.front()), line.c_str(), line.size() + 1);
-  for (int c = 0; c < line.size(); ++c)
+  // Remove leading and trailing whitespace
+  while(lineBegin < lineEnd && EbsdTextScanner::isSpace(*lineBegin))
   {
-    if(line.at(c) == ',')
-    {
-      line[c] = '.';
-    }
+    ++lineBegin;
   }
-
-  QList<QByteArray> tokens = line.split('\t');
-  if(tokens.size() != m_NamePointerMap.size())
+  while(lineEnd > lineBegin && EbsdTextScanner::isSpace(lineEnd[-1]))
   {
-    setErrorCode(-107);
-    QString msg;
-    QTextStream ss(&msg);
-    ss << "The number of tab delimited data columns (" << tokens.size() << ") does not match the number of tab delimited header columns (";
-    ss << m_NamePointerMap.size() << "). Please check the CTF file for mistakes.";
-    ss << "The error occurred at data row " << row << " which is " << row << " past ";
-    ss << "the column header row.";
-    ss << "\nThe CTF Reader will now abort reading any further in the file.";
+    --lineEnd;
+  }
 
-    setErrorMessage(msg);
-    return -106; // Could not allocate the memory
+  numTokens = 1;
+  for(const char* c = lineBegin; c < lineEnd; ++c)
+  {
+    if(*c == '\t')
+    {
+      ++numTokens;
+    }
   }
-  QMapIterator<QString, DataParser::Pointer> iter(m_NamePointerMap);
-  while (iter.hasNext())
+  if(static_cast<size_t>(numTokens) != numColumns || static_cast<size_t>(numTokens) > columns.size())
   {
-    iter.next();
+    return -106;
+  }
 
-    DataParser::Pointer dparser = iter.value();
-    dparser->parse(tokens[dparser->getColumnIndex()], offset);
+  const char* tokBegin = lineBegin;
+  for(int t = 0; t < numTokens; ++t)
+  {
+    const char* tokEnd = tokBegin;
+    while(tokEnd < lineEnd && *tokEnd != '\t')
+    {
+      ++tokEnd;
+    }
+    const DataColumn& column = columns[t];
+    if(Ebsd::Int32 == column.type)
+    {
+      EbsdTextScanner::parseInt32(tokBegin, tokEnd, static_cast<int32_t*>(column.ptr)[offset], true);
+    }
+    else if(Ebsd::Float == column.type)
+    {
+      EbsdTextScanner::parseFloat(tokBegin, tokEnd, static_cast<float*>(column.ptr)[offset], true);
+    }
+    tokBegin = tokEnd + 1;
   }
   return 0;
 }
@@ -653,7 +732,7 @@ QVector<QString> CtfReader::tokenize(char* buf, char delimiter)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int CtfReader::getHeaderLines(QFile& reader, QList<QByteArray>& headerLines)
+int CtfReader::getHeaderLines(EbsdTextScanner& reader, QList<QByteArray>& headerLines)
 {
   int err = 0;
   QByteArray buf;
@@ -41,6 +41,8 @@
 #include <QtCore/QFile>
 #include <QtCore/QtDebug>
 
+#include <vector>
+
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdConstants.h"
@@ -50,6 +52,8 @@
 #include "CtfPhase.h"
 #include "DataParser.hpp"
 
+class EbsdTextScanner;
+
 
 /**
 * @class CtfReader CtfReader.h EbsdLib/HKL/CtfReader.h
@@ -91,6 +95,9 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
 
     EBSD_INSTANCE_PROPERTY(QVector<CtfPhase::Pointer>, PhaseVector)
 
+    /** @brief Parse the data section of large files with several threads. Defaults to true. */
+    EBSD_INSTANCE_PROPERTY(bool, ParallelParsing)
+
     EBSD_POINTER_PROP(Phase, Phase, int)
     EBSD_POINTER_PROP(X, X, float)
     EBSD_POINTER_PROP(Y, Y, float)
@@ -170,6 +177,13 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
   protected:
 
   private:
+    /** @brief Destination array of one tab delimited column in the data section */
+    struct DataColumn
+    {
+      Ebsd::NumType type = Ebsd::UnknownNumType;
+      void* ptr = nullptr;
+    };
+
     int m_SingleSliceRead;
     QMap<QString, DataParser::Pointer> m_NamePointerMap;
 
@@ -179,7 +193,7 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
      * @param headerLines
      * @return
      */
-    int getHeaderLines(QFile& reader, QList<QByteArray>& headerLines);
+    int getHeaderLines(EbsdTextScanner& reader, QList<QByteArray>& headerLines);
 
     /**
     * Checks that the line is the header of the columns for the data.
@@ -198,20 +212,20 @@ class EbsdLib_EXPORT CtfReader : public EbsdReader
 
     /**
        * @brief
-       * @param in The input file stream to read from
+       * @param in The mapped input file, positioned at the column header line
        */
-    int readData(QFile& in);
+    int readData(EbsdTextScanner& in);
 
     /**
     * @brief Reads a line of Data from the ASCII based file
-    * @param line The current line of data
-    * @param row Current Row of Data
-    * @param i The current index into a flat array
-    * @param xCells Number of X Data Points
-    * @param yCells Number of Y Data Points
-    * @param col The current Column of Data
+    * @param lineBegin Start of the current line of data
+    * @param lineEnd End of the line (not including the newline)
+    * @param offset The current index into a flat array
+    * @param columns The destination of each tab delimited column
+    * @param numColumns The number of columns that were allocated
+    * @param numTokens Set to the number of tab delimited values found on the line
     */
-    int parseDataLine(QByteArray& line, size_t row, size_t col, size_t i, size_t xCells, size_t yCells );
+    int parseDataLine(const char* lineBegin, const char* lineEnd, size_t offset, const std::vector<DataColumn>& columns, size_t numColumns, int& numTokens);
 
     CtfReader(const CtfReader&) = delete;      // Copy Constructor Not Implemented
     void operator=(const CtfReader&) = delete; // Move assignment Not Implemented
@@ -83,7 +83,7 @@ using namespace H5Support_NAMESPACE;
 #define WRITE_EBSD_DATA_ARRAY(reader, m_msgType, gid, key)\
   {\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataColumn(gid, key, dims[0], static_cast<hsize_t>(reader.getXCells()), dataPtr);\
       if (err < 0) {\
         QString ss = \
                      QObject::tr("H5CtfImporter Error: Could not write Ctf Data array for '%1' to the HDF5 file with data set name '%2'\n")\
@@ -147,17 +147,46 @@ int H5CtfImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5CtfImporter::importFile(hid_t fileId, int64_t z, const QString& ctfFile)
 {
-  herr_t err = -1;
-  setCancel(false);
-  setErrorCondition(0);
-  setPipelineMessage("");
+  int err = 0;
+  std::shared_ptr<EbsdReader> reader = readFile(ctfFile, err);
+  return writeFile(fileId, z, reader.get(), err);
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<EbsdReader> H5CtfImporter::readFile(const QString& ctfFile, int& err)
+{
   //  std::cout << "H5CtfImporter: Importing " << ctfFile << std::endl;
-  CtfReader reader;
-  reader.setFileName(ctfFile);
+  std::shared_ptr<CtfReader> reader(new CtfReader);
+  reader->setFileName(ctfFile);
+  reader->setParallelParsing(getParallelParsing());
 
   // Now actually read the file
-  err = reader.readFile();
+  err = reader->readFile();
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfImporter::writeFile(hid_t fileId, int64_t z, EbsdReader* ebsdReader, int readError)
+{
+  herr_t err = readError;
+  setCancel(false);
+  setErrorCondition(0);
+  setPipelineMessage("");
+
+  CtfReader* ctfReader = dynamic_cast<CtfReader*>(ebsdReader);
+  if(nullptr == ctfReader)
+  {
+    QString ss = "H5CtfImporter Error: The reader passed to writeFile() is not a CtfReader.";
+    setPipelineMessage(ss);
+    setErrorCondition(-800);
+    progressMessage(ss, 100);
+    return -1;
+  }
+  CtfReader& reader = *ctfReader;
 
   // Check for errors
   if (err < 0)
@@ -333,7 +362,6 @@ int H5CtfImporter::writeSliceData(hid_t fileId, CtfReader& reader, int z, int ac
     return -1;
   }
 
-  int32_t rank = 1;
   hsize_t dims[1] =
   { static_cast<hsize_t> (reader.getXCells() * reader.getYCells()) };
 
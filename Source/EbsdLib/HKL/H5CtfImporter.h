@@ -73,6 +73,23 @@ class EbsdLib_EXPORT H5CtfImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& angFile);
 
+    /**
+     * @brief Reads the .ctf file into memory without touching the HDF5 file
+     * @param ctfFile The absolute path to the input .ctf file
+     * @param err The error code from the CtfReader (out)
+     * @return The CtfReader holding the data
+     */
+    std::shared_ptr<EbsdReader> readFile(const QString& ctfFile, int& err);
+
+    /**
+     * @brief Writes a .ctf file that was read with readFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     * @param reader The CtfReader returned from readFile()
+     * @param readError The error code returned from readFile()
+     */
+    int writeFile(hid_t fileId, int64_t index, EbsdReader* reader, int readError);
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid AngReader instance
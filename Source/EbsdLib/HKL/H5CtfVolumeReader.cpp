@@ -317,3 +317,25 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfVolumeReader::readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells)
+{
+  hid_t headerGid = H5Gopen(sliceGid, Ebsd::H5::Header.toLatin1().data(), H5P_DEFAULT);
+  if(headerGid < 0)
+  {
+    return -1;
+  }
+  int cols = 0;
+  int rows = 0;
+  herr_t err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ctf::XCells, cols);
+  if(err >= 0)
+  {
+    err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ctf::YCells, rows);
+  }
+  H5Gclose(headerGid);
+  xCells = cols;
+  yCells = rows;
+  return err;
+}
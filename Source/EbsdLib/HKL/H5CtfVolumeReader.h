@@ -124,6 +124,15 @@ class EbsdLib_EXPORT H5CtfVolumeReader : public H5EbsdVolumeReader
   protected:
     H5CtfVolumeReader();
 
+    /**
+     * @brief Reads the number of columns and rows of a single slice from its header
+     * @param sliceGid The HDF5 group of the slice
+     * @param xCells The number of columns in the slice
+     * @param yCells The number of rows in the slice
+     * @return Error code, negative on failure
+     */
+    int readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells);
+
   private:
     QVector<CtfPhase::Pointer> m_Phases;
 
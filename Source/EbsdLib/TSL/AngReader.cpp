@@ -35,7 +35,10 @@
 
 #include "AngReader.h"
 
+#include <string.h>
+
 #include <algorithm>
+#include <vector>
 
 #include <QtCore/QFile>
 #include <QtCore/QObject>
@@ -44,6 +47,7 @@
 #include "AngConstants.h"
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
+#include "EbsdLib/Utilities/EbsdTextScanner.h"
 
 // -----------------------------------------------------------------------------
 //
@@ -66,6 +70,7 @@ AngReader::AngReader()
   setNumFeatures(10);
 
   m_ReadHexGrid = false;
+  m_ParallelParsing = true;
 
   // Initialize the map of header key to header value
   m_HeaderMap[Ebsd::Ang::TEMPIXPerUM] = AngHeaderEntry<float>::NewEbsdHeaderEntry(Ebsd::Ang::TEMPIXPerUM);
@@ -290,8 +295,8 @@ int AngReader::readFile()
   QByteArray buf;
   setHeaderIsComplete(false);
 
-  QFile in(getFileName());
-  if(!in.open(QIODevice::ReadOnly | QIODevice::Text))
+  EbsdTextScanner in;
+  if(!in.open(getFileName()))
   {
     QString msg = QObject::tr("Ang file could not be opened: %1").arg(getFileName());
     setErrorCode(-100);
@@ -303,8 +308,11 @@ int AngReader::readFile()
   setOriginalHeader(origHeader);
   m_PhaseVector.clear();
 
+  // The first line that does not start with '#' is the first line of data
+  size_t dataStart = in.getPosition();
   while(!in.atEnd() && false == getHeaderIsComplete())
   {
+    dataStart = in.getPosition();
     buf = in.readLine();
     if(buf.at(0) != '#')
     {
@@ -336,8 +344,8 @@ int AngReader::readFile()
     setErrorMessage("No phase was parsed in the header portion of the file. This possibly means that part of the header is missing.");
     return -150;
   }
-  // We need to pass in the buffer because it has the first line of data
-  readData(in, buf);
+  // The data section is parsed straight out of the mapped file
+  readData(in.data() + dataStart, in.data() + in.size());
   if(getErrorCode() < 0)
   {
     return getErrorCode();
@@ -349,7 +357,7 @@ int AngReader::readFile()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void AngReader::readData(QFile& in, QByteArray& buf)
+void AngReader::readData(const char* dataBegin, const char* dataEnd)
 {
   QString streamBuf;
   QTextStream ss(&streamBuf);
@@ -427,68 +435,121 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  size_t counter = 1; // Because we are on the first line now.
-
-  bool onEvenRow = false;
-  int col = 0;
-
-  int yChange = 0;
+  // The row tracking below starts from the value that was in the array before any parsing
   float oldY = m_Y[0];
-  int nxOdd = 0;
-  int nxEven = 0;
-  // int nRows = 0;
 
-  for(size_t i = 0; i < totalDataPoints; ++i)
+  // Split the data section into chunks of whole lines and parse each chunk on its own thread.
+  // Each line knows its own index so the values land in the same place as a serial read.
+  size_t numChunks = EbsdTextScanner::suggestedChunkCount(dataEnd - dataBegin, m_ParallelParsing);
+  std::vector<EbsdTextScanner::LineChunk> chunks = EbsdTextScanner::splitLines(dataBegin, dataEnd, numChunks, numChunks > 1);
+  size_t numLines = 0;
+  for(size_t c = 0; c < chunks.size(); ++c)
+  {
+    numLines += chunks[c].numLines;
+  }
+
+  // Lowest failing line of each chunk
+  size_t numResults = std::max(chunks.size(), static_cast<size_t>(1));
+  std::vector<size_t> errorLine(numResults, totalDataPoints);
+  std::vector<int> errorCode(numResults, 0);
+  std::vector<int> errorColumn(numResults, 0);
+  auto parseChunk = [&](size_t c) {
+    const char* p = chunks[c].begin;
+    const char* end = chunks[c].end;
+    for(size_t i = chunks[c].firstLine; p < end && i < totalDataPoints; ++i)
+    {
+      const char* newline = static_cast<const char*>(::memchr(p, '\n', end - p));
+      const char* lineEnd = (nullptr == newline) ? end : newline;
+      int column = 0;
+      int err = parseDataLine(p, lineEnd, i, column);
+      if(err < 0)
+      {
+        errorLine[c] = i;
+        errorCode[c] = err;
+        errorColumn[c] = column;
+        break;
+      }
+      p = lineEnd + 1;
+    }
+  };
+  if(numLines == 0)
   {
-    if(i > 0)
+    // The header ran right up to the end of the file. Parse the empty line like a serial read would.
+    if(totalDataPoints > 0)
     {
-      //  ::memset(buf, 0, bufSize); // Clear the buffer
-      buf = in.readLine();
-      ++counter;
+      errorCode[0] = parseDataLine(dataEnd, dataEnd, 0, errorColumn[0]);
+      errorLine[0] = (errorCode[0] < 0) ? 0 : totalDataPoints;
     }
-    this->parseDataLine(buf, i);
-    if(getErrorCode() < 0)
-    {
-      ss.string()->clear();
+    numLines = 1;
+  }
+  else
+  {
+    EbsdTextScanner::forEachChunk(chunks.size(), parseChunk);
+  }
 
-      ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
-         << buf << "\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols << "  Calculated Data Points: " << totalDataPoints
-         << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter << "\n";
-      setErrorMessage(*(ss.string()));
+  size_t numParsed = std::min(totalDataPoints, numLines);
+  int err = 0;
+  for(size_t c = 0; c < numResults; ++c)
+  {
+    if(errorCode[c] < 0)
+    {
+      numParsed = errorLine[c];
+      err = errorCode[c];
+      m_ErrorColumn = errorColumn[c];
       break;
     }
+  }
 
+  // Replay the row/column tracking over the lines that were successfully parsed
+  int col = 0;
+  int yChange = 0;
+  for(size_t i = 0; i < numParsed; ++i)
+  {
     if(fabs(m_Y[i] - oldY) > 1e-6)
     {
       ++yChange;
       oldY = m_Y[i];
-      onEvenRow = !onEvenRow;
       col = 0;
     }
     else
     {
       col++;
     }
-    if(yChange == 0)
-    {
-      ++nxOdd;
-    }
-    if(yChange == 1)
-    {
-      ++nxEven;
-    }
-    if(in.atEnd() == true)
-    {
-      break;
-    }
   }
 
-#if 0
-  nRows = yChange + 1;
+  // A serial read counts the first line before the loop starts
+  size_t counter = (totalDataPoints == 0) ? 1 : numParsed;
+  bool atEnd = (std::max(numParsed, static_cast<size_t>(1)) >= numLines);
 
-  std::cout << "Header: nRows: " << numRows << " Odd Cols: " << nOddCols << "  Even Cols: " << nEvenCols << std::endl;
-  std::cout << "File:   nRows: " << nRows << " Odd Cols: " << nxOdd << "  Even Cols: " << nxEven << std::endl;
-#endif
+  if(err < 0)
+  {
+    counter = numParsed + 1;
+    const char* lineBegin = dataBegin;
+    const char* lineEnd = dataEnd;
+    for(size_t c = 0; c < chunks.size(); ++c)
+    {
+      if(errorCode[c] < 0)
+      {
+        lineBegin = chunks[c].begin;
+        lineEnd = chunks[c].end;
+        for(size_t i = chunks[c].firstLine; i < numParsed; ++i)
+        {
+          lineBegin = static_cast<const char*>(::memchr(lineBegin, '\n', lineEnd - lineBegin)) + 1;
+        }
+        const char* newline = static_cast<const char*>(::memchr(lineBegin, '\n', lineEnd - lineBegin));
+        lineEnd = (nullptr == newline) ? lineEnd : newline;
+        break;
+      }
+    }
+    setErrorCode(err);
+    ss.string()->clear();
+
+    ss << "Error parsing the data line (Numeric conversion). Error code is " << getErrorCode() << " and occurred at data column " << m_ErrorColumn << " (Zero Based)\n"
+       << QByteArray(lineBegin, static_cast<int>(lineEnd - lineBegin)) << "\n\n*** Header information ***\nRows=" << numRows << " EvenCols=" << nEvenCols << " OddCols=" << nOddCols
+       << "  Calculated Data Points: " << totalDataPoints << "\n***Parsing Position ***\nCurrent Row: " << yChange << "  Current Column Index: " << col << "  Current Data Point Count: " << counter
+       << "\n";
+    setErrorMessage(*(ss.string()));
+  }
 
   if(getNumFeatures() < 10)
   {
@@ -503,7 +564,7 @@ void AngReader::readData(QFile& in, QByteArray& buf)
     return;
   }
 
-  if(counter != totalDataPoints && in.atEnd() == true)
+  if(counter != totalDataPoints && atEnd == true)
   {
     ss.string()->clear();
 
@@ -645,7 +706,7 @@ std::cout << "m_HeaderMap[Ebsd::Ang::" << word << "] = AngHeaderEntry<float>::Ne
 // -----------------------------------------------------------------------------
 //  Read the data part of the ANG file
 // -----------------------------------------------------------------------------
-void AngReader::parseDataLine(QByteArray& line, size_t i)
+int AngReader::parseDataLine(const char* lineBegin, const char* lineEnd, size_t i, int& errorColumn)
 {
   /* When reading the data there should be at least 8 cols of data. There may even
    * be 10 columns of data. The column names should be the following:
@@ -662,127 +723,151 @@ void AngReader::parseDataLine(QByteArray& line, size_t i)
    *
    * Some TSL ang files do NOT have all 10 columns. Assume these are lacking the last
    * 2 columns and all the other columns are the same as above.
+   *
+   * This is called from several threads at once so it only writes into its own
+   * slot of the arrays and reports any error back to the caller.
    */
-  m_ErrorColumn = 0;
+  errorColumn = 0;
+  int err = 0;
   float p1 = 0.0f, p = 0.0f, p2 = 0.0f, x = -1.0f, y = -1.0f, iqual = -1.0f, conf = -1.0f, semSignal = -1.0f, fit = -1.0f;
   int ph = 0;
-  size_t offset = 0;
-  QList<QByteArray> tokens = line.trimmed().simplified().split(' ');
-  bool ok = true;
-  offset = i;
-  if(tokens.size() >= 1)
+  size_t offset = i;
+
+  // Find the white space delimited tokens. We only ever need the first 10 of them.
+  const char* tokBegin[10];
+  const char* tokEnd[10];
+  int numTokens = 0;
+  const char* c = lineBegin;
+  while(numTokens < 10)
   {
-    p1 = tokens[0].toFloat(&ok);
-    if(!ok)
+    while(c < lineEnd && EbsdTextScanner::isSpace(*c))
     {
-      setErrorCode(-2501);
-      m_ErrorColumn = 0;
+      ++c;
+    }
+    if(c == lineEnd)
+    {
+      break;
+    }
+    tokBegin[numTokens] = c;
+    while(c < lineEnd && !EbsdTextScanner::isSpace(*c))
+    {
+      ++c;
+    }
+    tokEnd[numTokens] = c;
+    ++numTokens;
+  }
+  if(numTokens == 0)
+  {
+    // A blank line still produces a single empty token
+    tokBegin[0] = lineEnd;
+    tokEnd[0] = lineEnd;
+    numTokens = 1;
+  }
+
+  if(numTokens >= 1)
+  {
+    if(!EbsdTextScanner::parseFloat(tokBegin[0], tokEnd[0], p1))
+    {
+      err = -2501;
+      errorColumn = 0;
     }
     m_Phi1[offset] = p1;
   }
-  if(tokens.size() >= 2)
+  if(numTokens >= 2)
   {
-    p = tokens[1].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[1], tokEnd[1], p))
     {
-      setErrorCode(-2502);
-      m_ErrorColumn = 1;
+      err = -2502;
+      errorColumn = 1;
     }
     m_Phi[offset] = p;
   }
-  if(tokens.size() >= 3)
+  if(numTokens >= 3)
   {
-    p2 = tokens[2].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[2], tokEnd[2], p2))
     {
-      setErrorCode(-2503);
-      m_ErrorColumn = 2;
+      err = -2503;
+      errorColumn = 2;
     }
     m_Phi2[offset] = p2;
   }
-  if(tokens.size() >= 4)
+  if(numTokens >= 4)
   {
-    x = tokens[3].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[3], tokEnd[3], x))
     {
-      setErrorCode(-2504);
-      m_ErrorColumn = 3;
+      err = -2504;
+      errorColumn = 3;
     }
     m_X[offset] = x;
   }
-  if(tokens.size() >= 5)
+  if(numTokens >= 5)
   {
-    y = tokens[4].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[4], tokEnd[4], y))
     {
-      setErrorCode(-2505);
-      m_ErrorColumn = 4;
+      err = -2505;
+      errorColumn = 4;
     }
     m_Y[offset] = y;
   }
-  if(tokens.size() >= 6)
+  if(numTokens >= 6)
   {
-    iqual = tokens[5].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[5], tokEnd[5], iqual))
     {
-      setErrorCode(-2506);
-      m_ErrorColumn = 5;
+      err = -2506;
+      errorColumn = 5;
     }
     m_Iq[offset] = iqual;
   }
-  if(tokens.size() >= 7)
+  if(numTokens >= 7)
   {
-    conf = tokens[6].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[6], tokEnd[6], conf))
     {
-      setErrorCode(-2507);
-      m_ErrorColumn = 6;
+      err = -2507;
+      errorColumn = 6;
     }
     m_Ci[offset] = conf;
   }
-  if(tokens.size() >= 8)
+  if(numTokens >= 8)
   {
-    ph = tokens[7].toInt(&ok);
-    if(!ok)
-    { 
-      setErrorCode(-2508);
-      m_ErrorColumn = 7;
+    if(!EbsdTextScanner::parseInt32(tokBegin[7], tokEnd[7], ph))
+    {
+      err = -2508;
+      errorColumn = 7;
       // Some have floats instead of integers so lets try that.
-      float f = tokens[7].toFloat(&ok);
-      if(!ok)
+      float f = 0.0f;
+      if(!EbsdTextScanner::parseFloat(tokBegin[7], tokEnd[7], f))
       {
-        setErrorCode(-2588);
-        m_ErrorColumn = 7;
+        err = -2588;
+        errorColumn = 7;
       }
       else
       {
-        setErrorCode(0);
+        err = 0;
         ph = static_cast<int32_t>(f);
       }
     }
     m_PhaseData[offset] = ph;
   }
 
-  if(tokens.size() >= 9)
+  if(numTokens >= 9)
   {
-    semSignal = tokens[8].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[8], tokEnd[8], semSignal))
     {
-      setErrorCode(-2509);
-      m_ErrorColumn = 8;
+      err = -2509;
+      errorColumn = 8;
     }
     m_SEMSignal[offset] = semSignal;
   }
-  if(tokens.size() >= 10)
+  if(numTokens >= 10)
   {
-    fit = tokens[9].toFloat(&ok);
-    if(!ok)
+    if(!EbsdTextScanner::parseFloat(tokBegin[9], tokEnd[9], fit))
     {
-      setErrorCode(-2510);
-      m_ErrorColumn = 9;
+      err = -2510;
+      errorColumn = 9;
     }
     m_Fit[offset] = fit;
   }
+  return err;
 }
 
 // -----------------------------------------------------------------------------
@@ -90,6 +90,9 @@ class EbsdLib_EXPORT AngReader : public EbsdReader
 
     EBSD_INSTANCE_PROPERTY(bool, ReadHexGrid)
 
+    /** @brief Parse the data section of large files with several threads. Defaults to true. */
+    EBSD_INSTANCE_PROPERTY(bool, ParallelParsing)
+
     EBSD_POINTER_PROPERTY(Phi1, Phi1, float)
     EBSD_POINTER_PROPERTY(Phi, Phi, float)
     EBSD_POINTER_PROPERTY(Phi2, Phi2, float)
@@ -147,7 +150,11 @@ class EbsdLib_EXPORT AngReader : public EbsdReader
     AngPhase::Pointer   m_CurrentPhase;
     int m_ErrorColumn = 0;
 
-    void readData(QFile& in, QByteArray& buf);
+    /** @brief Parses the data section of the file
+    * @param dataBegin Start of the first line of data
+    * @param dataEnd End of the file
+    */
+    void readData(const char* dataBegin, const char* dataEnd);
 
     /** @brief Parses the value from a single line of the header section of the TSL .ang file
     * @param line The line to parse
@@ -155,9 +162,13 @@ class EbsdLib_EXPORT AngReader : public EbsdReader
     void parseHeaderLine(QByteArray& buf);
 
     /** @brief Parses the data from a line of data from the TSL .ang file
-      * @param line The line of data to parse
+      * @param lineBegin Start of the line of data to parse
+      * @param lineEnd End of the line (not including the newline)
+      * @param i The index of the line in the data section
+      * @param errorColumn Set to the column that failed to convert
+      * @return 0 on success or the error code for the column that failed
       */
-    void parseDataLine(QByteArray& line, size_t i);
+    int parseDataLine(const char* lineBegin, const char* lineEnd, size_t i, int& errorColumn);
 
     AngReader(const AngReader&);    // Copy Constructor Not Implemented
     void operator=(const AngReader&); // Move assignment Not Implemented
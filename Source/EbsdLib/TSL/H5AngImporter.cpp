@@ -101,7 +101,7 @@ H5AngImporter::~H5AngImporter() = default;
   {\
     m_msgType* dataPtr = reader.get##prpty##Pointer();\
     if (nullptr != dataPtr) {\
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);\
+      err = writeDataColumn(gid, key, dims[0], static_cast<hsize_t>(reader.getNumEvenCols()), dataPtr);\
       if (err < 0) {\
         ss.string()->clear();\
         ss << "H5AngImporter Error: Could not write Ang Data array for '" << key\
@@ -144,19 +144,49 @@ int H5AngImporter::numberOfSlicesImported()
 // -----------------------------------------------------------------------------
 int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
 {
-  herr_t err = -1;
+  int err = 0;
+  std::shared_ptr<EbsdReader> reader = readFile(angFile, err);
+  return writeFile(fileId, z, reader.get(), err);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<EbsdReader> H5AngImporter::readFile(const QString& angFile, int& err)
+{
+  //  std::cout << "H5AngImporter: Importing " << angFile;
+  std::shared_ptr<AngReader> reader(new AngReader);
+  reader->setFileName(angFile);
+  reader->setParallelParsing(getParallelParsing());
+
+  // Now actually read the file
+  err = reader->readFile();
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngImporter::writeFile(hid_t fileId, int64_t z, EbsdReader* ebsdReader, int readError)
+{
+  herr_t err = readError;
   setCancel(false);
   setErrorCondition(false);
   setPipelineMessage("");
   QString streamBuf;
   QTextStream ss(&streamBuf);
 
-  //  std::cout << "H5AngImporter: Importing " << angFile;
-  AngReader reader;
-  reader.setFileName(angFile);
-
-  // Now actually read the file
-  err = reader.readFile();
+  AngReader* angReader = dynamic_cast<AngReader*>(ebsdReader);
+  if(nullptr == angReader)
+  {
+    ss << "H5AngImporter Error: The reader passed to writeFile() is not an AngReader.";
+    setPipelineMessage(*(ss.string()));
+    setErrorCondition(-800);
+    progressMessage(*(ss.string()), 100);
+    return -1;
+  }
+  AngReader& reader = *angReader;
+  QString angFile = reader.getFileName();
 
   // Check for errors
   if (err < 0)
@@ -297,7 +327,6 @@ int H5AngImporter::importFile(hid_t fileId, int64_t z, const QString& angFile)
     return -1;
   }
 
-  int32_t rank = 1;
   hsize_t dims[1] = { static_cast<hsize_t>(reader.getNumEvenCols() * reader.getNumRows() ) };
 
   WRITE_ANG_DATA_ARRAY(reader, float, gid, Phi1, Ebsd::Ang::Phi1);
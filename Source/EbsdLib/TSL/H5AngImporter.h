@@ -76,6 +76,23 @@ class EbsdLib_EXPORT H5AngImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& angFile);
 
+    /**
+     * @brief Reads the .ang file into memory without touching the HDF5 file
+     * @param angFile The absolute path to the input .ang file
+     * @param err The error code from the AngReader (out)
+     * @return The AngReader holding the data
+     */
+    std::shared_ptr<EbsdReader> readFile(const QString& angFile, int& err);
+
+    /**
+     * @brief Writes an .ang file that was read with readFile() into the HDF5 file
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param index The slice index for the file
+     * @param reader The AngReader returned from readFile()
+     * @param readError The error code returned from readFile()
+     */
+    int writeFile(hid_t fileId, int64_t index, EbsdReader* reader, int readError);
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid AngReader instance
@@ -41,6 +41,7 @@
 #include <QtCore/QString>
 
 #include "H5Support/H5Lite.h"
+#include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
 
 #include "EbsdLib/EbsdConstants.h"
@@ -315,4 +316,52 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngVolumeReader::readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells)
+{
+  hid_t headerGid = H5Gopen(sliceGid, Ebsd::H5::Header.toLatin1().data(), H5P_DEFAULT);
+  if(headerGid < 0)
+  {
+    return -1;
+  }
+  int cols = 0;
+  int rows = 0;
+  herr_t err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ang::NColsEven, cols);
+  if(err >= 0)
+  {
+    err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ang::NRows, rows);
+  }
+  H5Gclose(headerGid);
+  xCells = cols;
+  yCells = rows;
+  return err;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5AngVolumeReader::sliceLoaded(int64_t zval, int64_t xstart, int64_t ystart, int64_t xCells, int64_t yCells, int64_t xpoints, int64_t ypoints)
+{
+  /* For TSL OIM Files if there is a single phase then the value of the phase
+   * data is zero (0). See loadData() for the details.
+   */
+  const DestinationArray* phases = getDestinationArray(Ebsd::Ang::PhaseData);
+  if(nullptr == phases || getNumPhases() != 1)
+  {
+    return;
+  }
+  int* phasePtr = static_cast<int*>(phases->ptr);
+  for(int64_t j = 0; j < yCells; j++)
+  {
+    for(int64_t i = 0; i < xCells; i++)
+    {
+      int64_t index = ((zval * xpoints * ypoints) + ((j + ystart) * xpoints) + (i + xstart)) * phases->numComponents + phases->componentIndex;
+      if(phasePtr[index] < 1)
+      {
+        phasePtr[index] = 1;
+      }
+    }
+  }
+}
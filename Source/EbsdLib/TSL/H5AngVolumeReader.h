@@ -118,6 +118,20 @@ class EbsdLib_EXPORT H5AngVolumeReader : public H5EbsdVolumeReader
   protected:
     H5AngVolumeReader();
 
+    /**
+     * @brief Reads the number of columns and rows of a single slice from its header
+     * @param sliceGid The HDF5 group of the slice
+     * @param xCells The number of columns in the slice
+     * @param yCells The number of rows in the slice
+     * @return Error code, negative on failure
+     */
+    int readSliceDimensions(hid_t sliceGid, int64_t& xCells, int64_t& yCells);
+
+    /**
+     * @brief Converts the phase values of a slice the same way that loadData() does
+     */
+    void sliceLoaded(int64_t zval, int64_t xstart, int64_t ystart, int64_t xCells, int64_t yCells, int64_t xpoints, int64_t ypoints);
+
   private:
     QVector<AngPhase::Pointer> m_Phases;
 
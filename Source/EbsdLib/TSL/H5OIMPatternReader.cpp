@@ -0,0 +1,295 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#include "H5OIMPatternReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/AngConstants.h"
+
+#if defined (H5Support_NAMESPACE)
+using namespace H5Support_NAMESPACE;
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5OIMPatternReader::H5OIMPatternReader()
+: m_FileName()
+, m_HDF5Path()
+, m_BlockSize(256)
+, m_MaxCachedBlocks(8)
+, m_ErrorCode(0)
+, m_ErrorMessage()
+, m_FileId(-1)
+, m_DatasetId(-1)
+, m_NumPatterns(0)
+, m_CachedBlockSize(0)
+, m_CacheHits(0)
+, m_CacheMisses(0)
+{
+  m_PatternDims[0] = 0;
+  m_PatternDims[1] = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5OIMPatternReader::~H5OIMPatternReader()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5OIMPatternReader::open()
+{
+  close();
+  setErrorCode(0);
+  setErrorMessage("");
+
+  m_FileId = QH5Utilities::openFile(getFileName(), true);
+  if(m_FileId < 0)
+  {
+    setErrorCode(-90700);
+    setErrorMessage(QString("H5OIMPatternReader Error: Could not open HDF5 file '%1'").arg(getFileName()));
+    return getErrorCode();
+  }
+
+  QString path = getHDF5Path() + "/" + Ebsd::H5::EBSD + "/" + Ebsd::H5::Data + "/" + Ebsd::Ang::PatternData;
+  m_DatasetId = H5Dopen(m_FileId, path.toLatin1().data(), H5P_DEFAULT);
+  if(m_DatasetId < 0)
+  {
+    setErrorCode(-90701);
+    setErrorMessage(QString("H5OIMPatternReader Error: Could not open the pattern data set '%1'").arg(path));
+    close();
+    return -90701;
+  }
+
+  hid_t fileSpace = H5Dget_space(m_DatasetId);
+  int rank = H5Sget_simple_extent_ndims(fileSpace);
+  hsize_t dims[3] = {0, 0, 0};
+  if(rank == 3)
+  {
+    H5Sget_simple_extent_dims(fileSpace, dims, nullptr);
+  }
+  H5Sclose(fileSpace);
+  if(rank != 3 || dims[1] == 0 || dims[2] == 0)
+  {
+    setErrorCode(-90702);
+    setErrorMessage(QString("H5OIMPatternReader Error: The pattern data set '%1' must have 3 dimensions (NumPatterns, Height, Width)").arg(path));
+    close();
+    return -90702;
+  }
+
+  m_NumPatterns = static_cast<size_t>(dims[0]);
+  m_PatternDims[0] = static_cast<int>(dims[1]);
+  m_PatternDims[1] = static_cast<int>(dims[2]);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5OIMPatternReader::close()
+{
+  if(m_DatasetId >= 0)
+  {
+    H5Dclose(m_DatasetId);
+    m_DatasetId = -1;
+  }
+  if(m_FileId >= 0)
+  {
+    QH5Utilities::closeFile(m_FileId);
+    m_FileId = -1;
+  }
+  m_NumPatterns = 0;
+  m_PatternDims[0] = 0;
+  m_PatternDims[1] = 0;
+  m_Blocks.clear();
+  m_LruOrder.clear();
+  m_CacheHits = 0;
+  m_CacheMisses = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool H5OIMPatternReader::isOpen() const
+{
+  return m_DatasetId >= 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5OIMPatternReader::getNumberOfPatterns() const
+{
+  return m_NumPatterns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void H5OIMPatternReader::getPatternDims(int dims[2]) const
+{
+  dims[0] = m_PatternDims[0];
+  dims[1] = m_PatternDims[1];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5OIMPatternReader::getPatternSize() const
+{
+  return static_cast<size_t>(m_PatternDims[0]) * static_cast<size_t>(m_PatternDims[1]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5OIMPatternReader::readPatterns(size_t start, size_t count, uint8_t* buffer)
+{
+  if(!isOpen())
+  {
+    setErrorCode(-90703);
+    setErrorMessage("H5OIMPatternReader Error: The pattern data set has not been opened");
+    return -90703;
+  }
+  if(start + count > m_NumPatterns || start + count < start)
+  {
+    setErrorCode(-90704);
+    setErrorMessage(QString("H5OIMPatternReader Error: Patterns %1 to %2 were requested but the scan only has %3 patterns").arg(start).arg(start + count).arg(m_NumPatterns));
+    return -90704;
+  }
+  if(count == 0)
+  {
+    return 0;
+  }
+
+  hsize_t fileStart[3] = {static_cast<hsize_t>(start), 0, 0};
+  hsize_t fileCount[3] = {static_cast<hsize_t>(count), static_cast<hsize_t>(m_PatternDims[0]), static_cast<hsize_t>(m_PatternDims[1])};
+  hid_t fileSpace = H5Dget_space(m_DatasetId);
+  H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, nullptr, fileCount, nullptr);
+  hid_t memSpace = H5Screate_simple(3, fileCount, nullptr);
+
+  herr_t err = H5Dread(m_DatasetId, H5T_NATIVE_UINT8, memSpace, fileSpace, H5P_DEFAULT, buffer);
+  H5Sclose(memSpace);
+  H5Sclose(fileSpace);
+  if(err < 0)
+  {
+    setErrorCode(-90705);
+    setErrorMessage(QString("H5OIMPatternReader Error: Could not read patterns %1 to %2").arg(start).arg(start + count));
+    return -90705;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const uint8_t* H5OIMPatternReader::getPattern(size_t index)
+{
+  if(!isOpen() || index >= m_NumPatterns)
+  {
+    setErrorCode(-90704);
+    setErrorMessage(QString("H5OIMPatternReader Error: Pattern %1 is not available").arg(index));
+    return nullptr;
+  }
+
+  size_t blockSize = std::max<size_t>(1, m_BlockSize);
+  size_t maxBlocks = std::max<size_t>(1, m_MaxCachedBlocks);
+  // Cached blocks are keyed on the block size, so throw them away if it changed
+  if(blockSize != m_CachedBlockSize)
+  {
+    m_Blocks.clear();
+    m_LruOrder.clear();
+    m_CachedBlockSize = blockSize;
+  }
+
+  size_t blockIndex = index / blockSize;
+  size_t patternSize = getPatternSize();
+  std::map<size_t, PatternBlock>::iterator iter = m_Blocks.find(blockIndex);
+  if(iter != m_Blocks.end())
+  {
+    m_CacheHits++;
+    m_LruOrder.splice(m_LruOrder.begin(), m_LruOrder, iter->second.lruPosition);
+    return iter->second.data.data() + (index - blockIndex * blockSize) * patternSize;
+  }
+
+  m_CacheMisses++;
+  while(m_Blocks.size() >= maxBlocks)
+  {
+    m_Blocks.erase(m_LruOrder.back());
+    m_LruOrder.pop_back();
+  }
+
+  size_t blockStart = blockIndex * blockSize;
+  size_t blockCount = std::min(blockSize, m_NumPatterns - blockStart);
+  PatternBlock block;
+  block.data.resize(blockCount * patternSize);
+  if(readPatterns(blockStart, blockCount, block.data.data()) < 0)
+  {
+    return nullptr;
+  }
+  m_LruOrder.push_front(blockIndex);
+  block.lruPosition = m_LruOrder.begin();
+  iter = m_Blocks.insert(std::make_pair(blockIndex, std::move(block))).first;
+  return iter->second.data.data() + (index - blockStart) * patternSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5OIMPatternReader::getCacheHits() const
+{
+  return m_CacheHits;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t H5OIMPatternReader::getCacheMisses() const
+{
+  return m_CacheMisses;
+}
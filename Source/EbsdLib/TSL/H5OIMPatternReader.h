@@ -0,0 +1,162 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <list>
+#include <map>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdSetGetMacros.h"
+
+/**
+ * @class H5OIMPatternReader H5OIMPatternReader.h EbsdLib/TSL/H5OIMPatternReader.h
+ * @brief Gives access to the EBSD patterns stored in an EDAX/TSL .h5 file without
+ * loading the whole 'Pattern' data set into memory.
+ *
+ * The pattern data set of a scan is laid out as [NumPatterns][Height][Width] of
+ * unsigned bytes. Callers either copy a range of scan points straight into their own
+ * buffer with readPatterns(), which only touches that range of the file through an
+ * HDF5 hyperslab, or ask for single patterns with getPattern(). The latter reads
+ * BlockSize consecutive patterns at a time and keeps at most MaxCachedBlocks of
+ * those blocks, discarding the least recently used block first.
+ *
+ * The file stays open between open() and close() (or the destructor).
+ */
+class EbsdLib_EXPORT H5OIMPatternReader
+{
+  public:
+    EBSD_SHARED_POINTERS(H5OIMPatternReader)
+    EBSD_STATIC_NEW_MACRO(H5OIMPatternReader)
+    EBSD_TYPE_MACRO(H5OIMPatternReader)
+    virtual ~H5OIMPatternReader();
+
+    EBSD_INSTANCE_STRING_PROPERTY(FileName)
+    /**
+     * @brief The name of the scan inside the file
+     */
+    EBSD_INSTANCE_STRING_PROPERTY(HDF5Path)
+    /**
+     * @brief Number of consecutive patterns that getPattern() reads at a time
+     */
+    EBSD_INSTANCE_PROPERTY(size_t, BlockSize)
+    /**
+     * @brief Maximum number of blocks held by the getPattern() cache
+     */
+    EBSD_INSTANCE_PROPERTY(size_t, MaxCachedBlocks)
+    EBSD_INSTANCE_PROPERTY(int, ErrorCode)
+    EBSD_INSTANCE_STRING_PROPERTY(ErrorMessage)
+
+    /**
+     * @brief Opens the file and the pattern data set of the scan
+     * @return Zero or positive on success
+     */
+    int open();
+
+    /**
+     * @brief Closes the file and releases all cached pattern blocks
+     */
+    void close();
+
+    /**
+     * @brief Returns true between a successful open() and close()
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns the number of patterns (scan points) in the data set
+     */
+    size_t getNumberOfPatterns() const;
+
+    /**
+     * @brief Returns the pattern dimensions as {Height, Width}, the same order H5OIMReader uses
+     */
+    void getPatternDims(int dims[2]) const;
+
+    /**
+     * @brief Returns the number of bytes in a single pattern
+     */
+    size_t getPatternSize() const;
+
+    /**
+     * @brief Copies the patterns [start, start + count) into buffer which has to hold
+     * count * getPatternSize() bytes. This does not go through the cache.
+     * @return Zero or positive on success
+     */
+    int readPatterns(size_t start, size_t count, uint8_t* buffer);
+
+    /**
+     * @brief Returns a pointer to a single pattern or nullptr on error. The pointer
+     * stays valid until the next call to getPattern(), close() or a change of the cache sizes.
+     */
+    const uint8_t* getPattern(size_t index);
+
+    /**
+     * @brief Number of getPattern() calls that were answered from the cache / from the file
+     */
+    size_t getCacheHits() const;
+    size_t getCacheMisses() const;
+
+  protected:
+    H5OIMPatternReader();
+
+  private:
+    struct PatternBlock
+    {
+      std::vector<uint8_t> data;
+      std::list<size_t>::iterator lruPosition;
+    };
+
+    hid_t m_FileId;
+    hid_t m_DatasetId;
+    size_t m_NumPatterns;
+    int m_PatternDims[2];
+    size_t m_CachedBlockSize;
+    size_t m_CacheHits;
+    size_t m_CacheMisses;
+
+    std::map<size_t, PatternBlock> m_Blocks;
+    std::list<size_t> m_LruOrder; // Most recently used block first
+
+    H5OIMPatternReader(const H5OIMPatternReader&) = delete; // Copy Constructor Not Implemented
+    void operator=(const H5OIMPatternReader&) = delete;      // Move assignment Not Implemented
+};
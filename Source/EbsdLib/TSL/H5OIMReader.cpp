@@ -62,6 +62,7 @@ H5OIMReader::H5OIMReader()
 : AngReader()
 , m_HDF5Path()
 , m_ReadPatternData(false)
+, m_StreamPatternData(false)
 , m_PatternData(nullptr)
 , m_ReadAllArrays(true)
 {
@@ -754,8 +755,11 @@ int H5OIMReader::readData(hid_t parId)
       m_PatternDims[0] = dims[1];
       m_PatternDims[1] = dims[2];
 
-      m_PatternData = this->allocateArray<uint8_t>(totalDataRows);
-      err = QH5Lite::readPointerDataset(gid, Ebsd::Ang::PatternData, m_PatternData);
+      if(!m_StreamPatternData)
+      {
+        m_PatternData = this->allocateArray<uint8_t>(totalDataRows);
+        err = QH5Lite::readPointerDataset(gid, Ebsd::Ang::PatternData, m_PatternData);
+      }
     }
   }
   err = H5Gclose(gid);
@@ -98,6 +98,12 @@ class EbsdLib_EXPORT H5OIMReader : public AngReader
      */
     EBSD_INSTANCE_STRING_PROPERTY(HDF5Path)
     EBSD_INSTANCE_PROPERTY(bool, ReadPatternData)
+    /**
+     * @brief When set together with ReadPatternData, readFile() only records the pattern
+     * dimensions and leaves PatternData empty. The patterns can then be read in windows
+     * with an H5OIMPatternReader instead of loading the whole data set at once.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, StreamPatternData)
     EBSD_INSTANCE_PROPERTY(uint8_t*, PatternData)
     EBSD_INSTANCE_2DVECTOR_PROPERTY(int, PatternDims)
 
@@ -0,0 +1,485 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <string.h>
+
+#include <random>
+#include <vector>
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#include <iostream>
+#endif
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QtDebug>
+
+#include "EbsdLib/HKL/CtfReader.h"
+#include "EbsdLib/TSL/AngReader.h"
+#include "EbsdLib/Utilities/EbsdTextScanner.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+class EbsdTextScannerTest
+{
+public:
+  EbsdTextScannerTest()
+  {
+  }
+  virtual ~EbsdTextScannerTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::EbsdTextScannerTest::AngFile);
+    QFile::remove(UnitTest::EbsdTextScannerTest::CtfFile);
+    QFile::remove(UnitTest::EbsdTextScannerTest::BadAngFile);
+    QFile::remove(UnitTest::EbsdTextScannerTest::ShortCtfFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // The scanner has to give back exactly what QByteArray::toFloat()/toInt() would
+  // -----------------------------------------------------------------------------
+  void CompareFloat(const QByteArray& token, bool commaIsDecimalPoint)
+  {
+    float value = 0.0f;
+    bool ok = EbsdTextScanner::parseFloat(token.constData(), token.constData() + token.size(), value, commaIsDecimalPoint);
+    QByteArray qtToken = token;
+    if(commaIsDecimalPoint)
+    {
+      qtToken.replace(',', '.');
+    }
+    bool qtOk = false;
+    float qtValue = qtToken.toFloat(&qtOk);
+    DREAM3D_REQUIRE_EQUAL(ok, qtOk)
+    DREAM3D_REQUIRE(::memcmp(&value, &qtValue, sizeof(float)) == 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareInt(const QByteArray& token)
+  {
+    int32_t value = 0;
+    bool ok = EbsdTextScanner::parseInt32(token.constData(), token.constData() + token.size(), value);
+    bool qtOk = false;
+    int32_t qtValue = token.toInt(&qtOk, 10);
+    DREAM3D_REQUIRE_EQUAL(ok, qtOk)
+    DREAM3D_REQUIRE_EQUAL(value, qtValue)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestNumberConversion()
+  {
+    QList<QByteArray> tokens;
+    tokens << "0" << "-0" << "0.0" << "-0.00000" << "1." << ".5" << "-.5" << "+3" << "1e5" << "2.5E-3" << "nan" << "inf" << "abc" << ""
+           << "-" << "12.3456789012345678" << "0.000000000000000000000001" << "007.5" << "3.40282e38" << "1e39" << "999999999" << "-999999999"
+           << "2147483647" << "2147483648" << "-2147483648" << "1.0" << "12a" << "1,5" << "6.28318" << "-180.00000";
+    for(int i = 0; i < tokens.size(); ++i)
+    {
+      CompareFloat(tokens[i], false);
+      CompareFloat(tokens[i], true);
+      CompareInt(tokens[i]);
+    }
+
+    std::mt19937_64 generator(12345);
+    std::uniform_real_distribution<double> values(-1.0E4, 1.0E4);
+    for(int i = 0; i < 1000000; ++i)
+    {
+      double v = values(generator);
+      int precision = static_cast<int>(generator() % 10);
+      QByteArray token = QByteArray::number(v, 'f', precision);
+      CompareFloat(token, false);
+      if(i % 8 == 0)
+      {
+        token.replace('.', ',');
+        CompareFloat(token, true);
+      }
+      CompareInt(QByteArray::number(static_cast<qint64>(generator() % 4000000000ULL) - 2000000000LL));
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteAngFile(const QString& filePath, int numCols, int numRows, std::vector<float>& phi1, std::vector<float>& y, std::vector<int>& phase, std::vector<float>& fit)
+  {
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\r\n";
+    out << "# x-star                0.500000\r\n";
+    out << "# y-star                0.500000\r\n";
+    out << "# z-star                0.500000\r\n";
+    out << "# WorkingDistance       20.000000\r\n";
+    out << "#\r\n";
+    out << "# Phase 1\r\n";
+    out << "# MaterialName  	Nickel\r\n";
+    out << "# Formula     	Ni\r\n";
+    out << "# Info\r\n";
+    out << "# Symmetry              43\r\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\r\n";
+    out << "# NumberFamilies        0\r\n";
+    out << "#\r\n";
+    out << "# GRID: SqrGrid\r\n";
+    out << "# XSTEP: 0.250000\r\n";
+    out << "# YSTEP: 0.250000\r\n";
+    out << "# NCOLS_ODD: " << numCols << "\r\n";
+    out << "# NCOLS_EVEN: " << numCols << "\r\n";
+    out << "# NROWS: " << numRows << "\r\n";
+    out << "#\r\n";
+
+    std::mt19937_64 generator(54321);
+    std::uniform_real_distribution<float> angles(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t totalPoints = static_cast<size_t>(numCols) * numRows;
+    phi1.resize(totalPoints);
+    y.resize(totalPoints);
+    phase.resize(totalPoints);
+    fit.resize(totalPoints);
+    for(size_t i = 0; i < totalPoints; ++i)
+    {
+      QByteArray p1 = QByteArray::number(angles(generator), 'f', 5);
+      QByteArray xPos = QByteArray::number((i % numCols) * 0.25, 'f', 5);
+      QByteArray yPos = QByteArray::number((i / numCols) * 0.25, 'f', 5);
+      QByteArray f = QByteArray::number(unit(generator), 'f', 3);
+      int ph = static_cast<int>(i % 3);
+      bool ok = false;
+      phi1[i] = p1.toFloat(&ok);
+      y[i] = yPos.toFloat(&ok);
+      phase[i] = ph;
+      fit[i] = f.toFloat(&ok);
+      out << "  " << p1 << "   " << QByteArray::number(angles(generator), 'f', 5) << "   " << QByteArray::number(angles(generator), 'f', 5) << "      " << xPos << "      " << yPos << " "
+          << QByteArray::number(unit(generator) * 3000.0f, 'f', 1) << "  " << QByteArray::number(unit(generator), 'f', 3) << "  " << ph << "  " << QByteArray::number(unit(generator) * 2000.0f, 'f', 3)
+          << "  " << f << "\r\n";
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAngReader()
+  {
+    const int numCols = 600;
+    const int numRows = 500;
+    std::vector<float> phi1;
+    std::vector<float> y;
+    std::vector<int> phase;
+    std::vector<float> fit;
+    WriteAngFile(UnitTest::EbsdTextScannerTest::AngFile, numCols, numRows, phi1, y, phase, fit);
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    double megaBytes = QFileInfo(UnitTest::EbsdTextScannerTest::AngFile).size() / (1024.0 * 1024.0);
+#endif
+
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      AngReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::AngFile);
+      reader.setParallelParsing(parallel == 1);
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#endif
+      int err = reader.readFile();
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#endif
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, phi1.size())
+
+      float* readPhi1 = reader.getPhi1Pointer();
+      float* readY = reader.getYPositionPointer();
+      int* readPhase = reader.getPhaseDataPointer();
+      float* readFit = reader.getFitPointer();
+      for(size_t i = 0; i < phi1.size(); ++i)
+      {
+        DREAM3D_REQUIRE(::memcmp(readPhi1 + i, &(phi1[i]), sizeof(float)) == 0)
+        DREAM3D_REQUIRE(::memcmp(readY + i, &(y[i]), sizeof(float)) == 0)
+        DREAM3D_REQUIRE_EQUAL(readPhase[i], phase[i])
+        DREAM3D_REQUIRE(::memcmp(readFit + i, &(fit[i]), sizeof(float)) == 0)
+      }
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      std::cout << ".ang " << (parallel == 1 ? "parallel" : "serial") << " read: " << megaBytes / seconds << " MB/s" << std::endl;
+#endif
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestAngErrors()
+  {
+    const int numCols = 600;
+    const int numRows = 500;
+    std::vector<float> phi1;
+    std::vector<float> y;
+    std::vector<int> phase;
+    std::vector<float> fit;
+    WriteAngFile(UnitTest::EbsdTextScannerTest::BadAngFile, numCols, numRows, phi1, y, phase, fit);
+
+    QFile file(UnitTest::EbsdTextScannerTest::BadAngFile);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadWrite))
+    QByteArray contents = file.readAll();
+
+    // Corrupt the 3rd column of two lines late in the file. The first one has to be reported.
+    int lineStart = contents.lastIndexOf('\n', contents.size() - 2000) + 1;
+    int earlierStart = contents.lastIndexOf('\n', contents.size() / 2) + 1;
+    QList<QByteArray> corruptions;
+    corruptions << QByteArray("x") << QByteArray("y");
+    int starts[2] = {earlierStart, lineStart};
+    for(int c = 0; c < 2; ++c)
+    {
+      int pos = starts[c];
+      for(int t = 0; t < 2; ++t)
+      {
+        while(contents[pos] == ' ')
+        {
+          ++pos;
+        }
+        while(contents[pos] != ' ')
+        {
+          ++pos;
+        }
+      }
+      while(contents[pos] == ' ')
+      {
+        ++pos;
+      }
+      contents[pos] = corruptions[c][0];
+    }
+    file.resize(0);
+    file.write(contents);
+    file.close();
+
+    QString serialMessage;
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      AngReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::BadAngFile);
+      reader.setParallelParsing(parallel == 1);
+      int err = reader.readFile();
+      DREAM3D_REQUIRED(err, ==, -2503)
+      if(parallel == 0)
+      {
+        serialMessage = reader.getErrorMessage();
+      }
+      else
+      {
+        DREAM3D_REQUIRE(serialMessage == reader.getErrorMessage())
+      }
+    }
+
+    // Chop the file off part way through the data
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    file.write(contents.left(earlierStart));
+    file.close();
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      AngReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::BadAngFile);
+      reader.setParallelParsing(parallel == 1);
+      int err = reader.readFile();
+      DREAM3D_REQUIRED(err, ==, -600)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteCtfFile(const QString& filePath, int xCells, int yCells, std::vector<float>& euler1, std::vector<int>& bands, std::vector<float>& mad)
+  {
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    QTextStream out(&file);
+    out << "Channel Text File\n";
+    out << "Prj Synthetic.cpr\n";
+    out << "Author\t[Unknown]\n";
+    out << "JobMode\tGrid\n";
+    out << "XCells\t" << xCells << "\n";
+    out << "YCells\t" << yCells << "\n";
+    out << "XStep\t0,5\n";
+    out << "YStep\t0,5\n";
+    out << "Euler angles refer to Sample Coordinate system (CS0)!\tMag\t100\tCoverage\t100\tDevice\t0\tKV\t20\tTiltAngle\t70\tTiltAxis\t0\n";
+    out << "Phases\t1\n";
+    out << "3,524;3,524;3,524\t90;90;90\tNickel\t11\t225\n";
+    out << "Phase\tX\tY\tBands\tError\tEuler1\tEuler2\tEuler3\tMAD\tBC\tBS\n";
+
+    std::mt19937_64 generator(98765);
+    std::uniform_real_distribution<float> angles(0.0f, 360.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t totalPoints = static_cast<size_t>(xCells) * yCells;
+    euler1.resize(totalPoints);
+    bands.resize(totalPoints);
+    mad.resize(totalPoints);
+    for(size_t i = 0; i < totalPoints; ++i)
+    {
+      QByteArray e1 = QByteArray::number(angles(generator), 'f', 3);
+      QByteArray m = QByteArray::number(unit(generator) * 2.0f, 'f', 4);
+      int b = static_cast<int>(generator() % 12);
+      bool ok = false;
+      euler1[i] = e1.toFloat(&ok);
+      bands[i] = b;
+      mad[i] = m.toFloat(&ok);
+      // European style decimal commas in the data section
+      e1.replace('.', ',');
+      m.replace('.', ',');
+      out << "1\t" << QByteArray::number((i % xCells) * 0.5, 'f', 4).replace('.', ',') << "\t" << QByteArray::number((i / xCells) * 0.5, 'f', 4).replace('.', ',') << "\t" << b << "\t0\t" << e1
+          << "\t" << QByteArray::number(angles(generator) / 2.0f, 'f', 3).replace('.', ',') << "\t" << QByteArray::number(angles(generator), 'f', 3).replace('.', ',') << "\t" << m << "\t"
+          << static_cast<int>(generator() % 255) << "\t" << static_cast<int>(generator() % 255) << "\n";
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCtfReader()
+  {
+    const int xCells = 600;
+    const int yCells = 500;
+    std::vector<float> euler1;
+    std::vector<int> bands;
+    std::vector<float> mad;
+    WriteCtfFile(UnitTest::EbsdTextScannerTest::CtfFile, xCells, yCells, euler1, bands, mad);
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    double megaBytes = QFileInfo(UnitTest::EbsdTextScannerTest::CtfFile).size() / (1024.0 * 1024.0);
+#endif
+
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      CtfReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::CtfFile);
+      reader.setParallelParsing(parallel == 1);
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#endif
+      int err = reader.readFile();
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#endif
+      DREAM3D_REQUIRED(err, ==, 0)
+      DREAM3D_REQUIRED(reader.getNumberOfElements(), ==, euler1.size())
+
+      float* readEuler1 = reinterpret_cast<float*>(reader.getPointerByName(Ebsd::Ctf::Euler1));
+      int* readBands = reinterpret_cast<int*>(reader.getPointerByName(Ebsd::Ctf::Bands));
+      float* readMad = reinterpret_cast<float*>(reader.getPointerByName(Ebsd::Ctf::MAD));
+      DREAM3D_REQUIRE(readEuler1 != nullptr)
+      DREAM3D_REQUIRE(readBands != nullptr)
+      DREAM3D_REQUIRE(readMad != nullptr)
+      for(size_t i = 0; i < euler1.size(); ++i)
+      {
+        DREAM3D_REQUIRE(::memcmp(readEuler1 + i, &(euler1[i]), sizeof(float)) == 0)
+        DREAM3D_REQUIRE_EQUAL(readBands[i], bands[i])
+        DREAM3D_REQUIRE(::memcmp(readMad + i, &(mad[i]), sizeof(float)) == 0)
+      }
+#ifdef DREAM3D_BUILD_BENCHMARKS
+      std::cout << ".ctf " << (parallel == 1 ? "parallel" : "serial") << " read: " << megaBytes / seconds << " MB/s" << std::endl;
+#endif
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestCtfErrors()
+  {
+    const int xCells = 600;
+    const int yCells = 500;
+    std::vector<float> euler1;
+    std::vector<int> bands;
+    std::vector<float> mad;
+    WriteCtfFile(UnitTest::EbsdTextScannerTest::ShortCtfFile, xCells, yCells, euler1, bands, mad);
+
+    QFile file(UnitTest::EbsdTextScannerTest::ShortCtfFile);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadOnly))
+    QByteArray contents = file.readAll();
+    file.close();
+
+    // Drop a column from a line in the second half of the file
+    QByteArray dropped = contents;
+    int lineStart = dropped.lastIndexOf('\n', dropped.size() - 5000) + 1;
+    dropped.remove(lineStart, dropped.indexOf('\t', lineStart) + 1 - lineStart);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    file.write(dropped);
+    file.close();
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      CtfReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::ShortCtfFile);
+      reader.setParallelParsing(parallel == 1);
+      int err = reader.readFile();
+      DREAM3D_REQUIRED(err, ==, -106)
+      DREAM3D_REQUIRED(reader.getErrorCode(), ==, -107)
+    }
+
+    // Chop the file off part way through the data. A trailing blank line does not count as data.
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    file.write(contents.left(contents.lastIndexOf('\n', contents.size() / 2) + 1));
+    file.write("\n");
+    file.close();
+    for(int parallel = 0; parallel < 2; ++parallel)
+    {
+      CtfReader reader;
+      reader.setFileName(UnitTest::EbsdTextScannerTest::ShortCtfFile);
+      reader.setParallelParsing(parallel == 1);
+      int err = reader.readFile();
+      DREAM3D_REQUIRED(err, ==, -105)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestNumberConversion())
+    DREAM3D_REGISTER_TEST(TestAngReader())
+    DREAM3D_REGISTER_TEST(TestAngErrors())
+    DREAM3D_REGISTER_TEST(TestCtfReader())
+    DREAM3D_REGISTER_TEST(TestCtfErrors())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
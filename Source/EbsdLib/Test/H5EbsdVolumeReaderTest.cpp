@@ -0,0 +1,420 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTextStream>
+#include <QtCore/QtDebug>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/H5AngImporter.h"
+#include "EbsdLib/TSL/H5AngVolumeReader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+class H5EbsdVolumeReaderTest
+{
+public:
+  H5EbsdVolumeReaderTest()
+  {
+  }
+  virtual ~H5EbsdVolumeReaderTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::H5EbsdVolumeReaderTest::AngFile);
+    QFile::remove(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile);
+    QFile::remove(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes a single phase .ang file where every column holds random values
+  // -----------------------------------------------------------------------------
+  void WriteAngFile(const QString& filePath, int numCols, int numRows, unsigned int seed)
+  {
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\r\n";
+    out << "# x-star                0.500000\r\n";
+    out << "# y-star                0.500000\r\n";
+    out << "# z-star                0.500000\r\n";
+    out << "# WorkingDistance       20.000000\r\n";
+    out << "#\r\n";
+    out << "# Phase 1\r\n";
+    out << "# MaterialName  	Nickel\r\n";
+    out << "# Formula     	Ni\r\n";
+    out << "# Info\r\n";
+    out << "# Symmetry              43\r\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\r\n";
+    out << "# NumberFamilies        0\r\n";
+    out << "#\r\n";
+    out << "# GRID: SqrGrid\r\n";
+    out << "# XSTEP: 0.250000\r\n";
+    out << "# YSTEP: 0.250000\r\n";
+    out << "# NCOLS_ODD: " << numCols << "\r\n";
+    out << "# NCOLS_EVEN: " << numCols << "\r\n";
+    out << "# NROWS: " << numRows << "\r\n";
+    out << "#\r\n";
+
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<float> angles(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t totalPoints = static_cast<size_t>(numCols) * numRows;
+    for(size_t i = 0; i < totalPoints; ++i)
+    {
+      out << "  " << QByteArray::number(angles(generator), 'f', 5) << "   " << QByteArray::number(angles(generator), 'f', 5) << "   " << QByteArray::number(angles(generator), 'f', 5) << "      "
+          << QByteArray::number((i % numCols) * 0.25, 'f', 5) << "      " << QByteArray::number((i / numCols) * 0.25, 'f', 5) << " " << QByteArray::number(unit(generator) * 3000.0f, 'f', 1) << "  "
+          << QByteArray::number(unit(generator), 'f', 3) << "  " << static_cast<int>(i % 2) << "  " << QByteArray::number(unit(generator) * 2000.0f, 'f', 3) << "  "
+          << QByteArray::number(unit(generator), 'f', 3) << "\r\n";
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds an .h5ebsd file the same way EbsdToH5Ebsd does, with slices of
+  // different sizes so that the centering of smaller slices gets exercised.
+  // -----------------------------------------------------------------------------
+  void WriteH5EbsdFile(int64_t& xPoints, int64_t& yPoints, int64_t& zPoints)
+  {
+    const int cols[3] = {40, 36, 40};
+    const int rows[3] = {30, 30, 25};
+    WriteH5EbsdFile(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, cols, rows, false, xPoints, yPoints, zPoints);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteH5EbsdFile(const QString& filePath, const int cols[3], const int rows[3], bool chunked, int64_t& xPoints, int64_t& yPoints, int64_t& zPoints)
+  {
+    xPoints = std::max(cols[0], std::max(cols[1], cols[2]));
+    yPoints = std::max(rows[0], std::max(rows[1], rows[2]));
+    zPoints = 3;
+
+    hid_t fileId = QH5Utilities::createFile(filePath);
+    DREAM3D_REQUIRE(fileId > 0)
+
+    int64_t zStart = 0;
+    int64_t zEnd = zPoints - 1;
+    float res = 0.25f;
+    uint32_t stackingOrder = 0;
+    float angle = 0.0f;
+    float axis[3] = {0.0f, 0.0f, 1.0f};
+    int32_t rank = 1;
+    hsize_t dims[1] = {3};
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZResolution, res) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::StackingOrder, stackingOrder) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::SampleTransformationAngle, angle) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset<float>(fileId, Ebsd::H5::SampleTransformationAxis, rank, dims, axis) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::EulerTransformationAngle, angle) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset<float>(fileId, Ebsd::H5::EulerTransformationAxis, rank, dims, axis) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeStringDataset(fileId, Ebsd::H5::Manufacturer, Ebsd::Ang::Manufacturer) >= 0)
+
+    H5AngImporter::Pointer importer = H5AngImporter::New();
+    importer->setChunkedDatasets(chunked);
+    QVector<int32_t> indices;
+    for(int z = 0; z < zPoints; ++z)
+    {
+      WriteAngFile(UnitTest::H5EbsdVolumeReaderTest::AngFile, cols[z], rows[z], 1000 + z);
+      int err = importer->importFile(fileId, z, UnitTest::H5EbsdVolumeReaderTest::AngFile);
+      DREAM3D_REQUIRED(err, >=, 0)
+      indices.push_back(z);
+    }
+
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, zStart) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZEndIndex, zEnd) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XPoints, xPoints) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YPoints, yPoints) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XResolution, res) >= 0)
+    DREAM3D_REQUIRE(QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YResolution, res) >= 0)
+    QVector<hsize_t> dimsL(1, indices.size());
+    DREAM3D_REQUIRE(QH5Lite::writeVectorDataset(fileId, Ebsd::H5::Index, dimsL, indices) >= 0)
+    QH5Utilities::closeFile(fileId);
+  }
+
+  // -----------------------------------------------------------------------------
+  // loadDataDirect() has to produce exactly what loadData() produces, including
+  // interleaved destinations and the single phase correction.
+  // -----------------------------------------------------------------------------
+  void CompareLoadModes(uint32_t zDir, bool parallel)
+  {
+    int64_t xPoints = 0;
+    int64_t yPoints = 0;
+    int64_t zPoints = 0;
+    WriteH5EbsdFile(xPoints, yPoints, zPoints);
+    size_t totalPoints = static_cast<size_t>(xPoints * yPoints * zPoints);
+
+    QSet<QString> arrayNames;
+    arrayNames << Ebsd::Ang::Phi1 << Ebsd::Ang::Phi << Ebsd::Ang::Phi2 << Ebsd::Ang::PhaseData << Ebsd::Ang::ConfidenceIndex;
+
+    H5AngVolumeReader::Pointer reference = H5AngVolumeReader::New();
+    reference->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile);
+    reference->setSliceStart(0);
+    reference->setSliceEnd(static_cast<int>(zPoints - 1));
+    reference->readAllArrays(false);
+    reference->setArraysToRead(arrayNames);
+    int err = reference->loadData(xPoints, yPoints, zPoints, zDir);
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    // Fill the destinations with garbage so that missed voxels show up
+    std::vector<float> eulers(totalPoints * 3, -1.0f);
+    std::vector<int> phases(totalPoints, -1);
+    std::vector<float> ci(totalPoints, -1.0f);
+
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile);
+    reader->setSliceStart(0);
+    reader->setSliceEnd(static_cast<int>(zPoints - 1));
+    reader->setParallelSliceReads(parallel);
+    reader->setDestinationPointer(Ebsd::Ang::Phi1, eulers.data(), 3, 0);
+    reader->setDestinationPointer(Ebsd::Ang::Phi, eulers.data(), 3, 1);
+    reader->setDestinationPointer(Ebsd::Ang::Phi2, eulers.data(), 3, 2);
+    reader->setDestinationPointer(Ebsd::Ang::PhaseData, phases.data());
+    reader->setDestinationPointer(Ebsd::Ang::ConfidenceIndex, ci.data());
+    err = reader->loadDataDirect(xPoints, yPoints, zPoints, zDir);
+    DREAM3D_REQUIRED(err, >=, 0)
+    // Nothing else should have been allocated by the reader
+    DREAM3D_REQUIRE(reader->getImageQualityPointer() == nullptr)
+    DREAM3D_REQUIRE(reader->getPhi1Pointer() == nullptr)
+
+    float* refPhi1 = reference->getPhi1Pointer();
+    float* refPhi = reference->getPhiPointer();
+    float* refPhi2 = reference->getPhi2Pointer();
+    int* refPhases = reference->getPhaseDataPointer();
+    float* refCi = reference->getConfidenceIndexPointer();
+    for(size_t i = 0; i < totalPoints; ++i)
+    {
+      DREAM3D_REQUIRE(::memcmp(&(eulers[3 * i]), refPhi1 + i, sizeof(float)) == 0)
+      DREAM3D_REQUIRE(::memcmp(&(eulers[3 * i + 1]), refPhi + i, sizeof(float)) == 0)
+      DREAM3D_REQUIRE(::memcmp(&(eulers[3 * i + 2]), refPhi2 + i, sizeof(float)) == 0)
+      DREAM3D_REQUIRE_EQUAL(phases[i], refPhases[i])
+      DREAM3D_REQUIRE(::memcmp(&(ci[i]), refCi + i, sizeof(float)) == 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestLoadDataDirect()
+  {
+    CompareLoadModes(SIMPL::RefFrameZDir::LowtoHigh, false);
+    CompareLoadModes(SIMPL::RefFrameZDir::HightoLow, false);
+    CompareLoadModes(SIMPL::RefFrameZDir::LowtoHigh, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMissingArray()
+  {
+    int64_t xPoints = 0;
+    int64_t yPoints = 0;
+    int64_t zPoints = 0;
+    WriteH5EbsdFile(xPoints, yPoints, zPoints);
+
+    std::vector<float> values(static_cast<size_t>(xPoints * yPoints * zPoints), 0.0f);
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile);
+    reader->setSliceStart(0);
+    reader->setSliceEnd(static_cast<int>(zPoints - 1));
+    reader->setDestinationPointer("NotAnArray", values.data());
+    int err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, ==, -90600)
+
+    reader->clearDestinationPointers();
+    reader->setSliceStart(1);
+    reader->setDestinationPointer(Ebsd::Ang::Fit, values.data());
+    err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, ==, -90602)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reading a range of rows has to produce the same rows as a full read
+  // -----------------------------------------------------------------------------
+  void CompareRowRange(const QString& filePath, int64_t xPoints, int64_t yPoints, int64_t zPoints, int64_t rowStart, int64_t rowCount)
+  {
+    size_t totalPoints = static_cast<size_t>(xPoints * yPoints * zPoints);
+    std::vector<float> fullEulers(totalPoints * 3, -1.0f);
+    std::vector<int> fullPhases(totalPoints, -1);
+
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(filePath);
+    reader->setSliceStart(0);
+    reader->setSliceEnd(static_cast<int>(zPoints - 1));
+    reader->setDestinationPointer(Ebsd::Ang::Phi1, fullEulers.data(), 3, 0);
+    reader->setDestinationPointer(Ebsd::Ang::Phi, fullEulers.data(), 3, 1);
+    reader->setDestinationPointer(Ebsd::Ang::Phi2, fullEulers.data(), 3, 2);
+    reader->setDestinationPointer(Ebsd::Ang::PhaseData, fullPhases.data());
+    int err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    size_t rangePoints = static_cast<size_t>(xPoints * rowCount * zPoints);
+    std::vector<float> eulers(rangePoints * 3, -1.0f);
+    std::vector<int> phases(rangePoints, -1);
+    reader->clearDestinationPointers();
+    reader->setRowStart(rowStart);
+    reader->setRowCount(rowCount);
+    reader->setDestinationPointer(Ebsd::Ang::Phi1, eulers.data(), 3, 0);
+    reader->setDestinationPointer(Ebsd::Ang::Phi, eulers.data(), 3, 1);
+    reader->setDestinationPointer(Ebsd::Ang::Phi2, eulers.data(), 3, 2);
+    reader->setDestinationPointer(Ebsd::Ang::PhaseData, phases.data());
+    err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    for(int64_t z = 0; z < zPoints; ++z)
+    {
+      for(int64_t y = 0; y < rowCount; ++y)
+      {
+        size_t fullIndex = static_cast<size_t>((z * yPoints + y + rowStart) * xPoints);
+        size_t index = static_cast<size_t>((z * rowCount + y) * xPoints);
+        DREAM3D_REQUIRE(::memcmp(&(eulers[3 * index]), &(fullEulers[3 * fullIndex]), xPoints * 3 * sizeof(float)) == 0)
+        DREAM3D_REQUIRE(::memcmp(&(phases[index]), &(fullPhases[fullIndex]), xPoints * sizeof(int)) == 0)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestRowRange()
+  {
+    const int cols[3] = {40, 36, 40};
+    const int rows[3] = {30, 30, 25};
+    int64_t xPoints = 0;
+    int64_t yPoints = 0;
+    int64_t zPoints = 0;
+    WriteH5EbsdFile(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, cols, rows, false, xPoints, yPoints, zPoints);
+    WriteH5EbsdFile(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile, cols, rows, true, xPoints, yPoints, zPoints);
+
+    // The last slice only covers rows 2 to 26 so the ranges also hit the zero filled border
+    CompareRowRange(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, xPoints, yPoints, zPoints, 5, 12);
+    CompareRowRange(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, xPoints, yPoints, zPoints, 20, 10);
+    CompareRowRange(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, xPoints, yPoints, zPoints, 0, 1);
+    CompareRowRange(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile, xPoints, yPoints, zPoints, 5, 12);
+    CompareRowRange(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile, xPoints, yPoints, zPoints, 20, 10);
+
+    std::vector<float> values(static_cast<size_t>(xPoints * yPoints * zPoints), 0.0f);
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile);
+    reader->setSliceStart(0);
+    reader->setSliceEnd(static_cast<int>(zPoints - 1));
+    reader->setDestinationPointer(Ebsd::Ang::Fit, values.data());
+    reader->setRowStart(yPoints - 5);
+    reader->setRowCount(10);
+    int err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, ==, -90608)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reads every array of the file into one buffer per array
+  // -----------------------------------------------------------------------------
+  void ReadAllArrays(const QString& filePath, int64_t xPoints, int64_t yPoints, int64_t zPoints, std::vector<std::vector<float>>& values)
+  {
+    QStringList names;
+    names << Ebsd::Ang::Phi1 << Ebsd::Ang::Phi << Ebsd::Ang::Phi2 << Ebsd::Ang::XPosition << Ebsd::Ang::YPosition << Ebsd::Ang::ImageQuality << Ebsd::Ang::ConfidenceIndex
+          << Ebsd::Ang::SEMSignal << Ebsd::Ang::Fit;
+    size_t totalPoints = static_cast<size_t>(xPoints * yPoints * zPoints);
+    values.assign(names.size(), std::vector<float>(totalPoints, 0.0f));
+
+    H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+    reader->setFileName(filePath);
+    reader->setSliceStart(0);
+    reader->setSliceEnd(static_cast<int>(zPoints - 1));
+    for(int i = 0; i < names.size(); ++i)
+    {
+      reader->setDestinationPointer(names[i], values[i].data());
+    }
+    int err = reader->loadDataDirect(xPoints, yPoints, zPoints, SIMPL::RefFrameZDir::LowtoHigh);
+    DREAM3D_REQUIRED(err, >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Chunked, compressed data sets have to read back exactly like contiguous ones
+  // -----------------------------------------------------------------------------
+  void TestChunkedLayout()
+  {
+    const int cols[3] = {400, 400, 400};
+    const int rows[3] = {300, 300, 300};
+    int64_t xPoints = 0;
+    int64_t yPoints = 0;
+    int64_t zPoints = 0;
+
+    WriteH5EbsdFile(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, cols, rows, false, xPoints, yPoints, zPoints);
+    WriteH5EbsdFile(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile, cols, rows, true, xPoints, yPoints, zPoints);
+    qint64 contiguousSize = QFileInfo(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile).size();
+    qint64 chunkedSize = QFileInfo(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile).size();
+    DREAM3D_REQUIRED(chunkedSize, <, contiguousSize)
+
+    std::vector<std::vector<float>> contiguous;
+    std::vector<std::vector<float>> chunked;
+    ReadAllArrays(UnitTest::H5EbsdVolumeReaderTest::H5EbsdFile, xPoints, yPoints, zPoints, contiguous);
+    ReadAllArrays(UnitTest::H5EbsdVolumeReaderTest::ChunkedH5EbsdFile, xPoints, yPoints, zPoints, chunked);
+    for(size_t i = 0; i < contiguous.size(); ++i)
+    {
+      DREAM3D_REQUIRE(::memcmp(contiguous[i].data(), chunked[i].data(), contiguous[i].size() * sizeof(float)) == 0)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestLoadDataDirect())
+    DREAM3D_REGISTER_TEST(TestMissingArray())
+    DREAM3D_REGISTER_TEST(TestRowRange())
+    DREAM3D_REGISTER_TEST(TestChunkedLayout())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
@@ -0,0 +1,231 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QtDebug>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/AngConstants.h"
+#include "EbsdLib/TSL/H5OIMPatternReader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/Test/EbsdLibTestFileLocations.h"
+
+class H5OIMPatternReaderTest
+{
+public:
+  H5OIMPatternReaderTest()
+  {
+  }
+  virtual ~H5OIMPatternReaderTest()
+  {
+  }
+
+  const size_t k_NumPatterns = 1000;
+  const int k_Height = 12;
+  const int k_Width = 10;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::H5OIMPatternReaderTest::PatternFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every byte encodes both the pattern index and the pixel so misplaced reads show up
+  // -----------------------------------------------------------------------------
+  uint8_t PatternValue(size_t pattern, size_t pixel)
+  {
+    return static_cast<uint8_t>((pattern * 31 + pixel * 7) & 0xFF);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes the 'Scan 1/EBSD/Data/Pattern' data set laid out like an EDAX .h5 file
+  // -----------------------------------------------------------------------------
+  void WritePatternFile()
+  {
+    size_t patternSize = static_cast<size_t>(k_Height * k_Width);
+    std::vector<uint8_t> patterns(k_NumPatterns * patternSize);
+    for(size_t i = 0; i < k_NumPatterns; i++)
+    {
+      for(size_t p = 0; p < patternSize; p++)
+      {
+        patterns[i * patternSize + p] = PatternValue(i, p);
+      }
+    }
+
+    hid_t fileId = QH5Utilities::createFile(UnitTest::H5OIMPatternReaderTest::PatternFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    QString groupPath = QString("Scan 1/") + Ebsd::H5::EBSD + "/" + Ebsd::H5::Data;
+    DREAM3D_REQUIRE(QH5Utilities::createGroupsFromPath(groupPath, fileId) >= 0)
+    hid_t gid = H5Gopen(fileId, groupPath.toLatin1().data(), H5P_DEFAULT);
+    DREAM3D_REQUIRE(gid > 0)
+    hsize_t dims[3] = {static_cast<hsize_t>(k_NumPatterns), static_cast<hsize_t>(k_Height), static_cast<hsize_t>(k_Width)};
+    DREAM3D_REQUIRE(QH5Lite::writePointerDataset<uint8_t>(gid, Ebsd::Ang::PatternData, 3, dims, patterns.data()) >= 0)
+    H5Gclose(gid);
+    QH5Utilities::closeFile(fileId);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestReadPatterns()
+  {
+    WritePatternFile();
+
+    H5OIMPatternReader::Pointer reader = H5OIMPatternReader::New();
+    reader->setFileName(UnitTest::H5OIMPatternReaderTest::PatternFile);
+    reader->setHDF5Path("Scan 1");
+    int err = reader->open();
+    DREAM3D_REQUIRED(err, >=, 0)
+    DREAM3D_REQUIRED(reader->getNumberOfPatterns(), ==, k_NumPatterns)
+    int dims[2] = {0, 0};
+    reader->getPatternDims(dims);
+    DREAM3D_REQUIRED(dims[0], ==, k_Height)
+    DREAM3D_REQUIRED(dims[1], ==, k_Width)
+    size_t patternSize = reader->getPatternSize();
+    DREAM3D_REQUIRED(patternSize, ==, static_cast<size_t>(k_Height * k_Width))
+
+    // Walk the whole scan in windows that do not line up with the end of the data set
+    const size_t window = 64;
+    std::vector<uint8_t> buffer(window * patternSize);
+    for(size_t start = 0; start < k_NumPatterns; start += window)
+    {
+      size_t count = std::min(window, k_NumPatterns - start);
+      err = reader->readPatterns(start, count, buffer.data());
+      DREAM3D_REQUIRED(err, >=, 0)
+      for(size_t i = 0; i < count; i++)
+      {
+        for(size_t p = 0; p < patternSize; p++)
+        {
+          DREAM3D_REQUIRED(buffer[i * patternSize + p], ==, PatternValue(start + i, p))
+        }
+      }
+    }
+
+    err = reader->readPatterns(k_NumPatterns - 10, 11, buffer.data());
+    DREAM3D_REQUIRED(err, ==, -90704)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestPatternCache()
+  {
+    WritePatternFile();
+
+    H5OIMPatternReader::Pointer reader = H5OIMPatternReader::New();
+    reader->setFileName(UnitTest::H5OIMPatternReaderTest::PatternFile);
+    reader->setHDF5Path("Scan 1");
+    reader->setBlockSize(100);
+    reader->setMaxCachedBlocks(2);
+    int err = reader->open();
+    DREAM3D_REQUIRED(err, >=, 0)
+    size_t patternSize = reader->getPatternSize();
+
+    // Each entry is a pattern index and whether its block should already be cached
+    const size_t indices[8] = {0, 50, 150, 10, 250, 150, 10, 999};
+    const bool cached[8] = {false, true, false, true, false, false, false, false};
+    size_t hits = 0;
+    size_t misses = 0;
+    for(int i = 0; i < 8; i++)
+    {
+      const uint8_t* pattern = reader->getPattern(indices[i]);
+      DREAM3D_REQUIRE_VALID_POINTER(pattern)
+      for(size_t p = 0; p < patternSize; p++)
+      {
+        DREAM3D_REQUIRED(pattern[p], ==, PatternValue(indices[i], p))
+      }
+      if(cached[i])
+      {
+        hits++;
+      }
+      else
+      {
+        misses++;
+      }
+      DREAM3D_REQUIRED(reader->getCacheHits(), ==, hits)
+      DREAM3D_REQUIRED(reader->getCacheMisses(), ==, misses)
+    }
+
+    DREAM3D_REQUIRE(reader->getPattern(k_NumPatterns) == nullptr)
+    reader->close();
+    DREAM3D_REQUIRE(reader->isOpen() == false)
+    DREAM3D_REQUIRE(reader->getPattern(0) == nullptr)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMissingScan()
+  {
+    WritePatternFile();
+
+    H5OIMPatternReader::Pointer reader = H5OIMPatternReader::New();
+    reader->setFileName(UnitTest::H5OIMPatternReaderTest::PatternFile);
+    reader->setHDF5Path("Scan 2");
+    int err = reader->open();
+    DREAM3D_REQUIRED(err, ==, -90701)
+    DREAM3D_REQUIRE(reader->isOpen() == false)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestReadPatterns())
+    DREAM3D_REGISTER_TEST(TestPatternCache())
+    DREAM3D_REGISTER_TEST(TestMissingScan())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+};
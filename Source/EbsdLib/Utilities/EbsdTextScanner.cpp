@@ -0,0 +1,379 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "EbsdTextScanner.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace
+{
+// Every power of 10 up to 10^22 is exactly representable as a double
+const double k_Pow10[] = {1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,  1.0e8,  1.0e9,  1.0e10, 1.0e11,
+                          1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22};
+
+// Mantissas with at most 15 significant digits are exactly representable as a double
+const int k_MaxSignificantDigits = 15;
+const int k_MaxFractionDigits = 22;
+
+// Don't bother splitting data sections smaller than this
+const size_t k_MinChunkBytes = 4 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray makeToken(const char* begin, const char* end, bool commaIsDecimalPoint)
+{
+  QByteArray token(begin, static_cast<int>(end - begin));
+  if(commaIsDecimalPoint)
+  {
+    token.replace(',', '.');
+  }
+  return token;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextScanner::EbsdTextScanner()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+EbsdTextScanner::~EbsdTextScanner()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextScanner::open(const QString& filePath)
+{
+  close();
+  m_File.setFileName(filePath);
+  if(!m_File.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  qint64 fileSize = m_File.size();
+  if(fileSize > 0)
+  {
+    uchar* mapped = m_File.map(0, fileSize);
+    if(nullptr != mapped)
+    {
+      m_Data = reinterpret_cast<const char*>(mapped);
+      m_Size = static_cast<size_t>(fileSize);
+    }
+    else
+    {
+      // Mapping is not available for this file so pull the whole file into memory instead
+      m_Contents = m_File.readAll();
+      m_Data = m_Contents.constData();
+      m_Size = static_cast<size_t>(m_Contents.size());
+    }
+  }
+  m_Position = 0;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdTextScanner::close()
+{
+  if(m_File.isOpen())
+  {
+    m_File.close(); // Also releases any mapping
+  }
+  m_Contents.clear();
+  m_Data = nullptr;
+  m_Size = 0;
+  m_Position = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* EbsdTextScanner::data() const
+{
+  return m_Data;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdTextScanner::size() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdTextScanner::getPosition() const
+{
+  return m_Position;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EbsdTextScanner::setPosition(size_t pos)
+{
+  m_Position = std::min(pos, m_Size);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextScanner::atEnd() const
+{
+  return m_Position >= m_Size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray EbsdTextScanner::readLine()
+{
+  if(atEnd())
+  {
+    return QByteArray();
+  }
+  const char* begin = m_Data + m_Position;
+  const char* end = m_Data + m_Size;
+  const char* newline = static_cast<const char*>(::memchr(begin, '\n', end - begin));
+  const char* lineEnd = (nullptr == newline) ? end : newline + 1;
+  m_Position = lineEnd - m_Data;
+
+  QByteArray line(begin, static_cast<int>(lineEnd - begin));
+  int length = line.size();
+  if(length > 1 && line.at(length - 1) == '\n' && line.at(length - 2) == '\r')
+  {
+    line.remove(length - 2, 1);
+  }
+  return line;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextScanner::parseFloat(const char* begin, const char* end, float& value, bool commaIsDecimalPoint)
+{
+  const char* p = begin;
+  bool negative = false;
+  if(p < end && *p == '-')
+  {
+    negative = true;
+    ++p;
+  }
+
+  uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int fractionDigits = 0;
+
+  const char* intStart = p;
+  while(p < end && *p >= '0' && *p <= '9')
+  {
+    int digit = *p - '0';
+    if(significantDigits > 0 || digit != 0)
+    {
+      ++significantDigits;
+      mantissa = (significantDigits <= k_MaxSignificantDigits) ? mantissa * 10 + digit : mantissa;
+    }
+    ++p;
+  }
+  bool fastPath = (p > intStart);
+
+  if(fastPath && p < end && (*p == '.' || (commaIsDecimalPoint && *p == ',')))
+  {
+    ++p;
+    const char* fracStart = p;
+    while(p < end && *p >= '0' && *p <= '9')
+    {
+      int digit = *p - '0';
+      if(significantDigits > 0 || digit != 0)
+      {
+        ++significantDigits;
+        mantissa = (significantDigits <= k_MaxSignificantDigits) ? mantissa * 10 + digit : mantissa;
+      }
+      ++fractionDigits;
+      ++p;
+    }
+    fastPath = (p > fracStart);
+  }
+
+  if(fastPath && p == end && significantDigits <= k_MaxSignificantDigits && fractionDigits <= k_MaxFractionDigits)
+  {
+    // Both operands are exact so the single division is correctly rounded, which is
+    // exactly what the full string to double conversion would have produced.
+    double d = static_cast<double>(mantissa);
+    if(fractionDigits > 0)
+    {
+      d = d / k_Pow10[fractionDigits];
+    }
+    value = static_cast<float>(negative ? -d : d);
+    return true;
+  }
+
+  // Exponents, NaN/Inf, signs, stray characters and long mantissas all go through Qt
+  bool ok = false;
+  value = makeToken(begin, end, commaIsDecimalPoint).toFloat(&ok);
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EbsdTextScanner::parseInt32(const char* begin, const char* end, int32_t& value, bool commaIsDecimalPoint)
+{
+  const char* p = begin;
+  bool negative = false;
+  if(p < end && *p == '-')
+  {
+    negative = true;
+    ++p;
+  }
+  // Up to 9 digits can never overflow an int32_t
+  if(p < end && end - p <= 9)
+  {
+    int32_t v = 0;
+    while(p < end && *p >= '0' && *p <= '9')
+    {
+      v = v * 10 + (*p - '0');
+      ++p;
+    }
+    if(p == end)
+    {
+      value = negative ? -v : v;
+      return true;
+    }
+  }
+
+  bool ok = false;
+  value = makeToken(begin, end, commaIsDecimalPoint).toInt(&ok, 10);
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdTextScanner::countLines(const char* begin, const char* end)
+{
+  size_t numLines = 0;
+  const char* p = begin;
+  while(p < end)
+  {
+    const char* newline = static_cast<const char*>(::memchr(p, '\n', end - p));
+    ++numLines;
+    if(nullptr == newline)
+    {
+      break;
+    }
+    p = newline + 1;
+  }
+  return numLines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<EbsdTextScanner::LineChunk> EbsdTextScanner::splitLines(const char* begin, const char* end, size_t numChunks, bool parallel)
+{
+  std::vector<LineChunk> chunks;
+  if(numChunks < 1)
+  {
+    numChunks = 1;
+  }
+  size_t numBytes = end - begin;
+  const char* chunkBegin = begin;
+  for(size_t c = 1; c <= numChunks && chunkBegin < end; ++c)
+  {
+    const char* chunkEnd = end;
+    if(c < numChunks)
+    {
+      // Move the nominal split point forward to the start of the next line
+      const char* target = std::max(begin + (numBytes / numChunks) * c, chunkBegin);
+      const char* newline = static_cast<const char*>(::memchr(target, '\n', end - target));
+      chunkEnd = (nullptr == newline) ? end : newline + 1;
+    }
+    LineChunk chunk;
+    chunk.begin = chunkBegin;
+    chunk.end = chunkEnd;
+    chunks.push_back(chunk);
+    chunkBegin = chunkEnd;
+  }
+
+  auto counter = [&chunks](size_t c) { chunks[c].numLines = countLines(chunks[c].begin, chunks[c].end); };
+  if(parallel)
+  {
+    forEachChunk(chunks.size(), counter);
+  }
+  else
+  {
+    for(size_t c = 0; c < chunks.size(); ++c)
+    {
+      counter(c);
+    }
+  }
+
+  size_t firstLine = 0;
+  for(size_t c = 0; c < chunks.size(); ++c)
+  {
+    chunks[c].firstLine = firstLine;
+    firstLine += chunks[c].numLines;
+  }
+  return chunks;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t EbsdTextScanner::suggestedChunkCount(size_t numBytes, bool parallel)
+{
+  if(!parallel)
+  {
+    return 1;
+  }
+  size_t numThreads = std::thread::hardware_concurrency();
+  size_t maxChunks = numBytes / k_MinChunkBytes;
+  return std::max(static_cast<size_t>(1), std::min(numThreads, maxChunks));
+}
@@ -0,0 +1,182 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+
+#pragma once
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "EbsdLib/EbsdLib.h"
+
+/**
+ * @class EbsdTextScanner EbsdTextScanner.h EbsdLib/Utilities/EbsdTextScanner.h
+ * @brief This class gives the ASCII based EBSD readers (.ang, .ctf) direct access
+ * to the bytes of a file. The file is memory mapped when possible (otherwise it is
+ * read into memory in one piece) and the numeric columns are converted straight out
+ * of the mapped bytes without creating intermediate QByteArray tokens. The conversion
+ * functions produce bit-identical values to QByteArray::toFloat() and QByteArray::toInt()
+ * and fall back to those functions for anything out of the ordinary.
+ *
+ * The data section can also be split into chunks that start on line boundaries so
+ * that the lines can be parsed by several threads at once.
+ */
+class EbsdLib_EXPORT EbsdTextScanner
+{
+  public:
+    EbsdTextScanner();
+    virtual ~EbsdTextScanner();
+
+    /**
+     * @brief The LineChunk struct describes a range of complete lines in the buffer
+     * along with the zero based index of the first line in the chunk.
+     */
+    struct LineChunk
+    {
+      const char* begin = nullptr;
+      const char* end = nullptr;
+      size_t firstLine = 0;
+      size_t numLines = 0;
+    };
+
+    /**
+     * @brief Opens and maps the file. The read position is set to the start of the file.
+     * @param filePath
+     * @return true on success
+     */
+    bool open(const QString& filePath);
+
+    /**
+     * @brief Releases the mapping and closes the file
+     */
+    void close();
+
+    const char* data() const;
+    size_t size() const;
+
+    size_t getPosition() const;
+    void setPosition(size_t pos);
+    bool atEnd() const;
+
+    /**
+     * @brief Reads a single line starting at the current position, including the
+     * trailing newline. A trailing "\r\n" is returned as "\n" which is what QFile::readLine()
+     * returns for files opened with the QIODevice::Text flag.
+     */
+    QByteArray readLine();
+
+    /**
+     * @brief Converts the characters in [begin, end) to a float. The result is identical
+     * to QByteArray::toFloat() of the same characters.
+     * @param commaIsDecimalPoint Treat ',' as the decimal point (European style files)
+     * @return false if the characters could not be converted in which case value is 0.0f
+     */
+    static bool parseFloat(const char* begin, const char* end, float& value, bool commaIsDecimalPoint = false);
+
+    /**
+     * @brief Converts the characters in [begin, end) to a base 10 integer. The result is
+     * identical to QByteArray::toInt(&ok, 10) of the same characters.
+     * @param commaIsDecimalPoint Treat ',' as the decimal point (European style files)
+     * @return false if the characters could not be converted in which case value is 0
+     */
+    static bool parseInt32(const char* begin, const char* end, int32_t& value, bool commaIsDecimalPoint = false);
+
+    /**
+     * @brief Returns true for the same characters that QByteArray::trimmed() removes
+     */
+    static inline bool isSpace(char c)
+    {
+      return (c == ' ' || (c >= '\t' && c <= '\r'));
+    }
+
+    /**
+     * @brief Returns the number of lines in [begin, end). A trailing run of characters without
+     * a newline counts as a line.
+     */
+    static size_t countLines(const char* begin, const char* end);
+
+    /**
+     * @brief Splits [begin, end) into at most numChunks chunks that start on line boundaries
+     * and fills in the line numbering of each chunk.
+     * @param parallel Count the lines of each chunk on a separate thread
+     */
+    static std::vector<LineChunk> splitLines(const char* begin, const char* end, size_t numChunks, bool parallel);
+
+    /**
+     * @brief Returns the number of chunks that the data should be split into. Small data
+     * sections are not worth splitting.
+     */
+    static size_t suggestedChunkCount(size_t numBytes, bool parallel);
+
+    /**
+     * @brief Calls func(chunkIndex) for every chunk. Each chunk after the first one is
+     * handed to its own thread and the first chunk is processed on the calling thread.
+     */
+    template <typename Functor> static void forEachChunk(size_t numChunks, Functor& func)
+    {
+      if(numChunks == 0)
+      {
+        return;
+      }
+      std::vector<std::thread> threads;
+      threads.reserve(numChunks - 1);
+      for(size_t c = 1; c < numChunks; ++c)
+      {
+        threads.emplace_back([&func, c]() { func(c); });
+      }
+      func(0);
+      for(size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+    }
+
+  private:
+    QFile m_File;
+    QByteArray m_Contents;
+    const char* m_Data = nullptr;
+    size_t m_Size = 0;
+    size_t m_Position = 0;
+
+    EbsdTextScanner(const EbsdTextScanner&) = delete; // Copy Constructor Not Implemented
+    void operator=(const EbsdTextScanner&) = delete;  // Move assignment Not Implemented
+};
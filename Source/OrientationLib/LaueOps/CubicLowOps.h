@@ -98,6 +98,7 @@ class OrientationLib_EXPORT CubicLowOps : public LaueOps
     QString getSymmetryName();
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuatBatch(const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
@@ -177,10 +178,6 @@ class OrientationLib_EXPORT CubicLowOps : public LaueOps
     virtual QVector<UInt8ArrayType::Pointer> generatePoleFigure(PoleFigureConfiguration_t& config);
 
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
   private:
     CubicLowOps(const CubicLowOps&) = delete;    // Copy Constructor Not Implemented
     void operator=(const CubicLowOps&) = delete; // Move assignment Not Implemented
@@ -35,6 +35,8 @@
 
 #include "CubicOps.h"
 
+#include <algorithm>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
@@ -52,7 +54,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
-#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/PoleFigureAccumulator.h"
 
 namespace Detail
 {
@@ -340,6 +342,127 @@ float CubicOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n
   return _calcMisoQuat(CubicQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubicOps::getMisoQuatBatch(const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes)
+{
+  // The pairs are processed in blocks that keep each quaternion component in its own array.
+  // The sort of the four absolute components is a min/max network and the choice between the
+  // three kinds of cubic operators is a select, so both loops run without branches and the
+  // compiler can vectorize them. Only acos, sin and the axis are computed one pair at a time.
+  // Every step uses the same arithmetic as _calcMisoQuat, so the results are identical to it.
+  static const size_t k_BlockSize = 64;
+  float qa[k_BlockSize];
+  float qb[k_BlockSize];
+  float qcc[k_BlockSize];
+  float qd[k_BlockSize];
+  float cosHalf[k_BlockSize];
+  int32_t types[k_BlockSize];
+
+  for(size_t start = 0; start < numPairs; start += k_BlockSize)
+  {
+    size_t count = std::min(k_BlockSize, numPairs - start);
+
+    for(size_t i = 0; i < count; i++)
+    {
+      QuatF q2 = q2s[start + i];
+      QuatF q2inv;
+      QuatF qc;
+      QuaternionMathF::Conjugate(q2, q2inv);
+      QuaternionMathF::Multiply(q1s[start + i], q2inv, qc);
+      QuaternionMathF::ElementWiseAbs(qc);
+      qa[i] = qc.x;
+      qb[i] = qc.y;
+      qcc[i] = qc.z;
+      qd[i] = qc.w;
+    }
+
+    // Sort the absolute components so that qa <= qb <= qcc <= qd
+    for(size_t i = 0; i < count; i++)
+    {
+      float a = std::min(qa[i], qb[i]);
+      float b = std::max(qa[i], qb[i]);
+      float c = std::min(qcc[i], qd[i]);
+      float d = std::max(qcc[i], qd[i]);
+      float lo = std::min(a, c);
+      float hi = std::max(b, d);
+      float midA = std::max(a, c);
+      float midB = std::min(b, d);
+      qa[i] = lo;
+      qb[i] = std::min(midA, midB);
+      qcc[i] = std::max(midA, midB);
+      qd[i] = hi;
+    }
+
+    // The largest cosine of the half angle comes from a 4-fold, a 2-fold or a 3-fold operator
+    for(size_t i = 0; i < count; i++)
+    {
+      float wmin = qd[i];
+      int32_t type = 1;
+      bool twoFold = ((qcc[i] + qd[i]) / (SIMPLib::Constants::k_Sqrt2)) > wmin;
+      wmin = twoFold ? static_cast<float>((qcc[i] + qd[i]) / (SIMPLib::Constants::k_Sqrt2)) : wmin;
+      type = twoFold ? 2 : type;
+      bool threeFold = ((qa[i] + qb[i] + qcc[i] + qd[i]) / 2) > wmin;
+      wmin = threeFold ? ((qa[i] + qb[i] + qcc[i] + qd[i]) / 2) : wmin;
+      type = threeFold ? 3 : type;
+      cosHalf[i] = wmin;
+      types[i] = type;
+    }
+
+    for(size_t i = 0; i < count; i++)
+    {
+      // The components are absolute values, so only the upper bound needs clamping
+      float wmin = cosHalf[i];
+      if(wmin > 1.0)
+      {
+        wmin = SIMPLib::Constants::k_ACos1;
+      }
+      else
+      {
+        wmin = acos(wmin);
+      }
+      angles[start + i] = 2.0f * wmin;
+
+      if(nullptr == axes)
+      {
+        continue;
+      }
+      float sin_wmin_over_2 = sinf(wmin);
+      float n1 = 0.0f;
+      float n2 = 0.0f;
+      float n3 = 0.0f;
+      if(types[i] == 1)
+      {
+        n1 = qa[i] / sin_wmin_over_2;
+        n2 = qb[i] / sin_wmin_over_2;
+        n3 = qcc[i] / sin_wmin_over_2;
+      }
+      else if(types[i] == 2)
+      {
+        n1 = ((qa[i] - qb[i]) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+        n2 = ((qa[i] + qb[i]) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+        n3 = ((qcc[i] - qd[i]) / (SIMPLib::Constants::k_Sqrt2)) / sin_wmin_over_2;
+      }
+      else
+      {
+        n1 = ((qa[i] - qb[i] + qcc[i] - qd[i]) / (2.0f)) / sin_wmin_over_2;
+        n2 = ((qa[i] + qb[i] - qcc[i] - qd[i]) / (2.0f)) / sin_wmin_over_2;
+        n3 = ((-qa[i] + qb[i] + qcc[i] - qd[i]) / (2.0f)) / sin_wmin_over_2;
+      }
+      float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+      float* n = axes + (start + i) * 3;
+      n[0] = n1 / denom;
+      n[1] = n2 / denom;
+      n[2] = n3 / denom;
+      if(denom == 0 || wmin == 0)
+      {
+        n[0] = 0.0, n[1] = 0.0, n[2] = 1.0;
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1498,15 +1621,15 @@ void CubicOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatArray
   // Sanity Check the size of the arrays
   if (xyz001->getNumberOfTuples() < nOrientations * Detail::CubicHigh::symSize0)
   {
-    xyz001->resize(nOrientations * Detail::CubicHigh::symSize0 * 3);
+    xyz001->resize(nOrientations * Detail::CubicHigh::symSize0);
   }
   if (xyz011->getNumberOfTuples() < nOrientations * Detail::CubicHigh::symSize1)
   {
-    xyz011->resize(nOrientations * Detail::CubicHigh::symSize1 * 3);
+    xyz011->resize(nOrientations * Detail::CubicHigh::symSize1);
   }
   if (xyz111->getNumberOfTuples() < nOrientations * Detail::CubicHigh::symSize2)
   {
-    xyz111->resize(nOrientations * Detail::CubicHigh::symSize2 * 3);
+    xyz111->resize(nOrientations * Detail::CubicHigh::symSize2);
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1813,50 +1936,16 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   if(config.labels.size() > 1) { label1 = config.labels.at(1); }
   if(config.labels.size() > 2) { label2 = config.labels.at(2); }
 
-  int numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  QVector<size_t> dims(1, 3);
-  FloatArrayType::Pointer xyz001 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize0, dims, label0 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <011> Family
-  FloatArrayType::Pointer xyz011 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize1, dims, label1 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <111> Family
-  FloatArrayType::Pointer xyz111 = FloatArrayType::CreateArray(numOrientations * Detail::CubicHigh::symSize2, dims, label2 + QString("xyzCoords"));
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
   DoubleArrayType::Pointer intensity001 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-
-  if(doParallel)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
+  // Stream the orientations through the sphere coordinates and straight into per thread modified Lambert squares
+  // so the XYZ coordinates of every orientation never have to be held in memory at the same time.
+  PoleFigureAccumulator::Execute(this, &config, intensity001.get(), intensity011.get(), intensity111.get());
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
   double max = std::numeric_limits<double>::min();
@@ -1908,7 +1997,7 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   config.minScale = min;
   config.maxScale = max;
 
-  dims[0] = 4;
+  QVector<size_t> dims(1, 4);
   UInt8ArrayType::Pointer image001 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label0);
   UInt8ArrayType::Pointer image011 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label1);
   UInt8ArrayType::Pointer image111 = UInt8ArrayType::CreateArray(static_cast<size_t>(config.imageDim * config.imageDim), dims, label2);
@@ -1928,6 +2017,8 @@ QVector<UInt8ArrayType::Pointer> CubicOps::generatePoleFigure(PoleFigureConfigur
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
 
   if(doParallel == true)
   {
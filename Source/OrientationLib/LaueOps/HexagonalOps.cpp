@@ -52,7 +52,7 @@
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
-#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/PoleFigureAccumulator.h"
 
 namespace Detail
 {
@@ -222,70 +222,20 @@ QString HexagonalOps::getSymmetryName()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-float HexagonalOps::_calcMisoQuat(const QuatF quatsym[12], int numsym,
-                                  QuatF& q1, QuatF& q2,
-                                  float& n1, float& n2, float& n3)
+float HexagonalOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-  QuaternionMathF::Copy(q2, q2inv);
-  QuaternionMathF::Conjugate(q2inv);
-
-  QuaternionMathF::Multiply(q1, q2inv, qr);
-  for (int i = 0; i < numsym; i++)
-  {
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
-    if (qc.w < -1)
-    {
-      qc.w = -1;
-    }
-    else if (qc.w > 1)
-    {
-      qc.w = 1;
-    }
-
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
+  int numsym = 12;
 
-    if (w > SIMPLib::Constants::k_Pi)
-    {
-      w = SIMPLib::Constants::k_2Pi - w;
-    }
-    if (w < wmin)
-    {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
-    }
-  }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
+  return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
 }
 
-float HexagonalOps::getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void HexagonalOps::getMisoQuatBatch(const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes)
 {
   int numsym = 12;
-
-  return _calcMisoQuat(HexQuatSym, numsym, q1, q2, n1, n2, n3);
+  _calcMisoQuatBatch(HexQuatSym, numsym, q1s, q2s, numPairs, angles, axes);
 }
 
 void HexagonalOps::getQuatSymOp(int i, QuatF& q)
@@ -1276,15 +1226,15 @@ void HexagonalOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, FloatA
   // Sanity Check the size of the arrays
   if (xyz0001->getNumberOfTuples() < nOrientations * Detail::HexagonalHigh::symSize0)
   {
-    xyz0001->resize(nOrientations * Detail::HexagonalHigh::symSize0 * 3);
+    xyz0001->resize(nOrientations * Detail::HexagonalHigh::symSize0);
   }
   if (xyz1010->getNumberOfTuples() < nOrientations * Detail::HexagonalHigh::symSize1)
   {
-    xyz1010->resize(nOrientations * Detail::HexagonalHigh::symSize1 * 3);
+    xyz1010->resize(nOrientations * Detail::HexagonalHigh::symSize1);
   }
   if (xyz1120->getNumberOfTuples() < nOrientations * Detail::HexagonalHigh::symSize2)
   {
-    xyz1120->resize(nOrientations * Detail::HexagonalHigh::symSize2 * 3);
+    xyz1120->resize(nOrientations * Detail::HexagonalHigh::symSize2);
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -1457,51 +1407,16 @@ QVector<UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(PoleFigureConf
   if(config.labels.size() > 1) { label1 = config.labels.at(1); }
   if(config.labels.size() > 2) { label2 = config.labels.at(2); }
 
-  int numOrientations = config.eulers->getNumberOfTuples();
-
-  // Create an Array to hold the XYZ Coordinates which are the coords on the sphere.
-  // this is size for CUBIC ONLY, <001> Family
-  QVector<size_t> dims(1, 3);
-  FloatArrayType::Pointer xyz001 = FloatArrayType::CreateArray(numOrientations * Detail::HexagonalHigh::symSize0, dims, label0 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <011> Family
-  FloatArrayType::Pointer xyz011 = FloatArrayType::CreateArray(numOrientations * Detail::HexagonalHigh::symSize1, dims, label1 + QString("xyzCoords"));
-  // this is size for CUBIC ONLY, <111> Family
-  FloatArrayType::Pointer xyz111 = FloatArrayType::CreateArray(numOrientations * Detail::HexagonalHigh::symSize2, dims, label2 + QString("xyzCoords"));
-
   config.sphereRadius = 1.0f;
 
-  // Generate the coords on the sphere **** Parallelized
-  generateSphereCoordsFromEulers(config.eulers, xyz001.get(), xyz011.get(), xyz111.get());
-
-
   // These arrays hold the "intensity" images which eventually get converted to an actual Color RGB image
-  // Generate the modified Lambert projection images (Squares, 2 of them, 1 for northern hemisphere, 1 for southern hemisphere
   DoubleArrayType::Pointer intensity001 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label0 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-
-  if(doParallel == true)
-  {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    g->run(ComputeStereographicProjection(xyz001.get(), &config, intensity001.get()));
-    g->run(ComputeStereographicProjection(xyz011.get(), &config, intensity011.get()));
-    g->run(ComputeStereographicProjection(xyz111.get(), &config, intensity111.get()));
-    g->wait(); // Wait for all the threads to complete before moving on.
 
-  }
-  else
-#endif
-  {
-    ComputeStereographicProjection m001(xyz001.get(), &config, intensity001.get());
-    m001();
-    ComputeStereographicProjection m011(xyz011.get(), &config, intensity011.get());
-    m011();
-    ComputeStereographicProjection m111(xyz111.get(), &config, intensity111.get());
-    m111();
-  }
+  // Stream the orientations through the sphere coordinates and straight into per thread modified Lambert squares
+  // so the XYZ coordinates of every orientation never have to be held in memory at the same time.
+  PoleFigureAccumulator::Execute(this, &config, intensity001.get(), intensity011.get(), intensity111.get());
 
   // Find the Max and Min values based on ALL 3 arrays so we can color scale them all the same
   double max = std::numeric_limits<double>::min();
@@ -1553,7 +1468,7 @@ QVector<UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(PoleFigureConf
   config.minScale = min;
   config.maxScale = max;
 
-  dims[0] = 4;
+  QVector<size_t> dims(1, 4);
   UInt8ArrayType::Pointer image001 = UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label0);
   UInt8ArrayType::Pointer image011 = UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label1);
   UInt8ArrayType::Pointer image111 = UInt8ArrayType::CreateArray(config.imageDim * config.imageDim, dims, label2);
@@ -1573,6 +1488,8 @@ QVector<UInt8ArrayType::Pointer> HexagonalOps::generatePoleFigure(PoleFigureConf
   }
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
 
   if(doParallel == true)
   {
@@ -36,6 +36,7 @@
 #include "LaueOps.h"
 
 #include <chrono>
+#include <cmath>
 #include <limits>
 #include <random>
 
@@ -99,23 +100,67 @@ void LaueOps::getFZQuat(QuatF& qr)
 // -----------------------------------------------------------------------------
 float LaueOps::_calcMisoQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3)
 {
-  float wmin = 9999999.0f; //,na,nb,nc;
-  float w = 0;
-  float n1min = 0.0f;
-  float n2min = 0.0f;
-  float n3min = 0.0f;
-  QuatF qr;
-  QuatF qc;
-  QuatF q2inv;
-
-  QuaternionMathF::Copy(q2, q2inv);
+  float wmin = 0.0f;
+  float axis[3] = {0.0f, 0.0f, 1.0f};
+  _calcMisoQuatBatch(quatsym, numsym, &q1, &q2, 1, &wmin, axis);
+  n1 = axis[0];
+  n2 = axis[1];
+  n3 = axis[2];
+  return wmin;
+}
 
-  QuaternionMathF::Conjugate(q2inv);
-  QuaternionMathF::Multiply(q1, q2inv, qr);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void LaueOps::_calcMisoQuatBatch(const QuatF* quatsym, int numsym, const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes)
+{
+  static const int k_MaxNumSym = 24;
+  Q_ASSERT(numsym > 0 && numsym <= k_MaxNumSym);
+
+  // Split the symmetry operators into separate component arrays so the inner
+  // loop below is a straight dot product that the compiler can vectorize.
+  float symX[k_MaxNumSym];
+  float symY[k_MaxNumSym];
+  float symZ[k_MaxNumSym];
+  float symW[k_MaxNumSym];
   for(int i = 0; i < numsym; i++)
   {
+    symX[i] = quatsym[i].x;
+    symY[i] = quatsym[i].y;
+    symZ[i] = quatsym[i].z;
+    symW[i] = quatsym[i].w;
+  }
 
-    QuaternionMathF::Multiply(quatsym[i], qr, qc);
+  float wabs[k_MaxNumSym];
+  QuatF q1;
+  QuatF q2inv;
+  QuatF qr;
+  QuatF qc;
+  for(size_t p = 0; p < numPairs; p++)
+  {
+    q1 = q1s[p];
+    q2inv = q2s[p];
+    QuaternionMathF::Conjugate(q2inv);
+    QuaternionMathF::Multiply(q1, q2inv, qr);
+
+    // The rotation angle 2*acos(|w|) decreases as |w| grows, so the symmetric
+    // equivalent with the smallest angle is the one with the largest |w|.
+    for(int i = 0; i < numsym; i++)
+    {
+      float w = symW[i] * qr.w - symX[i] * qr.x - symY[i] * qr.y - symZ[i] * qr.z;
+      w = std::fabs(w);
+      wabs[i] = (w > 1.0f) ? 1.0f : w;
+    }
+    int best = 0;
+    for(int i = 1; i < numsym; i++)
+    {
+      if(wabs[i] > wabs[best])
+      {
+        best = i;
+      }
+    }
+
+    QuaternionMathF::Multiply(quatsym[best], qr, qc);
     if(qc.w < -1)
     {
       qc.w = -1;
@@ -124,36 +169,35 @@ float LaueOps::_calcMisoQuat(const QuatF quatsym[24], int numsym, QuatF& q1, Qua
     {
       qc.w = 1;
     }
+    float wmin = 2.0 * acos(std::fabs(qc.w));
+    angles[p] = wmin;
 
-    FOrientArrayType ax(4, 0.0f);
-    FOrientTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
-    ax.toAxisAngle(n1, n2, n3, w);
-
-    if(w > SIMPLib::Constants::k_Pi)
+    if(nullptr == axes)
     {
-      w = SIMPLib::Constants::k_2Pi - w;
+      continue;
     }
-    if(w < wmin)
+    float* n = axes + p * 3;
+    if(wmin == 0)
     {
-      wmin = w;
-      n1min = n1;
-      n2min = n2;
-      n3min = n3;
+      n[0] = 0.0f, n[1] = 0.0f, n[2] = 1.0f;
+      continue;
     }
+    // Same normalization sequence as qu2ax() followed by the final unit
+    // vector step of the original implementation
+    float mag = 1.0 / sqrt(qc.x * qc.x + qc.y * qc.y + qc.z * qc.z);
+    float n1 = qc.x * mag;
+    float n2 = qc.y * mag;
+    float n3 = qc.z * mag;
+    float denom = sqrt((n1 * n1 + n2 * n2 + n3 * n3));
+    if(denom == 0)
+    {
+      n[0] = 0.0f, n[1] = 0.0f, n[2] = 1.0f;
+      continue;
+    }
+    n[0] = n1 / denom;
+    n[1] = n2 / denom;
+    n[2] = n3 / denom;
   }
-  float denom = sqrt((n1min * n1min + n2min * n2min + n3min * n3min));
-  n1 = n1min / denom;
-  n2 = n2min / denom;
-  n3 = n3min / denom;
-  if(denom == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  if(wmin == 0)
-  {
-    n1 = 0.0, n2 = 0.0, n3 = 1.0;
-  }
-  return wmin;
 }
 
 // -----------------------------------------------------------------------------
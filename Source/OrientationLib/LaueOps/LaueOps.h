@@ -126,6 +126,20 @@ class OrientationLib_EXPORT LaueOps
      */
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3) = 0;
 
+    /**
+     * @brief getMisoQuatBatch Finds the misorientation for each pair of quaternions (q1s[i], q2s[i]). The
+     * results are identical to calling getMisoQuat on each pair but the symmetry operators are only
+     * prepared once and no temporary orientation arrays are allocated, which makes this the preferred
+     * entry point for any filter that computes many misorientations at once.
+     * @param q1s Pointer to the first quaternion of each pair
+     * @param q2s Pointer to the second quaternion of each pair
+     * @param numPairs The number of pairs
+     * @param angles [output] The misorientation angle (radians) of each pair. Must hold numPairs values
+     * @param axes [output] The misorientation axis of each pair. Must hold 3 * numPairs values or be nullptr
+     * if only the angles are needed.
+     */
+    virtual void getMisoQuatBatch(const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes) = 0;
+
     /**
      * @brief getQuatSymOp Copies the symmetry operator at index i into q
      * @param i The index into the Symmetry operators array
@@ -213,6 +227,23 @@ class OrientationLib_EXPORT LaueOps
                         QuatF& q1, QuatF& q2,
                         float& n1, float& n2, float& n3);
 
+    /**
+     * @brief _calcMisoQuatBatch Computes the misorientation angle and axis for numPairs quaternion pairs
+     * using the given symmetry operators. The operator that gives the smallest angle is the one with
+     * the largest |w| component so only that component is computed in the inner loop, and the
+     * axis and angle are only computed for the winning operator.
+     * @param quatsym The symmetry operators
+     * @param numsym The number of symmetry operators (at most 24)
+     * @param q1s Pointer to the first quaternion of each pair
+     * @param q2s Pointer to the second quaternion of each pair
+     * @param numPairs The number of pairs
+     * @param angles [output] Misorientation angles
+     * @param axes [output] Misorientation axes (3 values per pair) or nullptr
+     */
+    void _calcMisoQuatBatch(const QuatF* quatsym, int numsym,
+                            const QuatF* q1s, const QuatF* q2s, size_t numPairs,
+                            float* angles, float* axes);
+
     FOrientArrayType _calcRodNearestOrigin(const float rodsym[24][3], int numsym, FOrientArrayType rod);
     void _calcNearestQuat(const QuatF quatsym[24], int numsym, QuatF& q1, QuatF& q2);
     void _calcQuatNearestOrigin(const QuatF quatsym[24], int numsym, QuatF& qr);
@@ -97,6 +97,7 @@ class OrientationLib_EXPORT MonoclinicOps : public LaueOps
 
 
     virtual float getMisoQuat(QuatF& q1, QuatF& q2, float& n1, float& n2, float& n3);
+    virtual void getMisoQuatBatch(const QuatF* q1s, const QuatF* q2s, size_t numPairs, float* angles, float* axes);
     virtual void getQuatSymOp(int i, QuatF& q);
     virtual void getRodSymOp(int i, float* r);
     virtual void getMatSymOp(int i, float g[3][3]);
@@ -176,10 +177,6 @@ class OrientationLib_EXPORT MonoclinicOps : public LaueOps
      */
     virtual UInt8ArrayType::Pointer generateIPFTriangleLegend(int imageDim);
 
-  protected:
-    float _calcMisoQuat(const QuatF quatsym[24], int numsym,
-                        QuatF& q1, QuatF& q2,
-                        float& n1, float& n2, float& n3);
   private:
     MonoclinicOps(const MonoclinicOps&) = delete;  // Copy Constructor Not Implemented
     void operator=(const MonoclinicOps&) = delete; // Move assignment Not Implemented
@@ -31,6 +31,16 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SO3Sampler.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/ArrayHelpers.hpp"
@@ -102,6 +112,219 @@ static const int FZoarray[32] = { NoAxisOrder,NoAxisOrder,TwoFoldAxisOrder,TwoFo
                                   ThreeFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,SixFoldAxisOrder,
                                   SixFoldAxisOrder,SixFoldAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder,NoAxisOrder};
 
+namespace Detail
+{
+  namespace SO3
+  {
+    typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+
+    /**
+     * @brief gridCoordinate Returns the cubochoric coordinate of grid index i
+     */
+    inline double gridCoordinate(const SO3Sampler::CubochoricGrid& grid, int i)
+    {
+      return (static_cast<double>(i) + grid.shift) * grid.delta;
+    }
+
+    /**
+     * @brief walkSlab Visits every grid point of the i-slab of a cubochoric grid and hands
+     * the Rodrigues vector of each point that lies inside the FZ to the functor, together
+     * with its (j, k) cell. The points are visited in the same order as the EMsoft triple loop.
+     */
+    template<typename Functor>
+    void walkSlab(SO3Sampler* sampler, const SO3Sampler::CubochoricGrid& grid, int FZtype, int FZorder, int i, Functor& functor)
+    {
+      double x = gridCoordinate(grid, i);
+      if(fabs(x) > grid.edge)
+      {
+        return;
+      }
+      for(int j = grid.first; j <= grid.last; j++)
+      {
+        double y = gridCoordinate(grid, j);
+        if(fabs(y) > grid.edge)
+        {
+          continue;
+        }
+        for(int k = grid.first; k <= grid.last; k++)
+        {
+          double z = gridCoordinate(grid, k);
+          if(fabs(z) > grid.edge)
+          {
+            continue;
+          }
+          // convert to Rodrigues representation
+          DCubochoric3Type cu(x, y, z);
+          DRod4Type rod;
+          OrientationTransformsType::cu2ro(cu, rod);
+          if(sampler->IsinsideFZ(rod.data(), FZtype, FZorder))
+          {
+            functor(j, k, rod);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief The CellRecorder struct remembers the (j, k) cell of every FZ point of a slab
+     */
+    struct CellRecorder
+    {
+      const SO3Sampler::CubochoricGrid& grid;
+      std::vector<uint32_t>& cells;
+      void operator()(int j, int k, const DRod4Type&)
+      {
+        uint32_t dim = static_cast<uint32_t>(grid.last - grid.first + 1);
+        cells.push_back(static_cast<uint32_t>(j - grid.first) * dim + static_cast<uint32_t>(k - grid.first));
+      }
+    };
+
+    /**
+     * @brief The RodriguesStore struct writes FZ points as 4 component Rodrigues vectors
+     */
+    struct RodriguesStore
+    {
+      typedef double ValueType;
+      static const size_t k_NumComps = 4;
+      static void store(const DRod4Type& rod, ValueType* out)
+      {
+        out[0] = rod[0];
+        out[1] = rod[1];
+        out[2] = rod[2];
+        out[3] = rod[3];
+      }
+    };
+
+    /**
+     * @brief The EulerStore struct writes FZ points as Euler angles
+     */
+    struct EulerStore
+    {
+      typedef float ValueType;
+      static const size_t k_NumComps = 3;
+      static void store(const DRod4Type& rod, ValueType* out)
+      {
+        DEuler3Type eu;
+        OrientationTransformsType::ro2eu(rod, eu);
+        out[0] = static_cast<float>(eu[0]);
+        out[1] = static_cast<float>(eu[1]);
+        out[2] = static_cast<float>(eu[2]);
+      }
+    };
+
+    /**
+     * @brief The CountRFZImpl class counts the FZ points of a range of slabs and records their cells
+     */
+    class CountRFZImpl
+    {
+        SO3Sampler* m_Sampler;
+        const SO3Sampler::CubochoricGrid& m_Grid;
+        int m_FZtype;
+        int m_FZorder;
+        SO3Sampler::RFZSlabs& m_Slabs;
+
+      public:
+        CountRFZImpl(SO3Sampler* sampler, const SO3Sampler::CubochoricGrid& grid, int FZtype, int FZorder, SO3Sampler::RFZSlabs& slabs)
+        : m_Sampler(sampler)
+        , m_Grid(grid)
+        , m_FZtype(FZtype)
+        , m_FZorder(FZorder)
+        , m_Slabs(slabs)
+        {
+        }
+        virtual ~CountRFZImpl() = default;
+
+        void count(size_t start, size_t end) const
+        {
+          for(size_t s = start; s < end; s++)
+          {
+            CellRecorder recorder = {m_Grid, m_Slabs.cells[s]};
+            walkSlab(m_Sampler, m_Grid, m_FZtype, m_FZorder, m_Grid.first + static_cast<int>(s), recorder);
+            // count slab s into offsets[s + 1] so that a running sum turns the counts into offsets
+            m_Slabs.offsets[s + 1] = m_Slabs.cells[s].size();
+          }
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          count(r.begin(), r.end());
+        }
+#endif
+    };
+
+    /**
+     * @brief The SampleRFZImpl class converts the recorded cells of a range of slabs and
+     * writes them at the slab offsets
+     */
+    template<typename StoreType>
+    class SampleRFZImpl
+    {
+        typedef typename StoreType::ValueType ValueType;
+
+        const SO3Sampler::CubochoricGrid& m_Grid;
+        const SO3Sampler::RFZSlabs& m_Slabs;
+        ValueType* m_Output;
+
+      public:
+        SampleRFZImpl(const SO3Sampler::CubochoricGrid& grid, const SO3Sampler::RFZSlabs& slabs, ValueType* output)
+        : m_Grid(grid)
+        , m_Slabs(slabs)
+        , m_Output(output)
+        {
+        }
+        virtual ~SampleRFZImpl() = default;
+
+        void sample(size_t start, size_t end) const
+        {
+          uint32_t dim = static_cast<uint32_t>(m_Grid.last - m_Grid.first + 1);
+          for(size_t s = start; s < end; s++)
+          {
+            double x = gridCoordinate(m_Grid, m_Grid.first + static_cast<int>(s));
+            ValueType* out = m_Output + m_Slabs.offsets[s] * StoreType::k_NumComps;
+            for(uint32_t cell : m_Slabs.cells[s])
+            {
+              DCubochoric3Type cu(x, gridCoordinate(m_Grid, m_Grid.first + static_cast<int>(cell / dim)), gridCoordinate(m_Grid, m_Grid.first + static_cast<int>(cell % dim)));
+              DRod4Type rod;
+              OrientationTransformsType::cu2ro(cu, rod);
+              StoreType::store(rod, out);
+              out += StoreType::k_NumComps;
+            }
+          }
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          sample(r.begin(), r.end());
+        }
+#endif
+    };
+
+    /**
+     * @brief sampleSlabs Runs the fill pass over all slabs of the grid
+     */
+    template<typename StoreType>
+    void sampleSlabs(const SO3Sampler::CubochoricGrid& grid, const SO3Sampler::RFZSlabs& slabs, typename StoreType::ValueType* output)
+    {
+      size_t numSlabs = slabs.cells.size();
+      SampleRFZImpl<StoreType> impl(grid, slabs, output);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      tbb::task_scheduler_init init;
+      bool doParallel = true;
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), impl, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        impl.sample(0, numSlabs);
+      }
+    }
+  }
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -338,21 +561,12 @@ bool SO3Sampler::insideDihedralFZ(double* rod, int order)
 bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 {
   bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
+  const double r[3] = {rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3]};
   const double r1 = 1.0;
 
   // primary cube planes (only needed for octahedral case)
   if (ot == OctahedralType) {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    // std::vector<double> absR = OrientationTransformsType::OMHelperType::absValue(r);
-    // double maxVal = OrientationTransformsType::OMHelperType::maxval(absR);
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-
+    c1 = (fabs(r[0]) <= LPs::BP[3]) && (fabs(r[1]) <= LPs::BP[3]) && (fabs(r[2]) <= LPs::BP[3]);
   } else {
     c1 = true;
   }
@@ -421,50 +635,134 @@ bool SO3Sampler::insideCubicFZ(double* rod, int ot)
 //--------------------------------------------------------------------------
 SO3Sampler::OrientationListArrayType SO3Sampler::SampleRFZ(int nsteps,int pgnum)
 {
-
-  double                        x, y, z, delta;
-  OrientationListArrayType              FZlist;
-  int32_t                 FZtype, FZorder;
-
-  // step size for sampling of grid; total number of samples = (2*nsteps+1)**3
-  delta = ( 0.50 * LPs::ap)/static_cast<double>(nsteps);
-
-  // determine which function we should call for this point group symmetry
-  FZtype = FZtarray[pgnum-1];
-  FZorder = FZoarray[pgnum-1];
-  typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
+  OrientationListArrayType FZlist;
 
   // loop over the cube of volume pi^2; note that we do not want to include
   // the opposite edges/facets of the cube, to avoid double counting rotations
   // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
-  for(int i = -nsteps; i < nsteps; i++)
+  VisitRFZ(RFZGrid(nsteps), pgnum, [&FZlist](const double* rod) { FZlist.push_back(DOrientArrayType(rod[0], rod[1], rod[2], rod[3])); });
+
+  return FZlist;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SO3Sampler::CubochoricGrid SO3Sampler::RFZGrid(int nsteps)
+{
+  // step size for sampling of grid; total number of samples = (2*nsteps)**3. All
+  // points lie inside the cube so no edge test is needed.
+  CubochoricGrid grid;
+  grid.first = -nsteps;
+  grid.last = nsteps - 1;
+  grid.shift = 0.0;
+  grid.delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  grid.edge = std::numeric_limits<double>::max();
+  return grid;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SO3Sampler::CubochoricGrid SO3Sampler::DictionaryGrid(int nsteps, bool offsetGrid)
+{
+  // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
+  CubochoricGrid grid;
+  grid.first = -nsteps + 1;
+  grid.last = nsteps;
+  grid.shift = offsetGrid ? 0.5 : 0.0;
+  grid.delta = (0.50 * LPs::ap) / static_cast<double>(nsteps);
+  grid.edge = 0.5 * LPs::ap;
+  return grid;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SO3Sampler::CountRFZ(const CubochoricGrid& grid, int pgnum, RFZSlabs& slabs, const RFZProgressType& progress)
+{
+  size_t numSlabs = 0;
+  if(grid.last >= grid.first)
   {
-    x = static_cast<double>(i) * delta;
+    numSlabs = static_cast<size_t>(grid.last - grid.first + 1);
+  }
+  slabs.offsets.assign(numSlabs + 1, 0);
+  slabs.cells.assign(numSlabs, std::vector<uint32_t>());
 
-    for(int j = -nsteps; j < nsteps; j++)
-    {
-      y = static_cast<double>(j) * delta;
+  Detail::SO3::CountRFZImpl impl(this, grid, FZtarray[pgnum - 1], FZoarray[pgnum - 1], slabs);
 
-      for (int k = -nsteps; k < nsteps; k++)
-      {
-        z = static_cast<double>(k) * delta;
+  // Without a progress callback all slabs are counted in one go
+  size_t chunkSize = numSlabs;
+  if(progress)
+  {
+    chunkSize = std::max(numSlabs / 10, static_cast<size_t>(1));
+  }
 
-        // convert to Rodrigues representation
-        DOrientArrayType cu(x, y, z);
-        DOrientArrayType rod(4);
-        OrientationTransformsType::cu2ro(cu, rod);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-        // If insideFZ=true, then add this point to the linked list FZlist and keep
-        // track of how many points there are on this list
-        bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-        if (b)
-        {
-          FZlist.push_back(rod);
-        }
+  size_t insideFZ = 0;
+  for(size_t start = 0; start < numSlabs; start += chunkSize)
+  {
+    size_t end = std::min(start + chunkSize, numSlabs);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(start, end, 1), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.count(start, end);
+    }
 
-      }
+    for(size_t s = start; s < end; s++)
+    {
+      insideFZ += slabs.offsets[s + 1];
+    }
+    if(progress && !progress(end, insideFZ))
+    {
+      slabs.offsets.assign(1, 0);
+      slabs.cells.clear();
+      return 0;
     }
   }
 
-  return FZlist;
+  for(size_t s = 1; s <= numSlabs; s++)
+  {
+    slabs.offsets[s] += slabs.offsets[s - 1];
+  }
+  return slabs.offsets[numSlabs];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::SampleRFZRodrigues(const CubochoricGrid& grid, const RFZSlabs& slabs, double* rods)
+{
+  Detail::SO3::sampleSlabs<Detail::SO3::RodriguesStore>(grid, slabs, rods);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::SampleRFZEulers(const CubochoricGrid& grid, const RFZSlabs& slabs, float* eulers)
+{
+  Detail::SO3::sampleSlabs<Detail::SO3::EulerStore>(grid, slabs, eulers);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SO3Sampler::VisitRFZ(const CubochoricGrid& grid, int pgnum, const RFZVisitorType& visitor)
+{
+  int FZtype = FZtarray[pgnum - 1];
+  int FZorder = FZoarray[pgnum - 1];
+  auto forward = [&visitor](int, int, const DRod4Type& rod) { visitor(rod.data()); };
+  for(int i = grid.first; i <= grid.last; i++)
+  {
+    Detail::SO3::walkSlab(this, grid, FZtype, FZorder, i, forward);
+  }
 }
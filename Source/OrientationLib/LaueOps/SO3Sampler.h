@@ -33,6 +33,10 @@
 
 
 
+#include <functional>
+#include <list>
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
@@ -61,6 +65,96 @@ class OrientationLib_EXPORT SO3Sampler
     // sampler routine
     OrientationListArrayType SampleRFZ(int nsteps,int pgnum);
 
+    /**
+     * @brief The CubochoricGrid struct describes a cubic grid in cubochoric space. Along each
+     * axis the grid index i runs from first to last (inclusive) and maps to the coordinate
+     * (i + shift) * delta; points with any coordinate outside [-edge, edge] are skipped.
+     */
+    struct CubochoricGrid
+    {
+      int first;
+      int last;
+      double shift;
+      double delta;
+      double edge;
+    };
+
+    /**
+     * @brief RFZGrid Returns the grid that SampleRFZ(nsteps, pgnum) walks
+     * @param nsteps number of steps along the semi-edge of the cubochoric cube
+     * @return
+     */
+    static CubochoricGrid RFZGrid(int nsteps);
+
+    /**
+     * @brief DictionaryGrid Returns the grid used for EMsoft dictionary sampling, which runs
+     * from -nsteps+1 to nsteps and may be shifted half a step away from the origin
+     * @param nsteps number of steps along the semi-edge of the cubochoric cube
+     * @param offsetGrid shift the grid by half a step
+     * @return
+     */
+    static CubochoricGrid DictionaryGrid(int nsteps, bool offsetGrid);
+
+    /**
+     * @brief RFZVisitorType Receives the 4 component Rodrigues vector of each point inside the FZ
+     */
+    typedef std::function<void(const double* rod)> RFZVisitorType;
+
+    /**
+     * @brief The RFZSlabs struct holds the result of CountRFZ: where each i-slab of the grid
+     * starts in the output and which (j, k) cells of the slab lie inside the FZ.
+     */
+    struct RFZSlabs
+    {
+      std::vector<size_t> offsets;              // slab s starts at offsets[s]; offsets.back() is the total
+      std::vector<std::vector<uint32_t>> cells; // (j - first) * (last - first + 1) + (k - first), in sampling order
+    };
+
+    /**
+     * @brief RFZProgressType Receives the number of slabs that have been tested so far and the number of
+     * points inside the FZ that they hold. Returning false stops the count.
+     */
+    typedef std::function<bool(size_t slabsDone, size_t insideFZ)> RFZProgressType;
+
+    /**
+     * @brief CountRFZ Tests every grid point against the Rodrigues FZ, one i-slab per task when
+     * parallel algorithms are available, and records the FZ cells and output offsets of each slab.
+     * @param grid Cubochoric grid to sample
+     * @param pgnum Point group number (1-32)
+     * @param slabs (output) Slab offsets and FZ cells
+     * @param progress Optional callback that is called from the calling thread after about every
+     * tenth of the slabs. If it returns false the remaining slabs are skipped, slabs is cleared and 0 is returned.
+     * @return The total number of points inside the FZ
+     */
+    size_t CountRFZ(const CubochoricGrid& grid, int pgnum, RFZSlabs& slabs, const RFZProgressType& progress = RFZProgressType());
+
+    /**
+     * @brief SampleRFZRodrigues Fills a preallocated array with the 4 component Rodrigues
+     * vectors of the FZ points, writing every slab directly at its offset.
+     * @param grid Cubochoric grid that was passed to CountRFZ
+     * @param slabs Result of CountRFZ
+     * @param rods Output array holding at least slabs.offsets.back() * 4 values
+     */
+    void SampleRFZRodrigues(const CubochoricGrid& grid, const RFZSlabs& slabs, double* rods);
+
+    /**
+     * @brief SampleRFZEulers Same as SampleRFZRodrigues but stores the Euler angles (radians)
+     * of each FZ point, 3 values per point.
+     * @param grid Cubochoric grid that was passed to CountRFZ
+     * @param slabs Result of CountRFZ
+     * @param eulers Output array holding at least slabs.offsets.back() * 3 values
+     */
+    void SampleRFZEulers(const CubochoricGrid& grid, const RFZSlabs& slabs, float* eulers);
+
+    /**
+     * @brief VisitRFZ Streams the FZ points of the grid to a visitor in the same order that
+     * SampleRFZRodrigues stores them, without keeping any of them in memory.
+     * @param grid Cubochoric grid to sample
+     * @param pgnum Point group number (1-32)
+     * @param visitor Called once for every point inside the FZ
+     */
+    void VisitRFZ(const CubochoricGrid& grid, int pgnum, const RFZVisitorType& visitor);
+
     /**
      * @brief IsinsideFZ
      * @param rod
@@ -0,0 +1,490 @@
+/* ============================================================================
+* Copyright (c) 2009-2017 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The SinCosKernel class evaluates sine and cosine together with a range
+ * reduction by Pi/4 and the minimax polynomials of the Cephes math library. There
+ * are no branches or library calls so loops over it can be vectorized. The results
+ * agree with the standard library to about 1 ulp for arguments in the range of
+ * orientation angles (|x| < 1000).
+ */
+template<typename T>
+class SinCosKernel
+{
+};
+
+template<>
+class SinCosKernel<float>
+{
+  public:
+    static inline float FourOverPi() { return 1.27323954473516f; }
+    static inline float Reduce(float y, float x)
+    {
+      return ((x - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+    }
+    static inline float Sin(float z, float zz)
+    {
+      return ((-1.9515295891E-4f * zz + 8.3321608736E-3f) * zz - 1.6666654611E-1f) * zz * z + z;
+    }
+    static inline float Cos(float zz)
+    {
+      return ((2.443315711809948E-005f * zz - 1.388731625493765E-003f) * zz + 4.166664568298827E-002f) * zz * zz - 0.5f * zz + 1.0f;
+    }
+};
+
+template<>
+class SinCosKernel<double>
+{
+  public:
+    static inline double FourOverPi() { return 1.27323954473516268615; }
+    static inline double Reduce(double y, double x)
+    {
+      return ((x - y * 7.85398125648498535156E-1) - y * 3.77489470793079817668E-8) - y * 2.69515142907905952645E-15;
+    }
+    static inline double Sin(double z, double zz)
+    {
+      return z + z * zz * (((((1.58962301576546568060E-10 * zz - 2.50507477628578072866E-8) * zz + 2.75573136213857245213E-6) * zz - 1.98412698295895385996E-4) * zz + 8.33333333332211858878E-3) * zz - 1.66666666666666307295E-1);
+    }
+    static inline double Cos(double zz)
+    {
+      return 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300E-11 * zz + 2.08757008419747316778E-9) * zz - 2.75573141792967388112E-7) * zz + 2.48015872888517045348E-5) * zz - 1.38888888888730564116E-3) * zz + 4.16666666666665929218E-2);
+    }
+};
+
+/**
+ * @brief The BulkOrientationTransforms class converts whole arrays of orientations
+ * for the conversion chains that are used the most (Euler angles and quaternions
+ * into the other representations). The interleaved input is transposed into small
+ * tiles of k_TileSize orientations with one array per component so the arithmetic
+ * runs as straight, branch free loops that the compiler can vectorize. Sines and
+ * cosines come from SinCosKernel instead of the math library for the same reason. The special
+ * cases that OrientationTransforms handles with branches (zero rotation angle,
+ * degenerate Euler angles, ...) are detected per orientation inside the tile and
+ * those few orientations are handed back to the scalar OrientationTransforms
+ * functions, so the results match the scalar path to within rounding.
+ *
+ * Multi step conversions (eu2ro, eu2ho) are fused: the intermediate axis-angle
+ * pair only ever lives in the tile.
+ *
+ * All functions take interleaved (AoS) arrays with the standard component counts
+ * (Euler 3, Orientation Matrix 9, Quaternion 4 in <Vector>Scalar layout, Axis-Angle 4,
+ * Rodrigues 4 and Homochoric 3).
+ */
+template<typename T>
+class BulkOrientationTransforms
+{
+  public:
+    typedef OrientationArray<T> OrientationArrayType;
+    typedef OrientationTransforms<OrientationArrayType, T> TransformsType;
+
+    /**
+     * @brief The number of orientations that are processed together
+     */
+    static const size_t k_TileSize = 64;
+
+    /**
+     * @brief eu2om Converts Euler angles to Orientation Matrices
+     * @param in count * 3 values
+     * @param out count * 9 values
+     * @param count Number of orientations
+     */
+    static void eu2om(const T* in, T* out, size_t count)
+    {
+      T c1[k_TileSize], s1[k_TileSize], c[k_TileSize], s[k_TileSize], c2[k_TileSize], s2[k_TileSize];
+      const T eps = 1.0E-7f;
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        const T* e = in + start * 3;
+        T* res = out + start * 9;
+
+        for(size_t i = 0; i < n; i++)
+        {
+          sinCos(e[i * 3], s1[i], c1[i]);
+          sinCos(e[i * 3 + 1], s[i], c[i]);
+          sinCos(e[i * 3 + 2], s2[i], c2[i]);
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          T om[9];
+          om[0] = c1[i] * c2[i] - s1[i] * s2[i] * c[i];
+          om[1] = s1[i] * c2[i] + c1[i] * s2[i] * c[i];
+          om[2] = s2[i] * s[i];
+          om[3] = -c1[i] * s2[i] - s1[i] * c2[i] * c[i];
+          om[4] = -s1[i] * s2[i] + c1[i] * c2[i] * c[i];
+          om[5] = c2[i] * s[i];
+          om[6] = s1[i] * s[i];
+          om[7] = -c1[i] * s[i];
+          om[8] = c[i];
+          for(size_t j = 0; j < 9; j++)
+          {
+            res[i * 9 + j] = (std::fabs(om[j]) < eps) ? static_cast<T>(0.0) : om[j];
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief eu2qu Converts Euler angles to Quaternions (<Vector>Scalar layout)
+     * @param in count * 3 values
+     * @param out count * 4 values
+     * @param count Number of orientations
+     */
+    static void eu2qu(const T* in, T* out, size_t count)
+    {
+      T ee0[k_TileSize], ee1[k_TileSize], ee2[k_TileSize];
+      T cPhi[k_TileSize], sPhi[k_TileSize], cm[k_TileSize], sm[k_TileSize], cp[k_TileSize], sp[k_TileSize];
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        const T* e = in + start * 3;
+        T* res = out + start * 4;
+
+        for(size_t i = 0; i < n; i++)
+        {
+          ee0[i] = 0.5 * e[i * 3];
+          ee1[i] = 0.5 * e[i * 3 + 1];
+          ee2[i] = 0.5 * e[i * 3 + 2];
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          sinCos(ee1[i], sPhi[i], cPhi[i]);
+          sinCos(ee0[i] - ee2[i], sm[i], cm[i]);
+          sinCos(ee0[i] + ee2[i], sp[i], cp[i]);
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          T w = cPhi[i] * cp[i];
+          T x = -RConst::epsijk * sPhi[i] * cm[i];
+          T y = -RConst::epsijk * sPhi[i] * sm[i];
+          T z = -RConst::epsijk * cPhi[i] * sp[i];
+          T sign = (w < 0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+          res[i * 4] = sign * x;
+          res[i * 4 + 1] = sign * y;
+          res[i * 4 + 2] = sign * z;
+          res[i * 4 + 3] = sign * w;
+        }
+      }
+    }
+
+    /**
+     * @brief eu2ax Converts Euler angles to Axis-Angle pairs
+     * @param in count * 3 values
+     * @param out count * 4 values
+     * @param count Number of orientations
+     */
+    static void eu2ax(const T* in, T* out, size_t count)
+    {
+      T a0[k_TileSize], a1[k_TileSize], a2[k_TileSize], a3[k_TileSize];
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        T* res = out + start * 4;
+        eulerTileToAxisAngle(in + start * 3, n, a0, a1, a2, a3);
+        for(size_t i = 0; i < n; i++)
+        {
+          res[i * 4] = a0[i];
+          res[i * 4 + 1] = a1[i];
+          res[i * 4 + 2] = a2[i];
+          res[i * 4 + 3] = a3[i];
+        }
+      }
+    }
+
+    /**
+     * @brief eu2ro Converts Euler angles to Rodrigues Vectors without storing the
+     * intermediate Axis-Angle pairs
+     * @param in count * 3 values
+     * @param out count * 4 values
+     * @param count Number of orientations
+     */
+    static void eu2ro(const T* in, T* out, size_t count)
+    {
+      T a0[k_TileSize], a1[k_TileSize], a2[k_TileSize], a3[k_TileSize];
+      const T thr = 1.0E-6f;
+      const T inf = std::numeric_limits<T>::infinity();
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        T* res = out + start * 4;
+        eulerTileToAxisAngle(in + start * 3, n, a0, a1, a2, a3);
+        for(size_t i = 0; i < n; i++)
+        {
+          T t = a3[i];
+          bool isPi = std::fabs(t - SIMPLib::Constants::k_Pi) < thr;
+          bool isZero = (t == 0.0) && !isPi;
+          T tanHalf = tan(t * 0.5);
+          res[i * 4] = isZero ? static_cast<T>(0.0) : a0[i];
+          res[i * 4 + 1] = isZero ? static_cast<T>(0.0) : a1[i];
+          res[i * 4 + 2] = isZero ? static_cast<T>(0.0) : a2[i];
+          res[i * 4 + 3] = isPi ? inf : (isZero ? static_cast<T>(0.0) : tanHalf);
+        }
+      }
+    }
+
+    /**
+     * @brief eu2ho Converts Euler angles to Homochoric vectors without storing the
+     * intermediate Axis-Angle pairs
+     * @param in count * 3 values
+     * @param out count * 3 values
+     * @param count Number of orientations
+     */
+    static void eu2ho(const T* in, T* out, size_t count)
+    {
+      T a0[k_TileSize], a1[k_TileSize], a2[k_TileSize], a3[k_TileSize];
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        T* res = out + start * 3;
+        eulerTileToAxisAngle(in + start * 3, n, a0, a1, a2, a3);
+        for(size_t i = 0; i < n; i++)
+        {
+          T f = 0.75 * (a3[i] - sin(a3[i]));
+          f = pow(f, (1.0 / 3.0));
+          res[i * 3] = a0[i] * f;
+          res[i * 3 + 1] = a1[i] * f;
+          res[i * 3 + 2] = a2[i] * f;
+        }
+      }
+    }
+
+    /**
+     * @brief qu2om Converts Quaternions (<Vector>Scalar layout) to Orientation Matrices
+     * @param in count * 4 values
+     * @param out count * 9 values
+     * @param count Number of orientations
+     */
+    static void qu2om(const T* in, T* out, size_t count)
+    {
+      for(size_t i = 0; i < count; i++)
+      {
+        const T* r = in + i * 4;
+        T* res = out + i * 9;
+        T x = r[0], y = r[1], z = r[2], w = r[3];
+        T qq = w * w - (x * x + y * y + z * z);
+        res[0] = qq + 2.0 * x * x;
+        res[4] = qq + 2.0 * y * y;
+        res[8] = qq + 2.0 * z * z;
+        res[1] = 2.0 * (x * y - w * z);
+        res[5] = 2.0 * (y * z - w * x);
+        res[6] = 2.0 * (z * x - w * y);
+        res[3] = 2.0 * (y * x + w * z);
+        res[7] = 2.0 * (z * y + w * x);
+        res[2] = 2.0 * (x * z + w * y);
+      }
+      if(RConst::epsijk != 1.0)
+      {
+        for(size_t i = 0; i < count; i++)
+        {
+          T* res = out + i * 9;
+          std::swap(res[1], res[3]);
+          std::swap(res[2], res[6]);
+          std::swap(res[5], res[7]);
+        }
+      }
+    }
+
+    /**
+     * @brief qu2eu Converts Quaternions (<Vector>Scalar layout) to Euler angles
+     * @param in count * 4 values
+     * @param out count * 3 values
+     * @param count Number of orientations
+     */
+    static void qu2eu(const T* in, T* out, size_t count)
+    {
+      if(RConst::epsijk != 1.0)
+      {
+        for(size_t i = 0; i < count; i++)
+        {
+          scalarQu2Eu(in + i * 4, out + i * 3);
+        }
+        return;
+      }
+
+      T phi1[k_TileSize], Phi[k_TileSize], phi2[k_TileSize];
+      bool degenerate[k_TileSize];
+
+      for(size_t start = 0; start < count; start += k_TileSize)
+      {
+        size_t n = tileCount(start, count);
+        const T* qq = in + start * 4;
+        T* res = out + start * 3;
+
+        for(size_t i = 0; i < n; i++)
+        {
+          T x = qq[i * 4], y = qq[i * 4 + 1], z = qq[i * 4 + 2], w = qq[i * 4 + 3];
+          T q03 = w * w + z * z;
+          T q12 = x * x + y * y;
+          T chi = sqrt(q03 * q12);
+          degenerate[i] = (chi == 0.0);
+          Phi[i] = atan2(2.0 * chi, q03 - q12);
+          chi = 1.0 / chi;
+          phi1[i] = atan2((-w * y + x * z) * chi, (-w * x - y * z) * chi);
+          phi2[i] = atan2((w * y + x * z) * chi, (-w * x + y * z) * chi);
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          T p1 = phi1[i], p = Phi[i], p2 = phi2[i];
+          res[i * 3] = (p1 < 0.0) ? static_cast<T>(fmod(p1 + 100.0 * DConst::k_Pi, DConst::k_2Pi)) : p1;
+          res[i * 3 + 1] = (p < 0.0) ? static_cast<T>(fmod(p + 100.0 * DConst::k_Pi, DConst::k_Pi)) : p;
+          res[i * 3 + 2] = (p2 < 0.0) ? static_cast<T>(fmod(p2 + 100.0 * DConst::k_Pi, DConst::k_2Pi)) : p2;
+        }
+        for(size_t i = 0; i < n; i++)
+        {
+          if(degenerate[i])
+          {
+            scalarQu2Eu(qq + i * 4, res + i * 3);
+          }
+        }
+      }
+    }
+
+  protected:
+    BulkOrientationTransforms() = default;
+
+    /**
+     * @brief sinCos Computes the sine and cosine of x with SinCosKernel
+     */
+    static inline void sinCos(T x, T& s, T& c)
+    {
+      T ax = std::fabs(x);
+      int32_t j = static_cast<int32_t>(ax * SinCosKernel<T>::FourOverPi());
+      j += (j & 1); // map zeros to origin
+      T y = static_cast<T>(j);
+      j &= 7;
+      T z = SinCosKernel<T>::Reduce(y, ax);
+      T zz = z * z;
+      T ps = SinCosKernel<T>::Sin(z, zz);
+      T pc = SinCosKernel<T>::Cos(zz);
+      bool upper = (j > 3);
+      int32_t octant = upper ? j - 4 : j;
+      bool swap = (octant == 2);
+      T sv = swap ? pc : ps;
+      T cv = swap ? ps : pc;
+      s = (((x < 0.0) != upper) ? static_cast<T>(-1.0) : static_cast<T>(1.0)) * sv;
+      c = ((upper != (octant > 1)) ? static_cast<T>(-1.0) : static_cast<T>(1.0)) * cv;
+    }
+
+    /**
+     * @brief tileCount Returns the number of orientations in the tile that begins at start
+     */
+    static size_t tileCount(size_t start, size_t count)
+    {
+      size_t n = count - start;
+      if(n > k_TileSize)
+      {
+        n = k_TileSize;
+      }
+      return n;
+    }
+
+    /**
+     * @brief eulerTileToAxisAngle Converts up to k_TileSize interleaved Euler angles into
+     * separate axis and angle arrays. Orientations that hit one of the special cases
+     * of OrientationTransforms::eu2ax are redone with the scalar function.
+     */
+    static void eulerTileToAxisAngle(const T* e, size_t n, T* a0, T* a1, T* a2, T* a3)
+    {
+      const T thr = static_cast<T>(1.0E-6);
+      bool degenerate[k_TileSize];
+
+      for(size_t i = 0; i < n; i++)
+      {
+        T sinHalf, cosHalf;
+        sinCos(e[i * 3 + 1] * 0.5, sinHalf, cosHalf);
+        T t = sinHalf / cosHalf;
+        T sig = 0.5 * (e[i * 3] + e[i * 3 + 2]);
+        T del = 0.5 * (e[i * 3] - e[i * 3 + 2]);
+        T sinSig, cosSig, sinDel, cosDel;
+        sinCos(sig, sinSig, cosSig);
+        sinCos(del, sinDel, cosDel);
+        T tau = sqrt(t * t + sinSig * sinSig);
+        T alpha = 2.0 * atan(tau / cosSig);
+        T sign = (alpha < 0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+        degenerate[i] = SIMPLibMath::closeEnough(sig, static_cast<T>(SIMPLib::Constants::k_PiOver2), static_cast<T>(1.0E-6L)) || std::fabs(alpha) < thr;
+        a0[i] = sign * (-RConst::epsijkd * t * cosDel / tau);
+        a1[i] = sign * (-RConst::epsijkd * t * sinDel / tau);
+        a2[i] = sign * (-RConst::epsijkd * sinSig / tau);
+        a3[i] = sign * alpha;
+      }
+      for(size_t i = 0; i < n; i++)
+      {
+        if(degenerate[i])
+        {
+          T ax[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+          OrientationArrayType eu(const_cast<T*>(e + i * 3), 3);
+          OrientationArrayType res(ax, 4);
+          TransformsType::eu2ax(eu, res);
+          a0[i] = ax[0];
+          a1[i] = ax[1];
+          a2[i] = ax[2];
+          a3[i] = ax[3];
+        }
+      }
+    }
+
+    /**
+     * @brief scalarQu2Eu Runs the scalar OrientationTransforms::qu2eu on a single quaternion
+     */
+    static void scalarQu2Eu(const T* qu, T* eu)
+    {
+      OrientationArrayType q(const_cast<T*>(qu), 4);
+      OrientationArrayType res(eu, 3);
+      TransformsType::qu2eu(q, res);
+    }
+
+  private:
+    BulkOrientationTransforms(const BulkOrientationTransforms&) = delete; // Copy Constructor Not Implemented
+    void operator=(const BulkOrientationTransforms&) = delete;            // Move assignment Not Implemented
+};
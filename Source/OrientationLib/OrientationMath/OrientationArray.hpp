@@ -53,7 +53,10 @@ template<typename T>
  * Class is meant to allow easier use of the Rotation Transformation functions
  * included in the @see RotationTransformation class. The base implementation will
  * allocate the "size" number of elements which represent a single orientation
- * in space. Alternate constructors can allow the class to simply wrap an existing
+ * in space. Every representation fits in a small buffer that lives inside the
+ * object so constructing, copying or returning an orientation by value never
+ * touches the heap; only arrays larger than k_InlineCapacity are malloc'ed.
+ * Alternate constructors can allow the class to simply wrap an existing
  * array of values which makes looping through an array of orientations easier.
  */
 class OrientationArray
@@ -183,10 +186,7 @@ class OrientationArray
      */
     virtual ~OrientationArray()
     {
-      if(m_Ptr != nullptr && m_Owns == true)
-      {
-        free(m_Ptr);
-      }
+      release();
       m_Ptr = nullptr;
     }
 
@@ -197,16 +197,21 @@ class OrientationArray
      */
     void operator=(const OrientationArray& rhs)
     {
-      if(m_Ptr != nullptr && m_Owns == true)
+      if(this == &rhs)
       {
-        free(m_Ptr);
-        m_Ptr = nullptr;
-
-        m_Size = rhs.size();
-        allocate();
+        return;
+      }
+      if(m_Owns == true)
+      {
+        // Only reallocate when the number of elements changes
+        if(m_Ptr == nullptr || m_Size != rhs.size())
+        {
+          m_Size = rhs.size();
+          allocate();
+        }
         ::memcpy(m_Ptr, rhs.m_Ptr, sizeof(T) * m_Size); // Copy the bytes over to the new array
       }
-      if(m_Owns == false)
+      else
       {
         assert(m_Size == rhs.size());
         assert(m_Ptr != nullptr);
@@ -346,15 +351,48 @@ class OrientationArray
       // Wipe out the array completely if new size is zero.
       if (newSize == 0)
       {
-        if(m_Ptr != nullptr && m_Owns == true)
-        {
-          free(m_Ptr);
-        }
+        release();
         m_Ptr = nullptr;
         m_Owns = false;
         m_Size = 0;
         return;
       }
+
+      // Small arrays always live in the inline buffer
+      if (newSize <= k_InlineCapacity)
+      {
+        if (m_Ptr != nullptr && m_Ptr != m_Inline)
+        {
+          ::memcpy(m_Inline, m_Ptr, (newSize < oldSize ? newSize : oldSize) * sizeof(T));
+          free(m_Ptr);
+        }
+        m_Ptr = m_Inline;
+        m_Size = newSize;
+        m_Owns = true;
+        return;
+      }
+
+      // Growing out of the inline buffer needs a fresh heap block
+      if (m_Ptr == nullptr || m_Ptr == m_Inline)
+      {
+        newArray = (T*)malloc(newSize * sizeof(T));
+        if (!newArray)
+        {
+          m_Ptr = nullptr;
+          m_Owns = false;
+          m_Size = 0;
+          return;
+        }
+        if (m_Ptr != nullptr)
+        {
+          ::memcpy(newArray, m_Ptr, oldSize * sizeof(T));
+        }
+        m_Size = newSize;
+        m_Ptr = newArray;
+        m_Owns = true;
+        return;
+      }
+
       // OS X's realloc does not free memory if the new block is smaller.  This
       // is a very serious problem and causes huge amount of memory to be
       // wasted. Do not use realloc on the Mac.
@@ -389,10 +427,7 @@ class OrientationArray
         }
 
         // Copy the data from the old array.
-        if (m_Ptr != nullptr)
-        {
-          memcpy(newArray, m_Ptr, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
-        }
+        memcpy(newArray, m_Ptr, (newSize < m_Size ? newSize : m_Size) * sizeof(T));
         // Free the old array
         free(m_Ptr);
         m_Ptr = nullptr;
@@ -407,6 +442,11 @@ class OrientationArray
 
     }
 
+    /**
+     * @brief The number of elements that are stored inside the object itself. This
+     * covers the largest representation (the 3x3 orientation matrix).
+     */
+    static const size_t k_InlineCapacity = 9;
 
   protected:
     /**
@@ -418,7 +458,7 @@ class OrientationArray
 
       if(m_Ptr != nullptr && m_Owns == true)
       {
-        free(m_Ptr);
+        release();
         m_Ptr = nullptr;
       }
       else if(m_Ptr != nullptr && m_Owns == false)
@@ -428,20 +468,120 @@ class OrientationArray
       // If we made it this far the pointer should be nullptr and we can go ahead and allocate our memory
       if(m_Ptr == nullptr)
       {
-        m_Ptr = reinterpret_cast<T*>(malloc(sizeof(T) * m_Size));
+        if(m_Size <= k_InlineCapacity)
+        {
+          m_Ptr = m_Inline;
+        }
+        else
+        {
+          m_Ptr = reinterpret_cast<T*>(malloc(sizeof(T) * m_Size));
+        }
         ::memset(m_Ptr, 0, sizeof(T) * m_Size);
         m_Owns = true;
       }
 
     }
 
+    /**
+     * @brief release Frees the heap block if this instance owns one. The inline
+     * buffer and wrapped arrays are left alone.
+     */
+    void release()
+    {
+      if(m_Ptr != nullptr && m_Owns == true && m_Ptr != m_Inline)
+      {
+        free(m_Ptr);
+      }
+    }
+
   private:
     T* m_Ptr;
     size_t m_Size;
     bool m_Owns;
+    T m_Inline[k_InlineCapacity];
 
 };
 
+/**
+ * @brief The OrientationFixed class is an OrientationArray whose number of elements
+ * is fixed at compile time. The values always live in the inline buffer of the base
+ * class so these can be created freely inside per voxel or per sample loops. Because
+ * it IS an OrientationArray it can be handed directly to the OrientationTransforms
+ * and LaueOps functions that take the runtime sized type.
+ */
+template<typename T, size_t N>
+class OrientationFixed : public OrientationArray<T>
+{
+  public:
+    /**
+     * @brief OrientationFixed Constructor
+     * @param init Initialization value to be assigned to each element
+     */
+    explicit OrientationFixed(T init = (T)(0)) :
+      OrientationArray<T>(N, init)
+    {
+      static_assert(N <= OrientationArray<T>::k_InlineCapacity, "OrientationFixed must fit in the inline buffer");
+    }
+
+    /**
+     * @brief OrientationFixed Constructor for the 3 component representations
+     */
+    OrientationFixed(T val0, T val1, T val2) :
+      OrientationArray<T>(val0, val1, val2)
+    {
+      static_assert(N == 3, "This constructor needs a 3 component orientation");
+    }
+
+    /**
+     * @brief OrientationFixed Constructor for the 4 component representations
+     */
+    OrientationFixed(T val0, T val1, T val2, T val3) :
+      OrientationArray<T>(val0, val1, val2, val3)
+    {
+      static_assert(N == 4, "This constructor needs a 4 component orientation");
+    }
+
+    /**
+     * @brief OrientationFixed Constructor that copies the first N values out of an existing array
+     * @param ptr Pointer to at least N values
+     */
+    explicit OrientationFixed(const T* ptr) :
+      OrientationArray<T>(N)
+    {
+      ::memcpy(this->data(), ptr, sizeof(T) * N);
+    }
+
+    /**
+     * @brief OrientationFixed Copy constructor from the runtime sized type.
+     * @param rhs Must hold exactly N elements
+     */
+    OrientationFixed(const OrientationArray<T>& rhs) :
+      OrientationArray<T>(rhs)
+    {
+      assert(rhs.size() == N);
+    }
+
+    virtual ~OrientationFixed() {}
+
+    using OrientationArray<T>::operator=;
+};
+
+typedef OrientationFixed<float, 3> FEuler3Type;
+typedef OrientationFixed<float, 9> FOM9Type;
+typedef OrientationFixed<float, 4> FAxisAngle4Type;
+typedef OrientationFixed<float, 4> FRod4Type;
+typedef OrientationFixed<float, 4> FQuat4Type;
+typedef OrientationFixed<float, 3> FHomochoric3Type;
+typedef OrientationFixed<float, 3> FCubochoric3Type;
+
+typedef OrientationFixed<double, 3> DEuler3Type;
+typedef OrientationFixed<double, 9> DOM9Type;
+typedef OrientationFixed<double, 4> DAxisAngle4Type;
+typedef OrientationFixed<double, 4> DRod4Type;
+typedef OrientationFixed<double, 4> DQuat4Type;
+typedef OrientationFixed<double, 3> DHomochoric3Type;
+typedef OrientationFixed<double, 3> DCubochoric3Type;
+
 /**
  * @brief OrientationArrayF A convenience Typedef for a OrientationArray<float>
  */
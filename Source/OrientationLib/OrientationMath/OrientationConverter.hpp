@@ -48,6 +48,7 @@
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/BulkOrientationTransforms.hpp"
 
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -329,6 +330,35 @@ OC_CONVERTOR_FUNCTOR(Cu2Ho, 3, 3, cu2ho)
 
 }
 
+/**
+ * @brief This macro is used to create a functor that wraps one of the bulk (tiled)
+ * conversion methods of BulkOrientationTransforms so it can be passed to the parallel algorithms
+ */
+#define OC_BULK_CONVERTOR_FUNCTOR(CLASSNAME, CONVERSION_METHOD)\
+  template<typename T>\
+  class CLASSNAME {\
+  public:\
+  CLASSNAME()  { }\
+  void operator()(T* in, T* out, size_t count) { \
+  BulkOrientationTransforms<T>::CONVERSION_METHOD(in, out, count); \
+  }\
+  private:\
+  };
+
+/**
+ * @brief This contains the functors for the conversions that have a bulk implementation
+ */
+namespace BulkConvertors {
+OC_BULK_CONVERTOR_FUNCTOR(Eu2Om, eu2om)
+OC_BULK_CONVERTOR_FUNCTOR(Eu2Qu, eu2qu)
+OC_BULK_CONVERTOR_FUNCTOR(Eu2Ax, eu2ax)
+OC_BULK_CONVERTOR_FUNCTOR(Eu2Ro, eu2ro)
+OC_BULK_CONVERTOR_FUNCTOR(Eu2Ho, eu2ho)
+
+OC_BULK_CONVERTOR_FUNCTOR(Qu2Eu, qu2eu)
+OC_BULK_CONVERTOR_FUNCTOR(Qu2Om, qu2om)
+}
+
 /**
  * @brief This templated class is a functor class that is used for 
  * the TBB classes to use to parallelize the conversion of orientation
@@ -378,6 +408,48 @@ class ConvertRepresentation
 };
 
 
+/**
+ * @brief This templated class is a functor class that hands contiguous ranges of
+ * orientations to one of the BulkConvertors functors. The input must be tightly
+ * packed (the input stride equals the component count of the representation).
+ */
+template <typename T, class Converter>
+class ConvertRepresentationBulk
+{
+  public:
+    ConvertRepresentationBulk(T* inPtr, T* outPtr, size_t inStride, size_t outStride) :
+      m_InPtr(inPtr)
+    , m_OutPtr(outPtr)
+    , m_InStride(inStride)
+    , m_OutStride(outStride)
+    {}
+    ~ConvertRepresentationBulk() = default;
+
+    /**
+     * @brief This is the main conversion routine
+     * @param start Starting index
+     * @param end Ending index
+     */
+    void convert(size_t start, size_t end) const
+    {
+      Converter conv;
+      conv(m_InPtr + (start * m_InStride), m_OutPtr + (start * m_OutStride), end - start);
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    T* m_InPtr = nullptr;
+    T* m_OutPtr = nullptr;
+    size_t m_InStride = 0;
+    size_t m_OutStride = 0;
+};
+
 /**
  * @brief OC_CONVERT_BODY Generates the body of method that will perform the conversion
  */
@@ -399,6 +471,30 @@ class ConvertRepresentation
   ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
   this->setOutputData(output);
 
+#define OC_CONVERT_BULK_BODY(INSTRIDE, OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
+  sanityCheckInputData();\
+  typename DataArray<T>::Pointer input = this->getInputData();\
+  T* inPtr = input->getPointer(0);\
+  size_t nTuples = this->getInputData()->getNumberOfTuples();\
+  int inStride = input->getNumberOfComponents();\
+  size_t outStride = OUTSTRIDE;\
+  QVector<size_t> cDims = {outStride};\
+  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
+  T* outPtr = output->getPointer(0); /* Every value is written by the conversion */\
+  tbb::task_scheduler_init init;\
+  if(inStride == INSTRIDE)\
+  {\
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples, BulkOrientationTransforms<T>::k_TileSize),\
+    ConvertRepresentationBulk<T, BulkConvertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
+  }\
+  else\
+  {\
+    output->initializeWithZeros(); /* Intialize the array with Zeros */\
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, nTuples),\
+    ConvertRepresentation<T, Convertors::FUNCTOR<T>>(inPtr, outPtr, inStride, outStride), tbb::auto_partitioner());\
+  }\
+  this->setOutputData(output);
+
 #else
 
 #define OC_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
@@ -416,6 +512,29 @@ class ConvertRepresentation
   serial.convert(0, nTuples);\
   this->setOutputData(output);
 
+#define OC_CONVERT_BULK_BODY(INSTRIDE, OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD, FUNCTOR)\
+  sanityCheckInputData();\
+  typename DataArray<T>::Pointer input = this->getInputData();\
+  T* inPtr = input->getPointer(0);\
+  size_t nTuples = this->getInputData()->getNumberOfTuples();\
+  int inStride = input->getNumberOfComponents();\
+  size_t outStride = OUTSTRIDE;\
+  QVector<size_t> cDims = {outStride}; /* Create the n component (nx1) based array.*/\
+  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
+  T* outPtr = output->getPointer(0); /* Every value is written by the conversion */\
+  if(inStride == INSTRIDE)\
+  {\
+    ConvertRepresentationBulk<T, BulkConvertors::FUNCTOR <T>> serial(inPtr, outPtr, inStride, outStride);\
+    serial.convert(0, nTuples);\
+  }\
+  else\
+  {\
+    output->initializeWithZeros(); /* Intialize the array with Zeros */\
+    ConvertRepresentation<T, Convertors::FUNCTOR <T>> serial(inPtr, outPtr, inStride, outStride);\
+    serial.convert(0, nTuples);\
+  }\
+  this->setOutputData(output);
+
 #endif
 
 
@@ -491,27 +610,27 @@ class EulerConverter : public OrientationConverter<T>
     
     virtual void toOrientationMatrix()
     {
-      OC_CONVERT_BODY(9, OrientationMatrix, eu2om, Eu2Om)
+      OC_CONVERT_BULK_BODY(3, 9, OrientationMatrix, eu2om, Eu2Om)
     }
     
     virtual void toQuaternion()
     {  
-      OC_CONVERT_BODY(4, Quaternion, eu2qu, Eu2Qu)      
+      OC_CONVERT_BULK_BODY(3, 4, Quaternion, eu2qu, Eu2Qu)      
     }
     
     virtual void toAxisAngle()
     {
-      OC_CONVERT_BODY(4, AxisAngle, eu2ax, Eu2Ax)
+      OC_CONVERT_BULK_BODY(3, 4, AxisAngle, eu2ax, Eu2Ax)
     }
     
     virtual void toRodrigues()
     {
-      OC_CONVERT_BODY(4, Rodrigues, eu2ro, Eu2Ro)
+      OC_CONVERT_BULK_BODY(3, 4, Rodrigues, eu2ro, Eu2Ro)
     }
     
     virtual void toHomochoric()
     {
-      OC_CONVERT_BODY(3, Homochoric, eu2ho, Eu2Ho)
+      OC_CONVERT_BULK_BODY(3, 3, Homochoric, eu2ho, Eu2Ho)
     }
     
     virtual void toCubochoric()
@@ -834,12 +953,12 @@ class QuaternionConverter : public OrientationConverter<T>
     
     virtual void toEulers()
     {
-      OC_CONVERT_BODY(3, Eulers, qu2eu, Qu2Eu)
+      OC_CONVERT_BULK_BODY(4, 3, Eulers, qu2eu, Qu2Eu)
     }
     
     virtual void toOrientationMatrix()
     {
-      OC_CONVERT_BODY(9, OrientationMatrix, qu2om, Qu2Om)
+      OC_CONVERT_BULK_BODY(4, 9, OrientationMatrix, qu2om, Qu2Om)
     }
     
     virtual void toQuaternion()
@@ -0,0 +1,350 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#include <iostream>
+#endif
+
+#include "SIMPLib/Math/QuaternionMath.hpp"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/PoleFigureAccumulator.h"
+#include "OrientationLib/Utilities/StereographicLookupTable.h"
+
+#include "UnitTestSupport.hpp"
+
+class LaueOpsTest
+{
+public:
+  LaueOpsTest()
+  {
+  }
+  virtual ~LaueOpsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CreateRandomQuats(size_t count, std::vector<QuatF>& quats)
+  {
+    std::mt19937_64 generator(5489u);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    quats.resize(count);
+    for(size_t i = 0; i < count; i++)
+    {
+      QuatF& q = quats[i];
+      q.x = distribution(generator);
+      q.y = distribution(generator);
+      q.z = distribution(generator);
+      q.w = distribution(generator);
+      QuaternionMathF::UnitQuaternion(q);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Straight forward version of the misorientation search that tries every
+  // symmetry operator and converts each result to axis-angle. This is what the
+  // LaueOps classes used to do for every pair and is kept here as the reference.
+  // -----------------------------------------------------------------------------
+  float ReferenceMisoAngle(LaueOps::Pointer ops, QuatF& q1, QuatF& q2)
+  {
+    typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformsType;
+    float wmin = 9999999.0f;
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f, w = 0.0f;
+    QuatF qr;
+    QuatF qc;
+    QuatF q2inv;
+    QuatF sym;
+    QuaternionMathF::Copy(q2, q2inv);
+    QuaternionMathF::Conjugate(q2inv);
+    QuaternionMathF::Multiply(q1, q2inv, qr);
+    for(int i = 0; i < ops->getNumSymOps(); i++)
+    {
+      ops->getQuatSymOp(i, sym);
+      QuaternionMathF::Multiply(sym, qr, qc);
+      if(qc.w < -1)
+      {
+        qc.w = -1;
+      }
+      else if(qc.w > 1)
+      {
+        qc.w = 1;
+      }
+      FOrientArrayType ax(4, 0.0f);
+      OrientationTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
+      ax.toAxisAngle(n1, n2, n3, w);
+      if(w > SIMPLib::Constants::k_Pi)
+      {
+        w = SIMPLib::Constants::k_2Pi - w;
+      }
+      if(w < wmin)
+      {
+        wmin = w;
+      }
+    }
+    return wmin;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestMisoQuatBatch()
+  {
+    const size_t numPairs = 2000;
+    std::vector<QuatF> q1s;
+    std::vector<QuatF> q2s;
+    CreateRandomQuats(numPairs * 2, q1s);
+    q2s.assign(q1s.begin() + numPairs, q1s.end());
+    q1s.resize(numPairs);
+    // Identical orientations must give a zero angle and the default axis
+    q1s[0] = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 1.0f);
+    q2s[0] = q1s[0];
+
+    std::vector<float> angles(numPairs, -1.0f);
+    std::vector<float> axes(numPairs * 3, 0.0f);
+    std::vector<float> anglesOnly(numPairs, -1.0f);
+
+    // One table serves every Laue class, the same way WritePoleFigure shares it between phases
+    StereographicLookupTable::Pointer sharedTable = StereographicLookupTable::New(imageDim, 32, 1.0f);
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsVector();
+    for(size_t o = 0; o < orientationOps.size(); o++)
+    {
+      LaueOps::Pointer ops = orientationOps[o];
+      ops->getMisoQuatBatch(q1s.data(), q2s.data(), numPairs, angles.data(), axes.data());
+      ops->getMisoQuatBatch(q1s.data(), q2s.data(), numPairs, anglesOnly.data(), nullptr);
+
+      DREAM3D_REQUIRE_EQUAL(angles[0], 0.0f)
+      DREAM3D_REQUIRE_EQUAL(axes[2], 1.0f)
+
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+        QuatF q1 = q1s[i];
+        QuatF q2 = q2s[i];
+        float w = ops->getMisoQuat(q1, q2, n1, n2, n3);
+        DREAM3D_REQUIRE_EQUAL(angles[i], w)
+        DREAM3D_REQUIRE_EQUAL(anglesOnly[i], w)
+        DREAM3D_REQUIRE_EQUAL(axes[i * 3], n1)
+        DREAM3D_REQUIRE_EQUAL(axes[i * 3 + 1], n2)
+        DREAM3D_REQUIRE_EQUAL(axes[i * 3 + 2], n3)
+
+        // The generic kernel picks the same operator and runs the same final
+        // product as the search over all operators, so its angle is identical.
+        // The cubic closed form sorts the product instead and was never exact
+        // against the search; it differs by up to about 3e-5 rad for nearly
+        // identical orientations where acos is poorly conditioned.
+        float refW = ReferenceMisoAngle(ops, q1, q2);
+        if(ops->getNameOfClass() == "CubicOps")
+        {
+          DREAM3D_REQUIRE(std::fabs(refW - w) < 1.0E-4f)
+        }
+        else
+        {
+          DREAM3D_REQUIRE_EQUAL(refW, w)
+        }
+
+        float axisLength = n1 * n1 + n2 * n2 + n3 * n3;
+        DREAM3D_REQUIRE(std::fabs(axisLength - 1.0f) < 1.0E-4f)
+      }
+    }
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  // Times the per pair search over all operators, the per pair getMisoQuat and
+  // the batched kernel for every Laue class
+  // -----------------------------------------------------------------------------
+  void BenchmarkMisoQuatBatch()
+  {
+    const size_t numPairs = 200000;
+    std::vector<QuatF> q1s;
+    std::vector<QuatF> q2s;
+    CreateRandomQuats(numPairs * 2, q1s);
+    q2s.assign(q1s.begin() + numPairs, q1s.end());
+    q1s.resize(numPairs);
+
+    std::vector<float> angles(numPairs, 0.0f);
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsVector();
+    for(size_t o = 0; o < orientationOps.size(); o++)
+    {
+      LaueOps::Pointer ops = orientationOps[o];
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      float refSum = 0.0f;
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        refSum += ReferenceMisoAngle(ops, q1s[i], q2s[i]);
+      }
+      double refSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      start = std::chrono::steady_clock::now();
+      float pairSum = 0.0f;
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        pairSum += ops->getMisoQuat(q1s[i], q2s[i], n1, n2, n3);
+      }
+      double pairSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      start = std::chrono::steady_clock::now();
+      ops->getMisoQuatBatch(q1s.data(), q2s.data(), numPairs, angles.data(), nullptr);
+      double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+      float batchSum = 0.0f;
+      for(size_t i = 0; i < numPairs; i++)
+      {
+        batchSum += angles[i];
+      }
+      DREAM3D_REQUIRE_EQUAL(pairSum, batchSum)
+      DREAM3D_REQUIRE(std::fabs(refSum - batchSum) / numPairs < 1.0E-4f)
+
+      std::cout << ops->getSymmetryName().toStdString() << ": " << numPairs / refSeconds << " pairs/s (search over operators), " << numPairs / pairSeconds
+                << " pairs/s (getMisoQuat), " << numPairs / batchSeconds << " pairs/s (batch)" << std::endl;
+    }
+  }
+#endif
+
+  // -----------------------------------------------------------------------------
+  // The streamed pole figure intensities must match the ones computed from the
+  // fully materialized sphere coordinates for every Laue class and both modes,
+  // whether the accumulator builds its own lookup table or is handed one.
+  // -----------------------------------------------------------------------------
+  void TestPoleFigureAccumulator()
+  {
+    const size_t numOrientations = 5003;
+    const int imageDim = 64;
+    QVector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(numOrientations, cDims, "Eulers");
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < numOrientations; i++)
+    {
+      float* eu = eulers->getPointer(i * 3);
+      eu[0] = distribution(generator) * SIMPLib::Constants::k_2Pi;
+      eu[1] = std::acos(2.0f * distribution(generator) - 1.0f);
+      eu[2] = distribution(generator) * SIMPLib::Constants::k_2Pi;
+    }
+
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsVector();
+    for(size_t o = 0; o < orientationOps.size(); o++)
+    {
+      LaueOps::Pointer ops = orientationOps[o];
+      for(int discrete = 0; discrete < 2; discrete++)
+      {
+        PoleFigureConfiguration_t config;
+        config.eulers = eulers.get();
+        config.imageDim = imageDim;
+        config.lambertDim = 32;
+        config.sphereRadius = 1.0f;
+        config.discrete = (discrete == 1);
+
+        std::vector<FloatArrayType::Pointer> coords(3);
+        std::vector<DoubleArrayType::Pointer> reference(3);
+        std::vector<DoubleArrayType::Pointer> streamed(3);
+        std::vector<DoubleArrayType::Pointer> shared(3);
+        for(int f = 0; f < 3; f++)
+        {
+          coords[f] = FloatArrayType::CreateArray(0, cDims, "xyzCoords");
+          reference[f] = DoubleArrayType::CreateArray(imageDim * imageDim, "Reference_Intensity");
+          streamed[f] = DoubleArrayType::CreateArray(imageDim * imageDim, "Streamed_Intensity");
+          shared[f] = DoubleArrayType::CreateArray(imageDim * imageDim, "Shared_Table_Intensity");
+        }
+        ops->generateSphereCoordsFromEulers(eulers.get(), coords[0].get(), coords[1].get(), coords[2].get());
+        for(int f = 0; f < 3; f++)
+        {
+          DREAM3D_REQUIRE(coords[f]->getNumberOfTuples() % numOrientations == 0)
+          ComputeStereographicProjection projection(coords[f].get(), &config, reference[f].get());
+          projection();
+        }
+
+        // An odd block size leaves a partial block at the end
+        PoleFigureAccumulator::Execute(ops.get(), &config, streamed[0].get(), streamed[1].get(), streamed[2].get(), 97);
+        config.stereoTable = sharedTable.get();
+        PoleFigureAccumulator::Execute(ops.get(), &config, shared[0].get(), shared[1].get(), shared[2].get(), 97);
+
+        // The discrete images are whole counts, so the order in which the threads are joined does not matter.
+        // The Lambert squares hold bilinear weights that the threads add up in a different order than the
+        // single pass reference, so those agree to within the rounding of summing about 60000 doubles.
+        for(int f = 0; f < 3; f++)
+        {
+          DREAM3D_REQUIRE_EQUAL(streamed[f]->getNumberOfTuples(), reference[f]->getNumberOfTuples())
+          DREAM3D_REQUIRE_EQUAL(shared[f]->getNumberOfTuples(), reference[f]->getNumberOfTuples())
+          for(size_t i = 0; i < reference[f]->getNumberOfTuples(); i++)
+          {
+            double ref = reference[f]->getValue(i);
+            double value = streamed[f]->getValue(i);
+            double sharedValue = shared[f]->getValue(i);
+            if(config.discrete)
+            {
+              DREAM3D_REQUIRE_EQUAL(value, ref)
+              DREAM3D_REQUIRE_EQUAL(sharedValue, ref)
+            }
+            else
+            {
+              DREAM3D_REQUIRE(std::fabs(ref - value) <= 1.0E-9 * std::max(1.0, std::fabs(ref)))
+              DREAM3D_REQUIRE(std::fabs(ref - sharedValue) <= 1.0E-9 * std::max(1.0, std::fabs(ref)))
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestMisoQuatBatch())
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(BenchmarkMisoQuatBatch())
+#endif
+    DREAM3D_REGISTER_TEST(TestPoleFigureAccumulator())
+  }
+
+private:
+  LaueOpsTest(const LaueOpsTest&);    // Copy Constructor Not Implemented
+  void operator=(const LaueOpsTest&); // Move assignment Not Implemented
+};
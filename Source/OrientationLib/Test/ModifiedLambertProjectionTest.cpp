@@ -0,0 +1,171 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+#include "OrientationLib/Utilities/StereographicLookupTable.h"
+
+#include "UnitTestSupport.hpp"
+
+class ModifiedLambertProjectionTest
+{
+public:
+  ModifiedLambertProjectionTest()
+  {
+  }
+  virtual ~ModifiedLambertProjectionTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  ModifiedLambertProjection::Pointer CreateRandomProjection(int lambertDim, size_t numPoints)
+  {
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+    lambert->initializeSquares(lambertDim, 1.0f);
+
+    std::mt19937_64 generator(5489u);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    for(size_t i = 0; i < numPoints; i++)
+    {
+      float xyz[3] = {distribution(generator), distribution(generator), distribution(generator)};
+      float length = std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2]);
+      xyz[0] /= length;
+      xyz[1] /= length;
+      xyz[2] /= length;
+      lambert->addSphereCoords(xyz, 1);
+    }
+    lambert->normalizeSquaresToMRD();
+    return lambert;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Projects every pixel back onto the sphere and interpolates the squares. This
+  // is what createStereographicProjection did before the lookup table was added.
+  // -----------------------------------------------------------------------------
+  DoubleArrayType::Pointer ReferenceStereographicProjection(ModifiedLambertProjection* lambert, int dim)
+  {
+    DoubleArrayType::Pointer stereoIntensity = DoubleArrayType::CreateArray(dim * dim, "Reference");
+    stereoIntensity->initializeWithZeros();
+    double* intensity = stereoIntensity->getPointer(0);
+
+    int halfDim = dim / 2;
+    float res = 2.0 / (float)(dim);
+    float sqCoord[2];
+    float xyz[3];
+    for(int64_t y = 0; y < dim; y++)
+    {
+      for(int64_t x = 0; x < dim; x++)
+      {
+        float xtmp = float(x - halfDim) * res + (res * 0.5);
+        float ytmp = float(y - halfDim) * res + (res * 0.5);
+        int index = y * dim + x;
+        if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+        {
+          xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+          xyz[0] = xtmp * (1 + xyz[2]);
+          xyz[1] = ytmp * (1 + xyz[2]);
+          for(int64_t m = 0; m < 2; m++)
+          {
+            if(m == 1)
+            {
+              MatrixMath::Multiply3x1withConstant(xyz, -1.0);
+            }
+            if(lambert->getSquareCoord(xyz, sqCoord))
+            {
+              intensity[index] += lambert->getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
+            }
+            else
+            {
+              intensity[index] += lambert->getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
+            }
+          }
+          intensity[index] = intensity[index] * 0.5;
+        }
+      }
+    }
+    return stereoIntensity;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestStereographicLookupTable()
+  {
+    int lambertDims[3] = {16, 64, 73};
+    int imageDims[5] = {1, 2, 31, 128, 257};
+    for(int l = 0; l < 3; l++)
+    {
+      ModifiedLambertProjection::Pointer lambert = CreateRandomProjection(lambertDims[l], 20000);
+      for(int i = 0; i < 5; i++)
+      {
+        int dim = imageDims[i];
+        DoubleArrayType::Pointer reference = ReferenceStereographicProjection(lambert.get(), dim);
+        DoubleArrayType::Pointer projection = lambert->createStereographicProjection(dim);
+
+        // A table built by the caller can be reused for several projections of the same size
+        StereographicLookupTable::Pointer table = StereographicLookupTable::New(dim, lambertDims[l], 1.0f);
+        DREAM3D_REQUIRE_EQUAL(table->getImageDimension(), dim)
+        DREAM3D_REQUIRE_EQUAL(table->getLambertDimension(), lambertDims[l])
+        DoubleArrayType::Pointer shared = DoubleArrayType::CreateArray(dim * dim, "Shared");
+        lambert->createStereographicProjection(table.get(), shared.get());
+        lambert->createStereographicProjection(table.get(), shared.get());
+
+        DREAM3D_REQUIRE_EQUAL(projection->getNumberOfTuples(), reference->getNumberOfTuples())
+        for(size_t p = 0; p < reference->getNumberOfTuples(); p++)
+        {
+          DREAM3D_REQUIRE_EQUAL(projection->getValue(p), reference->getValue(p))
+          DREAM3D_REQUIRE_EQUAL(shared->getValue(p), reference->getValue(p))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestStereographicLookupTable())
+  }
+
+private:
+  ModifiedLambertProjectionTest(const ModifiedLambertProjectionTest&); // Copy Constructor Not Implemented
+  void operator=(const ModifiedLambertProjectionTest&);                // Move assignment Not Implemented
+};
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#endif
 #include <complex>
 #include <iomanip>
 #include <iostream>
@@ -36,6 +39,7 @@ using namespace SIMPLib::Constants;
 
 #include "OrientationLib/Test/OrientationLibTestFileLocations.h"
 
+#include "HeapOrientationArray.h"
 #include "TestPrintFunctions.h"
 
 class OrientationArrayTest
@@ -1090,10 +1094,161 @@ Orientation Matrix               : | -1.0000   0.0000   0.0000 |
     std::cout << "vg: " << vg[0] << "," << vg[1] << "," << vg[2] << std::endl;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestInlineStorage()
+  {
+    // Every representation fits in the inline buffer
+    FOrientArrayType om(9, 1.0f);
+    DREAM3D_REQUIRE_EQUAL(om.size(), 9)
+    DREAM3D_REQUIRE(om.data() >= reinterpret_cast<float*>(&om) && om.data() < reinterpret_cast<float*>(&om + 1))
+
+    // Copies get their own buffer
+    FOrientArrayType copy(om);
+    copy[0] = 2.0f;
+    DREAM3D_REQUIRE(copy.data() != om.data())
+    DREAM3D_REQUIRE_EQUAL(om[0], 1.0f)
+    DREAM3D_REQUIRE_EQUAL(copy[8], 1.0f)
+
+    // Assigning between sizes, growing onto the heap and shrinking back keeps the values
+    FOrientArrayType ro(4, 3.0f);
+    copy = ro;
+    DREAM3D_REQUIRE_EQUAL(copy.size(), 4)
+    DREAM3D_REQUIRE_EQUAL(copy[3], 3.0f)
+    copy.resize(16);
+    DREAM3D_REQUIRE(copy.data() < reinterpret_cast<float*>(&copy) || copy.data() >= reinterpret_cast<float*>(&copy + 1))
+    copy[15] = 5.0f;
+    DREAM3D_REQUIRE_EQUAL(copy[2], 3.0f)
+    FOrientArrayType big(copy);
+    DREAM3D_REQUIRE_EQUAL(big[15], 5.0f)
+    copy.resize(3);
+    DREAM3D_REQUIRE_EQUAL(copy.size(), 3)
+    DREAM3D_REQUIRE_EQUAL(copy[2], 3.0f)
+    DREAM3D_REQUIRE(copy.data() >= reinterpret_cast<float*>(&copy) && copy.data() < reinterpret_cast<float*>(&copy + 1))
+
+    // Wrapped arrays are written through
+    float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    FOrientArrayType wrapped(values, 4);
+    wrapped = ro;
+    DREAM3D_REQUIRE_EQUAL(values[1], 3.0f)
+
+    // The fixed size types go straight into the transforms and match the runtime sized type
+    FEuler3Type eu(0.5f, 1.2f, 2.3f);
+    FRod4Type rod;
+    FOM9Type omf;
+    OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
+    OrientationTransforms<FOrientArrayType, float>::eu2om(eu, omf);
+    FOrientArrayType euRef(0.5f, 1.2f, 2.3f);
+    FOrientArrayType rodRef(4), omRef(9);
+    OrientationTransforms<FOrientArrayType, float>::eu2ro(euRef, rodRef);
+    OrientationTransforms<FOrientArrayType, float>::eu2om(euRef, omRef);
+    for(size_t i = 0; i < 4; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(rod[i], rodRef[i])
+    }
+    for(size_t i = 0; i < 9; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(omf[i], omRef[i])
+    }
+    rod = rodRef;
+    DREAM3D_REQUIRE_EQUAL(rod.size(), 4)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> float ConvertAndBin(const std::vector<float>& eulers, size_t count)
+  {
+    float sum = 0.0f;
+    for(size_t i = 0; i < count; i++)
+    {
+      T eu(3);
+      eu[0] = eulers[3 * i];
+      eu[1] = eulers[3 * i + 1];
+      eu[2] = eulers[3 * i + 2];
+      T rod(4);
+      T ho(3);
+      OrientationTransforms<T, float>::eu2ro(eu, rod);
+      OrientationTransforms<T, float>::ro2ho(rod, ho);
+      sum += ho[0] + ho[1] + ho[2];
+    }
+    return sum;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CreateBenchmarkEulers(size_t count, std::vector<float>& eulers)
+  {
+    eulers.resize(count * 3);
+    for(size_t i = 0; i < count; i++)
+    {
+      eulers[3 * i] = static_cast<float>(i % 628) * 0.01f;
+      eulers[3 * i + 1] = static_cast<float>(i % 314) * 0.01f;
+      eulers[3 * i + 2] = static_cast<float>(i % 613) * 0.01f;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestInlineMatchesHeapStorage()
+  {
+    const size_t count = 20000;
+    std::vector<float> eulers;
+    CreateBenchmarkEulers(count, eulers);
+
+    float heapSum = ConvertAndBin<HeapOrientationArray<float>>(eulers, count);
+    float inlineSum = ConvertAndBin<FOrientArrayType>(eulers, count);
+    DREAM3D_REQUIRE_EQUAL(heapSum, inlineSum)
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> double BestOrientationsPerSecond(const std::vector<float>& eulers, size_t count, float& sum)
+  {
+    double best = 0.0;
+    for(int run = 0; run < 5; run++)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      sum = ConvertAndBin<T>(eulers, count);
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      best = std::max(best, count / seconds);
+    }
+    return best;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void BenchmarkInlineStorage()
+  {
+    const size_t count = 1000000;
+    std::vector<float> eulers;
+    CreateBenchmarkEulers(count, eulers);
+
+    float heapSum = 0.0f;
+    float inlineSum = 0.0f;
+    double heapRate = BestOrientationsPerSecond<HeapOrientationArray<float>>(eulers, count, heapSum);
+    double inlineRate = BestOrientationsPerSecond<FOrientArrayType>(eulers, count, inlineSum);
+    DREAM3D_REQUIRE_EQUAL(heapSum, inlineSum)
+    std::cout << "eu2ro + ro2ho: " << heapRate << " orientations/s (heap OrientationArray), " << inlineRate << " orientations/s (inline OrientationArray), "
+              << inlineRate / heapRate << "x" << std::endl;
+  }
+#endif
+
   void operator()()
   {
     int err = EXIT_SUCCESS;
     DREAM3D_REGISTER_TEST(TestRotArray());
+    DREAM3D_REGISTER_TEST(TestInlineStorage());
+    DREAM3D_REGISTER_TEST(TestInlineMatchesHeapStorage());
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(BenchmarkInlineStorage());
+#endif
     DREAM3D_REGISTER_TEST(Test_eu_check());
     DREAM3D_REGISTER_TEST(Test_ro_check());
     DREAM3D_REGISTER_TEST(Test_ho_check());
@@ -35,8 +35,13 @@
 
 #include <stdio.h>
 
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#endif
 #include <iomanip>
 #include <iostream>
+#include <random>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -186,11 +191,159 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> std::vector<T> CreateBulkEulers(size_t count)
+  {
+    std::mt19937_64 generator(23);
+    std::uniform_real_distribution<T> distribution(0.0, 1.0);
+    std::vector<T> eulers(count * 3);
+    for(size_t i = 0; i < count; i++)
+    {
+      eulers[i * 3] = distribution(generator) * SIMPLib::Constants::k_2Pi;
+      eulers[i * 3 + 1] = distribution(generator) * SIMPLib::Constants::k_Pi;
+      eulers[i * 3 + 2] = distribution(generator) * SIMPLib::Constants::k_2Pi;
+    }
+    // Sprinkle in the special cases that the scalar transforms handle with branches
+    T specials[7][3] = {{0.0, 0.0, 0.0},
+                        {1.0, 0.0, 1.0},
+                        {0.5, 0.0, 0.0},
+                        {static_cast<T>(SIMPLib::Constants::k_PiOver2), 1.0, static_cast<T>(SIMPLib::Constants::k_PiOver2)},
+                        {1.0, static_cast<T>(SIMPLib::Constants::k_Pi), 2.0},
+                        {0.0, static_cast<T>(SIMPLib::Constants::k_Pi), 0.0},
+                        {3.0, 0.0, static_cast<T>(SIMPLib::Constants::k_2Pi - 3.0)}};
+    for(size_t s = 0; s < 7; s++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        eulers[(s * 97 + 5) * 3 + c] = specials[s][c];
+      }
+    }
+    return eulers;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T, class ScalarConverter, class BulkConverter>
+  void CompareBulkConversion(std::vector<T>& input, size_t inStride, size_t outStride, T tolerance, bool rodrigues = false)
+  {
+    size_t count = input.size() / inStride;
+    std::vector<T> scalar(count * outStride, 0.0);
+    std::vector<T> bulk(count * outStride, 0.0);
+    ConvertRepresentation<T, ScalarConverter>(input.data(), scalar.data(), inStride, outStride).convert(0, count);
+    ConvertRepresentationBulk<T, BulkConverter>(input.data(), bulk.data(), inStride, outStride).convert(0, count);
+
+    for(size_t i = 0; i < count * outStride; i++)
+    {
+      T a = scalar[i];
+      T b = bulk[i];
+      if(rodrigues && i % outStride == 3)
+      {
+        // tan(w/2) is ill conditioned close to w = Pi so compare the rotation angles instead
+        a = 2.0 * atan(a);
+        b = 2.0 * atan(b);
+      }
+      DREAM3D_REQUIRE(std::fabs(a - b) <= tolerance)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void TestBulkConversions(T tolerance)
+  {
+    const size_t count = 10007; // Not a multiple of the tile size
+    std::vector<T> eulers = CreateBulkEulers<T>(count);
+
+    CompareBulkConversion<T, Convertors::Eu2Om<T>, BulkConvertors::Eu2Om<T>>(eulers, 3, 9, tolerance);
+    CompareBulkConversion<T, Convertors::Eu2Qu<T>, BulkConvertors::Eu2Qu<T>>(eulers, 3, 4, tolerance);
+    CompareBulkConversion<T, Convertors::Eu2Ax<T>, BulkConvertors::Eu2Ax<T>>(eulers, 3, 4, tolerance);
+    CompareBulkConversion<T, Convertors::Eu2Ro<T>, BulkConvertors::Eu2Ro<T>>(eulers, 3, 4, tolerance, true);
+    CompareBulkConversion<T, Convertors::Eu2Ho<T>, BulkConvertors::Eu2Ho<T>>(eulers, 3, 3, tolerance);
+
+    std::vector<T> quats(count * 4, 0.0);
+    ConvertRepresentation<T, Convertors::Eu2Qu<T>>(eulers.data(), quats.data(), 3, 4).convert(0, count);
+    // Quaternions that take the degenerate branches of qu2eu
+    T specials[5][4] = {{0.0, 0.0, 0.0, 1.0}, {0.0, 0.0, 1.0, 0.0}, {1.0, 0.0, 0.0, 0.0}, {0.6, 0.8, 0.0, 0.0}, {0.0, 0.0, -0.6, 0.8}};
+    for(size_t s = 0; s < 5; s++)
+    {
+      for(size_t c = 0; c < 4; c++)
+      {
+        quats[(s * 89 + 3) * 4 + c] = specials[s][c];
+      }
+    }
+    CompareBulkConversion<T, Convertors::Qu2Om<T>, BulkConvertors::Qu2Om<T>>(quats, 4, 9, tolerance);
+    CompareBulkConversion<T, Convertors::Qu2Eu<T>, BulkConvertors::Qu2Eu<T>>(quats, 4, 3, tolerance);
+
+    // The converter classes pick the bulk path for packed input
+    typename DataArray<T>::Pointer input = DataArray<T>::CreateArray(count, QVector<size_t>(1, 3), "Eulers");
+    std::copy(eulers.begin(), eulers.end(), input->getPointer(0));
+    typename EulerConverter<T>::Pointer converter = EulerConverter<T>::New();
+    converter->setInputData(input);
+    converter->toQuaternion();
+    typename DataArray<T>::Pointer output = converter->getOutputData();
+    DREAM3D_REQUIRE_EQUAL(output->getNumberOfComponents(), 4)
+    // The converter wraps the Euler angles in place before converting them
+    ConvertRepresentation<T, Convertors::Eu2Qu<T>>(input->getPointer(0), quats.data(), 3, 4).convert(0, count);
+    for(size_t i = 0; i < count * 4; i++)
+    {
+      DREAM3D_REQUIRE(std::fabs(output->getValue(i) - quats[i]) <= tolerance)
+    }
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T, class ScalarConverter, class BulkConverter>
+  void BenchmarkBulkConversion(const std::string& name, std::vector<T>& input, size_t inStride, size_t outStride)
+  {
+    size_t count = input.size() / inStride;
+    std::vector<T> output(count * outStride, 0.0);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ConvertRepresentation<T, ScalarConverter>(input.data(), output.data(), inStride, outStride).convert(0, count);
+    double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ConvertRepresentationBulk<T, BulkConverter>(input.data(), output.data(), inStride, outStride).convert(0, count);
+    double bulkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << name << ": " << count / scalarSeconds << " orientations/s (scalar), " << count / bulkSeconds << " orientations/s (bulk)" << std::endl;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void BenchmarkBulkConversions()
+  {
+    const size_t count = 2000000;
+    std::vector<float> eulers = CreateBulkEulers<float>(count);
+    std::vector<float> quats(count * 4, 0.0f);
+    ConvertRepresentation<float, Convertors::Eu2Qu<float>>(eulers.data(), quats.data(), 3, 4).convert(0, count);
+
+    BenchmarkBulkConversion<float, Convertors::Eu2Om<float>, BulkConvertors::Eu2Om<float>>("eu2om", eulers, 3, 9);
+    BenchmarkBulkConversion<float, Convertors::Eu2Qu<float>, BulkConvertors::Eu2Qu<float>>("eu2qu", eulers, 3, 4);
+    BenchmarkBulkConversion<float, Convertors::Eu2Ax<float>, BulkConvertors::Eu2Ax<float>>("eu2ax", eulers, 3, 4);
+    BenchmarkBulkConversion<float, Convertors::Eu2Ro<float>, BulkConvertors::Eu2Ro<float>>("eu2ro", eulers, 3, 4);
+    BenchmarkBulkConversion<float, Convertors::Eu2Ho<float>, BulkConvertors::Eu2Ho<float>>("eu2ho", eulers, 3, 3);
+    BenchmarkBulkConversion<float, Convertors::Qu2Om<float>, BulkConvertors::Qu2Om<float>>("qu2om", quats, 4, 9);
+    BenchmarkBulkConversion<float, Convertors::Qu2Eu<float>, BulkConvertors::Qu2Eu<float>>("qu2eu", quats, 4, 3);
+  }
+#endif
+
   void operator()()
   {
     int err = 0;
     DREAM3D_REGISTER_TEST(TestEulerConversion());
     DREAM3D_REGISTER_TEST(TestFilterDesign());
+    DREAM3D_REGISTER_TEST(TestBulkConversions<float>(2.0E-6f));
+    DREAM3D_REGISTER_TEST(TestBulkConversions<double>(1.0E-12));
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(BenchmarkBulkConversions());
+#endif
   }
 
 private:
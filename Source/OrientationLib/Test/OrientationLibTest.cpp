@@ -8,6 +8,7 @@
 #include "IPFLegendTest.cpp"
 #include "SO3SamplerTest.cpp"
 #include "OrientationTransformsTest.cpp"
+#include "LaueOpsTest.cpp"
 
 
 
@@ -40,6 +41,7 @@ int main(int argc, char** argv)
   IPFLegendTest()();
   SO3SamplerTest()();
   OrientationTransformsTest()();
+  LaueOpsTest()();
 
   return err;
 }
@@ -30,6 +30,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <vector>
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLib.h"
 #include "UnitTestSupport.hpp"
@@ -75,6 +77,107 @@ public:
     DREAM3D_REQUIRE_EQUAL(333227, orientations.size());
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void TestContiguousSampling(const SO3Sampler::CubochoricGrid& grid, int pgnum)
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+
+    // reference: every FZ point of the grid in the serial loop order
+    std::vector<double> expected;
+    sampler->VisitRFZ(grid, pgnum, [&expected](const double* rod) { expected.insert(expected.end(), rod, rod + 4); });
+    size_t count = expected.size() / 4;
+
+    SO3Sampler::RFZSlabs slabs;
+    size_t total = sampler->CountRFZ(grid, pgnum, slabs);
+    DREAM3D_REQUIRE_EQUAL(total, count)
+    DREAM3D_REQUIRE_EQUAL(slabs.offsets.size(), static_cast<size_t>(grid.last - grid.first + 2))
+    DREAM3D_REQUIRE_EQUAL(slabs.offsets.front(), 0)
+    DREAM3D_REQUIRE_EQUAL(slabs.offsets.back(), count)
+
+    // counting in groups of slabs with a progress callback gives the same slabs
+    SO3Sampler::RFZSlabs chunkedSlabs;
+    size_t lastSlabsDone = 0;
+    size_t lastInsideFZ = 0;
+    size_t chunkedTotal = sampler->CountRFZ(grid, pgnum, chunkedSlabs, [&](size_t slabsDone, size_t insideFZ) {
+      DREAM3D_REQUIRE(slabsDone > lastSlabsDone)
+      DREAM3D_REQUIRE(insideFZ >= lastInsideFZ)
+      lastSlabsDone = slabsDone;
+      lastInsideFZ = insideFZ;
+      return true;
+    });
+    DREAM3D_REQUIRE_EQUAL(chunkedTotal, total)
+    DREAM3D_REQUIRE_EQUAL(lastSlabsDone, slabs.cells.size())
+    DREAM3D_REQUIRE_EQUAL(lastInsideFZ, total)
+    DREAM3D_REQUIRE(chunkedSlabs.offsets == slabs.offsets)
+    DREAM3D_REQUIRE(chunkedSlabs.cells == slabs.cells)
+
+    // stopping after the first group of slabs leaves nothing to sample
+    size_t calls = 0;
+    size_t stoppedTotal = sampler->CountRFZ(grid, pgnum, chunkedSlabs, [&calls](size_t, size_t) {
+      calls++;
+      return false;
+    });
+    DREAM3D_REQUIRE_EQUAL(calls, 1)
+    DREAM3D_REQUIRE_EQUAL(stoppedTotal, 0)
+    DREAM3D_REQUIRE_EQUAL(chunkedSlabs.offsets.size(), 1)
+    DREAM3D_REQUIRE_EQUAL(chunkedSlabs.cells.size(), 0)
+
+    std::vector<double> rods(total * 4, -1.0);
+    sampler->SampleRFZRodrigues(grid, slabs, rods.data());
+    for(size_t i = 0; i < rods.size(); i++)
+    {
+      DREAM3D_REQUIRE(rods[i] == expected[i])
+    }
+
+    std::vector<float> eulers(total * 3, -1.0f);
+    sampler->SampleRFZEulers(grid, slabs, eulers.data());
+    for(size_t i = 0; i < total; i++)
+    {
+      DOrientArrayType rod(expected[i * 4], expected[i * 4 + 1], expected[i * 4 + 2], expected[i * 4 + 3]);
+      DOrientArrayType eu(3);
+      OrientationTransformsType::ro2eu(rod, eu);
+      DREAM3D_REQUIRE(eulers[i * 3] == static_cast<float>(eu[0]))
+      DREAM3D_REQUIRE(eulers[i * 3 + 1] == static_cast<float>(eu[1]))
+      DREAM3D_REQUIRE(eulers[i * 3 + 2] == static_cast<float>(eu[2]))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SO3ContiguousSamplingTest()
+  {
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+
+    // the list based sampler and the contiguous sampler must agree point for point
+    SO3Sampler::OrientationListArrayType orientations = sampler->SampleRFZ(10, 32);
+    SO3Sampler::RFZSlabs slabs;
+    size_t total = sampler->CountRFZ(SO3Sampler::RFZGrid(10), 32, slabs);
+    DREAM3D_REQUIRE_EQUAL(total, orientations.size())
+    std::vector<double> rods(total * 4);
+    sampler->SampleRFZRodrigues(SO3Sampler::RFZGrid(10), slabs, rods.data());
+    size_t index = 0;
+    for(const DOrientArrayType& rod : orientations)
+    {
+      for(size_t c = 0; c < 4; c++)
+      {
+        DREAM3D_REQUIRE(rods[index * 4 + c] == rod[c])
+      }
+      index++;
+    }
+
+    // one point group per FZ type, on the plain and the dictionary grids
+    const int pointGroups[6] = {1, 3, 12, 27, 28, 32};
+    for(int pgnum : pointGroups)
+    {
+      TestContiguousSampling(SO3Sampler::RFZGrid(12), pgnum);
+      TestContiguousSampling(SO3Sampler::DictionaryGrid(12, false), pgnum);
+      TestContiguousSampling(SO3Sampler::DictionaryGrid(12, true), pgnum);
+    }
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -133,6 +236,7 @@ public:
     DREAM3D_REGISTER_TEST(InsideCubicFZTest())
     DREAM3D_REGISTER_TEST(TestPyramid())
     DREAM3D_REGISTER_TEST(SO3CountTest())
+    DREAM3D_REGISTER_TEST(SO3ContiguousSamplingTest())
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
 
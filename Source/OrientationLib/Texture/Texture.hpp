@@ -100,8 +100,8 @@ public:
 
     for(size_t i = 0; i < numEntries; i++)
     {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
+      FEuler3Type eu(e1s[i], e2s[i], e3s[i]);
+      FRod4Type rod;
       OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
 
       rod = ops.getODFFZRod(rod);
@@ -237,8 +237,8 @@ public:
     HexagonalOps ops;
     for(size_t i = 0; i < numEntries; i++)
     {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
+      FEuler3Type eu(e1s[i], e2s[i], e3s[i]);
+      FRod4Type rod;
       OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
 
       rod = ops.getODFFZRod(rod);
@@ -374,8 +374,8 @@ public:
     float dist, fraction;
     for(size_t i = 0; i < numEntries; i++)
     {
-      FOrientArrayType eu(e1s[i], e2s[i], e3s[i]);
-      FOrientArrayType rod(4);
+      FEuler3Type eu(e1s[i], e2s[i], e3s[i]);
+      FRod4Type rod;
       OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
 
       rod = ops.getODFFZRod(rod);
@@ -517,8 +517,8 @@ public:
     int aSize = static_cast<int>(numEntries);
     for(int i = 0; i < aSize; i++)
     {
-      FOrientArrayType ax(axes[3 * i], axes[3 * i + 1], axes[3 * i + 2], angles[i]);
-      FOrientArrayType rod(4);
+      FAxisAngle4Type ax(axes[3 * i], axes[3 * i + 1], axes[3 * i + 2], angles[i]);
+      FRod4Type rod;
       OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, rod);
 
       rod = orientationOps.getMDFFZRod(rod);
@@ -553,7 +553,7 @@ public:
       }
 
       FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
-      FOrientArrayType qu(4);
+      FQuat4Type qu;
       OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
       q1 = qu.toQuaternion();
 
@@ -563,8 +563,8 @@ public:
       q2 = qu.toQuaternion();
       w = orientationOps.getMisoQuat(q1, q2, n1, n2, n3);
 
-      FOrientArrayType ax(n1, n2, n3, w);
-      FOrientArrayType ro(4);
+      FAxisAngle4Type ax(n1, n2, n3, w);
+      FRod4Type ro;
       OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, ro);
 
       ro = orientationOps.getMDFFZRod(ro);
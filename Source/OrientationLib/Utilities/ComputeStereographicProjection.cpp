@@ -62,30 +62,8 @@ void ComputeStereographicProjection::operator()() const
 
   if(m_Config->discrete)
   {
-    int halfDim = m_Config->imageDim / 2;
     double* intensity = m_Intensity->getPointer(0);
-    size_t numCoords = m_XYZCoords->getNumberOfTuples();
-    float* xyzPtr = m_XYZCoords->getPointer(0);
-    for(size_t i = 0; i < numCoords; i++)
-    {
-      if(xyzPtr[i * 3 + 2] < 0.0f)
-      {
-        xyzPtr[i * 3 + 2] *= -1.0f;
-      }
-      float x = xyzPtr[i * 3] / (1 + xyzPtr[i * 3 + 2]);
-      float y = xyzPtr[i * 3 + 1] / (1 + xyzPtr[i * 3 + 2]);
-
-      int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
-      int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
-
-      size_t index = static_cast<size_t>((yCoord * m_Config->imageDim) + xCoord);
-
-      intensity[index]++;
-    }
-
-    for(size_t i = 0; i < numCoords; i++)
-    {
-    }
+    AddDiscreteCoords(m_XYZCoords->getPointer(0), m_XYZCoords->getNumberOfTuples(), m_Config->imageDim, intensity);
 #if 0
     // This chunk is here for some debugging....
     int dim = m_Config->imageDim;
@@ -112,3 +90,27 @@ void ComputeStereographicProjection::operator()() const
     lambert->createStereographicProjection(m_Config->imageDim, m_Intensity);
   }
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ComputeStereographicProjection::AddDiscreteCoords(float* xyz, size_t numCoords, int imageDim, double* intensity)
+{
+  int halfDim = imageDim / 2;
+  for(size_t i = 0; i < numCoords; i++)
+  {
+    if(xyz[i * 3 + 2] < 0.0f)
+    {
+      xyz[i * 3 + 2] *= -1.0f;
+    }
+    float x = xyz[i * 3] / (1 + xyz[i * 3 + 2]);
+    float y = xyz[i * 3 + 1] / (1 + xyz[i * 3 + 2]);
+
+    int xCoord = static_cast<int>(x * (halfDim - 1)) + halfDim;
+    int yCoord = static_cast<int>(y * (halfDim - 1)) + halfDim;
+
+    size_t index = static_cast<size_t>((yCoord * imageDim) + xCoord);
+
+    intensity[index]++;
+  }
+}
@@ -60,6 +60,16 @@ class OrientationLib_EXPORT ComputeStereographicProjection
      */
     void operator()() const;
 
+    /**
+     * @brief AddDiscreteCoords Bins each XYZ coordinate into the stereographic intensity image without any
+     * interpolation. Coordinates in the southern hemisphere are folded into the northern hemisphere in place.
+     * @param xyz Pointer to numCoords XYZ coordinates that are on the unit sphere
+     * @param numCoords The number of XYZ coordinates
+     * @param imageDim The height/width of the intensity image
+     * @param intensity [output] The intensity image that is incremented
+     */
+    static void AddDiscreteCoords(float* xyz, size_t numCoords, int imageDim, double* intensity);
+
   protected:
 
     /**
@@ -42,6 +42,8 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
 
+#include "OrientationLib/Utilities/StereographicLookupTable.h"
+
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
 // -----------------------------------------------------------------------------
@@ -298,6 +300,45 @@ void ModifiedLambertProjection::addValue(Square square, int index, double value)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addSphereCoords(float* xyz, size_t numCoords)
+{
+  float sqCoord[2] = {0.0f, 0.0f};
+  for(size_t i = 0; i < numCoords; ++i)
+  {
+    sqCoord[0] = 0.0f;
+    sqCoord[1] = 0.0f;
+    if(getSquareCoord(xyz + i * 3, sqCoord))
+    {
+      addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+    }
+    else
+    {
+      addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::addSquares(ModifiedLambertProjection* other)
+{
+  size_t npoints = m_NorthSquare->getNumberOfTuples();
+  double* north = m_NorthSquare->getPointer(0);
+  double* south = m_SouthSquare->getPointer(0);
+  double* otherNorth = other->getNorthSquare()->getPointer(0);
+  double* otherSouth = other->getSouthSquare()->getPointer(0);
+
+  for(size_t i = 0; i < npoints; ++i)
+  {
+    north[i] += otherNorth[i];
+    south[i] += otherSouth[i];
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -332,6 +373,36 @@ double ModifiedLambertProjection::getValue(Square square, int index)
 //
 // -----------------------------------------------------------------------------
 double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqCoord)
+{
+  int bins[4];
+  float mods[2];
+  getInterpolationBins(sqCoord, bins, mods);
+  float modX = mods[0];
+  float modY = mods[1];
+  if (square == NorthSquare)
+  {
+    float intensity1 = m_NorthSquare->getValue(bins[0]);
+    float intensity2 = m_NorthSquare->getValue(bins[1]);
+    float intensity3 = m_NorthSquare->getValue(bins[2]);
+    float intensity4 = m_NorthSquare->getValue(bins[3]);
+    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+    return interpolatedIntensity;
+  }
+  else
+  {
+    float intensity1 = m_SouthSquare->getValue(bins[0]);
+    float intensity2 = m_SouthSquare->getValue(bins[1]);
+    float intensity3 = m_SouthSquare->getValue(bins[2]);
+    float intensity4 = m_SouthSquare->getValue(bins[3]);
+    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+    return interpolatedIntensity;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::getInterpolationBins(float* sqCoord, int* bins, float* mods)
 {
 // float sqCoord[2] = { sqCoord0[0] - 0.5*m_StepSize, sqCoord0[1] - 0.5*m_StepSize};
   int abin1, bbin1;
@@ -393,24 +464,12 @@ double ModifiedLambertProjection::getInterpolatedValue(Square square, float* sqC
   }
   modX = fabs(modX);
   modY = fabs(modY);
-  if (square == NorthSquare)
-  {
-    float intensity1 = m_NorthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_NorthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_NorthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_NorthSquare->getValue((abin4) + (bbin4 * m_Dimension));
-    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-    return interpolatedIntensity;
-  }
-  else
-  {
-    float intensity1 = m_SouthSquare->getValue((abin1) + (bbin1 * m_Dimension));
-    float intensity2 = m_SouthSquare->getValue((abin2) + (bbin2 * m_Dimension));
-    float intensity3 = m_SouthSquare->getValue((abin3) + (bbin3 * m_Dimension));
-    float intensity4 = m_SouthSquare->getValue((abin4) + (bbin4 * m_Dimension));
-    float interpolatedIntensity = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
-    return interpolatedIntensity;
-  }
+  bins[0] = (abin1) + (bbin1 * m_Dimension);
+  bins[1] = (abin2) + (bbin2 * m_Dimension);
+  bins[2] = (abin3) + (bbin3 * m_Dimension);
+  bins[3] = (abin4) + (bbin4 * m_Dimension);
+  mods[0] = modX;
+  mods[1] = modY;
 }
 
 // -----------------------------------------------------------------------------
@@ -539,64 +598,16 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createStereographicProjection(int dim, DoubleArrayType* stereoIntensity)
 {
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float xres = 2.0 / (float)(xpoints);
-  float yres = 2.0 / (float)(ypoints);
-  float xtmp, ytmp;
-  float sqCoord[2];
-  float xyz[3];
-  bool nhCheck = false;
-
-  stereoIntensity->initializeWithZeros();
-  double* intensity = stereoIntensity->getPointer(0);
-// int sqIndex = 0;
+  StereographicLookupTable::Pointer table = StereographicLookupTable::New(dim, m_Dimension, m_SphereRadius);
+  createStereographicProjection(table.get(), stereoIntensity);
+}
 
-  for (int64_t y = 0; y < ypoints; y++)
-  {
-    for (int64_t x = 0; x < xpoints; x++)
-    {
-      //get (x,y) for stereographic projection pixel
-      xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
-      ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
-      int index = y * xpoints + x;
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
-      {
-        //project xy from stereo projection to the unit spehere
-        xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
-        xyz[0] = xtmp * (1 + xyz[2]);
-        xyz[1] = ytmp * (1 + xyz[2]);
-
-
-        for( int64_t m = 0; m < 2; m++)
-        {
-          if(m == 1)
-          {
-            MatrixMath::Multiply3x1withConstant(xyz, -1.0);
-          }
-          nhCheck = getSquareCoord(xyz, sqCoord);
-          //sqIndex = getSquareIndex(sqCoord);
-          if (nhCheck == true)
-          {
-            //get Value from North square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::NorthSquare, sqIndex);
-          }
-          else
-          {
-            //get Value from South square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::SouthSquare, sqIndex);
-          }
-        }
-        intensity[index]  = intensity[index] * 0.5;
-      }
-    }
-  }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ModifiedLambertProjection::createStereographicProjection(StereographicLookupTable* table, DoubleArrayType* stereoIntensity)
+{
+  table->project(m_NorthSquare->getPointer(0), m_SouthSquare->getPointer(0), stereoIntensity->getPointer(0));
 }
 
 // -----------------------------------------------------------------------------
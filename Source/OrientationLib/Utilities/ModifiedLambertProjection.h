@@ -43,6 +43,8 @@
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/Utilities/PoleFigureUtilities.h"
 
+class StereographicLookupTable;
+
 /**
  * @class ModifiedLambertProjection ModifiedLambertProjection.h DREAM3DLib/Common/ModifiedLambertProjection.h
  * @brief  This class holds a pair of Modified Lambert Projection images. Based off the paper
@@ -111,6 +113,22 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     void addValue(Square square, int index, double value);
 
+    /**
+     * @brief addSphereCoords Adds an interpolated value of 1.0 into the north or south square for each of the XYZ
+     * coordinates. This is the same accumulation that LambertBallToSquare performs but lets the caller build up
+     * the squares one block of coordinates at a time.
+     * @param xyz Pointer to numCoords XYZ coordinates that are on the sphere
+     * @param numCoords The number of XYZ coordinates
+     */
+    void addSphereCoords(float* xyz, size_t numCoords);
+
+    /**
+     * @brief addSquares Adds the north and south squares of another projection into the squares of this projection.
+     * Both projections must have been initialized with the same dimension.
+     * @param other The projection whose squares are added to this one
+     */
+    void addSquares(ModifiedLambertProjection* other);
+
     /**
      * @brief This function sets the value of a bin in the lambert projection
      * @param square The North or South Squares
@@ -135,6 +153,16 @@ class OrientationLib_EXPORT ModifiedLambertProjection
      */
     double getInterpolatedValue(Square square, float* sqCoord);
 
+    /**
+     * @brief getInterpolationBins Computes the 4 bins and the fractional offsets that getInterpolatedValue
+     * uses to bilinearly interpolate a square at the given coordinate. The bins wrap across the edges of the
+     * square the same way addInterpolatedValues does.
+     * @param sqCoord The XY coordinate in the Modified Lambert Square
+     * @param bins [output] The 4 indices into the square
+     * @param mods [output] The absolute X and Y offsets of the coordinate from the center of the first bin
+     */
+    void getInterpolationBins(float* sqCoord, int* bins, float* mods);
+
     /**
      * @brief getSquareCoord
      * @param xyz The input XYZ coordinate on the unit sphere.
@@ -169,6 +197,14 @@ class OrientationLib_EXPORT ModifiedLambertProjection
 
     void createStereographicProjection(int dim, DoubleArrayType* stereoIntensity);
 
+    /**
+     * @brief createStereographicProjection Resamples the squares through a lookup table that the caller built for
+     * this Lambert dimension, so that several projections of the same size only compute the table once.
+     * @param table The lookup table
+     * @param stereoIntensity [output] The intensity image which has table->getImageDimension() squared values
+     */
+    void createStereographicProjection(StereographicLookupTable* table, DoubleArrayType* stereoIntensity);
+
   protected:
     ModifiedLambertProjection();
 
@@ -0,0 +1,260 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "PoleFigureAccumulator.h"
+
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/Utilities/ComputeStereographicProjection.h"
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+#include "OrientationLib/Utilities/StereographicLookupTable.h"
+
+namespace Detail
+{
+  namespace PoleFigureAccumulation
+  {
+    static const size_t k_DefaultBlockSize = 4096;
+
+    /**
+     * @brief The AccumulatePoleFigureImpl class holds the Lambert squares (or discrete intensity images) of a single
+     * thread along with the scratch arrays that one block of orientations is converted into.
+     */
+    class AccumulatePoleFigureImpl
+    {
+        LaueOps* m_Ops;
+        PoleFigureConfiguration_t* m_Config;
+        size_t m_BlockSize;
+
+        FloatArrayType::Pointer m_Eulers;
+        FloatArrayType::Pointer m_Coords[3];
+        size_t m_CoordsPerOrientation[3];
+
+        ModifiedLambertProjection::Pointer m_Lambert[3];
+        DoubleArrayType::Pointer m_Discrete[3];
+
+      public:
+        AccumulatePoleFigureImpl(LaueOps* ops, PoleFigureConfiguration_t* config, size_t blockSize) :
+          m_Ops(ops),
+          m_Config(config),
+          m_BlockSize(blockSize)
+        {
+          initialize();
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        AccumulatePoleFigureImpl(AccumulatePoleFigureImpl& other, tbb::split) :
+          m_Ops(other.m_Ops),
+          m_Config(other.m_Config),
+          m_BlockSize(other.m_BlockSize)
+        {
+          initialize();
+        }
+#endif
+
+        virtual ~AccumulatePoleFigureImpl() {}
+
+        void initialize()
+        {
+          QVector<size_t> cDims(1, 3);
+          m_Eulers = FloatArrayType::CreateArray(m_BlockSize, cDims, "Eulers_Block");
+          for(int f = 0; f < 3; f++)
+          {
+            m_Coords[f] = FloatArrayType::CreateArray(0, cDims, "xyzCoords_Block");
+            m_CoordsPerOrientation[f] = 0;
+            if(m_Config->discrete)
+            {
+              m_Discrete[f] = DoubleArrayType::CreateArray(m_Config->imageDim * m_Config->imageDim, "Discrete_Intensity_Image");
+              m_Discrete[f]->initializeWithZeros();
+            }
+            else
+            {
+              m_Lambert[f] = ModifiedLambertProjection::New();
+              m_Lambert[f]->initializeSquares(m_Config->lambertDim, m_Config->sphereRadius);
+            }
+          }
+        }
+
+        void accumulate(size_t startBlock, size_t endBlock)
+        {
+          size_t numOrientations = m_Config->eulers->getNumberOfTuples();
+          float* eulers = m_Config->eulers->getPointer(0);
+
+          for(size_t b = startBlock; b < endBlock; b++)
+          {
+            size_t start = b * m_BlockSize;
+            size_t count = std::min(m_BlockSize, numOrientations - start);
+            if(m_Eulers->getNumberOfTuples() != count)
+            {
+              m_Eulers->resize(count);
+            }
+            std::copy(eulers + start * 3, eulers + (start + count) * 3, m_Eulers->getPointer(0));
+
+            m_Ops->generateSphereCoordsFromEulers(m_Eulers.get(), m_Coords[0].get(), m_Coords[1].get(), m_Coords[2].get());
+
+            for(int f = 0; f < 3; f++)
+            {
+              // The coordinate arrays start out empty and generateSphereCoordsFromEulers only ever grows them to
+              // exactly fit the block, so the first block tells us how many directions each orientation produces.
+              if(m_CoordsPerOrientation[f] == 0)
+              {
+                m_CoordsPerOrientation[f] = m_Coords[f]->getNumberOfTuples() / count;
+              }
+              size_t numCoords = count * m_CoordsPerOrientation[f];
+              if(m_Config->discrete)
+              {
+                ComputeStereographicProjection::AddDiscreteCoords(m_Coords[f]->getPointer(0), numCoords, m_Config->imageDim, m_Discrete[f]->getPointer(0));
+              }
+              else
+              {
+                m_Lambert[f]->addSphereCoords(m_Coords[f]->getPointer(0), numCoords);
+              }
+            }
+          }
+        }
+
+        void join(const AccumulatePoleFigureImpl& other)
+        {
+          for(int f = 0; f < 3; f++)
+          {
+            if(m_Config->discrete)
+            {
+              size_t count = m_Discrete[f]->getNumberOfTuples();
+              double* intensity = m_Discrete[f]->getPointer(0);
+              double* otherIntensity = other.m_Discrete[f]->getPointer(0);
+              for(size_t i = 0; i < count; i++)
+              {
+                intensity[i] += otherIntensity[i];
+              }
+            }
+            else
+            {
+              m_Lambert[f]->addSquares(other.m_Lambert[f].get());
+            }
+          }
+        }
+
+        void createIntensityImage(int family, StereographicLookupTable* table, DoubleArrayType* intensity)
+        {
+          intensity->resize(static_cast<size_t>(m_Config->imageDim * m_Config->imageDim));
+          intensity->initializeWithZeros();
+          if(m_Config->discrete)
+          {
+            std::copy(m_Discrete[family]->getPointer(0), m_Discrete[family]->getPointer(0) + m_Discrete[family]->getNumberOfTuples(), intensity->getPointer(0));
+          }
+          else
+          {
+            m_Lambert[family]->normalizeSquaresToMRD();
+            m_Lambert[family]->createStereographicProjection(table, intensity);
+          }
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r)
+        {
+          accumulate(r.begin(), r.end());
+        }
+#endif
+    };
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::PoleFigureAccumulator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PoleFigureAccumulator::~PoleFigureAccumulator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::Execute(LaueOps* ops, PoleFigureConfiguration_t* config, DoubleArrayType* intensity0, DoubleArrayType* intensity1, DoubleArrayType* intensity2)
+{
+  Execute(ops, config, intensity0, intensity1, intensity2, Detail::PoleFigureAccumulation::k_DefaultBlockSize);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PoleFigureAccumulator::Execute(LaueOps* ops, PoleFigureConfiguration_t* config, DoubleArrayType* intensity0, DoubleArrayType* intensity1, DoubleArrayType* intensity2, size_t blockSize)
+{
+  if(blockSize == 0)
+  {
+    blockSize = 1;
+  }
+  size_t numOrientations = config->eulers->getNumberOfTuples();
+  size_t numBlocks = (numOrientations + blockSize - 1) / blockSize;
+
+  Detail::PoleFigureAccumulation::AccumulatePoleFigureImpl accumulator(ops, config, blockSize);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+
+  if(doParallel == true)
+  {
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, numBlocks), accumulator, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    accumulator.accumulate(0, numBlocks);
+  }
+
+  // The 3 families share one lookup table. Use the caller's table when it matches this pole figure
+  // and only build one that lives as long as this pole figure when it does not.
+  StereographicLookupTable* table = nullptr;
+  StereographicLookupTable::Pointer ownTable;
+  if(!config->discrete)
+  {
+    table = config->stereoTable;
+    if(nullptr == table || table->getImageDimension() != config->imageDim || table->getLambertDimension() != config->lambertDim ||
+       table->getSphereRadius() != config->sphereRadius)
+    {
+      ownTable = StereographicLookupTable::New(config->imageDim, config->lambertDim, config->sphereRadius);
+      table = ownTable.get();
+    }
+  }
+  accumulator.createIntensityImage(0, table, intensity0);
+  accumulator.createIntensityImage(1, table, intensity1);
+  accumulator.createIntensityImage(2, table, intensity2);
+}
@@ -0,0 +1,79 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/Utilities/PoleFigureUtilities.h"
+
+class LaueOps;
+
+/**
+* @class PoleFigureAccumulator This class generates the 3 stereographic intensity images of a pole figure without
+* ever holding the XYZ sphere coordinates of all the orientations in memory. The Euler angles are pushed through
+* LaueOps::generateSphereCoordsFromEulers a block at a time and each block of coordinates is added straight into
+* a set of modified Lambert squares (or discrete intensity images) that belong to the thread doing the work. The
+* per thread results are summed once every orientation has been visited so the memory that is used only depends
+* on the size of the Lambert squares and images and not on the number of orientations.
+*/
+class OrientationLib_EXPORT PoleFigureAccumulator
+{
+  public:
+    /**
+     * @brief Execute Computes the intensity images for the 3 pole figure families of the given LaueOps. The results
+     * are identical to calling generateSphereCoordsFromEulers followed by a ComputeStereographicProjection for each
+     * family (up to the order in which the values are summed).
+     * @param ops The LaueOps that generates the symmetric directions for each family
+     * @param config The pole figure configuration which holds the Euler angles and, optionally, a lookup table
+     * that is shared with other pole figures of the same size
+     * @param intensity0 [output] Intensity image for the first family
+     * @param intensity1 [output] Intensity image for the second family
+     * @param intensity2 [output] Intensity image for the third family
+     */
+    static void Execute(LaueOps* ops, PoleFigureConfiguration_t* config, DoubleArrayType* intensity0, DoubleArrayType* intensity1, DoubleArrayType* intensity2);
+
+    /**
+     * @brief Execute Same as above but with an explicit number of orientations per block.
+     * @param blockSize The number of orientations that are converted into sphere coordinates at a time
+     */
+    static void Execute(LaueOps* ops, PoleFigureConfiguration_t* config, DoubleArrayType* intensity0, DoubleArrayType* intensity1, DoubleArrayType* intensity2, size_t blockSize);
+
+  protected:
+    PoleFigureAccumulator();
+    virtual ~PoleFigureAccumulator();
+
+  private:
+    PoleFigureAccumulator(const PoleFigureAccumulator&) = delete; // Copy Constructor Not Implemented
+    void operator=(const PoleFigureAccumulator&) = delete;        // Move assignment Not Implemented
+};
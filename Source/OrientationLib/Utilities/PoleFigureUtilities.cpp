@@ -39,6 +39,13 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QTextStream>
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Utilities/ColorTable.h"
 
 
@@ -52,6 +59,113 @@
 #define WRITE_XYZ_SPHERE_COORD_VTK 0
 #define WRITE_LAMBERT_SQUARES 0
 
+namespace Detail
+{
+  namespace PoleFigureColoring
+  {
+    /**
+     * @brief The CreateColorImageImpl class converts a range of rows of an intensity image into RGBA colors.
+     */
+    class CreateColorImageImpl
+    {
+        double* m_Data;
+        PoleFigureConfiguration_t* m_Config;
+        const QVector<float>& m_Colors;
+        UInt8ArrayType* m_Image;
+
+      public:
+        CreateColorImageImpl(DoubleArrayType* data, PoleFigureConfiguration_t* config, const QVector<float>& colors, UInt8ArrayType* image) :
+          m_Data(data->getPointer(0)),
+          m_Config(config),
+          m_Colors(colors),
+          m_Image(image)
+        {}
+        virtual ~CreateColorImageImpl() {}
+
+        void convert(size_t startRow, size_t endRow) const
+        {
+          int width = m_Config->imageDim;
+          int height = m_Config->imageDim;
+
+          int halfWidth = width / 2;
+          int halfHeight = height / 2;
+
+          float xres = 2.0f / static_cast<float>(width);
+          float yres = 2.0f / static_cast<float>(height);
+          float xtmp, ytmp;
+
+          float max = static_cast<float>(m_Config->maxScale);
+          float min = static_cast<float>(m_Config->minScale);
+
+          uint32_t* rgbaPtr = reinterpret_cast<uint32_t*>(m_Image->getPointer(0));
+
+          int numColors = m_Config->numColors;
+          float r = 0.0f, g = 0.0f, b = 0.0f;
+
+          double* dataPtr = m_Data;
+          size_t idx = 0;
+          double value;
+          int bin;
+          for(int64_t y = static_cast<int64_t>(startRow); y < static_cast<int64_t>(endRow); y++)
+          {
+            for(int64_t x = 0; x < width; x++)
+            {
+              xtmp = float(x - halfWidth) * xres + (xres * 0.5f);
+              ytmp = float(y - halfHeight) * yres + (yres * 0.5f);
+              idx = (width * y) + x;
+              if((xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
+              {
+                value = dataPtr[y * width + x];
+                value = (value - min) / (max - min);
+                bin = int(value * numColors);
+                if(bin > numColors - 1)
+                {
+                  bin = numColors - 1;
+                }
+                if(bin < 0 || bin >= m_Colors.size())
+                {
+                  r = 0x00;
+                  b = 0x00;
+                  g = 0x00;
+                }
+                else if(!m_Config->discreteHeatMap && m_Config->discrete)
+                {
+                  float frgb = 1.0f;
+                  if(value > 0.0)
+                  {
+                    frgb = 0.0f;
+                  }
+                  r = frgb;
+                  b = frgb;
+                  g = frgb;
+                }
+                else
+                {
+                  r = m_Colors[3 * bin];
+                  g = m_Colors[3 * bin + 1];
+                  b = m_Colors[3 * bin + 2];
+                }
+
+                rgbaPtr[idx] = RgbColor::dRgb(static_cast<int>(r * 255.0f), static_cast<int>(g * 255.0f), static_cast<int>(b * 255.0f), 255);
+              }
+              else // Outside the Circle - Set pixel to White
+              {
+                rgbaPtr[idx] = 0xFFFFFFFF; // White
+              }
+            }
+          }
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          convert(r.begin(), r.end());
+        }
+#endif
+    };
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -114,82 +228,28 @@ UInt8ArrayType::Pointer PoleFigureUtilities::CreateColorImage(DoubleArrayType* d
 // -----------------------------------------------------------------------------
 void PoleFigureUtilities::CreateColorImage(DoubleArrayType* data, PoleFigureConfiguration_t& config, UInt8ArrayType* image)
 {
-  int width = config.imageDim ;
-  int height = config.imageDim ;
-
-  int halfWidth = width / 2;
-  int halfHeight = height / 2;
-
-  float xres = 2.0f / static_cast<float>(width);
-  float yres = 2.0f / static_cast<float>(height);
-  float xtmp, ytmp;
-
-  float max = static_cast<float>(config.maxScale);
-  float min = static_cast<float>(config.minScale);
-
   // Initialize the image with all zeros
   image->initializeWithZeros();
-  uint32_t* rgbaPtr = reinterpret_cast<uint32_t*>(image->getPointer(0));
 
   int numColors = config.numColors;
   QVector<float> colors(numColors * 3, 0.0f);
   SIMPLColorTable::GetColorTable(config.numColors, colors);
 
-  float r = 0.0f, g = 0.0f, b = 0.0f;
+  Detail::PoleFigureColoring::CreateColorImageImpl colorImage(data, &config, colors, image);
 
-  double* dataPtr = data->getPointer(0);
-  size_t idx = 0;
-  double value;
-  int bin;
-  for (int64_t y = 0; y < height; y++)
-  {
-    for (int64_t x = 0; x < width; x++)
-    {
-      xtmp = float(x - halfWidth) * xres + (xres * 0.5f);
-      ytmp = float(y - halfHeight) * yres + (yres * 0.5f);
-      idx = (width * y) + x;
-      if( ( xtmp * xtmp + ytmp * ytmp) <= 1.0) // Inside the circle
-      {
-        value = dataPtr[y * width + x];
-        value = (value - min) / (max - min);
-        bin = int(value * numColors);
-        if(bin > numColors - 1)
-        {
-          bin = numColors - 1;
-        }
-        if (bin < 0 || bin >= colors.size())
-        {
-          r = 0x00;
-          b = 0x00;
-          g = 0x00;
-        }
-        else if(!config.discreteHeatMap && config.discrete)
-        {
-          float frgb = 1.0f;
-          if(value > 0.0)
-          {
-            frgb = 0.0f;
-          }
-          r = frgb;
-          b = frgb;
-          g = frgb;
-        }
-        else
-        {
-          r = colors[3 * bin];
-          g = colors[3 * bin + 1];
-          b = colors[3 * bin + 2];
-        }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
 
-        rgbaPtr[idx] = RgbColor::dRgb(static_cast<int>(r * 255.0f), static_cast<int>(g * 255.0f), static_cast<int>(b * 255.0f), 255);
-      }
-      else // Outside the Circle - Set pixel to White
-      {
-        rgbaPtr[idx] = 0xFFFFFFFF; // White
-      }
-    }
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(config.imageDim)), colorImage, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    colorImage.convert(0, static_cast<size_t>(config.imageDim));
   }
-
 }
 
 // -----------------------------------------------------------------------------
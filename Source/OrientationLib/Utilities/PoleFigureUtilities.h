@@ -40,6 +40,8 @@
 
 #include "OrientationLib/OrientationLib.h"
 
+class StereographicLookupTable;
+
 /**
  * @struct PoleFigureConfiguration_t
  * @brief This structure controls how Pole Figures are generated. The Order member
@@ -54,6 +56,11 @@
  * label for each Pole Figure. If the developer would like to over ride those labels
  * then this member can be set with a 3 Element QVector<QString> with the new labels.
  * Note that the new lables will REPLACE the default labels.
+ *
+ * The stereoTable member lets a caller that generates several pole figures of the
+ * same size share one StereographicLookupTable between them. The caller owns the
+ * table. When it is left as nullptr (or does not match the sizes above) a table is
+ * built for each pole figure.
  */
 typedef struct
 {
@@ -70,6 +77,7 @@ typedef struct
   QVector<QString> labels;     ///<* The labels for each of the 3 Pole Figures
   QVector<unsigned int> order; ///<* The order that the pole figures should appear in.
   QString phaseName;           ///<* The Names of the phase
+  StereographicLookupTable* stereoTable = nullptr; ///<* Optional lookup table that is shared between pole figures of the same size
 } PoleFigureConfiguration_t;
 
 /**
@@ -0,0 +1,191 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/Geometry/VertexGeom.h"
+
+/**
+ * @brief The SamplePointGrid class buckets the vertices of a VertexGeom into a uniform grid
+ * of cells so that the points falling inside an axis aligned box can be visited without
+ * scanning every point.
+ */
+class SamplePointGrid
+{
+public:
+  /**
+   * @brief Buckets the points
+   * @param points Vertex geometry holding the points
+   * @param pointsPerCell Average number of points to aim for in each cell
+   */
+  SamplePointGrid(VertexGeom* points, size_t pointsPerCell = 8)
+  {
+    int64_t numPoints = points->getNumberOfVertices();
+    if(numPoints <= 0)
+    {
+      m_CellOffsets.assign(2, 0);
+      return;
+    }
+    float* coords = points->getVertexPointer(0);
+
+    float extent[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Min[d] = std::numeric_limits<float>::max();
+      m_Max[d] = std::numeric_limits<float>::lowest();
+    }
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        m_Min[d] = std::min(m_Min[d], coords[3 * i + d]);
+        m_Max[d] = std::max(m_Max[d], coords[3 * i + d]);
+      }
+    }
+
+    // Pick a cubic cell size from the extents that actually span space, so a planar set of
+    // points (a single slice) is bucketed in 2D rather than collapsing into a few cells
+    double spannedVolume = 1.0;
+    int32_t spannedDims = 0;
+    for(size_t d = 0; d < 3; d++)
+    {
+      extent[d] = m_Max[d] - m_Min[d];
+      if(extent[d] > 0.0f)
+      {
+        spannedVolume *= extent[d];
+        spannedDims++;
+      }
+    }
+    double targetCells = std::max(1.0, static_cast<double>(numPoints) / static_cast<double>(std::max<size_t>(pointsPerCell, 1)));
+    double cellSize = spannedDims > 0 ? std::pow(spannedVolume / targetCells, 1.0 / spannedDims) : 1.0;
+    size_t numCells = 1;
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_Dims[d] = 1;
+      if(extent[d] > 0.0f && cellSize > 0.0)
+      {
+        m_Dims[d] = static_cast<int64_t>(std::min(std::ceil(extent[d] / cellSize), targetCells));
+        m_Dims[d] = std::max<int64_t>(m_Dims[d], 1);
+      }
+      m_CellSize[d] = extent[d] > 0.0f ? extent[d] / static_cast<float>(m_Dims[d]) : 1.0f;
+      numCells *= static_cast<size_t>(m_Dims[d]);
+    }
+
+    // Counting sort of the point ids into compressed rows, one row per cell
+    std::vector<size_t> pointCells(static_cast<size_t>(numPoints));
+    m_CellOffsets.assign(numCells + 1, 0);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      int64_t cell[3] = {0, 0, 0};
+      for(size_t d = 0; d < 3; d++)
+      {
+        cell[d] = cellIndex(coords[3 * i + d], d);
+      }
+      pointCells[i] = static_cast<size_t>((cell[2] * m_Dims[1] + cell[1]) * m_Dims[0] + cell[0]);
+      m_CellOffsets[pointCells[i] + 1]++;
+    }
+    for(size_t c = 0; c < numCells; c++)
+    {
+      m_CellOffsets[c + 1] += m_CellOffsets[c];
+    }
+    std::vector<size_t> fill(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+    m_PointIds.resize(static_cast<size_t>(numPoints));
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      m_PointIds[fill[pointCells[i]]++] = i;
+    }
+  }
+
+  virtual ~SamplePointGrid() = default;
+
+  /**
+   * @brief Calls func(pointId) for every point in the cells overlapping the box [ll, ur].
+   * Points near the box may be visited as well, so callers still test each point against the box.
+   */
+  template <typename Func> void forEachPointNearBox(const float* ll, const float* ur, Func func) const
+  {
+    if(m_PointIds.empty())
+    {
+      return;
+    }
+    int64_t lo[3] = {0, 0, 0};
+    int64_t hi[3] = {0, 0, 0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(ur[d] < m_Min[d] || ll[d] > m_Max[d])
+      {
+        return;
+      }
+      lo[d] = cellIndex(ll[d], d);
+      hi[d] = cellIndex(ur[d], d);
+    }
+    for(int64_t z = lo[2]; z <= hi[2]; z++)
+    {
+      for(int64_t y = lo[1]; y <= hi[1]; y++)
+      {
+        size_t rowStart = static_cast<size_t>((z * m_Dims[1] + y) * m_Dims[0]);
+        for(size_t p = m_CellOffsets[rowStart + lo[0]]; p < m_CellOffsets[rowStart + hi[0] + 1]; p++)
+        {
+          func(m_PointIds[p]);
+        }
+      }
+    }
+  }
+
+protected:
+  int64_t cellIndex(float coord, size_t d) const
+  {
+    float cell = std::floor((coord - m_Min[d]) / m_CellSize[d]);
+    if(cell <= 0.0f)
+    {
+      return 0;
+    }
+    return std::min(static_cast<int64_t>(cell), m_Dims[d] - 1);
+  }
+
+private:
+  float m_Min[3] = {0.0f, 0.0f, 0.0f};
+  float m_Max[3] = {0.0f, 0.0f, 0.0f};
+  float m_CellSize[3] = {1.0f, 1.0f, 1.0f};
+  int64_t m_Dims[3] = {1, 1, 1};
+  std::vector<size_t> m_CellOffsets;
+  std::vector<int64_t> m_PointIds;
+};
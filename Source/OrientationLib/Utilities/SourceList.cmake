@@ -44,7 +44,11 @@ set(OrientationLib_Utilities_HDRS
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionArray.h
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjection3D.hpp
   ${OrientationLib_SOURCE_DIR}/Utilities/ComputeStereographicProjection.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureAccumulator.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/StereographicLookupTable.h
   ${OrientationLib_SOURCE_DIR}/Utilities/LambertUtilities.h
+  ${OrientationLib_SOURCE_DIR}/Utilities/TriangleBVH.hpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/SamplePointGrid.hpp
 )
 
 set(OrientationLib_Utilities_SRCS
@@ -53,6 +57,8 @@ set(OrientationLib_Utilities_SRCS
   ${OrientationLib_SOURCE_DIR}/Utilities/ModifiedLambertProjectionArray.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureData.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/ComputeStereographicProjection.cpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/PoleFigureAccumulator.cpp
+  ${OrientationLib_SOURCE_DIR}/Utilities/StereographicLookupTable.cpp
   ${OrientationLib_SOURCE_DIR}/Utilities/LambertUtilities.cpp
 )
 # QT5_WRAP_CPP( OrientationLib_Generated_MOC_SRCS ${OrientationLib_Utilities_MOC_HDRS} )
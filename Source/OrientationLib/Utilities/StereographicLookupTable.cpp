@@ -0,0 +1,327 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "StereographicLookupTable.h"
+
+#include <algorithm>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+
+namespace Detail
+{
+  namespace StereographicLookup
+  {
+    /**
+     * @brief The FillTableImpl class computes the Lambert bins and offsets for a range of rows of the table.
+     */
+    class FillTableImpl
+    {
+        ModifiedLambertProjection* m_Lambert;
+        int m_ImageDim;
+        const int* m_RowStart;
+        const int* m_RowEnd;
+        const size_t* m_RowOffset;
+        int* m_Bins;
+        float* m_Mods;
+
+      public:
+        FillTableImpl(ModifiedLambertProjection* lambert, int imageDim, const int* rowStart, const int* rowEnd, const size_t* rowOffset, int* bins, float* mods) :
+          m_Lambert(lambert),
+          m_ImageDim(imageDim),
+          m_RowStart(rowStart),
+          m_RowEnd(rowEnd),
+          m_RowOffset(rowOffset),
+          m_Bins(bins),
+          m_Mods(mods)
+        {}
+        virtual ~FillTableImpl() {}
+
+        void fill(size_t startRow, size_t endRow) const
+        {
+          int xpointshalf = m_ImageDim / 2;
+          int ypointshalf = m_ImageDim / 2;
+          float xres = 2.0 / (float)(m_ImageDim);
+          float yres = 2.0 / (float)(m_ImageDim);
+          float xtmp, ytmp;
+          float sqCoord[2];
+          float xyz[3];
+          int squareSize = m_Lambert->getDimension() * m_Lambert->getDimension();
+
+          for(size_t y = startRow; y < endRow; y++)
+          {
+            int* bins = m_Bins + m_RowOffset[y] * 8;
+            float* mods = m_Mods + m_RowOffset[y] * 4;
+            for(int64_t x = m_RowStart[y]; x < m_RowEnd[y]; x++)
+            {
+              // This is the same math that createStereographicProjection has always used for each pixel
+              xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
+              ytmp = float(static_cast<int64_t>(y) - ypointshalf) * yres + (yres * 0.5);
+              xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+              xyz[0] = xtmp * (1 + xyz[2]);
+              xyz[1] = ytmp * (1 + xyz[2]);
+
+              for(int64_t m = 0; m < 2; m++)
+              {
+                if(m == 1)
+                {
+                  MatrixMath::Multiply3x1withConstant(xyz, -1.0);
+                }
+                bool nhCheck = m_Lambert->getSquareCoord(xyz, sqCoord);
+                m_Lambert->getInterpolationBins(sqCoord, bins, mods);
+                if(!nhCheck)
+                {
+                  // The south square follows the north square in the combined array
+                  for(int i = 0; i < 4; i++)
+                  {
+                    bins[i] += squareSize;
+                  }
+                }
+                bins += 4;
+                mods += 2;
+              }
+            }
+          }
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          fill(r.begin(), r.end());
+        }
+#endif
+    };
+
+    /**
+     * @brief The ProjectRowsImpl class resamples a range of rows of a stereographic intensity image.
+     */
+    class ProjectRowsImpl
+    {
+        const StereographicLookupTable* m_Table;
+        const double* m_Squares;
+        double* m_Intensity;
+
+      public:
+        ProjectRowsImpl(const StereographicLookupTable* table, const double* squares, double* intensity) :
+          m_Table(table),
+          m_Squares(squares),
+          m_Intensity(intensity)
+        {}
+        virtual ~ProjectRowsImpl() {}
+
+        void project(size_t startRow, size_t endRow) const
+        {
+          m_Table->projectRows(m_Squares, m_Intensity, static_cast<int>(startRow), static_cast<int>(endRow));
+        }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        void operator()(const tbb::blocked_range<size_t>& r) const
+        {
+          project(r.begin(), r.end());
+        }
+#endif
+    };
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StereographicLookupTable::StereographicLookupTable() :
+  m_ImageDimension(0),
+  m_LambertDimension(0),
+  m_SphereRadius(1.0f)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StereographicLookupTable::~StereographicLookupTable() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+StereographicLookupTable::Pointer StereographicLookupTable::New(int imageDim, int lambertDim, float sphereRadius)
+{
+  Pointer table = Pointer(new StereographicLookupTable());
+  table->initialize(imageDim, lambertDim, sphereRadius);
+  return table;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StereographicLookupTable::initialize(int imageDim, int lambertDim, float sphereRadius)
+{
+  m_ImageDimension = imageDim;
+  m_LambertDimension = lambertDim;
+  m_SphereRadius = sphereRadius;
+
+  ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+  lambert->initializeSquares(lambertDim, sphereRadius);
+
+  // Find the columns of each row that are inside the unit circle. The test is the same one that the
+  // per pixel projection used so exactly the same pixels are filled in.
+  int xpointshalf = imageDim / 2;
+  int ypointshalf = imageDim / 2;
+  float xres = 2.0 / (float)(imageDim);
+  float yres = 2.0 / (float)(imageDim);
+  float xtmp, ytmp;
+
+  m_RowStart.assign(imageDim, 0);
+  m_RowEnd.assign(imageDim, 0);
+  m_RowOffset.assign(imageDim + 1, 0);
+  for(int64_t y = 0; y < imageDim; y++)
+  {
+    ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
+    int start = imageDim;
+    int end = 0;
+    for(int64_t x = 0; x < imageDim; x++)
+    {
+      xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
+      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+      {
+        start = std::min(start, static_cast<int>(x));
+        end = static_cast<int>(x) + 1;
+      }
+    }
+    if(start > end)
+    {
+      start = end;
+    }
+    m_RowStart[y] = start;
+    m_RowEnd[y] = end;
+    m_RowOffset[y + 1] = m_RowOffset[y] + static_cast<size_t>(end - start);
+  }
+
+  size_t numPixels = m_RowOffset[imageDim];
+  m_Bins.resize(numPixels * 8);
+  m_Mods.resize(numPixels * 4);
+
+  Detail::StereographicLookup::FillTableImpl fillTable(lambert.get(), imageDim, m_RowStart.data(), m_RowEnd.data(), m_RowOffset.data(), m_Bins.data(), m_Mods.data());
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(imageDim)), fillTable, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    fillTable.fill(0, static_cast<size_t>(imageDim));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StereographicLookupTable::project(double* north, double* south, double* intensity)
+{
+  size_t squareSize = static_cast<size_t>(m_LambertDimension * m_LambertDimension);
+  std::vector<double> squares(squareSize * 2);
+  std::copy(north, north + squareSize, squares.begin());
+  std::copy(south, south + squareSize, squares.begin() + squareSize);
+
+  Detail::StereographicLookup::ProjectRowsImpl projectRows(this, squares.data(), intensity);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(m_ImageDimension)), projectRows, tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    projectRows.project(0, static_cast<size_t>(m_ImageDimension));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void StereographicLookupTable::projectRows(const double* squares, double* intensity, int startRow, int endRow) const
+{
+  for(int y = startRow; y < endRow; y++)
+  {
+    double* row = intensity + static_cast<size_t>(y) * m_ImageDimension;
+    int start = m_RowStart[y];
+    int end = m_RowEnd[y];
+    std::fill(row, row + start, 0.0);
+    std::fill(row + end, row + m_ImageDimension, 0.0);
+
+    // The interpolation is done in single precision exactly like getInterpolatedValue so the
+    // image is identical to projecting each pixel back onto the sphere.
+    const int* bins = m_Bins.data() + m_RowOffset[y] * 8;
+    const float* mods = m_Mods.data() + m_RowOffset[y] * 4;
+    int count = end - start;
+    for(int i = 0; i < count; i++)
+    {
+      const int* b = bins + i * 8;
+      const float* m = mods + i * 4;
+
+      float modX = m[0];
+      float modY = m[1];
+      float intensity1 = squares[b[0]];
+      float intensity2 = squares[b[1]];
+      float intensity3 = squares[b[2]];
+      float intensity4 = squares[b[3]];
+      float value0 = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+
+      modX = m[2];
+      modY = m[3];
+      intensity1 = squares[b[4]];
+      intensity2 = squares[b[5]];
+      intensity3 = squares[b[6]];
+      intensity4 = squares[b[7]];
+      float value1 = ((intensity1 * (1 - modX) * (1 - modY)) + (intensity2 * (modX) * (1 - modY)) + (intensity3 * (1 - modX) * (modY)) + (intensity4 * (modX) * (modY)));
+
+      double value = 0.0;
+      value += value0;
+      value += value1;
+      row[start + i] = value * 0.5;
+    }
+  }
+}
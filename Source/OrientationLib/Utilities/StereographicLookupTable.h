@@ -0,0 +1,114 @@
+/* ============================================================================
+ * Copyright (c) 2017 BlueQuartz Software, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+#include "OrientationLib/OrientationLib.h"
+
+/**
+* @class StereographicLookupTable This class holds, for every pixel of a stereographic projection image that lies inside
+* the unit circle, the modified Lambert square bins and interpolation offsets of the pixel's direction and of its
+* antipode. Resampling a pair of Lambert squares into a stereographic image then only needs to gather and blend the 8
+* values of each pixel instead of projecting every pixel back onto the sphere. A table only depends on the image
+* dimension, the Lambert dimension and the sphere radius so the caller builds it once and uses it for every projection
+* of that size. The table is released with the last Pointer that refers to it.
+*/
+class OrientationLib_EXPORT StereographicLookupTable
+{
+  public:
+    SIMPL_SHARED_POINTERS(StereographicLookupTable)
+    SIMPL_TYPE_MACRO(StereographicLookupTable)
+
+    virtual ~StereographicLookupTable();
+
+    /**
+     * @brief New Computes the lookup table for the given sizes.
+     * @param imageDim The height/width of the stereographic image
+     * @param lambertDim The dimension of the modified Lambert squares
+     * @param sphereRadius The radius of the sphere the Lambert squares were created with
+     * @return
+     */
+    static Pointer New(int imageDim, int lambertDim, float sphereRadius);
+
+    SIMPL_GET_PROPERTY(int, ImageDimension)
+    SIMPL_GET_PROPERTY(int, LambertDimension)
+    SIMPL_GET_PROPERTY(float, SphereRadius)
+
+    /**
+     * @brief project Resamples the north and south squares into the stereographic intensity image. Pixels outside
+     * of the unit circle are set to zero. The rows of the image are computed in parallel.
+     * @param north The north square which has getLambertDimension() * getLambertDimension() values
+     * @param south The south square which has getLambertDimension() * getLambertDimension() values
+     * @param intensity [output] The intensity image which has getImageDimension() * getImageDimension() values
+     */
+    void project(double* north, double* south, double* intensity);
+
+    /**
+     * @brief projectRows Resamples the rows [startRow, endRow) of the stereographic intensity image.
+     * @param squares The north square followed by the south square
+     * @param intensity [output] The intensity image
+     * @param startRow
+     * @param endRow
+     */
+    void projectRows(const double* squares, double* intensity, int startRow, int endRow) const;
+
+  protected:
+    StereographicLookupTable();
+
+    /**
+     * @brief initialize Computes the table for the given sizes.
+     */
+    void initialize(int imageDim, int lambertDim, float sphereRadius);
+
+  private:
+    int m_ImageDimension;
+    int m_LambertDimension;
+    float m_SphereRadius;
+
+    // For each row the half open range of columns that are inside the unit circle and the index
+    // of the first of those pixels in the packed per pixel arrays below.
+    std::vector<int> m_RowStart;
+    std::vector<int> m_RowEnd;
+    std::vector<size_t> m_RowOffset;
+
+    // 2 samples per pixel (the direction and its antipode), each with 4 bins into the combined
+    // north/south squares and the X/Y interpolation offsets.
+    std::vector<int> m_Bins;
+    std::vector<float> m_Mods;
+
+    StereographicLookupTable(const StereographicLookupTable&) = delete; // Copy Constructor Not Implemented
+    void operator=(const StereographicLookupTable&) = delete;           // Move assignment Not Implemented
+};
@@ -0,0 +1,421 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/Geometry/TriangleGeom.h"
+
+/**
+ * @brief The TriangleBVH class is a bounding volume hierarchy over a set of triangles from a
+ * TriangleGeom, usually the faces that bound a single Feature. It answers point in polyhedron
+ * queries for the closed surface formed by those triangles by casting a ray from the query
+ * point and counting crossings, only visiting the triangles whose boxes the ray passes through.
+ *
+ * The class is header only so that any plugin working on TriangleGeom objects can use it.
+ */
+class TriangleBVH
+{
+public:
+  /**
+   * @brief Builds the hierarchy over the listed triangles
+   * @param triangles Triangle geometry holding the triangles
+   * @param faceIds Indices of the triangles to include
+   * @param numFaces Number of entries in faceIds
+   */
+  TriangleBVH(TriangleGeom* triangles, const int32_t* faceIds, size_t numFaces)
+  {
+    float* vertices = triangles->getVertexPointer(0);
+    int64_t* tris = triangles->getTriPointer(0);
+
+    std::vector<float> centroids(3 * numFaces);
+    m_Triangles.resize(9 * numFaces);
+    for(size_t f = 0; f < numFaces; f++)
+    {
+      int64_t faceId = static_cast<int64_t>(faceIds[f]);
+      for(size_t v = 0; v < 3; v++)
+      {
+        const float* coords = vertices + 3 * tris[3 * faceId + v];
+        for(size_t d = 0; d < 3; d++)
+        {
+          m_Triangles[9 * f + 3 * v + d] = static_cast<double>(coords[d]);
+          centroids[3 * f + d] += coords[d] / 3.0f;
+        }
+      }
+    }
+
+    std::vector<uint32_t> order(numFaces);
+    for(size_t f = 0; f < numFaces; f++)
+    {
+      order[f] = static_cast<uint32_t>(f);
+    }
+    if(numFaces > 0)
+    {
+      m_Nodes.reserve(2 * (numFaces / k_LeafSize + 1));
+      build(order, centroids, 0, static_cast<uint32_t>(numFaces));
+    }
+
+    // Store the triangles in leaf order so each leaf reads one contiguous block
+    std::vector<double> sorted(m_Triangles.size());
+    for(size_t f = 0; f < numFaces; f++)
+    {
+      std::copy(m_Triangles.begin() + 9 * order[f], m_Triangles.begin() + 9 * order[f] + 9, sorted.begin() + 9 * f);
+    }
+    m_Triangles.swap(sorted);
+
+    if(!m_Nodes.empty())
+    {
+      double diagonal = 0.0;
+      for(size_t d = 0; d < 3; d++)
+      {
+        double extent = static_cast<double>(m_Nodes[0].max[d]) - static_cast<double>(m_Nodes[0].min[d]);
+        diagonal += extent * extent;
+      }
+      m_Diagonal = std::sqrt(diagonal);
+    }
+  }
+
+  virtual ~TriangleBVH() = default;
+
+  /**
+   * @brief Returns the number of triangles in the hierarchy
+   */
+  size_t getNumberOfTriangles() const
+  {
+    return m_Triangles.size() / 9;
+  }
+
+  /**
+   * @brief Returns the axis aligned bounding box of all the triangles
+   * @param ll Lower corner
+   * @param ur Upper corner
+   */
+  void getBounds(float* ll, float* ur) const
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      ll[d] = m_Nodes.empty() ? 0.0f : m_Nodes[0].min[d];
+      ur[d] = m_Nodes.empty() ? 0.0f : m_Nodes[0].max[d];
+    }
+  }
+
+  /**
+   * @brief Classifies a point against the closed surface formed by the triangles
+   * @param point Query point
+   * @return 'i' if the point is inside, 'o' if it is outside and 'F' if it lies on one of
+   * the triangles, matching the codes of GeometryMath::PointInPolyhedron. If every ray
+   * direction is degenerate the point can not be classified and '?' is returned.
+   */
+  char pointInPolyhedron(const float* point) const
+  {
+    if(m_Nodes.empty())
+    {
+      return 'o';
+    }
+    const double q[3] = {point[0], point[1], point[2]};
+    const double tolerance = k_RelativeTolerance * m_Diagonal;
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(q[d] < m_Nodes[0].min[d] - tolerance || q[d] > m_Nodes[0].max[d] + tolerance)
+      {
+        return 'o';
+      }
+    }
+
+    // A ray that grazes an edge or vertex, or runs inside the plane of a triangle, makes the
+    // crossing count ambiguous, so such a ray is thrown away and the next direction tried
+    static const size_t numDirections = 8;
+    static const double directions[numDirections][3] = {{0.617213, 0.428746, 0.659743},   {-0.381128, 0.814699, 0.437010},   {0.290336, -0.518974, 0.804029},
+                                                        {-0.701319, -0.333913, 0.629828}, {0.881137, 0.231019, -0.412615},   {-0.136708, -0.917668, -0.373147},
+                                                        {0.447735, -0.739822, -0.502236}, {-0.586231, 0.191304, -0.787232}};
+    for(size_t attempt = 0; attempt < numDirections; attempt++)
+    {
+      size_t crossings = 0;
+      Crossing result = castRay(q, directions[attempt], tolerance, crossings);
+      if(result == Crossing::OnSurface)
+      {
+        return 'F';
+      }
+      if(result != Crossing::Degenerate)
+      {
+        return (crossings % 2 == 1) ? 'i' : 'o';
+      }
+    }
+    return '?';
+  }
+
+protected:
+  enum class Crossing
+  {
+    Miss,
+    Hit,
+    OnSurface,
+    Degenerate
+  };
+
+  struct Node
+  {
+    float min[3];
+    float max[3];
+    uint32_t start;
+    uint32_t count;    // Number of triangles for a leaf, 0 for an interior node
+    uint32_t rightChild; // The left child always directly follows its parent
+  };
+
+  static const uint32_t k_LeafSize = 4;
+  static constexpr double k_RelativeTolerance = 1.0e-7;
+  static constexpr double k_BarycentricTolerance = 1.0e-9;
+
+  /**
+   * @brief Recursively splits the triangles [start, end) at the median centroid along the
+   * longest axis of their centroid bounds
+   */
+  uint32_t build(std::vector<uint32_t>& order, const std::vector<float>& centroids, uint32_t start, uint32_t end)
+  {
+    uint32_t nodeIndex = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.push_back(Node());
+    Node node;
+    float cmin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float cmax[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for(size_t d = 0; d < 3; d++)
+    {
+      node.min[d] = std::numeric_limits<float>::max();
+      node.max[d] = std::numeric_limits<float>::lowest();
+    }
+    for(uint32_t f = start; f < end; f++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        for(size_t v = 0; v < 3; v++)
+        {
+          float coord = static_cast<float>(m_Triangles[9 * order[f] + 3 * v + d]);
+          node.min[d] = std::min(node.min[d], coord);
+          node.max[d] = std::max(node.max[d], coord);
+        }
+        cmin[d] = std::min(cmin[d], centroids[3 * order[f] + d]);
+        cmax[d] = std::max(cmax[d], centroids[3 * order[f] + d]);
+      }
+    }
+    node.start = start;
+    node.count = end - start;
+    node.rightChild = 0;
+
+    if(end - start > k_LeafSize)
+    {
+      size_t axis = 0;
+      for(size_t d = 1; d < 3; d++)
+      {
+        if(cmax[d] - cmin[d] > cmax[axis] - cmin[axis])
+        {
+          axis = d;
+        }
+      }
+      uint32_t mid = start + (end - start) / 2;
+      std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + end,
+                       [&centroids, axis](uint32_t lhs, uint32_t rhs) { return centroids[3 * lhs + axis] < centroids[3 * rhs + axis]; });
+      node.count = 0;
+      build(order, centroids, start, mid);
+      node.rightChild = build(order, centroids, mid, end);
+    }
+    m_Nodes[nodeIndex] = node;
+    return nodeIndex;
+  }
+
+  /**
+   * @brief Casts a ray from q along direction and counts the triangles it crosses
+   */
+  Crossing castRay(const double q[3], const double direction[3], double tolerance, size_t& crossings) const
+  {
+    const double length = 2.0 * m_Diagonal + 1.0;
+    double inverse[3] = {0.0, 0.0, 0.0};
+    for(size_t d = 0; d < 3; d++)
+    {
+      inverse[d] = 1.0 / direction[d];
+    }
+
+    uint32_t stack[64];
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+      const Node& node = m_Nodes[stack[--stackSize]];
+      if(!rayHitsBox(q, inverse, length, tolerance, node))
+      {
+        continue;
+      }
+      if(node.count == 0)
+      {
+        stack[stackSize++] = node.rightChild;
+        stack[stackSize++] = static_cast<uint32_t>(&node - m_Nodes.data()) + 1;
+        continue;
+      }
+      for(uint32_t f = node.start; f < node.start + node.count; f++)
+      {
+        Crossing result = crossTriangle(q, direction, length, tolerance, &m_Triangles[9 * f]);
+        if(result == Crossing::Hit)
+        {
+          crossings++;
+        }
+        else if(result != Crossing::Miss)
+        {
+          return result;
+        }
+      }
+    }
+    return Crossing::Miss;
+  }
+
+  /**
+   * @brief Slab test of the segment [q, q + length * direction] against a node box grown by tolerance
+   */
+  static bool rayHitsBox(const double q[3], const double inverse[3], double length, double tolerance, const Node& node)
+  {
+    double tNear = 0.0;
+    double tFar = length;
+    for(size_t d = 0; d < 3; d++)
+    {
+      double t0 = (node.min[d] - tolerance - q[d]) * inverse[d];
+      double t1 = (node.max[d] + tolerance - q[d]) * inverse[d];
+      if(t0 > t1)
+      {
+        std::swap(t0, t1);
+      }
+      tNear = std::max(tNear, t0);
+      tFar = std::min(tFar, t1);
+      if(tNear > tFar)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Moller-Trumbore intersection of the ray with one triangle, also detecting a query
+   * point lying on the triangle and rays that touch an edge or vertex
+   */
+  static Crossing crossTriangle(const double q[3], const double direction[3], double length, double tolerance, const double* tri)
+  {
+    double e1[3], e2[3], s[3], normal[3], p[3], qv[3];
+    for(size_t d = 0; d < 3; d++)
+    {
+      e1[d] = tri[3 + d] - tri[d];
+      e2[d] = tri[6 + d] - tri[d];
+      s[d] = q[d] - tri[d];
+    }
+    Cross(e1, e2, normal);
+    double normalLength = std::sqrt(Dot(normal, normal));
+    if(normalLength == 0.0)
+    {
+      // Collapsed triangles enclose nothing
+      return Crossing::Miss;
+    }
+
+    // Points within tolerance of the plane are either on the triangle or the crossing is
+    // decided right at the query point, which makes the ray ambiguous
+    double planeDistance = Dot(normal, s) / normalLength;
+    bool inPlane = std::fabs(planeDistance) <= tolerance;
+    if(inPlane)
+    {
+      double e1e1 = Dot(e1, e1), e1e2 = Dot(e1, e2), e2e2 = Dot(e2, e2);
+      double se1 = Dot(s, e1), se2 = Dot(s, e2);
+      double denom = e1e1 * e2e2 - e1e2 * e1e2;
+      double u = (e2e2 * se1 - e1e2 * se2) / denom;
+      double v = (e1e1 * se2 - e1e2 * se1) / denom;
+      double eps = tolerance / std::sqrt(std::max(e1e1, e2e2));
+      if(u >= -eps && v >= -eps && u + v <= 1.0 + eps)
+      {
+        return Crossing::OnSurface;
+      }
+    }
+
+    Cross(direction, e2, p);
+    double det = Dot(e1, p);
+    if(std::fabs(det) <= k_BarycentricTolerance * normalLength)
+    {
+      // The ray runs parallel to the triangle; it only matters if it runs inside its plane
+      return inPlane ? Crossing::Degenerate : Crossing::Miss;
+    }
+    if(inPlane)
+    {
+      // The ray leaves the plane at the query point, which lies outside the triangle
+      return Crossing::Miss;
+    }
+    double invDet = 1.0 / det;
+    double u = Dot(s, p) * invDet;
+    if(u < -k_BarycentricTolerance || u > 1.0 + k_BarycentricTolerance)
+    {
+      return Crossing::Miss;
+    }
+    Cross(s, e1, qv);
+    double v = Dot(direction, qv) * invDet;
+    if(v < -k_BarycentricTolerance || u + v > 1.0 + k_BarycentricTolerance)
+    {
+      return Crossing::Miss;
+    }
+    double t = Dot(e2, qv) * invDet;
+    if(t <= 0.0 || t > length)
+    {
+      return Crossing::Miss;
+    }
+    if(u <= k_BarycentricTolerance || v <= k_BarycentricTolerance || u + v >= 1.0 - k_BarycentricTolerance)
+    {
+      return Crossing::Degenerate;
+    }
+    return Crossing::Hit;
+  }
+
+  static double Dot(const double a[3], const double b[3])
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  static void Cross(const double a[3], const double b[3], double c[3])
+  {
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+  }
+
+private:
+  std::vector<Node> m_Nodes;
+  std::vector<double> m_Triangles;
+  double m_Diagonal = 0.0;
+};
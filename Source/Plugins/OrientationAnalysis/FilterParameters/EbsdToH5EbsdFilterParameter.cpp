@@ -90,6 +90,9 @@ void EbsdToH5EbsdFilterParameter::readJson(const QJsonObject& json)
   m_Filter->setFileSuffix(json["FileSuffix"].toString());
   m_Filter->setFileExtension(json["FileExtension"].toString());
   m_Filter->setPaddingDigits(json["PaddingDigits"].toInt());
+  m_Filter->setChunkedDatasets(json["ChunkedDatasets"].toBool(false));
+  m_Filter->setChunkRows(json["ChunkRows"].toInt(64));
+  m_Filter->setCompressionLevel(json["CompressionLevel"].toInt(6));
 
   QJsonObject sampleTransObj = json["SampleTransformation"].toObject();
   AxisAngleInput_t sampleTrans;
@@ -117,6 +120,9 @@ void EbsdToH5EbsdFilterParameter::writeJson(QJsonObject& json)
   json["FileSuffix"] = m_Filter->getFileSuffix();
   json["FileExtension"] = m_Filter->getFileExtension();
   json["PaddingDigits"] = m_Filter->getPaddingDigits();
+  json["ChunkedDatasets"] = m_Filter->getChunkedDatasets();
+  json["ChunkRows"] = m_Filter->getChunkRows();
+  json["CompressionLevel"] = m_Filter->getCompressionLevel();
 
   QJsonObject sampleTransObj;
   AxisAngleInput_t sampleTrans = m_Filter->getSampleTransformation();
@@ -42,7 +42,7 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/SIMPLibVersion.h"
 
-#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/LaueOps/SO3Sampler.h"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
@@ -63,6 +63,7 @@ EMsoftSO3Sampler::EMsoftSO3Sampler()
 , m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
 , m_EMsoftAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
 , m_EulerAngles(nullptr)
+, m_FZSampler(SO3Sampler::New())
 {
   m_RefOr.x = 0.0;
   m_RefOr.y = 0.0;
@@ -283,102 +284,62 @@ void EMsoftSO3Sampler::execute()
     return;
   }
 
-  OrientationListArrayType FZlist;
   typedef OrientationTransforms<DOrientArrayType, double> OrientationTransformsType;
 
-  if(getsampleModeSelector() == 0)
-  {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
-    double x, y, z, delta;
-    int32_t FZtype, FZorder;
-
-    // step size for sampling of grid; maximum total number of samples = pow(2*getNumsp()+1,3)
-    delta = (0.50 * LPs::ap) / static_cast<double>(getNumsp());
-
-    // do we need to shift this array away from the origin?
-    double gridShift = 0.0;
-    if(getOffsetGrid())
-    {
-      gridShift = 0.5;
-    }
+  // resize the EulerAngles array to the number of samples; don't forget to redefine the hard pointer
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
+  auto allocateEulerAngles = [this, &am](size_t count) {
+    QVector<size_t> tDims(1, count);
+    am->resizeAttributeArrays(tDims);
+    m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
+  };
 
-    // determine which function we should call for this point group symmetry
-    FZtype = OrientationAnalysisConstants::FZtarray[getPointGroup() - 1];
-    FZorder = OrientationAnalysisConstants::FZoarray[getPointGroup() - 1];
+  // store a Rodrigues vector as Euler angles in the m_EulerAngles array; convert doubles to floats along the way
+  auto storeEulerAngles = [this](size_t index, const DOrientArrayType& rod) {
+    DEuler3Type eu;
+    OrientationTransformsType::ro2eu(rod, eu);
+    m_EulerAngles[index * 3 + 0] = static_cast<float>(eu[0]);
+    m_EulerAngles[index * 3 + 1] = static_cast<float>(eu[1]);
+    m_EulerAngles[index * 3 + 2] = static_cast<float>(eu[2]);
+  };
 
+  if(getsampleModeSelector() == 0)
+  {
     // loop over the cube of volume pi^2; note that we do not want to include
     // the opposite edges/facets of the cube, to avoid double counting rotations
     // with a rotation angle of 180 degrees.  This only affects the cyclic groups.
+    // The sampler first finds the RFZ points of every i-slab, then the EulerAngles
+    // array is allocated once and each slab is written directly at its offset.
+    SO3Sampler::Pointer sampler = SO3Sampler::New();
+    SO3Sampler::CubochoricGrid grid = SO3Sampler::DictionaryGrid(getNumsp(), getOffsetGrid());
+
     int Np = getNumsp();
     int Totp = (2 * Np + 1) * (2 * Np + 1) * (2 * Np + 1);
-    int Dn = Totp / 10;
-    int Dc = Dn;
-    int Di = 0;
-    int Dg = 0;
-
-    // eliminate points for which any of the coordinates lies outside the cube with semi-edge length "edge"
-    double edge = 0.5 * LPs::ap;
-
-    for(int i = -Np + 1; i < Np + 1; i++)
+    size_t slabPoints = static_cast<size_t>(grid.last - grid.first + 1) * static_cast<size_t>(grid.last - grid.first + 1);
+
+    // report on status of computation after each group of slabs
+    auto progress = [this, Totp, slabPoints](size_t slabsDone, size_t insideFZ) {
+      QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(slabsDone * slabPoints), QString::number(Totp), QString::number(insideFZ));
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      return !getCancel();
+    };
+
+    SO3Sampler::RFZSlabs slabs;
+    size_t Dg = sampler->CountRFZ(grid, getPointGroup(), slabs, progress);
+    if(getCancel())
     {
-      x = (static_cast<double>(i) + gridShift) * delta;
-
-      if(fabs(x) <= edge)
-      {
-
-        for(int j = -Np + 1; j < Np + 1; j++)
-        {
-          y = (static_cast<double>(j) + gridShift) * delta;
-
-          if(fabs(y) <= edge)
-          {
-
-            for(int k = -Np + 1; k < Np + 1; k++)
-            {
-              z = (static_cast<double>(k) + gridShift) * delta;
-
-              if(fabs(z) <= edge)
-              {
-
-                // convert to Rodrigues representation
-                DOrientArrayType cu(x, y, z);
-                DOrientArrayType rod(4);
-                OrientationTransformsType::cu2ro(cu, rod);
-
-                // If insideFZ=true, then add this point to FZlist
-                bool b = IsinsideFZ(rod.data(), FZtype, FZorder);
-                if(b)
-                {
-                  FZlist.push_back(rod);
-                  Dg += 1;
-                }
-                Di += 1;
-              }
-            }
-          }
-        }
-      }
-
-      // report on status of computation
-      if(Di > Dc)
-      {
-        QString ss = QString("Euler Angles | Tested: %1 of %2 | Inside RFZ: %3 ").arg(QString::number(Di), QString::number(Totp), QString::number(Dg));
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        Dc += Dn;
-      }
-      if(getCancel())
-      {
-        break;
-      }
+      return;
     }
+
+    allocateEulerAngles(Dg);
+    sampler->SampleRFZEulers(grid, slabs, m_EulerAngles);
   }
 
   // here are the misorientation sampling cases:
   if(getsampleModeSelector() != 0)
   {
-    // here we perform the actual calculation; once we have the FZlist,
-    // we can allocate the data array and copy all entries
+    // the number of samples is known up front, so the data array is allocated
+    // first and each sample is written at its index
     double x, y, z, delta, omega, semi;
 
     // step size for sampling of grid; the edge length of the cube is (pi ( w - sin(w) ))^1/3 with w the misorientation angle
@@ -404,6 +365,7 @@ void EMsoftSO3Sampler::execute()
       int Dn = Totp / 20;
       int Dc = Dn;
       int Dg = 0;
+      allocateEulerAngles(Totp);
 
       // x-y bottom and top planes
       for(int i = -Np; i <= Np; i++)
@@ -414,19 +376,19 @@ void EMsoftSO3Sampler::execute()
           y = static_cast<double>(j) * delta;
           // convert to Rodrigues representation and apply Rodrigues composition formula
           {
-            DOrientArrayType cu(-x, -y, -semi);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(-x, -y, -semi);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
           {
-            DOrientArrayType cu(-x, -y, semi);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(-x, -y, semi);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
         }
@@ -444,19 +406,19 @@ void EMsoftSO3Sampler::execute()
           z = static_cast<double>(k) * delta;
           // convert to Rodrigues representation and apply Rodrigues composition formula
           {
-            DOrientArrayType cu(-semi, -y, -z);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(-semi, -y, -z);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
           {
-            DOrientArrayType cu(semi, -y, -z);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(semi, -y, -z);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
         }
@@ -474,19 +436,19 @@ void EMsoftSO3Sampler::execute()
           z = static_cast<double>(k) * delta;
           // convert to Rodrigues representation and apply Rodrigues composition formula
           {
-            DOrientArrayType cu(-x, -semi, -z);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(-x, -semi, -z);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
           {
-            DOrientArrayType cu(-x, semi, -z);
-            DOrientArrayType rod(4);
+            DCubochoric3Type cu(-x, semi, -z);
+            DRod4Type rod;
             OrientationTransformsType::cu2ro(cu, rod);
             RodriguesComposition(sigma, rod);
-            FZlist.push_back(rod);
+            storeEulerAngles(Dg, rod);
             Dg += 1;
           }
         }
@@ -503,6 +465,12 @@ void EMsoftSO3Sampler::execute()
         notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
         Dc += Dn;
       }
+
+      // a cancelled run only keeps the samples that were generated
+      if(Dg < Totp)
+      {
+        allocateEulerAngles(Dg);
+      }
     }
     else
     {
@@ -512,6 +480,7 @@ void EMsoftSO3Sampler::execute()
       int Dn = Totp / 20;
       int Dc = Dn;
       int Dg = 0;
+      allocateEulerAngles(Totp);
 
       for(int i = -Np; i <= Np; i++)
       {
@@ -524,11 +493,11 @@ void EMsoftSO3Sampler::execute()
             z = static_cast<double>(k) * delta;
             // convert to Rodrigues representation and apply Rodrigues composition formula
             {
-              DOrientArrayType cu(-x, -y, -z);
-              DOrientArrayType rod(4);
+              DCubochoric3Type cu(-x, -y, -z);
+              DRod4Type rod;
               OrientationTransformsType::cu2ro(cu, rod);
               RodriguesComposition(sigma, rod);
-              FZlist.push_back(rod);
+              storeEulerAngles(Dg, rod);
               Dg += 1;
             }
           }
@@ -540,27 +509,18 @@ void EMsoftSO3Sampler::execute()
           notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
           Dc += Dn;
         }
+        if(getCancel())
+        {
+          break;
+        }
       }
-    }
-  }
-
-  // resize the EulerAngles array to the number of items in FZlist; don't forget to redefine the hard pointer
-  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(DataArrayPath(getDataContainerName(), getEMsoftAttributeMatrixName(), ""));
-  QVector<size_t> tDims(1, FZlist.size());
-  am->resizeAttributeArrays(tDims);
-  m_EulerAngles = m_EulerAnglesPtr.lock()->getPointer(0);
 
-  // copy the Rodrigues vectors as Euler angles into the m_EulerAngles array; convert doubles to floats along the way
-  int j = -1;
-  for(DOrientArrayType rod : FZlist)
-  {
-    j += 1;
-    DOrientArrayType eu(3, 0.0);
-    OrientationTransformsType::ro2eu(rod, eu);
-
-    m_EulerAngles[j * 3 + 0] = static_cast<float>(eu[0]);
-    m_EulerAngles[j * 3 + 1] = static_cast<float>(eu[1]);
-    m_EulerAngles[j * 3 + 2] = static_cast<float>(eu[2]);
+      // a cancelled run only keeps the samples that were generated
+      if(Dg < Totp)
+      {
+        allocateEulerAngles(Dg);
+      }
+    }
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -569,9 +529,9 @@ void EMsoftSO3Sampler::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void EMsoftSO3Sampler::RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod)
+void EMsoftSO3Sampler::RodriguesComposition(const DOrientArrayType& sigma, DOrientArrayType& rod)
 {
-  DOrientArrayType rho(3), rhomis(3);
+  OrientationFixed<double, 3> rho, rhomis;
   rho[0] = -rod[0] * rod[3];
   rho[1] = -rod[1] * rod[3];
   rho[2] = -rod[2] * rod[3];
@@ -617,34 +577,7 @@ void EMsoftSO3Sampler::RodriguesComposition(DOrientArrayType sigma, DOrientArray
 // -----------------------------------------------------------------------------
 bool EMsoftSO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder)
 {
-  bool insideFZ = false;
-  // dealing with 180 rotations is needed only for
-  // FZtypes 0 and 1; the other FZs are always finite.
-  switch(FZtype)
-  {
-  case OrientationAnalysisConstants::AnorthicType:
-    insideFZ = true; // all points are inside the FZ
-    break;
-  case OrientationAnalysisConstants::CyclicType:
-    insideFZ = insideCyclicFZ(rod, FZorder); // infinity is checked inside this function
-    break;
-  case OrientationAnalysisConstants::DihedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideDihedralFZ(rod, FZorder);
-    break;
-  case OrientationAnalysisConstants::TetrahedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideCubicFZ(rod, OrientationAnalysisConstants::TetrahedralType);
-    break;
-  case OrientationAnalysisConstants::OctahedralType:
-    if(!std::isinf(rod[3]))
-      insideFZ = insideCubicFZ(rod, OrientationAnalysisConstants::OctahedralType);
-    break;
-  default:
-    insideFZ = false;
-    break;
-  }
-  return insideFZ;
+  return m_FZSampler->IsinsideFZ(rod, FZtype, FZorder);
 }
 
 // -----------------------------------------------------------------------------
@@ -652,19 +585,7 @@ bool EMsoftSO3Sampler::IsinsideFZ(double* rod, int FZtype, int FZorder)
 // -----------------------------------------------------------------------------
 bool EMsoftSO3Sampler::insideCyclicFZ(double* rod, int order)
 {
-
-  bool insideFZ = false;
-
-  if(! std::isinf(rod[3]))
-  {
-    // check the z-component vs. tan(pi/2n)
-    insideFZ = fabs(rod[2] * rod[3]) <= LPs::BP[order - 1];
-  }
-  else if(rod[2] == 0.0)
-  {
-    insideFZ = true;
-  }
-  return insideFZ;
+  return m_FZSampler->insideCyclicFZ(rod, order);
 }
 
 // -----------------------------------------------------------------------------
@@ -672,47 +593,7 @@ bool EMsoftSO3Sampler::insideCyclicFZ(double* rod, int order)
 // -----------------------------------------------------------------------------
 bool EMsoftSO3Sampler::insideDihedralFZ(double* rod, int order)
 {
-
-  bool res = false, c1 = false, c2 = false;
-  double r[3] = {rod[0] * rod[3], rod[1] * rod[3], rod[2] * rod[3]};
-  const double r1 = 1.0;
-
-  // first, check the z-component vs. tan(pi/2n)  (same as insideCyclicFZ)
-  c1 = fabs(r[2]) <= LPs::BP[order - 1];
-  res = false;
-
-  // check the square boundary planes if c1=true
-  if(c1)
-  {
-    switch(order)
-    {
-    case OrientationAnalysisConstants::TwoFoldAxisOrder:
-      c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-      break;
-    case OrientationAnalysisConstants::ThreeFoldAxisOrder:
-      c2 = fabs(LPs::srt * r[0] + 0.50 * r[1]) <= r1;
-      c2 = c2 && (fabs(LPs::srt * r[0] - 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(r[1]) <= r1);
-      break;
-    case OrientationAnalysisConstants::FourFoldAxisOrder:
-      c2 = (fabs(r[0]) <= r1) && (fabs(r[1]) <= r1);
-      c2 = c2 && ((LPs::r22 * fabs(r[0] + r[1]) <= r1) && (LPs::r22 * fabs(r[0] - r[1]) <= r1));
-      break;
-    case OrientationAnalysisConstants::SixFoldAxisOrder:
-      c2 = fabs(0.50 * r[0] + LPs::srt * r[1]) <= r1;
-      c2 = c2 && (fabs(LPs::srt * r[0] + 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(LPs::srt * r[0] - 0.50 * r[1]) <= r1);
-      c2 = c2 && (fabs(0.50 * r[0] - LPs::srt * r[1]) <= r1);
-      c2 = c2 && (fabs(r[1]) <= r1);
-      c2 = c2 && (fabs(r[0]) <= r1);
-      break;
-    default:
-      res = false;
-      break;
-    }
-    res = c2;
-  }
-  return res;
+  return m_FZSampler->insideDihedralFZ(rod, order);
 }
 
 // -----------------------------------------------------------------------------
@@ -720,36 +601,7 @@ bool EMsoftSO3Sampler::insideDihedralFZ(double* rod, int order)
 // -----------------------------------------------------------------------------
 bool EMsoftSO3Sampler::insideCubicFZ(double* rod, int ot)
 {
-  bool res = false, c1 = false, c2 = false;
-  std::vector<double> r(3);
-  r[0] = rod[0] * rod[3];
-  r[1] = rod[1] * rod[3];
-  r[2] = rod[2] * rod[3];
-  const double r1 = 1.0;
-
-  // primary cube planes (only needed for octahedral case)
-  if(ot == OrientationAnalysisConstants::OctahedralType)
-  {
-
-    typedef OrientationTransforms<std::vector<double>, double> OrientationTransformsType;
-
-    c1 = OrientationTransformsType::OMHelperType::maxval(OrientationTransformsType::OMHelperType::absValue(r)) <= LPs::BP[3];
-  }
-  else
-  {
-    c1 = true;
-  }
-
-  // octahedral truncation planes, both for tetrahedral and octahedral point groups
-  c2 = ((fabs(r[0]) + fabs(r[1]) + fabs(r[2])) <= r1);
-
-  // if both c1 and c2, then the point is inside
-  if(c1 && c2)
-  {
-    res = true;
-  }
-
-  return res;
+  return m_FZSampler->insideCubicFZ(rod, ot);
 }
 
 // -----------------------------------------------------------------------------
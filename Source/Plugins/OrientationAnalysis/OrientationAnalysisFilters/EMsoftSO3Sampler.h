@@ -36,6 +36,7 @@
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
+#include "OrientationLib/LaueOps/SO3Sampler.h"
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 
@@ -169,7 +170,7 @@ public:
    * @param sigma
    * @param rod
    */
-  void RodriguesComposition(DOrientArrayType sigma, DOrientArrayType& rod);
+  void RodriguesComposition(const DOrientArrayType& sigma, DOrientArrayType& rod);
 
   /**
    * @brief OrientationListArrayType
@@ -253,6 +254,9 @@ protected:
 private:
   DEFINE_DATAARRAY_VARIABLE(float, EulerAngles)
 
+  // The FZ tests are the ones in SO3Sampler, which is what the sampling itself uses
+  SO3Sampler::Pointer m_FZSampler;
+
 public:
   EMsoftSO3Sampler(const EMsoftSO3Sampler&) = delete; // Copy Constructor Not Implemented
   EMsoftSO3Sampler(EMsoftSO3Sampler&&) = delete;      // Move Constructor
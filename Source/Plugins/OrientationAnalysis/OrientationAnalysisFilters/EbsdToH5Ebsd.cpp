@@ -35,6 +35,9 @@
 
 #include "EbsdToH5Ebsd.h"
 
+#include <atomic>
+#include <memory>
+
 #include <QtCore/QDir>
 
 #include "H5Support/QH5Utilities.h"
@@ -44,6 +47,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
 
+#include "EbsdLib/EbsdReader.h"
 #include "EbsdLib/HKL/H5CtfImporter.h"
 #include "EbsdLib/TSL/H5AngImporter.h"
 
@@ -51,6 +55,24 @@
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+/**
+ * @brief Carries one input file through the parse and write stages of the import
+ */
+struct EbsdSliceToken
+{
+  int32_t fileIndex = 0;
+  int readError = 0;
+  std::shared_ptr<EbsdReader> reader;
+};
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -65,6 +87,9 @@ EbsdToH5Ebsd::EbsdToH5Ebsd()
 , m_FileSuffix("")
 , m_FileExtension("ang")
 , m_PaddingDigits(4)
+, m_ChunkedDatasets(false)
+, m_ChunkRows(64)
+, m_CompressionLevel(6)
 {
   m_SampleTransformation.angle = 0.0f;
   m_SampleTransformation.h = 0.0f;
@@ -113,6 +138,9 @@ void EbsdToH5Ebsd::readFilterParameters(AbstractFilterParametersReader* reader,
   setPaddingDigits(reader->readValue("PaddingDigits", getPaddingDigits()));
   setSampleTransformation(reader->readAxisAngle("SampleTransformation", getSampleTransformation(), -1));
   setEulerTransformation(reader->readAxisAngle("EulerTransformation", getEulerTransformation(), -1));
+  setChunkedDatasets(reader->readValue("ChunkedDatasets", getChunkedDatasets()));
+  setChunkRows(reader->readValue("ChunkRows", getChunkRows()));
+  setCompressionLevel(reader->readValue("CompressionLevel", getCompressionLevel()));
   reader->closeFilterGroup();
 }
 
@@ -380,6 +408,10 @@ void EbsdToH5Ebsd::execute()
     return;
   }
 
+  fileImporter->setChunkedDatasets(m_ChunkedDatasets);
+  fileImporter->setChunkRows(m_ChunkRows);
+  fileImporter->setCompressionLevel(m_CompressionLevel);
+
   QVector<int32_t> indices;
   // Loop on Each EBSD File
   float total = static_cast<float>(m_ZEndIndex - m_ZStartIndex);
@@ -413,20 +445,21 @@ void EbsdToH5Ebsd::execute()
   int64_t biggestxDim = 0;
   int64_t biggestyDim = 0;
   int32_t totalSlicesImported = 0;
-  for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
-  {
-    QString ebsdFName = *filepath;
+
+  // Stores one parsed file into the HDF5 file. This is only ever called for one file
+  // at a time and always in slice order. Returns false if the import has to stop.
+  auto writeSlice = [&](const QString& ebsdFName, EbsdReader* reader, int readError) -> bool {
     progress = static_cast<int32_t>(z - m_ZStartIndex);
     progress = (int32_t)(100.0f * (float)(progress) / total);
     QString msg = "Converting File: " + ebsdFName;
 
     notifyStatusMessage(getHumanLabel(), msg.toLatin1().data());
-    err = fileImporter->importFile(fileId, z, ebsdFName);
+    err = fileImporter->writeFile(fileId, z, reader, readError);
     if(err < 0)
     {
       setErrorCondition(err);
       notifyErrorMessage(getHumanLabel(), fileImporter->getPipelineMessage(), fileImporter->getErrorCondition());
-      return;
+      return false;
     }
     totalSlicesImported = totalSlicesImported + fileImporter->numberOfSlicesImported();
 
@@ -441,20 +474,72 @@ void EbsdToH5Ebsd::execute()
       biggestyDim = yDim;
     }
 
-    if(err < 0)
-    {
-      QString ss = QObject::tr("Could not write dataset for slice to HDF5 file");
-      setErrorCondition(-1);
-      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-    }
-
     indices.push_back(static_cast<int32_t>(z));
     ++z;
-    if(getCancel())
+    return (getCancel() == false);
+  };
+
+  bool importComplete = true;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = (fileList.size() > 1);
+  if(doParallel == true)
+  {
+    // Parse several files at once while a single stage writes them to the HDF5 file in order.
+    // The number of tokens bounds how many parsed files can be held in memory at any time.
+    fileImporter->setParallelParsing(false);
+    size_t maxFilesInFlight = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads()) + 1;
+    int32_t numFiles = fileList.size();
+    int32_t nextFile = 0;
+    std::atomic<bool> stopImport(false);
+
+    tbb::parallel_pipeline(maxFilesInFlight,
+                           tbb::make_filter<void, EbsdSliceToken*>(tbb::filter::serial_in_order,
+                                                                   [&](tbb::flow_control& fc) -> EbsdSliceToken* {
+                                                                     if(stopImport || nextFile >= numFiles)
+                                                                     {
+                                                                       fc.stop();
+                                                                       return nullptr;
+                                                                     }
+                                                                     EbsdSliceToken* token = new EbsdSliceToken;
+                                                                     token->fileIndex = nextFile++;
+                                                                     return token;
+                                                                   }) &
+                               tbb::make_filter<EbsdSliceToken*, EbsdSliceToken*>(tbb::filter::parallel,
+                                                                                  [&](EbsdSliceToken* token) -> EbsdSliceToken* {
+                                                                                    if(stopImport == false)
+                                                                                    {
+                                                                                      token->reader = fileImporter->readFile(fileList[token->fileIndex], token->readError);
+                                                                                    }
+                                                                                    return token;
+                                                                                  }) &
+                               tbb::make_filter<EbsdSliceToken*, void>(tbb::filter::serial_in_order, [&](EbsdSliceToken* token) {
+                                 if(stopImport == false && writeSlice(fileList[token->fileIndex], token->reader.get(), token->readError) == false)
+                                 {
+                                   stopImport = true;
+                                 }
+                                 delete token;
+                               }));
+    importComplete = (stopImport == false);
+  }
+  else
+#endif
+  {
+    for(QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
     {
-      return;
+      int readError = 0;
+      std::shared_ptr<EbsdReader> reader = fileImporter->readFile(*filepath, readError);
+      if(writeSlice(*filepath, reader.get(), readError) == false)
+      {
+        importComplete = false;
+        break;
+      }
     }
   }
+  if(importComplete == false)
+  {
+    return;
+  }
 
   // Write Z index start, Z index end and Z Resolution to the HDF5 file
   err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, m_ZStartIndex);
@@ -541,6 +626,9 @@ AbstractFilter::Pointer EbsdToH5Ebsd::newFilterInstance(bool copyFilterParameter
     SIMPL_COPY_INSTANCEVAR(PaddingDigits)
     SIMPL_COPY_INSTANCEVAR(SampleTransformation)
     SIMPL_COPY_INSTANCEVAR(EulerTransformation)
+    SIMPL_COPY_INSTANCEVAR(ChunkedDatasets)
+    SIMPL_COPY_INSTANCEVAR(ChunkRows)
+    SIMPL_COPY_INSTANCEVAR(CompressionLevel)
   }
   return filter;
 }
@@ -59,6 +59,9 @@ class OrientationAnalysis_EXPORT EbsdToH5Ebsd : public AbstractFilter
     PYB11_PROPERTY(int PaddingDigits READ getPaddingDigits WRITE setPaddingDigits)
     PYB11_PROPERTY(AxisAngleInput_t SampleTransformation READ getSampleTransformation WRITE setSampleTransformation)
     PYB11_PROPERTY(AxisAngleInput_t EulerTransformation READ getEulerTransformation WRITE setEulerTransformation)
+    PYB11_PROPERTY(bool ChunkedDatasets READ getChunkedDatasets WRITE setChunkedDatasets)
+    PYB11_PROPERTY(int ChunkRows READ getChunkRows WRITE setChunkRows)
+    PYB11_PROPERTY(int CompressionLevel READ getCompressionLevel WRITE setCompressionLevel)
 public:
   SIMPL_SHARED_POINTERS(EbsdToH5Ebsd)
   SIMPL_FILTER_NEW_MACRO(EbsdToH5Ebsd)
@@ -90,6 +93,15 @@ public:
 
   SIMPL_FILTER_PARAMETER(AxisAngleInput_t, EulerTransformation)
 
+  /**
+   * @brief Writes the data columns as chunked, deflate compressed data sets
+   */
+  SIMPL_INSTANCE_PROPERTY(bool, ChunkedDatasets)
+
+  SIMPL_INSTANCE_PROPERTY(int, ChunkRows)
+
+  SIMPL_INSTANCE_PROPERTY(int, CompressionLevel)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
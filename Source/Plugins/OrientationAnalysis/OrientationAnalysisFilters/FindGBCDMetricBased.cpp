@@ -45,6 +45,9 @@
 
 #include "FindGBCDMetricBased.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -62,6 +65,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/UnitNormalGrid.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -314,20 +318,23 @@ public:
 
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBCD
+ * for the GBCD. Only the triangles whose first normal lies near the sampling direction (or its
+ * inverse) can fall within the plane resolution, so each sampling point looks those up in a
+ * UnitNormalGrid instead of visiting every selected triangle.
  */
 class ProbeDistrib
 {
   QVector<double>* distribValues;
   QVector<double>* errorValues;
-  QVector<float> samplPtsX;
-  QVector<float> samplPtsY;
-  QVector<float> samplPtsZ;
+  QVector<float>* samplPtsX;
+  QVector<float>* samplPtsY;
+  QVector<float>* samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>& selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>& selectedTris;
 #endif
+  const UnitNormalGrid& normalGrid;
   float planeResolSq;
   double totalFaceArea;
   int numDistinctGBs;
@@ -335,19 +342,20 @@ class ProbeDistrib
   float (&gFixedT)[3][3];
 
 public:
-  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float> __samplPtsX, QVector<float> __samplPtsY, QVector<float> __samplPtsZ,
+  ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>& __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>& __selectedTris,
 #endif
-               float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
+               const UnitNormalGrid& __normalGrid, float __planeResolSq, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, float (&__gFixedT)[3][3])
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalGrid(__normalGrid)
   , planeResolSq(__planeResolSq)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
@@ -362,32 +370,39 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<int64_t> candidates;
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
-      float fixedNormal1[3] = {samplPtsX.at(ptIdx), samplPtsY.at(ptIdx), samplPtsZ.at(ptIdx)};
+      float fixedNormal1[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
       float fixedNormal2[3] = {0.0f, 0.0f, 0.0f};
       MatrixMath::Multiply3x3with3x1(gFixedT, fixedNormal1, fixedNormal2);
+      float invertedNormal1[3] = {-fixedNormal1[0], -fixedNormal1[1], -fixedNormal1[2]};
+
+      // Candidates are stored as 2 * triangle + inversion and sorted, so the areas are summed in
+      // the same order as a loop over all triangles and both inversions would
+      candidates.clear();
+      normalGrid.forEachNormalNear(fixedNormal1, [&](int64_t triRepresIdx) { candidates.push_back(2 * triRepresIdx); });
+      normalGrid.forEachNormalNear(invertedNormal1, [&](int64_t triRepresIdx) { candidates.push_back(2 * triRepresIdx + 1); });
+      std::sort(candidates.begin(), candidates.end());
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      for(int64_t candidate : candidates)
       {
-        for(int inversion = 0; inversion <= 1; inversion++)
+        const TriAreaAndNormals& tri = selectedTris[candidate / 2];
+        float sign = 1.0f;
+        if(candidate % 2 == 1)
         {
-          float sign = 1.0f;
-          if(inversion == 1)
-            sign = -1.0f;
+          sign = -1.0f;
+        }
 
-          float theta1 = acosf(sign * (selectedTris[triRepresIdx].normal_grain1_x * fixedNormal1[0] + selectedTris[triRepresIdx].normal_grain1_y * fixedNormal1[1] +
-                                       selectedTris[triRepresIdx].normal_grain1_z * fixedNormal1[2]));
+        float theta1 = acosf(sign * (tri.normal_grain1_x * fixedNormal1[0] + tri.normal_grain1_y * fixedNormal1[1] + tri.normal_grain1_z * fixedNormal1[2]));
 
-          float theta2 = acosf(-sign * (selectedTris[triRepresIdx].normal_grain2_x * fixedNormal2[0] + selectedTris[triRepresIdx].normal_grain2_y * fixedNormal2[1] +
-                                        selectedTris[triRepresIdx].normal_grain2_z * fixedNormal2[2]));
+        float theta2 = acosf(-sign * (tri.normal_grain2_x * fixedNormal2[0] + tri.normal_grain2_y * fixedNormal2[1] + tri.normal_grain2_z * fixedNormal2[2]));
 
-          float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
+        float distSq = 0.5f * (theta1 * theta1 + theta2 * theta2);
 
-          if(distSq < planeResolSq)
-          {
-            (*distribValues)[ptIdx] += selectedTris[triRepresIdx].area;
-          }
+        if(distSq < planeResolSq)
+        {
+          (*distribValues)[ptIdx] += tri.area;
         }
       }
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
@@ -1020,6 +1035,17 @@ void FindGBCDMetricBased::execute()
     totalFaceArea += m_FaceAreas[triIdx] * double(triIncluded.at(triIdx));
   }
 
+  // A triangle can only be within the plane resolution of a sampling point if its first normal is
+  // within sqrt(2) times the plane resolution of the point (or its inverse)
+  std::vector<float> selectedNormals(3 * selectedTris.size(), 0.0f);
+  for(size_t i = 0; i < selectedTris.size(); i++)
+  {
+    selectedNormals[3 * i] = selectedTris[i].normal_grain1_x;
+    selectedNormals[3 * i + 1] = selectedTris[i].normal_grain1_y;
+    selectedNormals[3 * i + 2] = selectedTris[i].normal_grain1_z;
+  }
+  UnitNormalGrid normalGrid(selectedNormals.data(), selectedTris.size(), sqrtf(2.0f * m_PlaneResolSq));
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1046,13 +1072,13 @@ void FindGBCDMetricBased::execute()
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
+                        GBCDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, normalGrid, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, samplPtsX, samplPtsY, samplPtsZ, selectedTris, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
+      GBCDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, normalGrid, m_PlaneResolSq, totalFaceArea, numDistinctGBs, ballVolume, gFixedT);
       serial.probe(i, i + pointsChunkSize);
     }
   }
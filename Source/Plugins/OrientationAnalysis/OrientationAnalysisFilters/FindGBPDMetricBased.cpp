@@ -45,6 +45,9 @@
 
 #include "FindGBPDMetricBased.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -62,6 +65,7 @@
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/UnitNormalGrid.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
@@ -241,9 +245,20 @@ public:
 #endif
 };
 
+/**
+ * @brief The SymOp class holds one symmetry operator of the Laue class as a rotation matrix
+ */
+class SymOp
+{
+public:
+  float mat[3][3];
+};
+
 /**
  * @brief The ProbeDistrib class implements a threaded algorithm that determines the distribution values
- * for the GBPD
+ * for the GBPD. Both normals of every selected triangle are held in a UnitNormalGrid, so for each
+ * symmetry operator and inversion a sampling point only visits the normals that can lie within
+ * the limiting distance instead of every selected triangle.
  */
 class ProbeDistrib
 {
@@ -253,40 +268,45 @@ class ProbeDistrib
   QVector<float>* samplPtsY;
   QVector<float>* samplPtsZ;
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  tbb::concurrent_vector<TriAreaAndNormals> selectedTris;
+  const tbb::concurrent_vector<TriAreaAndNormals>& selectedTris;
 #else
-  QVector<TriAreaAndNormals> selectedTris;
+  const QVector<TriAreaAndNormals>& selectedTris;
 #endif
+  const UnitNormalGrid& normalGrid;
   float limitDist;
   double totalFaceArea;
   int numDistinctGBs;
   double ballVolume;
-  QVector<LaueOps::Pointer> m_OrientationOps;
-  uint32_t cryst;
+  std::vector<SymOp> symOps;
   int32_t nsym;
 
 public:
   ProbeDistrib(QVector<double>* __distribValues, QVector<double>* __errorValues, QVector<float>* __samplPtsX, QVector<float>* __samplPtsY, QVector<float>* __samplPtsZ,
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-               tbb::concurrent_vector<TriAreaAndNormals> __selectedTris,
+               const tbb::concurrent_vector<TriAreaAndNormals>& __selectedTris,
 #else
-               QVector<TriAreaAndNormals> __selectedTris,
+               const QVector<TriAreaAndNormals>& __selectedTris,
 #endif
-               float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
+               const UnitNormalGrid& __normalGrid, float __limitDist, double __totalFaceArea, int __numDistinctGBs, double __ballVolume, int32_t __cryst)
   : distribValues(__distribValues)
   , errorValues(__errorValues)
   , samplPtsX(__samplPtsX)
   , samplPtsY(__samplPtsY)
   , samplPtsZ(__samplPtsZ)
   , selectedTris(__selectedTris)
+  , normalGrid(__normalGrid)
   , limitDist(__limitDist)
   , totalFaceArea(__totalFaceArea)
   , numDistinctGBs(__numDistinctGBs)
   , ballVolume(__ballVolume)
-  , cryst(__cryst)
   {
-    m_OrientationOps = LaueOps::getOrientationOpsQVector();
-    nsym = m_OrientationOps[__cryst]->getNumSymOps();
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+    nsym = orientationOps[__cryst]->getNumSymOps();
+    symOps.resize(nsym);
+    for(int j = 0; j < nsym; j++)
+    {
+      orientationOps[__cryst]->getMatSymOp(j, symOps[j].mat);
+    }
   }
 
   virtual ~ProbeDistrib()
@@ -295,58 +315,75 @@ public:
 
   void probe(size_t start, size_t end) const
   {
+    std::vector<int64_t> candidates;
     for(size_t ptIdx = start; ptIdx < end; ptIdx++)
     {
       double __c = 0.0;
 
       float probeNormal[3] = {(*samplPtsX).at(ptIdx), (*samplPtsY).at(ptIdx), (*samplPtsZ).at(ptIdx)};
 
-      for(int triRepresIdx = 0; triRepresIdx < static_cast<int>(selectedTris.size()); triRepresIdx++)
+      // The normal of grain (0 or 1) of a triangle is entry 2 * triangle + grain in the grid. The
+      // angle between the probe and a normal rotated by a symmetry operator is the angle between
+      // the normal and the probe rotated back, so each operator and inversion is one grid search.
+      // Candidates are keyed by (triangle, operator, inversion, grain) and sorted so the areas are
+      // summed in the same order as a loop over all triangles would.
+      candidates.clear();
+      for(int j = 0; j < nsym; j++)
       {
-        float normal1[3] = {selectedTris[triRepresIdx].normal_grain1_x, selectedTris[triRepresIdx].normal_grain1_y, selectedTris[triRepresIdx].normal_grain1_z};
+        float symT[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+        MatrixMath::Transpose3x3(symOps[j].mat, symT);
+        float probeInCrystal[3] = {0.0f, 0.0f, 0.0f};
+        MatrixMath::Multiply3x3with3x1(symT, probeNormal, probeInCrystal);
 
-        float normal2[3] = {selectedTris[triRepresIdx].normal_grain2_x, selectedTris[triRepresIdx].normal_grain2_y, selectedTris[triRepresIdx].normal_grain2_z};
+        for(int inversion = 0; inversion <= 1; inversion++)
+        {
+          if(inversion == 1)
+          {
+            probeInCrystal[0] = -probeInCrystal[0];
+            probeInCrystal[1] = -probeInCrystal[1];
+            probeInCrystal[2] = -probeInCrystal[2];
+          }
+          normalGrid.forEachNormalNear(probeInCrystal, [&](int64_t normalIdx) {
+            int64_t triRepresIdx = normalIdx / 2;
+            int64_t grain = normalIdx % 2;
+            candidates.push_back(((triRepresIdx * nsym + j) * 2 + inversion) * 2 + grain);
+          });
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
 
-        float sym[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+      for(int64_t candidate : candidates)
+      {
+        int64_t grain = candidate % 2;
+        int64_t inversion = (candidate / 2) % 2;
+        int64_t j = (candidate / 4) % nsym;
+        const TriAreaAndNormals& tri = selectedTris[candidate / 4 / nsym];
 
-        for(int j = 0; j < nsym; j++)
+        float normal[3] = {tri.normal_grain1_x, tri.normal_grain1_y, tri.normal_grain1_z};
+        if(grain == 1)
         {
-          m_OrientationOps[cryst]->getMatSymOp(j, sym);
+          normal[0] = tri.normal_grain2_x;
+          normal[1] = tri.normal_grain2_y;
+          normal[2] = tri.normal_grain2_z;
+        }
 
-          float sym_normal1[3] = {0.0f, 0.0f, 0.0f};
-          float sym_normal2[3] = {0.0f, 0.0f, 0.0f};
+        float sym_normal[3] = {0.0f, 0.0f, 0.0f};
+        MatrixMath::Multiply3x3with3x1(symOps[j].mat, normal, sym_normal);
 
-          MatrixMath::Multiply3x3with3x1(sym, normal1, sym_normal1);
-          MatrixMath::Multiply3x3with3x1(sym, normal2, sym_normal2);
+        float sign = 1.0f;
+        if(inversion == 1)
+          sign = -1.0f;
 
-          for(int inversion = 0; inversion <= 1; inversion++)
-          {
-            float sign = 1.0f;
-            if(inversion == 1)
-              sign = -1.0f;
-
-            float gamma1 = acosf(sign * (probeNormal[0] * sym_normal1[0] + probeNormal[1] * sym_normal1[1] + probeNormal[2] * sym_normal1[2]));
-
-            float gamma2 = acosf(sign * (probeNormal[0] * sym_normal2[0] + probeNormal[1] * sym_normal2[1] + probeNormal[2] * sym_normal2[2]));
-
-            if(gamma1 < limitDist)
-            {
-              // Kahan summation algorithm
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
-            if(gamma2 < limitDist)
-            {
-              double __y = selectedTris[triRepresIdx].area - __c;
-              double __t = (*distribValues)[ptIdx] + __y;
-              __c = (__t - (*distribValues)[ptIdx]);
-              __c -= __y;
-              (*distribValues)[ptIdx] = __t;
-            }
-          }
+        float gamma = acosf(sign * (probeNormal[0] * sym_normal[0] + probeNormal[1] * sym_normal[1] + probeNormal[2] * sym_normal[2]));
+
+        if(gamma < limitDist)
+        {
+          // Kahan summation algorithm
+          double __y = tri.area - __c;
+          double __t = (*distribValues)[ptIdx] + __y;
+          __c = (__t - (*distribValues)[ptIdx]);
+          __c -= __y;
+          (*distribValues)[ptIdx] = __t;
         }
       }
       (*errorValues)[ptIdx] = sqrt((*distribValues)[ptIdx] / totalFaceArea / double(numDistinctGBs)) / ballVolume;
@@ -1099,6 +1136,19 @@ void FindGBPDMetricBased::execute()
     totalFaceArea += selectedTris.at(i).area;
   }
 
+  // Both normals of each selected triangle are searched for sampling points within the limiting distance
+  std::vector<float> selectedNormals(6 * selectedTris.size(), 0.0f);
+  for(size_t i = 0; i < selectedTris.size(); i++)
+  {
+    selectedNormals[6 * i] = selectedTris[i].normal_grain1_x;
+    selectedNormals[6 * i + 1] = selectedTris[i].normal_grain1_y;
+    selectedNormals[6 * i + 2] = selectedTris[i].normal_grain1_z;
+    selectedNormals[6 * i + 3] = selectedTris[i].normal_grain2_x;
+    selectedNormals[6 * i + 4] = selectedTris[i].normal_grain2_y;
+    selectedNormals[6 * i + 5] = selectedTris[i].normal_grain2_z;
+  }
+  UnitNormalGrid normalGrid(selectedNormals.data(), 2 * selectedTris.size(), m_LimitDist);
+
   QVector<double> distribValues(samplPtsX.size(), 0.0);
   QVector<double> errorValues(samplPtsX.size(), 0.0);
 
@@ -1125,13 +1175,13 @@ void FindGBPDMetricBased::execute()
     if(doParallel == true)
     {
       tbb::parallel_for(tbb::blocked_range<size_t>(i, i + pointsChunkSize),
-                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
+                        GBPDMetricBased::ProbeDistrib(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, normalGrid, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst),
                         tbb::auto_partitioner());
     }
     else
 #endif
     {
-      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
+      GBPDMetricBased::ProbeDistrib serial(&distribValues, &errorValues, &samplPtsX, &samplPtsY, &samplPtsZ, selectedTris, normalGrid, m_LimitDist, totalFaceArea, numDistinctGBs, ballVolume, cryst);
       serial.probe(i, i + pointsChunkSize);
     }
   }
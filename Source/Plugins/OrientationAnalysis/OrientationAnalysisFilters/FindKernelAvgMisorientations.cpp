@@ -35,6 +35,15 @@
 
 #include "FindKernelAvgMisorientations.h"
 
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -48,6 +57,158 @@
 
 #include "EbsdLib/EbsdConstants.h"
 
+/**
+ * @brief The FindKernelAvgMisorientationsImpl class computes the kernel average misorientation
+ * for a range of Z planes. Cells are visited in memory order (x fastest) so that neighboring
+ * kernels touch the same cache lines, and each cell's kernel sum is accumulated in the same
+ * order as the serial algorithm so the results do not depend on how the work is split.
+ */
+class FindKernelAvgMisorientationsImpl
+{
+public:
+  FindKernelAvgMisorientationsImpl(int32_t* featureIds, int32_t* cellPhases, uint32_t* crystalStructures, float* quats, float* kernelAvgMisorientations, int64_t dims[3],
+                                   IntVec3_t kernelSize, const QVector<LaueOps::Pointer>& orientationOps)
+  : m_FeatureIds(featureIds)
+  , m_CellPhases(cellPhases)
+  , m_CrystalStructures(crystalStructures)
+  , m_Quats(reinterpret_cast<QuatF*>(quats))
+  , m_KernelAverageMisorientations(kernelAvgMisorientations)
+  , m_KernelSize(kernelSize)
+  , m_OrientationOps(orientationOps)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  virtual ~FindKernelAvgMisorientationsImpl()
+  {
+  }
+
+  void compute(int64_t zStart, int64_t zEnd) const
+  {
+    int64_t xPoints = m_Dims[0];
+    int64_t yPoints = m_Dims[1];
+    int64_t zPoints = m_Dims[2];
+
+    // The kernel neighbors of each cell are gathered first and then handed to
+    // the LaueOps class as a single batch of misorientation computations
+    size_t kernelVolume = static_cast<size_t>((2 * m_KernelSize.x + 1) * (2 * m_KernelSize.y + 1) * (2 * m_KernelSize.z + 1));
+    std::vector<QuatF> q1s;
+    std::vector<QuatF> q2s;
+    std::vector<float> angles(kernelVolume, 0.0f);
+    q1s.reserve(kernelVolume);
+    q2s.reserve(kernelVolume);
+
+    int32_t numVoxel = 0; // number of voxels in the feature...
+    bool good = false;
+    float w = 0.0f, totalmisorientation = 0.0f;
+    uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
+    int64_t point = 0;
+    size_t neighbor = 0;
+    int64_t jStride = 0;
+    int64_t kStride = 0;
+
+    for(int64_t plane = zStart; plane < zEnd; plane++)
+    {
+      for(int64_t row = 0; row < yPoints; row++)
+      {
+        for(int64_t col = 0; col < xPoints; col++)
+        {
+          point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+          if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
+          {
+            totalmisorientation = 0.0f;
+            numVoxel = 0;
+            q1s.clear();
+            q2s.clear();
+            phase1 = m_CrystalStructures[m_CellPhases[point]];
+            for(int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
+            {
+              jStride = j * xPoints * yPoints;
+              for(int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
+              {
+                kStride = k * xPoints;
+                for(int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
+                {
+                  good = true;
+                  neighbor = point + (jStride) + (kStride) + (l);
+                  if(plane + j < 0)
+                  {
+                    good = false;
+                  }
+                  else if(plane + j > zPoints - 1)
+                  {
+                    good = false;
+                  }
+                  else if(row + k < 0)
+                  {
+                    good = false;
+                  }
+                  else if(row + k > yPoints - 1)
+                  {
+                    good = false;
+                  }
+                  else if(col + l < 0)
+                  {
+                    good = false;
+                  }
+                  else if(col + l > xPoints - 1)
+                  {
+                    good = false;
+                  }
+                  if(good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
+                  {
+                    q1s.push_back(m_Quats[point]);
+                    q2s.push_back(m_Quats[neighbor]);
+                    numVoxel++;
+                  }
+                }
+              }
+            }
+            if(angles.size() < q2s.size())
+            {
+              angles.resize(q2s.size());
+            }
+            m_OrientationOps[phase1]->getMisoQuatBatch(q1s.data(), q2s.data(), q2s.size(), angles.data(), nullptr);
+            for(size_t b = 0; b < q2s.size(); b++)
+            {
+              w = angles[b] * (180.0f / SIMPLib::Constants::k_Pi);
+              totalmisorientation = totalmisorientation + w;
+            }
+            m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
+            if(numVoxel == 0)
+            {
+              m_KernelAverageMisorientations[point] = 0.0f;
+            }
+          }
+          if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
+          {
+            m_KernelAverageMisorientations[point] = 0.0f;
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<int64_t>& r) const
+  {
+    compute(r.begin(), r.end());
+  }
+#endif
+
+private:
+  int32_t* m_FeatureIds;
+  int32_t* m_CellPhases;
+  uint32_t* m_CrystalStructures;
+  QuatF* m_Quats;
+  float* m_KernelAverageMisorientations;
+  int64_t m_Dims[3];
+  IntVec3_t m_KernelSize;
+  const QVector<LaueOps::Pointer>& m_OrientationOps;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -225,100 +386,30 @@ void FindKernelAvgMisorientations::execute()
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-
-  int32_t numVoxel = 0; // number of voxels in the feature...
-  bool good = false;
-
-  float w = 0.0f, totalmisorientation = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = Ebsd::CrystalStructure::UnknownCrystalStructure;
-  uint32_t phase2 = Ebsd::CrystalStructure::UnknownCrystalStructure;
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  int64_t xPoints = static_cast<int64_t>(udims[0]);
-  int64_t yPoints = static_cast<int64_t>(udims[1]);
-  int64_t zPoints = static_cast<int64_t>(udims[2]);
-  int64_t point = 0;
-  size_t neighbor = 0;
-  int64_t jStride = 0;
-  int64_t kStride = 0;
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
+  };
 
-  for(int64_t col = 0; col < xPoints; col++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
   {
-    for(int64_t row = 0; row < yPoints; row++)
-    {
-      for(int64_t plane = 0; plane < zPoints; plane++)
-      {
-        point = (plane * xPoints * yPoints) + (row * xPoints) + col;
-        if(m_FeatureIds[point] > 0 && m_CellPhases[point] > 0)
-        {
-          totalmisorientation = 0.0f;
-          numVoxel = 0;
-          QuaternionMathF::Copy(quats[point], q1);
-          phase1 = m_CrystalStructures[m_CellPhases[point]];
-          for(int32_t j = -m_KernelSize.z; j < m_KernelSize.z + 1; j++)
-          {
-            jStride = j * xPoints * yPoints;
-            for(int32_t k = -m_KernelSize.y; k < m_KernelSize.y + 1; k++)
-            {
-              kStride = k * xPoints;
-              for(int32_t l = -m_KernelSize.x; l < m_KernelSize.z + 1; l++)
-              {
-                good = true;
-                neighbor = point + (jStride) + (kStride) + (l);
-                if(plane + j < 0)
-                {
-                  good = false;
-                }
-                else if(plane + j > zPoints - 1)
-                {
-                  good = false;
-                }
-                else if(row + k < 0)
-                {
-                  good = false;
-                }
-                else if(row + k > yPoints - 1)
-                {
-                  good = false;
-                }
-                else if(col + l < 0)
-                {
-                  good = false;
-                }
-                else if(col + l > xPoints - 1)
-                {
-                  good = false;
-                }
-                if(good == true && m_FeatureIds[point] == m_FeatureIds[neighbor])
-                {
-                  w = std::numeric_limits<float>::max();
-                  QuaternionMathF::Copy(quats[neighbor], q2);
-                  phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
-                  totalmisorientation = totalmisorientation + w;
-                  numVoxel++;
-                }
-              }
-            }
-          }
-          m_KernelAverageMisorientations[point] = totalmisorientation / (float)numVoxel;
-          if(numVoxel == 0)
-          {
-            m_KernelAverageMisorientations[point] = 0.0f;
-          }
-        }
-        if(m_FeatureIds[point] == 0 || m_CellPhases[point] == 0)
-        {
-          m_KernelAverageMisorientations[point] = 0.0f;
-        }
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, dims[2]),
+                      FindKernelAvgMisorientationsImpl(m_FeatureIds, m_CellPhases, m_CrystalStructures, m_Quats, m_KernelAverageMisorientations, dims, m_KernelSize, m_OrientationOps),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindKernelAvgMisorientationsImpl serial(m_FeatureIds, m_CellPhases, m_CrystalStructures, m_Quats, m_KernelAverageMisorientations, dims, m_KernelSize, m_OrientationOps);
+    serial.compute(0, dims[2]);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -36,6 +36,7 @@
 #include "FindMisorientations.h"
 
 #include <cmath>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -239,49 +240,55 @@ void FindMisorientations::execute()
 
   std::vector<std::vector<float>> misorientationlists;
 
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float w = 0.0f;
   size_t tempMisoList = 0;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   uint32_t xtalType1 = 0, xtalType2 = 0;
   int32_t nname = 0;
 
+  // The misorientations for all valid neighbors of a feature are gathered and
+  // computed with a single batched call into the LaueOps class
+  std::vector<QuatF> q1s;
+  std::vector<QuatF> q2s;
+  std::vector<size_t> batchIndices;
+  std::vector<float> angles;
+
   misorientationlists.resize(totalFeatures);
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    QuaternionMathF::Copy(avgQuats[i], q1);
     xtalType1 = m_CrystalStructures[m_FeaturePhases[i]];
-    misorientationlists[i].assign(neighborlist[i].size(), -1.0);
-    for(size_t j = 0; j < neighborlist[i].size(); j++)
+    size_t numNeighbors = neighborlist[i].size();
+    misorientationlists[i].assign(numNeighbors, NAN);
+    q1s.clear();
+    q2s.clear();
+    batchIndices.clear();
+    for(size_t j = 0; j < numNeighbors; j++)
     {
-      w = std::numeric_limits<float>::max();
       nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
       xtalType2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      tempMisoList = neighborlist[i].size();
       if(xtalType1 == xtalType2 && xtalType1 < m_OrientationOps.size())
       {
-        w = m_OrientationOps[xtalType1]->getMisoQuat(q1, q2, n1, n2, n3);
-        misorientationlists[i][j] = w * SIMPLib::Constants::k_180OverPi;
-        if(m_FindAvgMisors == true)
-        {
-          m_AvgMisorientations[i] += misorientationlists[i][j];
-        }
+        q1s.push_back(avgQuats[i]);
+        q2s.push_back(avgQuats[nname]);
+        batchIndices.push_back(j);
       }
-      else
+    }
+    if(!batchIndices.empty())
+    {
+      angles.resize(batchIndices.size());
+      m_OrientationOps[xtalType1]->getMisoQuatBatch(q1s.data(), q2s.data(), batchIndices.size(), angles.data(), nullptr);
+      for(size_t b = 0; b < batchIndices.size(); b++)
       {
+        misorientationlists[i][batchIndices[b]] = angles[b] * SIMPLib::Constants::k_180OverPi;
         if(m_FindAvgMisors == true)
         {
-          tempMisoList--;
+          m_AvgMisorientations[i] += misorientationlists[i][batchIndices[b]];
         }
-        misorientationlists[i][j] = NAN;
       }
     }
     if(m_FindAvgMisors == true)
     {
+      tempMisoList = batchIndices.size();
       if(tempMisoList != 0)
       {
         m_AvgMisorientations[i] /= tempMisoList;
@@ -290,7 +297,6 @@ void FindMisorientations::execute()
       {
         m_AvgMisorientations[i] = NAN;
       }
-      tempMisoList = 0;
     }
   }
 
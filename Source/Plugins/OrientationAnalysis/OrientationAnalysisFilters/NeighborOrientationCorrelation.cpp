@@ -292,7 +292,6 @@ void NeighborOrientationCorrelation::execute()
   size_t count = 1;
   int32_t best = 0;
   bool good = true;
-  bool good2 = true;
   int64_t neighbor = 0;
   int64_t neighbor2 = 0;
   int64_t column = 0, row = 0, plane = 0;
@@ -306,10 +305,14 @@ void NeighborOrientationCorrelation::execute()
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
   float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
+  bool validNeighbor[6] = {false, false, false, false, false, false};
+  std::vector<uint32_t> pairOps;
+  std::vector<QuatF> q1s;
+  std::vector<QuatF> q2s;
+  std::vector<float> angles;
+  pairOps.reserve(21);
+  q1s.reserve(21);
+  q2s.reserve(21);
 
   std::vector<int32_t> neighborDiffCount(totalPoints, 0);
   std::vector<int32_t> neighborSimCount(6, 0);
@@ -371,17 +374,61 @@ void NeighborOrientationCorrelation::execute()
           {
             good = false;
           }
-          if(good == true)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
+          validNeighbor[j] = good;
+        }
 
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
+        // Gather every orientation pair in the order the comparisons are made
+        // below so the misorientations can be computed in batches
+        pairOps.clear();
+        q1s.clear();
+        q2s.clear();
+        for(size_t j = 0; j < 6; j++)
+        {
+          if(validNeighbor[j] == true)
+          {
+            neighbor = int64_t(i) + neighpoints[j];
+            if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
+            {
+              pairOps.push_back(m_CrystalStructures[m_CellPhases[i]]);
+              q1s.push_back(quats[i]);
+              q2s.push_back(quats[neighbor]);
+            }
+            for(size_t k = j + 1; k < 6; k++)
+            {
+              neighbor2 = int64_t(i) + neighpoints[k];
+              if(validNeighbor[k] == true && m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
+              {
+                pairOps.push_back(m_CrystalStructures[m_CellPhases[neighbor2]]);
+                q1s.push_back(quats[neighbor2]);
+                q2s.push_back(quats[neighbor]);
+              }
+            }
+          }
+        }
+        angles.resize(pairOps.size());
+        size_t runStart = 0;
+        while(runStart < pairOps.size())
+        {
+          size_t runEnd = runStart + 1;
+          while(runEnd < pairOps.size() && pairOps[runEnd] == pairOps[runStart])
+          {
+            runEnd++;
+          }
+          m_OrientationOps[pairOps[runStart]]->getMisoQuatBatch(q1s.data() + runStart, q2s.data() + runStart, runEnd - runStart, angles.data() + runStart, nullptr);
+          runStart = runEnd;
+        }
 
+        // Pairs that were not computed keep the previous value of w, exactly as
+        // the original per pair evaluation did
+        size_t pairIndex = 0;
+        for(size_t j = 0; j < 6; j++)
+        {
+          if(validNeighbor[j] == true)
+          {
+            neighbor = int64_t(i) + neighpoints[j];
             if(m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0)
             {
-              w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+              w = angles[pairIndex++];
             }
             if(w > misorientationToleranceR)
             {
@@ -389,42 +436,12 @@ void NeighborOrientationCorrelation::execute()
             }
             for(size_t k = j + 1; k < 6; k++)
             {
-              good2 = true;
               neighbor2 = int64_t(i) + neighpoints[k];
-              if(k == 0 && plane == 0)
-              {
-                good2 = false;
-              }
-              if(k == 5 && plane == (dims[2] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 1 && row == 0)
+              if(validNeighbor[k] == true)
               {
-                good2 = false;
-              }
-              if(k == 4 && row == (dims[1] - 1))
-              {
-                good2 = false;
-              }
-              if(k == 2 && column == 0)
-              {
-                good2 = false;
-              }
-              if(k == 3 && column == (dims[0] - 1))
-              {
-                good2 = false;
-              }
-              if(good2 == true)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
                 if(m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
                 {
-                  w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+                  w = angles[pairIndex++];
                 }
                 if(w < misorientationToleranceR)
                 {
@@ -35,10 +35,13 @@
 
 #include "ReadEdaxH5Data.h"
 
+#include <algorithm>
+
 #include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
 
 #include "EbsdLib/TSL/AngFields.h"
+#include "EbsdLib/TSL/H5OIMPatternReader.h"
 #include "EbsdLib/TSL/H5OIMReader.h"
 
 #include "SIMPLib/Common/Constants.h"
@@ -412,6 +415,7 @@ void ReadEdaxH5Data::readDataFile(H5OIMReader* reader, DataContainer::Pointer m,
   {
     float zStep = static_cast<float>(getZSpacing()), xOrigin = getOrigin().x, yOrigin = getOrigin().y, zOrigin = getOrigin().z;
     reader->setReadPatternData(getReadPatternData());
+    reader->setStreamPatternData(true);
 
     // If the user has already set a Scan Name to read then we are good to go.
     reader->setHDF5Path(scanName);
@@ -660,29 +664,49 @@ void ReadEdaxH5Data::copyRawEbsdData(H5OIMReader* reader, QVector<size_t>& tDims
     ebsdAttrMat->addAttributeArray(Ebsd::Ang::Fit, fArray);
   }
 
-  if(getReadPatternData()) // Get the pattern Data from the
+  if(getReadPatternData()) // Stream the pattern data straight into the Cell array
   {
-    uint8_t* ptr = reader->getPatternData();
     int32_t pDims[2] = {0, 0};
     reader->getPatternDims(pDims);
 
     if(pDims[0] != 0 && pDims[1] != 0)
     {
-      QVector<size_t> pDimsV(2);
-      pDimsV[0] = pDims[0];
-      pDimsV[1] = pDims[1];
+      H5OIMPatternReader::Pointer patternReader = H5OIMPatternReader::New();
+      patternReader->setFileName(reader->getFileName());
+      patternReader->setHDF5Path(reader->getHDF5Path());
+      int32_t err = patternReader->open();
+      if(err >= 0 && patternReader->getNumberOfPatterns() < totalPoints)
+      {
+        err = -90706;
+        patternReader->setErrorMessage(QObject::tr("The scan '%1' holds %2 patterns but %3 are needed").arg(reader->getHDF5Path()).arg(patternReader->getNumberOfPatterns()).arg(totalPoints));
+      }
+      if(err < 0)
+      {
+        setErrorCondition(err);
+        notifyErrorMessage(getHumanLabel(), patternReader->getErrorMessage(), getErrorCondition());
+        return;
+      }
 
+      // Read a window of patterns at a time so that only that part of the data set is ever touched
       UInt8ArrayType::Pointer patternData = std::dynamic_pointer_cast<UInt8ArrayType>(m_EbsdArrayMap.value(Ebsd::Ang::PatternData));
-      ::memcpy(patternData->getPointer(offset), ptr, sizeof(uint8_t) * totalPoints);
+      size_t patternSize = patternReader->getPatternSize();
+      size_t window = patternReader->getBlockSize();
+      for(size_t start = 0; start < totalPoints; start += window)
+      {
+        if(getCancel())
+        {
+          return;
+        }
+        size_t count = std::min(window, totalPoints - start);
+        err = patternReader->readPatterns(start, count, patternData->getPointer((offset + start) * patternSize));
+        if(err < 0)
+        {
+          setErrorCondition(err);
+          notifyErrorMessage(getHumanLabel(), patternReader->getErrorMessage(), getErrorCondition());
+          return;
+        }
+      }
       ebsdAttrMat->addAttributeArray(Ebsd::Ang::PatternData, patternData);
-
-      // Remove the current PatternData array
-      ebsdAttrMat->removeAttributeArray(Ebsd::Ang::PatternData);
-
-      // Push in our own PatternData array
-      ebsdAttrMat->addAttributeArray(patternData->getName(), patternData);
-      // Set the readers pattern data pointer to nullptr so that reader does not "free" the memory
-      reader->setPatternData(nullptr);
     }
   }
 }
@@ -553,25 +553,16 @@ void ReadH5Ebsd::execute()
   ebsdReader->setSliceEnd(m_ZEndIndex);
   ebsdReader->readAllArrays(false);
   ebsdReader->setArraysToRead(m_SelectedArrayNames);
-  err = ebsdReader->loadData(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
-  if(err < 0)
-  {
-    setErrorCondition(err);
-    notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
-    notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
-    return;
-  }
 
-  // Copy the data from the pointers embedded in the reader object into our data container (Cell array).
+  // Create the Cell arrays up front and have the reader fill them straight from the file
   if(manufacturer.compare(Ebsd::Ang::Manufacturer) == 0)
   {
-    copyTSLArrays(ebsdReader.get());
+    createTSLArrays(ebsdReader.get());
   }
   else if(manufacturer.compare(Ebsd::Ctf::Manufacturer) == 0)
   {
-    copyHKLArrays(ebsdReader.get());
+    createHKLArrays(ebsdReader.get());
   }
-
   else
   {
     QString ss =
@@ -581,6 +572,19 @@ void ReadH5Ebsd::execute()
     return;
   }
 
+  err = ebsdReader->loadDataDirect(m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints(), m_RefFrameZDir);
+  ebsdReader->clearDestinationPointers();
+  if(err < 0)
+  {
+    setErrorCondition(err);
+    notifyErrorMessage(ebsdReader->getNameOfClass(), ebsdReader->getErrorMessage(), getErrorCondition());
+    notifyErrorMessage(getHumanLabel(), "Error Loading Data from Ebsd Data file.", -1);
+    return;
+  }
+
+  // The Euler angles were read as stored in the file so convert them in place
+  convertEulerAngles(manufacturer.compare(Ebsd::Ctf::Manufacturer) == 0);
+
   if(m_UseTransformations == true)
   {
 
@@ -804,13 +808,8 @@ H5EbsdVolumeReader::Pointer ReadH5Ebsd::initHKLEbsdVolumeReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::createTSLArrays(H5EbsdVolumeReader* ebsdReader)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
@@ -822,100 +821,45 @@ void ReadH5Ebsd::copyTSLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   QVector<size_t> cDims(1, 1);
   if(m_SelectedArrayNames.find(m_CellPhasesArrayName) != m_SelectedArrayNames.end())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ang::PhaseData));
     iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+    ebsdReader->setDestinationPointer(Ebsd::Ang::PhaseData, iArray->getPointer(0));
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
   }
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Phi2));
     cDims[0] = 3;
     fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    float degToRad = 1.0f;
-    if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
-    {
-      degToRad = SIMPLib::Constants::k_PiOver180;
-    }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-    }
+    ebsdReader->setDestinationPointer(Ebsd::Ang::Phi1, fArray->getPointer(0), 3, 0);
+    ebsdReader->setDestinationPointer(Ebsd::Ang::Phi, fArray->getPointer(0), 3, 1);
+    ebsdReader->setDestinationPointer(Ebsd::Ang::Phi2, fArray->getPointer(0), 3, 2);
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
   }
 
   // Reset this back to 1 for the rest of the arrays
   cDims[0] = 1;
 
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ImageQuality) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ImageQuality));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ImageQuality);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ImageQuality, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::ConfidenceIndex) != m_SelectedArrayNames.end())
+  QStringList floatNames;
+  floatNames << Ebsd::Ang::ImageQuality << Ebsd::Ang::ConfidenceIndex << Ebsd::Ang::SEMSignal << Ebsd::Ang::Fit << Ebsd::Ang::XPosition << Ebsd::Ang::YPosition;
+  for(const QString& name : floatNames)
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::ConfidenceIndex));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::ConfidenceIndex);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::ConfidenceIndex, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::SEMSignal) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::SEMSignal));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::SEMSignal);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::SEMSignal, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::Fit) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::Fit));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::Fit);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::Fit, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::XPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::XPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::XPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::XPosition, fArray);
-  }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ang::YPosition) != m_SelectedArrayNames.end())
-  {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ang::YPosition));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ang::YPosition);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ang::YPosition, fArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      fArray = FloatArrayType::CreateArray(tDims, cDims, name);
+      ebsdReader->setDestinationPointer(name, fArray->getPointer(0));
+      cellAttrMatrix->addAttributeArray(name, fArray);
+    }
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
+void ReadH5Ebsd::createHKLArrays(H5EbsdVolumeReader* ebsdReader)
 {
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int32_t* phasePtr = nullptr;
-
   FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
   Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
@@ -926,94 +870,88 @@ void ReadH5Ebsd::copyHKLArrays(H5EbsdVolumeReader* ebsdReader)
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMatrix->resizeAttributeArrays(tDims); // Resize the attribute Matrix to the proper dimensions
 
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+  // The phases are always needed to correct the Euler angles of hexagonal phases
   QVector<size_t> cDims(1, 1);
-  phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Phase));
   iArray = Int32ArrayType::CreateArray(tDims, cDims, SIMPL::CellData::Phases);
-  ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
+  ebsdReader->setDestinationPointer(Ebsd::Ctf::Phase, iArray->getPointer(0));
   cellAttrMatrix->addAttributeArray(SIMPL::CellData::Phases, iArray);
 
   if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) != m_SelectedArrayNames.end())
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler1));
-    f2 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler2));
-    f3 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Euler3));
     cDims[0] = 3;
     fArray = FloatArrayType::CreateArray(tDims, cDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    int32_t* cellPhases = iArray->getPointer(0);
-    float degToRad = 1.0f;
-    if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
-    {
-      degToRad = SIMPLib::Constants::k_PiOver180;
-    }
-    for(size_t i = 0; i < totalPoints; i++)
-    {
-      cellEulerAngles[3 * i] = f1[i] * degToRad;
-      cellEulerAngles[3 * i + 1] = f2[i] * degToRad;
-      cellEulerAngles[3 * i + 2] = f3[i] * degToRad;
-      if(m_CrystalStructures[cellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
-      {
-        cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
-      }
-    }
+    ebsdReader->setDestinationPointer(Ebsd::Ctf::Euler1, fArray->getPointer(0), 3, 0);
+    ebsdReader->setDestinationPointer(Ebsd::Ctf::Euler2, fArray->getPointer(0), 3, 1);
+    ebsdReader->setDestinationPointer(Ebsd::Ctf::Euler3, fArray->getPointer(0), 3, 2);
     cellAttrMatrix->addAttributeArray(SIMPL::CellData::EulerAngles, fArray);
   }
 
   cDims[0] = 1;
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Bands) != m_SelectedArrayNames.end())
+  QStringList intNames;
+  intNames << Ebsd::Ctf::Bands << Ebsd::Ctf::Error << Ebsd::Ctf::BC << Ebsd::Ctf::BS;
+  for(const QString& name : intNames)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Bands));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Bands);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Bands, iArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      iArray = Int32ArrayType::CreateArray(tDims, cDims, name);
+      ebsdReader->setDestinationPointer(name, iArray->getPointer(0));
+      cellAttrMatrix->addAttributeArray(name, iArray);
+    }
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Error) != m_SelectedArrayNames.end())
+  QStringList floatNames;
+  floatNames << Ebsd::Ctf::MAD << Ebsd::Ctf::X << Ebsd::Ctf::Y;
+  for(const QString& name : floatNames)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::Error));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Error);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Error, iArray);
+    if(m_SelectedArrayNames.find(name) != m_SelectedArrayNames.end())
+    {
+      fArray = FloatArrayType::CreateArray(tDims, cDims, name);
+      ebsdReader->setDestinationPointer(name, fArray->getPointer(0));
+      cellAttrMatrix->addAttributeArray(name, fArray);
+    }
   }
+}
 
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::MAD) != m_SelectedArrayNames.end())
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadH5Ebsd::convertEulerAngles(bool hexagonalCorrection)
+{
+  if(m_SelectedArrayNames.find(m_CellEulerAnglesArrayName) == m_SelectedArrayNames.end())
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::MAD));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::MAD);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::MAD, fArray);
+    return;
   }
-
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BC) != m_SelectedArrayNames.end())
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  AttributeMatrix::Pointer cellAttrMatrix = m->getAttributeMatrix(getCellAttributeMatrixName());
+  FloatArrayType::Pointer fArray = cellAttrMatrix->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+  Int32ArrayType::Pointer iArray = cellAttrMatrix->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+  if(nullptr == fArray.get())
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BC));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BC);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BC, iArray);
+    return;
   }
 
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::BS) != m_SelectedArrayNames.end())
+  float degToRad = 1.0f;
+  if(m_AngleRepresentation != Ebsd::AngleRepresentation::Radians && m_UseTransformations == true)
   {
-    phasePtr = reinterpret_cast<int32_t*>(ebsdReader->getPointerByName(Ebsd::Ctf::BS));
-    iArray = Int32ArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::BS);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::BS, iArray);
+    degToRad = SIMPLib::Constants::k_PiOver180;
   }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::X) != m_SelectedArrayNames.end())
+  if(degToRad == 1.0f && hexagonalCorrection == false)
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::X));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::X);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::X, fArray);
+    return;
   }
-  if(m_SelectedArrayNames.find(Ebsd::Ctf::Y) != m_SelectedArrayNames.end())
+
+  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+  float* cellEulerAngles = fArray->getPointer(0);
+  int32_t* cellPhases = (nullptr != iArray.get()) ? iArray->getPointer(0) : nullptr;
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    f1 = reinterpret_cast<float*>(ebsdReader->getPointerByName(Ebsd::Ctf::Y));
-    fArray = FloatArrayType::CreateArray(tDims, cDims, Ebsd::Ctf::Y);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMatrix->addAttributeArray(Ebsd::Ctf::Y, fArray);
+    cellEulerAngles[3 * i] = cellEulerAngles[3 * i] * degToRad;
+    cellEulerAngles[3 * i + 1] = cellEulerAngles[3 * i + 1] * degToRad;
+    cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] * degToRad;
+    if(hexagonalCorrection == true && nullptr != cellPhases && m_CrystalStructures[cellPhases[i]] == Ebsd::CrystalStructure::Hexagonal_High)
+    {
+      cellEulerAngles[3 * i + 2] = cellEulerAngles[3 * i + 2] + (30.0 * degToRad);
+    }
   }
 }
 
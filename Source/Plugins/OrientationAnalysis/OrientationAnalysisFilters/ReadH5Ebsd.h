@@ -243,16 +243,24 @@ protected:
   H5EbsdVolumeReader::Pointer initHKLEbsdVolumeReader();
 
   /**
-   * @brief copyTSLArrays Copies the read arrays into the data container structure (TSL variant)
+   * @brief createTSLArrays Creates the selected Cell arrays in the data container and registers them
+   * with the reader so the data is loaded straight into them (TSL variant)
    * @param ebsdReader H5EbsdVolumeReader instance pointer
    */
-  void copyTSLArrays(H5EbsdVolumeReader* ebsdReader);
+  void createTSLArrays(H5EbsdVolumeReader* ebsdReader);
 
   /**
-   * @brief copyHKLArrays Copies the read arrays into the data container structure (HKL variant)
+   * @brief createHKLArrays Creates the selected Cell arrays in the data container and registers them
+   * with the reader so the data is loaded straight into them (HKL variant)
    * @param ebsdReader H5EbsdVolumeReader instance pointer
    */
-  void copyHKLArrays(H5EbsdVolumeReader* ebsdReader);
+  void createHKLArrays(H5EbsdVolumeReader* ebsdReader);
+
+  /**
+   * @brief convertEulerAngles Converts the loaded Euler angles to radians if needed
+   * @param hexagonalCorrection Adds 30 degrees to phi2 of hexagonal phases (HKL data)
+   */
+  void convertEulerAngles(bool hexagonalCorrection);
 
   /**
   * @brief loadInfo Reads the values for the phase type, crystal structure
@@ -128,6 +128,8 @@ if(1)
   addIpfHelper(Trigonal)
 endif()
 
+ADD_SIMPL_SUPPORT_HEADER_SUBDIR(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} UnitNormalGrid.hpp util)
+
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
@@ -62,6 +62,7 @@
 #include "OrientationLib/LaueOps/TriclinicOps.h"
 #include "OrientationLib/LaueOps/TrigonalLowOps.h"
 #include "OrientationLib/LaueOps/TrigonalOps.h"
+#include "OrientationLib/Utilities/StereographicLookupTable.h"
 
 #include "EbsdLib/EbsdConstants.h"
 
@@ -698,6 +699,10 @@ void WritePoleFigure::execute()
   // Find how many phases we have by getting the number of Crystal Structures
   size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
+  // Every phase is drawn with the same image and Lambert sizes so one stereographic lookup table
+  // serves all of the Lambert pole figures that this filter writes. It is built for the first phase that needs it.
+  StereographicLookupTable::Pointer stereoTable;
+
   // Loop over all the voxels gathering the Eulers for a specific phase into an array
   for(size_t phase = 1; phase < numPhases; ++phase)
   {
@@ -749,6 +754,10 @@ void WritePoleFigure::execute()
     if(static_cast<WritePoleFigure::Algorithm>(getGenerationAlgorithm()) == WritePoleFigure::Algorithm::LambertProjection)
     {
       config.discrete = false;
+      if(nullptr == stereoTable.get())
+      {
+        stereoTable = StereographicLookupTable::New(config.imageDim, config.lambertDim, 1.0f);
+      }
     }
     else
     {
@@ -756,6 +765,7 @@ void WritePoleFigure::execute()
     }
 
     config.discreteHeatMap = m_UseDiscreteHeatMap;
+    config.stereoTable = stereoTable.get();
 
     QString label("Phase_");
     label.append(QString::number(phase));
@@ -0,0 +1,185 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+/**
+ * @brief The UnitNormalGrid class buckets a set of unit normals (e.g. boundary plane normals) into
+ * a uniform grid over the cube [-1, 1]^3 whose cells are at least as wide as the chord subtended
+ * by a limiting angle. Every normal within that angle of a query direction then lies in the
+ * query's cell or one of its 26 neighbors, so angular range searches only visit a small patch of
+ * the sphere instead of every normal.
+ *
+ * The search is conservative: it reports a superset of the normals within the limiting angle and
+ * callers are expected to apply their own exact test to each candidate.
+ */
+class UnitNormalGrid
+{
+public:
+  /**
+   * @brief Builds the grid
+   * @param normals Normals stored as consecutive (x, y, z) triplets; they need not be exactly unit length
+   * @param numNormals Number of normals
+   * @param maxAngle Largest angle (in radians) that will be searched for
+   */
+  UnitNormalGrid(const float* normals, size_t numNormals, float maxAngle)
+  : m_CellsPerAxis(1)
+  , m_CellSize(2.0f)
+  {
+    // Pad the angle so round off in the callers' own angle computations can never exclude a normal
+    const double paddedAngle = std::min(static_cast<double>(maxAngle) + 1.0e-3, SIMPLib::Constants::k_Pi);
+    const double chord = 2.0 * std::sin(0.5 * paddedAngle);
+    // Bound the grid size for very small angles; wider cells still keep the search conservative
+    const int64_t maxCellsPerAxis = 64;
+    m_CellsPerAxis = std::max<int64_t>(1, std::min<int64_t>(maxCellsPerAxis, static_cast<int64_t>(2.0 / chord)));
+    m_CellSize = 2.0f / static_cast<float>(m_CellsPerAxis);
+
+    size_t numCells = static_cast<size_t>(m_CellsPerAxis * m_CellsPerAxis * m_CellsPerAxis);
+    std::vector<int64_t> cellOfNormal(numNormals, -1);
+    m_CellOffsets.assign(numCells + 1, 0);
+    for(size_t i = 0; i < numNormals; i++)
+    {
+      float direction[3] = {0.0f, 0.0f, 0.0f};
+      if(normalize(normals + 3 * i, direction))
+      {
+        cellOfNormal[i] = findCell(direction);
+        m_CellOffsets[cellOfNormal[i] + 1]++;
+      }
+      else
+      {
+        // Zero length or non-finite normals cannot be placed on the sphere, so every search visits them
+        m_Unbinned.push_back(static_cast<int64_t>(i));
+      }
+    }
+    for(size_t c = 0; c < numCells; c++)
+    {
+      m_CellOffsets[c + 1] += m_CellOffsets[c];
+    }
+    m_Normals.resize(m_CellOffsets[numCells]);
+    std::vector<size_t> fill(m_CellOffsets.begin(), m_CellOffsets.end() - 1);
+    for(size_t i = 0; i < numNormals; i++)
+    {
+      if(cellOfNormal[i] >= 0)
+      {
+        m_Normals[fill[cellOfNormal[i]]++] = static_cast<int64_t>(i);
+      }
+    }
+  }
+
+  virtual ~UnitNormalGrid() = default;
+
+  /**
+   * @brief forEachNormalNear Calls func(index) for every normal that may lie within the limiting
+   * angle of the given direction. Each normal is reported at most once, in no particular order.
+   * @param direction Query direction; it need not be exactly unit length
+   * @param func Callable taking the int64_t index of a normal
+   */
+  template <typename Func> void forEachNormalNear(const float* direction, Func func) const
+  {
+    for(int64_t index : m_Unbinned)
+    {
+      func(index);
+    }
+    float unit[3] = {0.0f, 0.0f, 0.0f};
+    if(!normalize(direction, unit))
+    {
+      return;
+    }
+    int64_t center[3] = {0, 0, 0};
+    cellCoords(unit, center);
+    int64_t lo[3] = {0, 0, 0};
+    int64_t hi[3] = {0, 0, 0};
+    for(int32_t d = 0; d < 3; d++)
+    {
+      lo[d] = std::max<int64_t>(0, center[d] - 1);
+      hi[d] = std::min<int64_t>(m_CellsPerAxis - 1, center[d] + 1);
+    }
+    for(int64_t z = lo[2]; z <= hi[2]; z++)
+    {
+      for(int64_t y = lo[1]; y <= hi[1]; y++)
+      {
+        size_t rowCell = static_cast<size_t>((z * m_CellsPerAxis + y) * m_CellsPerAxis);
+        // The cells of one row are contiguous, so their normals form a single run
+        for(size_t n = m_CellOffsets[rowCell + lo[0]]; n < m_CellOffsets[rowCell + hi[0] + 1]; n++)
+        {
+          func(m_Normals[n]);
+        }
+      }
+    }
+  }
+
+private:
+  int64_t m_CellsPerAxis;
+  float m_CellSize;
+  std::vector<size_t> m_CellOffsets;
+  std::vector<int64_t> m_Normals;
+  std::vector<int64_t> m_Unbinned;
+
+  static bool normalize(const float* v, float unit[3])
+  {
+    float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if(!std::isfinite(length) || length < 1.0e-6f)
+    {
+      return false;
+    }
+    unit[0] = v[0] / length;
+    unit[1] = v[1] / length;
+    unit[2] = v[2] / length;
+    return true;
+  }
+
+  void cellCoords(const float unit[3], int64_t coords[3]) const
+  {
+    for(int32_t d = 0; d < 3; d++)
+    {
+      int64_t c = static_cast<int64_t>((unit[d] + 1.0f) / m_CellSize);
+      coords[d] = std::max<int64_t>(0, std::min<int64_t>(m_CellsPerAxis - 1, c));
+    }
+  }
+
+  int64_t findCell(const float unit[3]) const
+  {
+    int64_t coords[3] = {0, 0, 0};
+    cellCoords(unit, coords);
+    return (coords[2] * m_CellsPerAxis + coords[1]) * m_CellsPerAxis + coords[0];
+  }
+};
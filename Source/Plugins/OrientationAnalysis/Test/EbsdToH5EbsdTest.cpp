@@ -0,0 +1,310 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <string.h>
+
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/HKL/CtfReader.h"
+#include "EbsdLib/TSL/H5AngImporter.h"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/EbsdToH5Ebsd.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class EbsdToH5EbsdTest
+{
+
+public:
+  EbsdToH5EbsdTest() = default;
+  ~EbsdToH5EbsdTest() = default;
+  EbsdToH5EbsdTest(const EbsdToH5EbsdTest&) = delete;            // Copy Constructor
+  EbsdToH5EbsdTest(EbsdToH5EbsdTest&&) = delete;                 // Move Constructor
+  EbsdToH5EbsdTest& operator=(const EbsdToH5EbsdTest&) = delete; // Copy Assignment
+  EbsdToH5EbsdTest& operator=(EbsdToH5EbsdTest&&) = delete;      // Move Assignment
+
+  static const int k_NumSlices = 6;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QString SliceFilePath(int z)
+  {
+    return UnitTest::EbsdToH5EbsdTest::InputDir + QString("/Slice_%1.ang").arg(z);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    for(int z = 0; z < k_NumSlices; z++)
+    {
+      QFile::remove(SliceFilePath(z));
+    }
+    QDir().rmdir(UnitTest::EbsdToH5EbsdTest::InputDir);
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::PipelinedFile);
+    QFile::remove(UnitTest::EbsdToH5EbsdTest::SerialFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the EbsdToH5Ebsd Filter from the FilterManager
+    QString filtName = "EbsdToH5Ebsd";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The EbsdToH5EbsdTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes a small single phase .ang file with random orientations
+  // -----------------------------------------------------------------------------
+  void WriteAngFile(const QString& filePath, int numCols, int numRows, unsigned int seed)
+  {
+    QFile file(filePath);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    QTextStream out(&file);
+    out << "# TEM_PIXperUM          1.000000\r\n";
+    out << "# x-star                0.500000\r\n";
+    out << "# y-star                0.500000\r\n";
+    out << "# z-star                0.500000\r\n";
+    out << "# WorkingDistance       20.000000\r\n";
+    out << "#\r\n";
+    out << "# Phase 1\r\n";
+    out << "# MaterialName  	Nickel\r\n";
+    out << "# Formula     	Ni\r\n";
+    out << "# Info\r\n";
+    out << "# Symmetry              43\r\n";
+    out << "# LatticeConstants      3.560 3.560 3.560  90.000  90.000  90.000\r\n";
+    out << "# NumberFamilies        0\r\n";
+    out << "#\r\n";
+    out << "# GRID: SqrGrid\r\n";
+    out << "# XSTEP: 0.250000\r\n";
+    out << "# YSTEP: 0.250000\r\n";
+    out << "# NCOLS_ODD: " << numCols << "\r\n";
+    out << "# NCOLS_EVEN: " << numCols << "\r\n";
+    out << "# NROWS: " << numRows << "\r\n";
+    out << "#\r\n";
+
+    std::mt19937_64 generator(seed);
+    std::uniform_real_distribution<float> angles(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    size_t totalPoints = static_cast<size_t>(numCols) * numRows;
+    for(size_t i = 0; i < totalPoints; ++i)
+    {
+      out << "  " << QByteArray::number(angles(generator), 'f', 5) << "   " << QByteArray::number(angles(generator), 'f', 5) << "   " << QByteArray::number(angles(generator), 'f', 5) << "      "
+          << QByteArray::number((i % numCols) * 0.25, 'f', 5) << "      " << QByteArray::number((i / numCols) * 0.25, 'f', 5) << " " << QByteArray::number(unit(generator) * 3000.0f, 'f', 1) << "  "
+          << QByteArray::number(unit(generator), 'f', 3) << "  1  " << QByteArray::number(unit(generator) * 2000.0f, 'f', 3) << "  " << QByteArray::number(unit(generator), 'f', 3) << "\r\n";
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every data set below the reference group has to exist in the other group with
+  // the same type, the same number of elements and the same bytes
+  // -----------------------------------------------------------------------------
+  void CompareGroups(hid_t refGid, hid_t testGid)
+  {
+    QList<QString> refNames;
+    QList<QString> testNames;
+    DREAM3D_REQUIRE(QH5Utilities::getGroupObjects(refGid, H5Utilities::H5Support_DATASET, refNames) >= 0)
+    DREAM3D_REQUIRE(QH5Utilities::getGroupObjects(testGid, H5Utilities::H5Support_DATASET, testNames) >= 0)
+    DREAM3D_REQUIRE(refNames == testNames)
+
+    for(int i = 0; i < refNames.size(); i++)
+    {
+      hid_t refId = H5Dopen(refGid, refNames[i].toLatin1().data(), H5P_DEFAULT);
+      hid_t testId = H5Dopen(testGid, refNames[i].toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRE(refId > 0)
+      DREAM3D_REQUIRE(testId > 0)
+      hid_t refType = H5Dget_type(refId);
+      hid_t testType = H5Dget_type(testId);
+      DREAM3D_REQUIRE(H5Tequal(refType, testType) > 0)
+      hid_t refSpace = H5Dget_space(refId);
+      hid_t testSpace = H5Dget_space(testId);
+      hssize_t numElements = H5Sget_simple_extent_npoints(refSpace);
+      DREAM3D_REQUIRE_EQUAL(numElements, H5Sget_simple_extent_npoints(testSpace))
+
+      std::vector<uint8_t> refBytes(static_cast<size_t>(numElements) * H5Tget_size(refType), 0);
+      std::vector<uint8_t> testBytes(refBytes.size(), 1);
+      DREAM3D_REQUIRE(H5Dread(refId, refType, H5S_ALL, H5S_ALL, H5P_DEFAULT, refBytes.data()) >= 0)
+      DREAM3D_REQUIRE(H5Dread(testId, testType, H5S_ALL, H5S_ALL, H5P_DEFAULT, testBytes.data()) >= 0)
+      DREAM3D_REQUIRE(::memcmp(refBytes.data(), testBytes.data(), refBytes.size()) == 0)
+
+      H5Sclose(testSpace);
+      H5Sclose(refSpace);
+      H5Tclose(testType);
+      H5Tclose(refType);
+      H5Dclose(testId);
+      H5Dclose(refId);
+    }
+
+    refNames.clear();
+    testNames.clear();
+    DREAM3D_REQUIRE(QH5Utilities::getGroupObjects(refGid, H5Utilities::H5Support_GROUP, refNames) >= 0)
+    DREAM3D_REQUIRE(QH5Utilities::getGroupObjects(testGid, H5Utilities::H5Support_GROUP, testNames) >= 0)
+    DREAM3D_REQUIRE(refNames == testNames)
+    for(int i = 0; i < refNames.size(); i++)
+    {
+      hid_t refChild = H5Gopen(refGid, refNames[i].toLatin1().data(), H5P_DEFAULT);
+      hid_t testChild = H5Gopen(testGid, refNames[i].toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRE(refChild > 0)
+      DREAM3D_REQUIRE(testChild > 0)
+      CompareGroups(refChild, testChild);
+      H5Gclose(testChild);
+      H5Gclose(refChild);
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // With several input files the filter parses them on several threads and writes
+  // them from one. Every slice has to come out exactly as the serial import of the
+  // same files, one after the other, writes it.
+  // -----------------------------------------------------------------------------
+  int TestPipelinedImportMatchesSerial()
+  {
+    QDir().mkpath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    const int cols[k_NumSlices] = {40, 36, 40, 31, 40, 40};
+    const int rows[k_NumSlices] = {30, 30, 25, 30, 17, 30};
+    for(int z = 0; z < k_NumSlices; z++)
+    {
+      WriteAngFile(SliceFilePath(z), cols[z], rows[z], 2000 + z);
+    }
+
+    EbsdToH5Ebsd::Pointer filter = EbsdToH5Ebsd::New();
+    filter->setDataContainerArray(DataContainerArray::New());
+    filter->setOutputFile(UnitTest::EbsdToH5EbsdTest::PipelinedFile);
+    filter->setInputPath(UnitTest::EbsdToH5EbsdTest::InputDir);
+    filter->setFilePrefix("Slice_");
+    filter->setFileSuffix("");
+    filter->setFileExtension("ang");
+    filter->setPaddingDigits(1);
+    filter->setZStartIndex(0);
+    filter->setZEndIndex(k_NumSlices - 1);
+    filter->setZResolution(0.25f);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+    hid_t serialId = QH5Utilities::createFile(UnitTest::EbsdToH5EbsdTest::SerialFile);
+    DREAM3D_REQUIRE(serialId > 0)
+    H5AngImporter::Pointer importer = H5AngImporter::New();
+    importer->setParallelParsing(false);
+    for(int z = 0; z < k_NumSlices; z++)
+    {
+      int err = importer->importFile(serialId, z, SliceFilePath(z));
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+
+    hid_t pipelinedId = QH5Utilities::openFile(UnitTest::EbsdToH5EbsdTest::PipelinedFile, true);
+    DREAM3D_REQUIRE(pipelinedId > 0)
+
+    QVector<int32_t> indices;
+    DREAM3D_REQUIRE(QH5Lite::readVectorDataset(pipelinedId, Ebsd::H5::Index, indices) >= 0)
+    DREAM3D_REQUIRE_EQUAL(indices.size(), k_NumSlices)
+    for(int z = 0; z < k_NumSlices; z++)
+    {
+      DREAM3D_REQUIRE_EQUAL(indices[z], z)
+      hid_t serialGid = H5Gopen(serialId, QString::number(z).toLatin1().data(), H5P_DEFAULT);
+      hid_t pipelinedGid = H5Gopen(pipelinedId, QString::number(z).toLatin1().data(), H5P_DEFAULT);
+      DREAM3D_REQUIRE(serialGid > 0)
+      DREAM3D_REQUIRE(pipelinedGid > 0)
+      CompareGroups(serialGid, pipelinedGid);
+      H5Gclose(pipelinedGid);
+      H5Gclose(serialGid);
+    }
+
+    QH5Utilities::closeFile(pipelinedId);
+    QH5Utilities::closeFile(serialId);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Handing the .ang importer a reader for another format is an error, not a crash
+  // -----------------------------------------------------------------------------
+  int TestMismatchedReader()
+  {
+    hid_t fileId = QH5Utilities::createFile(UnitTest::EbsdToH5EbsdTest::SerialFile);
+    DREAM3D_REQUIRE(fileId > 0)
+    CtfReader ctfReader;
+    H5AngImporter::Pointer importer = H5AngImporter::New();
+    int err = importer->writeFile(fileId, 0, &ctfReader, 0);
+    QH5Utilities::closeFile(fileId);
+    DREAM3D_REQUIRED(err, <, 0)
+    DREAM3D_REQUIRED(importer->getErrorCondition(), ==, -800)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestPipelinedImportMatchesSerial())
+    DREAM3D_REGISTER_TEST(TestMismatchedReader())
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+};
@@ -0,0 +1,397 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#include <iostream>
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/FindKernelAvgMisorientations.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class FindKernelAvgMisorientationsTest
+{
+
+public:
+  FindKernelAvgMisorientationsTest() = default;
+  ~FindKernelAvgMisorientationsTest() = default;
+  FindKernelAvgMisorientationsTest(const FindKernelAvgMisorientationsTest&) = delete;            // Copy Constructor
+  FindKernelAvgMisorientationsTest(FindKernelAvgMisorientationsTest&&) = delete;                 // Move Constructor
+  FindKernelAvgMisorientationsTest& operator=(const FindKernelAvgMisorientationsTest&) = delete; // Copy Assignment
+  FindKernelAvgMisorientationsTest& operator=(FindKernelAvgMisorientationsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindKernelAvgMisorientations Filter from the FilterManager
+    QString filtName = "FindKernelAvgMisorientations";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindKernelAvgMisorientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a Voronoi like microstructure where every cell carries a small random
+  // rotation away from its grain orientation. Grains alternate between a cubic
+  // and a hexagonal phase and a few cells are left unindexed.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(size_t xDim, size_t yDim, size_t zDim, size_t numGrains)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {xDim, yDim, zDim};
+    igeom->setDimensions(dims);
+    dc->setGeometry(igeom);
+
+    size_t totalPoints = xDim * yDim * zDim;
+    QVector<size_t> tDims = {xDim, yDim, zDim};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, "Quats", true);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, cDims, "Phases", true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, cDims, "FeatureIds", true);
+    cellAM->addAttributeArray(quats->getName(), quats);
+    cellAM->addAttributeArray(phases->getName(), phases);
+    cellAM->addAttributeArray(featureIds->getName(), featureIds);
+
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> centers(3 * numGrains, 0.0f);
+    std::vector<float> grainQuats(4 * numGrains, 0.0f);
+    for(size_t g = 0; g < numGrains; g++)
+    {
+      centers[3 * g + 0] = unit(generator) * xDim;
+      centers[3 * g + 1] = unit(generator) * yDim;
+      centers[3 * g + 2] = unit(generator) * zDim;
+      for(size_t c = 0; c < 4; c++)
+      {
+        grainQuats[4 * g + c] = unit(generator) - 0.5f;
+      }
+    }
+
+    for(size_t z = 0; z < zDim; z++)
+    {
+      for(size_t y = 0; y < yDim; y++)
+      {
+        for(size_t x = 0; x < xDim; x++)
+        {
+          size_t index = (z * yDim + y) * xDim + x;
+          size_t closest = 0;
+          float minDist = std::numeric_limits<float>::max();
+          for(size_t g = 0; g < numGrains; g++)
+          {
+            float dx = centers[3 * g + 0] - x;
+            float dy = centers[3 * g + 1] - y;
+            float dz = centers[3 * g + 2] - z;
+            float dist = dx * dx + dy * dy + dz * dz;
+            if(dist < minDist)
+            {
+              minDist = dist;
+              closest = g;
+            }
+          }
+          float q[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+          float norm = 0.0f;
+          for(size_t c = 0; c < 4; c++)
+          {
+            q[c] = grainQuats[4 * closest + c] + 0.05f * (unit(generator) - 0.5f);
+            norm += q[c] * q[c];
+          }
+          norm = std::sqrt(norm);
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(index, c, q[c] / norm);
+          }
+          bool indexed = unit(generator) > 0.01f;
+          featureIds->setValue(index, indexed ? static_cast<int32_t>(closest + 1) : 0);
+          phases->setValue(index, indexed ? static_cast<int32_t>(closest % 2 + 1) : 0);
+        }
+      }
+    }
+
+    QVector<size_t> ensembleDims(1, 3);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(ensembleDims, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(ensembleAM->getName(), ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, cDims, "CrystalStructures", true);
+    crystalStructures->setValue(0, 999); // Unknown
+    crystalStructures->setValue(1, 1);   // Cubic_High
+    crystalStructures->setValue(2, 0);   // Hexagonal_High
+    ensembleAM->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The misorientation angle as the filter computed it before the batched kernels.
+  // The cubic class still uses the same closed form, every other class tried each
+  // symmetry operator and converted the result to axis-angle.
+  // -----------------------------------------------------------------------------
+  float OriginalMisoAngle(LaueOps::Pointer ops, uint32_t crystalStructure, QuatF& q1, QuatF& q2)
+  {
+    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f, w = 0.0f;
+    if(crystalStructure == 1) // Cubic_High
+    {
+      return ops->getMisoQuat(q1, q2, n1, n2, n3);
+    }
+
+    typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformsType;
+    float wmin = 9999999.0f;
+    QuatF qr;
+    QuatF qc;
+    QuatF q2inv;
+    QuatF sym;
+    QuaternionMathF::Copy(q2, q2inv);
+    QuaternionMathF::Conjugate(q2inv);
+    QuaternionMathF::Multiply(q1, q2inv, qr);
+    for(int i = 0; i < ops->getNumSymOps(); i++)
+    {
+      ops->getQuatSymOp(i, sym);
+      QuaternionMathF::Multiply(sym, qr, qc);
+      if(qc.w < -1)
+      {
+        qc.w = -1;
+      }
+      else if(qc.w > 1)
+      {
+        qc.w = 1;
+      }
+      FOrientArrayType ax(4, 0.0f);
+      OrientationTransformsType::qu2ax(FOrientArrayType(qc.x, qc.y, qc.z, qc.w), ax);
+      ax.toAxisAngle(n1, n2, n3, w);
+      if(w > SIMPLib::Constants::k_Pi)
+      {
+        w = SIMPLib::Constants::k_2Pi - w;
+      }
+      if(w < wmin)
+      {
+        wmin = w;
+      }
+    }
+    return wmin;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Straight forward serial version of the kernel average misorientation that walks
+  // the volume one cell at a time and computes every pair the way the filter did
+  // before it was threaded and batched
+  // -----------------------------------------------------------------------------
+  std::vector<float> ComputeReference(DataContainerArray::Pointer dca, IntVec3_t kernelSize)
+  {
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""));
+    AttributeMatrix::Pointer ensembleAM = dca->getAttributeMatrix(DataArrayPath("Test", "EnsembleData", ""));
+    int32_t* featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds")->getPointer(0);
+    int32_t* phases = cellAM->getAttributeArrayAs<Int32ArrayType>("Phases")->getPointer(0);
+    QuatF* quats = reinterpret_cast<QuatF*>(cellAM->getAttributeArrayAs<FloatArrayType>("Quats")->getPointer(0));
+    uint32_t* crystalStructures = ensembleAM->getAttributeArrayAs<UInt32ArrayType>("CrystalStructures")->getPointer(0);
+    QVector<LaueOps::Pointer> orientationOps = LaueOps::getOrientationOpsQVector();
+
+    size_t udims[3] = {0, 0, 0};
+    std::tie(udims[0], udims[1], udims[2]) = dca->getDataContainer("Test")->getGeometryAs<ImageGeom>()->getDimensions();
+    int64_t xPoints = static_cast<int64_t>(udims[0]);
+    int64_t yPoints = static_cast<int64_t>(udims[1]);
+    int64_t zPoints = static_cast<int64_t>(udims[2]);
+
+    std::vector<float> kam(xPoints * yPoints * zPoints, 0.0f);
+    for(int64_t plane = 0; plane < zPoints; plane++)
+    {
+      for(int64_t row = 0; row < yPoints; row++)
+      {
+        for(int64_t col = 0; col < xPoints; col++)
+        {
+          int64_t point = (plane * xPoints * yPoints) + (row * xPoints) + col;
+          if(featureIds[point] == 0 || phases[point] == 0)
+          {
+            continue;
+          }
+          float totalmisorientation = 0.0f;
+          int32_t numVoxel = 0;
+          QuatF q1 = quats[point];
+          uint32_t phase1 = crystalStructures[phases[point]];
+          for(int32_t j = -kernelSize.z; j < kernelSize.z + 1; j++)
+          {
+            for(int32_t k = -kernelSize.y; k < kernelSize.y + 1; k++)
+            {
+              for(int32_t l = -kernelSize.x; l < kernelSize.x + 1; l++)
+              {
+                if(plane + j < 0 || plane + j > zPoints - 1 || row + k < 0 || row + k > yPoints - 1 || col + l < 0 || col + l > xPoints - 1)
+                {
+                  continue;
+                }
+                int64_t neighbor = point + (j * xPoints * yPoints) + (k * xPoints) + l;
+                if(featureIds[point] == featureIds[neighbor])
+                {
+                  QuatF q2 = quats[neighbor];
+                  float w = OriginalMisoAngle(orientationOps[phase1], phase1, q1, q2);
+                  w = w * (180.0f / SIMPLib::Constants::k_Pi);
+                  totalmisorientation = totalmisorientation + w;
+                  numVoxel++;
+                }
+              }
+            }
+          }
+          kam[point] = (numVoxel == 0) ? 0.0f : totalmisorientation / (float)numVoxel;
+        }
+      }
+    }
+    return kam;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer RunFilter(DataContainerArray::Pointer dca, IntVec3_t kernelSize, double& millis)
+  {
+    FindKernelAvgMisorientations::Pointer filter = FindKernelAvgMisorientations::New();
+    filter->setDataContainerArray(dca);
+    filter->setFeatureIdsArrayPath(DataArrayPath("Test", "CellData", "FeatureIds"));
+    filter->setCellPhasesArrayPath(DataArrayPath("Test", "CellData", "Phases"));
+    filter->setQuatsArrayPath(DataArrayPath("Test", "CellData", "Quats"));
+    filter->setCrystalStructuresArrayPath(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+    filter->setKernelAverageMisorientationsArrayName("KAM");
+    filter->setKernelSize(kernelSize);
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    auto start = std::chrono::steady_clock::now();
+#endif
+    filter->execute();
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+#endif
+    int err = filter->getErrorCondition();
+    DREAM3D_REQUIRE(err >= 0)
+
+    return dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<FloatArrayType>("KAM");
+  }
+
+  // -----------------------------------------------------------------------------
+  // The threaded filter must reproduce the original serial computation bit for
+  // bit, for the cubic and the hexagonal grains alike
+  // -----------------------------------------------------------------------------
+  int TestKernelAvgMisorientations()
+  {
+    IntVec3_t kernelSizes[2];
+    kernelSizes[0].x = 1;
+    kernelSizes[0].y = 1;
+    kernelSizes[0].z = 1;
+    kernelSizes[1].x = 2;
+    kernelSizes[1].y = 2;
+    kernelSizes[1].z = 2;
+
+    for(size_t s = 0; s < 2; s++)
+    {
+      double millis = 0.0;
+      DataContainerArray::Pointer dca = CreateTestData(41, 33, 27, 30);
+      std::vector<float> reference = ComputeReference(dca, kernelSizes[s]);
+      FloatArrayType::Pointer kam = RunFilter(dca, kernelSizes[s], millis);
+      DREAM3D_REQUIRE_EQUAL(kam->getNumberOfTuples(), reference.size())
+      for(size_t i = 0; i < reference.size(); i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(kam->getValue(i), reference[i])
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int BenchmarkKernelAvgMisorientations()
+  {
+    IntVec3_t kernelSize;
+    kernelSize.x = 1;
+    kernelSize.y = 1;
+    kernelSize.z = 1;
+
+    double millis = 0.0;
+    DataContainerArray::Pointer dca = CreateTestData(128, 128, 96, 200);
+    RunFilter(dca, kernelSize, millis);
+    std::cout << "FindKernelAvgMisorientations 128x128x96: " << millis << " ms" << std::endl;
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestKernelAvgMisorientations())
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(BenchmarkKernelAvgMisorientations())
+#endif
+  }
+
+private:
+};
@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class GenerateFZQuaternionsTest
+{
+
+public:
+  GenerateFZQuaternionsTest()
+  {
+  }
+  virtual ~GenerateFZQuaternionsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/UnitNormalGrid.hpp"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+class UnitNormalGridTest
+{
+public:
+  UnitNormalGridTest()
+  {
+  }
+  virtual ~UnitNormalGridTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(UnitNormalGridTest)
+
+  // -----------------------------------------------------------------------------
+  // Every normal within the limiting angle of a query must be reported, exactly once
+  // -----------------------------------------------------------------------------
+  int TestRangeSearch()
+  {
+    std::mt19937 generator(5489u);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    auto randomUnit = [&](float* v) {
+      float length = 0.0f;
+      while(length < 1.0e-3f)
+      {
+        v[0] = gaussian(generator);
+        v[1] = gaussian(generator);
+        v[2] = gaussian(generator);
+        length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+      }
+      v[0] /= length;
+      v[1] /= length;
+      v[2] /= length;
+    };
+
+    const float degToRad = static_cast<float>(SIMPLib::Constants::k_PiOver180);
+    float limits[4] = {2.0f * degToRad, 7.0f * degToRad, 11.3f * degToRad, 95.0f * degToRad};
+    for(float limit : limits)
+    {
+      size_t numNormals = 5000;
+      std::vector<float> normals(3 * numNormals, 0.0f);
+      for(size_t i = 0; i < numNormals; i++)
+      {
+        randomUnit(&normals[3 * i]);
+      }
+      // Normals that cannot be placed on the sphere must still be reported by every search
+      normals[0] = normals[1] = normals[2] = 0.0f;
+      normals[3] = std::nanf("");
+      // Normals on the faces and edges of the grid's cube
+      normals[6] = 1.0f;
+      normals[7] = normals[8] = 0.0f;
+      normals[9] = normals[10] = -std::sqrt(0.5f);
+      normals[11] = 0.0f;
+
+      UnitNormalGrid grid(normals.data(), numNormals, limit);
+
+      for(size_t q = 0; q < 500; q++)
+      {
+        float query[3] = {0.0f, 0.0f, 0.0f};
+        if(q < 20)
+        {
+          // Queries slightly off the stored normals themselves
+          size_t n = 2 + q;
+          query[0] = normals[3 * n] + 1.0e-3f;
+          query[1] = normals[3 * n + 1];
+          query[2] = normals[3 * n + 2];
+        }
+        else
+        {
+          randomUnit(query);
+        }
+        float queryLength = std::sqrt(query[0] * query[0] + query[1] * query[1] + query[2] * query[2]);
+
+        std::multiset<int64_t> reported;
+        grid.forEachNormalNear(query, [&](int64_t index) { reported.insert(index); });
+        DREAM3D_REQUIRE(reported.count(0) == 1);
+        DREAM3D_REQUIRE(reported.count(1) == 1);
+
+        for(size_t i = 2; i < numNormals; i++)
+        {
+          const float* n = &normals[3 * i];
+          float angle = acosf((n[0] * query[0] + n[1] * query[1] + n[2] * query[2]) / queryLength);
+          size_t count = reported.count(static_cast<int64_t>(i));
+          DREAM3D_REQUIRE(count <= 1);
+          if(angle < limit)
+          {
+            DREAM3D_REQUIRE_EQUAL(count, 1);
+          }
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestRangeSearch())
+  }
+
+private:
+  UnitNormalGridTest(const UnitNormalGridTest&); // Copy Constructor Not Implemented
+  void operator=(const UnitNormalGridTest&);     // Move assignment Not Implemented
+};
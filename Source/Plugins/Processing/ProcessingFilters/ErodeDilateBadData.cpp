@@ -45,6 +45,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/VoxelFrontier.h"
 #include "Processing/ProcessingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -57,7 +58,6 @@ ErodeDilateBadData::ErodeDilateBadData()
 , m_YDirOn(true)
 , m_ZDirOn(true)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
-, m_Neighbors(nullptr)
 , m_FeatureIds(nullptr)
 {
 }
@@ -120,7 +120,6 @@ void ErodeDilateBadData::readFilterParameters(AbstractFilterParametersReader* re
 // -----------------------------------------------------------------------------
 void ErodeDilateBadData::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -176,12 +175,6 @@ void ErodeDilateBadData::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, "_INTERNAL_USE_ONLY_Neighbors");
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
   size_t udims[3] = {0, 0, 0};
   std::tie(udims[0], udims[1], udims[2]) = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -189,158 +182,53 @@ void ErodeDilateBadData::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
-
-  for(size_t i = 0; i < totalPoints; i++)
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  std::vector<IDataArray::Pointer> voxelArrays;
+  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
   }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  QVector<int32_t> n(numfeatures + 1, 0);
-
-  for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
-  {
-    for(int64_t k = 0; k < dims[2]; k++)
+  // One wave is one iteration. Eroding fills a bad voxel from its most common good neighbor, dilating
+  // overwrites a good voxel with its bad neighbor of highest index. Either way only the voxels next to the
+  // ones changed by the previous iteration have to be looked at again.
+  int32_t* featureIds = m_FeatureIds;
+  VoxelFrontier frontier(dims, m_XDirOn, m_YDirOn, m_ZDirOn);
+  auto copyVoxel = [&voxelArrays](int64_t voxel, int64_t source, size_t) {
+    for(size_t k = 0; k < voxelArrays.size(); k++)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || m_ZDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || m_YDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || m_XDirOn == false))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if(feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if(m_Direction == 1)
-            {
-              for(int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if(l == 0 && k == 0)
-                {
-                  good = 0;
-                }
-                if(l == 5 && k == (dims[2] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 1 && j == 0)
-                {
-                  good = 0;
-                }
-                if(l == 4 && j == (dims[1] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 2 && i == 0)
-                {
-                  good = 0;
-                }
-                if(l == 3 && i == (dims[0] - 1))
-                {
-                  good = 0;
-                }
-                if(good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
+      voxelArrays[k]->copyTuple(source, voxel);
     }
-
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if(neighbor >= 0)
+    return true;
+  };
+  size_t numIterations = m_NumIterations > 0 ? static_cast<size_t>(m_NumIterations) : 0;
+  std::vector<int64_t> front;
+  if(m_Direction == 1)
+  {
+    auto isBad = [featureIds](int64_t voxel) { return featureIds[voxel] == 0; };
+    auto choose = [&frontier, featureIds](int64_t voxel) { return frontier.findMajorityNeighbor(voxel, featureIds, 1); };
+    front = frontier.findCandidates(isBad);
+    frontier.propagate(front, choose, copyVoxel, isBad, numIterations, this);
+  }
+  else
+  {
+    auto isGood = [featureIds](int64_t voxel) { return featureIds[voxel] > 0; };
+    auto choose = [&frontier, featureIds](int64_t voxel) {
+      bool valid[6];
+      frontier.getValidNeighbors(voxel, valid);
+      int64_t source = -1;
+      for(int32_t j = 0; j < 6; j++)
       {
-        if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
+        if(valid[j] && featureIds[voxel + frontier.getOffset(j)] == 0)
         {
-          for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-            p->copyTuple(neighbor, j);
-          }
+          source = voxel + frontier.getOffset(j);
         }
       }
-    }
+      return source;
+    };
+    front = frontier.findCandidates(isGood);
+    frontier.propagate(front, choose, copyVoxel, isGood, numIterations, this);
   }
 
   // If there is an error set this to something negative and also set a message
@@ -0,0 +1,299 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the followig contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The VoxelFrontier class drives the "sweep the whole volume until nothing changes" loops of the
+ * voxel cleanup filters (FillBadData, MinSize, MinNeighbors, ErodeDilateBadData and the Manhattan pass of
+ * FindEuclideanDistMap) with a work list that only holds the voxels that can still change.
+ *
+ * Each wave does what one sweep of those loops does. First every voxel of the front chooses the voxel it takes
+ * its new value from, looking only at the state from the start of the wave. Then all of those choices are
+ * applied. Nothing is written while choosing, so the order of the front does not matter, both phases run in
+ * parallel, and the result is identical to the full sweeps. A choice only depends on the face neighbors, so the
+ * next front is made of the candidates around the voxels that just changed.
+ *
+ * The face neighbors are visited in the order the filters always used: -Z, -Y, -X, +X, +Y, +Z.
+ */
+class VoxelFrontier
+{
+public:
+  VoxelFrontier(const int64_t dims[3], bool xDirOn = true, bool yDirOn = true, bool zDirOn = true)
+  {
+    for(int32_t i = 0; i < 3; i++)
+    {
+      m_Dims[i] = dims[i];
+    }
+    m_Offsets[0] = -dims[0] * dims[1];
+    m_Offsets[1] = -dims[0];
+    m_Offsets[2] = -1;
+    m_Offsets[3] = 1;
+    m_Offsets[4] = dims[0];
+    m_Offsets[5] = dims[0] * dims[1];
+    m_DirOn[0] = m_DirOn[5] = zDirOn;
+    m_DirOn[1] = m_DirOn[4] = yDirOn;
+    m_DirOn[2] = m_DirOn[3] = xDirOn;
+  }
+
+  virtual ~VoxelFrontier() = default;
+
+  /**
+   * @brief Returns the offset to face neighbor j
+   */
+  int64_t getOffset(int32_t j) const
+  {
+    return m_Offsets[j];
+  }
+
+  /**
+   * @brief Flags which face neighbors of voxel exist and lie along an enabled direction
+   */
+  void getValidNeighbors(int64_t voxel, bool valid[6]) const
+  {
+    int64_t column = voxel % m_Dims[0];
+    int64_t row = (voxel / m_Dims[0]) % m_Dims[1];
+    int64_t plane = voxel / (m_Dims[0] * m_Dims[1]);
+    valid[0] = m_DirOn[0] && plane != 0;
+    valid[1] = m_DirOn[1] && row != 0;
+    valid[2] = m_DirOn[2] && column != 0;
+    valid[3] = m_DirOn[3] && column != m_Dims[0] - 1;
+    valid[4] = m_DirOn[4] && row != m_Dims[1] - 1;
+    valid[5] = m_DirOn[5] && plane != m_Dims[2] - 1;
+  }
+
+  /**
+   * @brief Returns the face neighbor of voxel whose Feature Id occurs most often among the face neighbors with
+   * an Id of at least minFeatureId, or -1 if there is none. Ties go to the neighbor that reached the count first,
+   * which is what the per-Feature counting arrays of the cleanup filters did.
+   */
+  int64_t findMajorityNeighbor(int64_t voxel, const int32_t* featureIds, int32_t minFeatureId) const
+  {
+    bool valid[6];
+    getValidNeighbors(voxel, valid);
+    int32_t seen[6] = {0, 0, 0, 0, 0, 0};
+    int32_t numSeen = 0;
+    int32_t most = 0;
+    int64_t best = -1;
+    for(int32_t j = 0; j < 6; j++)
+    {
+      if(!valid[j])
+      {
+        continue;
+      }
+      int64_t neighbor = voxel + m_Offsets[j];
+      int32_t feature = featureIds[neighbor];
+      if(feature < minFeatureId)
+      {
+        continue;
+      }
+      int32_t current = 1;
+      for(int32_t k = 0; k < numSeen; k++)
+      {
+        if(seen[k] == feature)
+        {
+          current++;
+        }
+      }
+      seen[numSeen++] = feature;
+      if(current > most)
+      {
+        most = current;
+        best = neighbor;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * @brief Collects every voxel for which isCandidate(voxel) is true. This is the first front.
+   */
+  template <typename IsCandidate> std::vector<int64_t> findCandidates(IsCandidate isCandidate) const
+  {
+    std::vector<int64_t> front;
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    for(int64_t voxel = 0; voxel < totalPoints; voxel++)
+    {
+      if(isCandidate(voxel))
+      {
+        front.push_back(voxel);
+      }
+    }
+    return front;
+  }
+
+  /**
+   * @brief Runs waves until the front is empty, maxWaves waves were run or the filter was canceled.
+   * @param front The first front; it is consumed
+   * @param choose int64_t(int64_t voxel) returns the voxel to take the new value from, or -1. It must not write anything.
+   * @param apply bool(int64_t voxel, int64_t source, size_t wave) applies a choice and returns true if the voxel changed.
+   * It may only write to voxel, and the sources of a wave must never be applied to in the same wave.
+   * @param isCandidate bool(int64_t voxel) tells if a neighbor of a changed voxel belongs to the next front
+   * @param maxWaves Upper limit on the number of waves; waves are numbered from 1
+   * @param filter Optional filter whose cancel flag is checked between waves
+   * @return The number of waves that were run
+   */
+  template <typename Choose, typename Apply, typename IsCandidate>
+  size_t propagate(std::vector<int64_t>& front, Choose choose, Apply apply, IsCandidate isCandidate, size_t maxWaves = SIZE_MAX, AbstractFilter* filter = nullptr)
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+#endif
+
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    std::vector<uint8_t> inNextFront(static_cast<size_t>(totalPoints), 0);
+    std::vector<int64_t> sources;
+    std::vector<uint8_t> changed;
+    std::vector<int64_t> nextFront;
+    m_Waves = 0;
+    m_VisitedVoxels = 0;
+
+    while(!front.empty() && m_Waves < maxWaves)
+    {
+      if(nullptr != filter && filter->getCancel())
+      {
+        break;
+      }
+      m_Waves++;
+      m_VisitedVoxels += front.size();
+      size_t frontSize = front.size();
+      size_t wave = m_Waves;
+      sources.assign(frontSize, -1);
+      changed.assign(frontSize, 0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      if(doParallel)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, frontSize), [&](const tbb::blocked_range<size_t>& r) {
+          for(size_t i = r.begin(); i != r.end(); i++)
+          {
+            sources[i] = choose(front[i]);
+          }
+        });
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, frontSize), [&](const tbb::blocked_range<size_t>& r) {
+          for(size_t i = r.begin(); i != r.end(); i++)
+          {
+            if(sources[i] >= 0)
+            {
+              changed[i] = apply(front[i], sources[i], wave) ? 1 : 0;
+            }
+          }
+        });
+      }
+      else
+#endif
+      {
+        for(size_t i = 0; i < frontSize; i++)
+        {
+          sources[i] = choose(front[i]);
+        }
+        for(size_t i = 0; i < frontSize; i++)
+        {
+          if(sources[i] >= 0)
+          {
+            changed[i] = apply(front[i], sources[i], wave) ? 1 : 0;
+          }
+        }
+      }
+
+      // Only the neighbors of the voxels that changed can make a different choice in the next wave
+      nextFront.clear();
+      bool valid[6];
+      for(size_t i = 0; i < frontSize; i++)
+      {
+        if(changed[i] == 0)
+        {
+          continue;
+        }
+        getValidNeighbors(front[i], valid);
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighbor = front[i] + m_Offsets[j];
+          if(valid[j] && inNextFront[neighbor] == 0 && isCandidate(neighbor))
+          {
+            inNextFront[neighbor] = 1;
+            nextFront.push_back(neighbor);
+          }
+        }
+      }
+      for(size_t i = 0; i < nextFront.size(); i++)
+      {
+        inNextFront[nextFront[i]] = 0;
+      }
+      front.swap(nextFront);
+    }
+    return m_Waves;
+  }
+
+  /**
+   * @brief Number of waves run by the last propagate()
+   */
+  size_t getWaves() const
+  {
+    return m_Waves;
+  }
+
+  /**
+   * @brief Total number of front entries processed by the last propagate(). A full sweep implementation visits
+   * (waves + 1) * totalPoints voxels for the same result.
+   */
+  size_t getVisitedVoxels() const
+  {
+    return m_VisitedVoxels;
+  }
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_Offsets[6] = {0, 0, 0, 0, 0, 0};
+  bool m_DirOn[6] = {true, true, true, true, true, true};
+  size_t m_Waves = 0;
+  size_t m_VisitedVoxels = 0;
+
+  VoxelFrontier(const VoxelFrontier&) = delete;  // Copy Constructor Not Implemented
+  void operator=(const VoxelFrontier&) = delete; // Move assignment Not Implemented
+};
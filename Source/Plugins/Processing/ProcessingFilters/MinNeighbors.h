@@ -197,7 +197,6 @@ protected:
   QVector<bool> merge_containedfeatures();
 
 private:
-  int32_t* m_Neighbors = nullptr;
 
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeaturePhases)
@@ -0,0 +1,544 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#include <iostream>
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class VoxelFrontierTest
+{
+
+public:
+  VoxelFrontierTest()
+  {
+  }
+  virtual ~VoxelFrontierTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames = {"FillBadData", "ErodeDilateBadData"};
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocky Features with scattered bad voxels and one large void
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(int64_t xDim, int64_t yDim, int64_t zDim)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims[3] = {static_cast<size_t>(xDim), static_cast<size_t>(yDim), static_cast<size_t>(zDim)};
+    igeom->setDimensions(dims);
+    dc->setGeometry(igeom);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = dims[0];
+    tDims[1] = dims[1];
+    tDims[2] = dims[2];
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds, true);
+    QVector<size_t> cDims(1, 2);
+    FloatArrayType::Pointer values = FloatArrayType::CreateArray(totalPoints, cDims, "Values", true);
+    size_t index = 0;
+    for(int64_t z = 0; z < zDim; z++)
+    {
+      for(int64_t y = 0; y < yDim; y++)
+      {
+        for(int64_t x = 0; x < xDim; x++)
+        {
+          int32_t feature = 1 + static_cast<int32_t>(((x / 4) + 3 * (y / 5) + 7 * (z / 4)) % 9);
+          if((x * 7 + y * 13 + z * 29) % 5 == 0)
+          {
+            feature = 0;
+          }
+          if(x >= xDim / 5 && x < xDim / 2 && y >= yDim / 4 && y < yDim / 2 && z >= zDim / 8 && z < zDim / 2)
+          {
+            feature = 0;
+          }
+          featureIds->setValue(index, feature);
+          values->setComponent(index, 0, static_cast<float>(index));
+          values->setComponent(index, 1, static_cast<float>(feature) * 0.5f);
+          index++;
+        }
+      }
+    }
+    cellAM->addAttributeArray(featureIds->getName(), featureIds);
+    cellAM->addAttributeArray(values->getName(), values);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AttributeMatrix::Pointer GetCellData(DataContainerArray::Pointer dca)
+  {
+    return dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void GetNeighbors(DataContainerArray::Pointer dca, int64_t dims[3], int64_t neighpoints[6])
+  {
+    size_t udims[3] = {0, 0, 0};
+    std::tie(udims[0], udims[1], udims[2]) = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getGeometryAs<ImageGeom>()->getDimensions();
+    for(int32_t i = 0; i < 3; i++)
+    {
+      dims[i] = static_cast<int64_t>(udims[i]);
+    }
+    neighpoints[0] = -dims[0] * dims[1];
+    neighpoints[1] = -dims[0];
+    neighpoints[2] = -1;
+    neighpoints[3] = 1;
+    neighpoints[4] = dims[0];
+    neighpoints[5] = dims[0] * dims[1];
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  bool IsGoodNeighbor(const int64_t dims[3], int64_t x, int64_t y, int64_t z, int32_t j, const bool dirOn[3])
+  {
+    if(j == 0 && (z == 0 || !dirOn[2]))
+    {
+      return false;
+    }
+    if(j == 5 && (z == dims[2] - 1 || !dirOn[2]))
+    {
+      return false;
+    }
+    if(j == 1 && (y == 0 || !dirOn[1]))
+    {
+      return false;
+    }
+    if(j == 4 && (y == dims[1] - 1 || !dirOn[1]))
+    {
+      return false;
+    }
+    if(j == 2 && (x == 0 || !dirOn[0]))
+    {
+      return false;
+    }
+    if(j == 3 && (x == dims[0] - 1 || !dirOn[0]))
+    {
+      return false;
+    }
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Small defects to -1 and then full volume sweeps, exactly as FillBadData did it before the frontier.
+  // Returns the number of sweeps.
+  // -----------------------------------------------------------------------------
+  size_t ReferenceFillBadData(DataContainerArray::Pointer dca, int32_t minAllowedDefectSize)
+  {
+    int64_t dims[3] = {0, 0, 0};
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    GetNeighbors(dca, dims, neighpoints);
+    const bool dirOn[3] = {true, true, true};
+    AttributeMatrix::Pointer cellAM = GetCellData(dca);
+    int32_t* featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds)->getPointer(0);
+    size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+
+    std::vector<bool> alreadyChecked(totalPoints, false);
+    int32_t numfeatures = 0;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      alreadyChecked[i] = (featureIds[i] != 0);
+      numfeatures = std::max(numfeatures, featureIds[i]);
+    }
+    std::vector<int64_t> currentvlist;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      if(alreadyChecked[i] || featureIds[i] != 0)
+      {
+        continue;
+      }
+      currentvlist.push_back(static_cast<int64_t>(i));
+      size_t count = 0;
+      while(count < currentvlist.size())
+      {
+        int64_t index = currentvlist[count];
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighbor = index + neighpoints[j];
+          if(IsGoodNeighbor(dims, index % dims[0], (index / dims[0]) % dims[1], index / (dims[0] * dims[1]), j, dirOn) && featureIds[neighbor] == 0 && !alreadyChecked[neighbor])
+          {
+            currentvlist.push_back(neighbor);
+            alreadyChecked[neighbor] = true;
+          }
+        }
+        count++;
+      }
+      if(static_cast<int32_t>(currentvlist.size()) < minAllowedDefectSize)
+      {
+        for(size_t k = 0; k < currentvlist.size(); k++)
+        {
+          featureIds[currentvlist[k]] = -1;
+        }
+      }
+      currentvlist.clear();
+    }
+
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    std::vector<int32_t> n(numfeatures + 1, 0);
+    size_t sweeps = 0;
+    size_t count = 1;
+    while(count != 0)
+    {
+      sweeps++;
+      count = 0;
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        if(featureIds[i] >= 0)
+        {
+          continue;
+        }
+        count++;
+        int32_t most = 0;
+        int64_t x = i % dims[0], y = (i / dims[0]) % dims[1], z = i / (dims[0] * dims[1]);
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighpoint = i + neighpoints[j];
+          if(IsGoodNeighbor(dims, x, y, z, j, dirOn) && featureIds[neighpoint] > 0)
+          {
+            int32_t current = ++n[featureIds[neighpoint]];
+            if(current > most)
+            {
+              most = current;
+              neighbors[i] = neighpoint;
+            }
+          }
+        }
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighpoint = i + neighpoints[j];
+          if(IsGoodNeighbor(dims, x, y, z, j, dirOn) && featureIds[neighpoint] > 0)
+          {
+            n[featureIds[neighpoint]] = 0;
+          }
+        }
+      }
+      QList<QString> voxelArrayNames = cellAM->getAttributeArrayNames();
+      for(size_t j = 0; j < totalPoints; j++)
+      {
+        int64_t neighbor = neighbors[j];
+        if(featureIds[j] < 0 && neighbor != -1 && featureIds[neighbor] > 0)
+        {
+          for(const QString& name : voxelArrayNames)
+          {
+            cellAM->getAttributeArray(name)->copyTuple(neighbor, j);
+          }
+        }
+      }
+    }
+    return sweeps;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Full volume sweeps, exactly as ErodeDilateBadData did it before the frontier
+  // -----------------------------------------------------------------------------
+  void ReferenceErodeDilateBadData(DataContainerArray::Pointer dca, uint32_t direction, int32_t numIterations, const bool dirOn[3])
+  {
+    int64_t dims[3] = {0, 0, 0};
+    int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
+    GetNeighbors(dca, dims, neighpoints);
+    AttributeMatrix::Pointer cellAM = GetCellData(dca);
+    int32_t* featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds)->getPointer(0);
+    size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+
+    int32_t numfeatures = 0;
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      numfeatures = std::max(numfeatures, featureIds[i]);
+    }
+    std::vector<int64_t> neighbors(totalPoints, -1);
+    std::vector<int32_t> n(numfeatures + 1, 0);
+    for(int32_t iteration = 0; iteration < numIterations; iteration++)
+    {
+      for(size_t i = 0; i < totalPoints; i++)
+      {
+        if(featureIds[i] != 0)
+        {
+          continue;
+        }
+        int32_t most = 0;
+        int64_t x = i % dims[0], y = (i / dims[0]) % dims[1], z = i / (dims[0] * dims[1]);
+        for(int32_t j = 0; j < 6; j++)
+        {
+          int64_t neighpoint = i + neighpoints[j];
+          if(!IsGoodNeighbor(dims, x, y, z, j, dirOn))
+          {
+            continue;
+          }
+          int32_t feature = featureIds[neighpoint];
+          if(direction == 0 && feature > 0)
+          {
+            neighbors[neighpoint] = i;
+          }
+          if(direction == 1 && feature > 0)
+          {
+            int32_t current = ++n[feature];
+            if(current > most)
+            {
+              most = current;
+              neighbors[i] = neighpoint;
+            }
+          }
+        }
+        for(int32_t j = 0; j < 6; j++)
+        {
+          if(IsGoodNeighbor(dims, x, y, z, j, dirOn))
+          {
+            n[featureIds[i + neighpoints[j]]] = 0;
+          }
+        }
+      }
+      QList<QString> voxelArrayNames = cellAM->getAttributeArrayNames();
+      for(size_t j = 0; j < totalPoints; j++)
+      {
+        int64_t neighbor = neighbors[j];
+        if(neighbor < 0)
+        {
+          continue;
+        }
+        if((featureIds[j] == 0 && featureIds[neighbor] > 0 && direction == 1) || (featureIds[j] > 0 && featureIds[neighbor] == 0 && direction == 0))
+        {
+          for(const QString& name : voxelArrayNames)
+          {
+            cellAM->getAttributeArray(name)->copyTuple(neighbor, j);
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CompareCellData(DataContainerArray::Pointer expected, DataContainerArray::Pointer actual)
+  {
+    Int32ArrayType::Pointer expectedIds = GetCellData(expected)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer actualIds = GetCellData(actual)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    FloatArrayType::Pointer expectedValues = GetCellData(expected)->getAttributeArrayAs<FloatArrayType>("Values");
+    FloatArrayType::Pointer actualValues = GetCellData(actual)->getAttributeArrayAs<FloatArrayType>("Values");
+    DREAM3D_REQUIRE_EQUAL(expectedIds->getSize(), actualIds->getSize())
+    for(size_t i = 0; i < expectedIds->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(expectedIds->getValue(i), actualIds->getValue(i))
+    }
+    for(size_t i = 0; i < expectedValues->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(expectedValues->getValue(i), actualValues->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunFillBadData(DataContainerArray::Pointer dca, int32_t minAllowedDefectSize)
+  {
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FillBadData")->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(minAllowedDefectSize);
+    bool propWasSet = filter->setProperty("MinAllowedDefectSize", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("StoreAsNewPhase", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunErodeDilateBadData(DataContainerArray::Pointer dca, uint32_t direction, int32_t numIterations, const bool dirOn[3])
+  {
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("ErodeDilateBadData")->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(direction);
+    bool propWasSet = filter->setProperty("Direction", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(numIterations);
+    propWasSet = filter->setProperty("NumIterations", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(dirOn[0]);
+    propWasSet = filter->setProperty("XDirOn", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(dirOn[1]);
+    propWasSet = filter->setProperty("YDirOn", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(dirOn[2]);
+    propWasSet = filter->setProperty("ZDirOn", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFillBadData()
+  {
+    // Small enough to leave the void, then large enough to fill it as well
+    QVector<int32_t> minSizes = {20, 100000};
+    for(int32_t minSize : minSizes)
+    {
+      DataContainerArray::Pointer expected = CreateTestData(23, 19, 17);
+      ReferenceFillBadData(expected, minSize);
+      DataContainerArray::Pointer actual = CreateTestData(23, 19, 17);
+      RunFillBadData(actual, minSize);
+      CompareCellData(expected, actual);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestErodeDilateBadData()
+  {
+    const bool allOn[3] = {true, true, true};
+    const bool xyOnly[3] = {true, true, false};
+    const bool zOnly[3] = {false, false, true};
+    const bool* dirOns[3] = {allOn, xyOnly, zOnly};
+    for(uint32_t direction = 0; direction < 2; direction++)
+    {
+      for(int32_t d = 0; d < 3; d++)
+      {
+        for(int32_t numIterations : {1, 3, 50})
+        {
+          DataContainerArray::Pointer expected = CreateTestData(23, 19, 17);
+          ReferenceErodeDilateBadData(expected, direction, numIterations, dirOns[d]);
+          DataContainerArray::Pointer actual = CreateTestData(23, 19, 17);
+          RunErodeDilateBadData(actual, direction, numIterations, dirOns[d]);
+          CompareCellData(expected, actual);
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  // Every frontier wave does what one sweep that still changes something does, so
+  // the frontier runs one wave less than the sweeps, which need a last sweep to
+  // find that nothing is left to change.
+  // -----------------------------------------------------------------------------
+  int TestFrontierSpeed()
+  {
+    DataContainerArray::Pointer expected = CreateTestData(160, 160, 120);
+    size_t totalPoints = 160 * 160 * 120;
+    auto start = std::chrono::steady_clock::now();
+    size_t sweeps = ReferenceFillBadData(expected, 100000000);
+    double sweepMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    DataContainerArray::Pointer actual = CreateTestData(160, 160, 120);
+    start = std::chrono::steady_clock::now();
+    RunFillBadData(actual, 100000000);
+    double frontierMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    CompareCellData(expected, actual);
+    std::cout << "  FillBadData 160x160x120: " << sweeps << " full sweeps (" << sweeps * totalPoints << " voxel visits) " << sweepMillis << " ms, " << sweeps - 1 << " frontier waves "
+              << frontierMillis << " ms" << std::endl;
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFillBadData())
+    DREAM3D_REGISTER_TEST(TestErodeDilateBadData())
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(TestFrontierSpeed())
+#endif
+  }
+
+private:
+  VoxelFrontierTest(const VoxelFrontierTest&); // Copy Constructor Not Implemented
+  void operator=(const VoxelFrontierTest&);    // Move assignment Not Implemented
+};
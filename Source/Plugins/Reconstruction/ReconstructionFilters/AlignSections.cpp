@@ -35,6 +35,9 @@
 
 #include "AlignSections.h"
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
@@ -56,14 +59,37 @@
 #include "Reconstruction/ReconstructionVersion.h"
 
 // -----------------------------------------------------------------------------
-//
+// Shifts one slice of an array in place by (xShift, yShift) cells. Every row is
+// moved as one block and the cells that have no source inside the slice are zeroed.
 // -----------------------------------------------------------------------------
-template <typename T> void initializeArrayValues(IDataArray::Pointer p, size_t index)
+template <typename T> void transferSliceData(IDataArray::Pointer p, const size_t* dims, size_t slice, int64_t xShift, int64_t yShift)
 {
-
   typename DataArray<T>::Pointer ptr = std::dynamic_pointer_cast<DataArray<T>>(p);
-  T var = static_cast<T>(0);
-  ptr->initializeTuple(index, &var);
+  size_t numComps = static_cast<size_t>(ptr->getNumberOfComponents());
+  int64_t dimX = static_cast<int64_t>(dims[0]);
+  int64_t dimY = static_cast<int64_t>(dims[1]);
+  size_t rowLength = dims[0] * numComps;
+  T* sliceData = ptr->getPointer(slice * dims[0] * dims[1] * numComps);
+
+  // Destination columns [xStart, xEnd) have a source column inside the slice
+  int64_t xStart = std::max<int64_t>(0, -xShift);
+  int64_t xEnd = std::min<int64_t>(dimX, dimX - xShift);
+  for(int64_t l = 0; l < dimY; l++)
+  {
+    // Walk the rows in the direction of the shift so no source row is overwritten before it has been moved
+    int64_t yspot = (yShift >= 0) ? l : dimY - 1 - l;
+    int64_t ySource = yspot + yShift;
+    T* row = sliceData + yspot * rowLength;
+    if(ySource < 0 || ySource >= dimY || xStart >= xEnd)
+    {
+      std::fill(row, row + rowLength, static_cast<T>(0));
+      continue;
+    }
+    T* source = sliceData + ySource * rowLength + (xStart + xShift) * numComps;
+    ::memmove(row + xStart * numComps, source, (xEnd - xStart) * numComps * sizeof(T));
+    std::fill(row, row + xStart * numComps, static_cast<T>(0));
+    std::fill(row + xEnd * numComps, row + rowLength, static_cast<T>(0));
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -75,84 +101,52 @@ public:
   AlignSectionsTransferDataImpl() = delete;
   AlignSectionsTransferDataImpl(const AlignSectionsTransferDataImpl&) = default; // Copy Constructor Not Implemented
 
-  AlignSectionsTransferDataImpl(AlignSections* filter, size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts, int32_t voxelArrayIndex)
+  AlignSectionsTransferDataImpl(AlignSections* filter, size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts, const std::vector<IDataArray::Pointer>& voxelArrays)
   : m_Filter(filter)
   , m_Dims(dims)
   , m_xshifts(xshifts)
   , m_yshifts(yshifts)
-  , m_VoxelArrayIndex(voxelArrayIndex)
+  , m_VoxelArrays(voxelArrays)
   {
   }
 
   ~AlignSectionsTransferDataImpl() = default;
 
-  void operator()() const
+  /**
+   * @brief transferSlice Applies the shift of section i to one of the cell arrays. Section i
+   * holds the shift for slice (dims[2] - 1 - i); section 0 is never moved.
+   */
+  void transferSlice(size_t voxelArrayIndex, size_t i) const
   {
-    DataContainer::Pointer m = m_Filter->getDataContainerArray()->getDataContainer(m_Filter->getDataContainerName());
-    QVector<QString> voxelArrayNames = m->getAttributeMatrix(m_Filter->getCellAttributeMatrixName())->getAttributeArrayNames().toVector();
-    size_t progIncrement = m_Dims[2] / 50;
-    size_t prog = 1;
-    size_t slice = 0;
+    size_t slice = (m_Dims[2] - 1) - i;
+    IDataArray::Pointer p = m_VoxelArrays[voxelArrayIndex];
+    EXECUTE_FUNCTION_TEMPLATE(m_Filter, transferSliceData, p, p, m_Dims, slice, m_xshifts[i], m_yshifts[i])
+  }
 
-    for(size_t i = 1; i < m_Dims[2]; i++)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  /**
+   * @brief operator() Each index of the range is one (array, section) pair
+   */
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    size_t numSections = m_Dims[2] - 1;
+    for(size_t task = r.begin(); task != r.end(); task++)
     {
-      if(i > prog)
-      {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
-      }
-      if(m_Filter->getCancel() == true)
+      if(m_Filter->getCancel())
       {
         return;
       }
-      slice = (m_Dims[2] - 1) - i;
-      for(size_t l = 0; l < m_Dims[1]; l++)
-      {
-        for(size_t n = 0; n < m_Dims[0]; n++)
-        {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(m_yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(m_yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(m_Dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(m_xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(m_xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(m_Dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * m_Dims[0] * m_Dims[1]) + (yspot * m_Dims[0]) + xspot;
-          currentPosition = (slice * m_Dims[0] * m_Dims[1]) + ((yspot + m_yshifts[i]) * m_Dims[0]) + (xspot + m_xshifts[i]);
-          if((yspot + m_yshifts[i]) >= 0 && (yspot + m_yshifts[i]) <= static_cast<int64_t>(m_Dims[1]) - 1 && (xspot + m_xshifts[i]) >= 0 &&
-             (xspot + m_xshifts[i]) <= static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(m_Filter->getCellAttributeMatrixName())->getAttributeArray(voxelArrayNames[m_VoxelArrayIndex]);
-            p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-          if((yspot + m_yshifts[i]) < 0 || (yspot + m_yshifts[i]) > static_cast<int64_t>(m_Dims[1] - 1) || (xspot + m_xshifts[i]) < 0 || (xspot + m_xshifts[i]) > static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(m_Filter->getCellAttributeMatrixName())->getAttributeArray(voxelArrayNames[m_VoxelArrayIndex]);
-            EXECUTE_FUNCTION_TEMPLATE(m_Filter, initializeArrayValues, p, p, newPosition)
-          }
-        }
-      }
+      transferSlice(task / numSections, task % numSections + 1);
     }
   }
+#endif
 
 private:
   AlignSections* m_Filter = nullptr;
   size_t* m_Dims = nullptr;
-  std::vector<int64_t> m_xshifts;
-  std::vector<int64_t> m_yshifts;
-  int32_t m_VoxelArrayIndex = 0;
+  const std::vector<int64_t>& m_xshifts;
+  const std::vector<int64_t>& m_yshifts;
+  const std::vector<IDataArray::Pointer>& m_VoxelArrays;
 
   void operator=(const AlignSectionsTransferDataImpl&) = delete; // Move assignment Not Implemented
 };
@@ -295,105 +289,48 @@ void AlignSections::execute()
 
   find_shifts(xshifts, yshifts);
 
+  // Resolve the arrays once; each one is then shifted slice by slice with whole row moves
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
+  std::vector<IDataArray::Pointer> voxelArrays;
+  for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    voxelArrays.push_back(m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter));
+  }
+  if(dims[2] < 2 || voxelArrays.empty())
+  {
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+  AlignSectionsTransferDataImpl transfer(this, dims, xshifts, yshifts, voxelArrays);
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
 #endif
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  // The idea for this parallel section is to parallelize over each Data Array that
-  // will need it's data adjusted. This should go faster than before by about 2x.
-  // Better speed up could be achieved if we had better data locality.
+  // Every (array, slice) pair is independent of all the others
   if(doParallel == true)
   {
-    std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-    QVector<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames().toVector();
-    m_TotalProgress = voxelArrayNames.size() * dims[2]; // Total number of slices to update
-    // Create all the tasks
-    for(int32_t voxelArray = 0; voxelArray < voxelArrayNames.size(); voxelArray++)
-    {
-      g->run(AlignSectionsTransferDataImpl(this, dims, xshifts, yshifts, voxelArray));
-    }
-    // Wait for them to complete.
-    g->wait();
-    
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Transferring Cell Data");
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, voxelArrays.size() * (dims[2] - 1)), transfer, tbb::auto_partitioner());
   }
   else
 #endif
   {
-#if 0
-  // This code is actually a bit slower than the code below.... 
-    QVector<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames().toVector();
-    for(int32_t voxelArray = 0; voxelArray < voxelArrayNames.size(); voxelArray++)
-    {
-      AlignSectionsTransferDataImpl(this, dims, xshifts, yshifts, voxelArray)();
-    }
-#else
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-    size_t progIncrement = dims[2] / 100;
-    size_t prog = 1;
-    size_t progressInt = 0;
-    size_t slice = 0;
-
+    m_TotalProgress = voxelArrays.size() * dims[2];
     for(size_t i = 1; i < dims[2]; i++)
     {
-      if(i > prog)
-      {
-        progressInt = static_cast<int>((static_cast<float>(i) / static_cast<float>(dims[2])) * 100.0f);
-        QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        prog = prog + progIncrement;
-      }
       if(getCancel())
       {
         return;
       }
-      slice = (dims[2] - 1) - i;
-      for(size_t l = 0; l < dims[1]; l++)
+      for(size_t voxelArray = 0; voxelArray < voxelArrays.size(); voxelArray++)
       {
-        for(size_t n = 0; n < dims[0]; n++)
-        {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-          currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-          if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
-          {
-            for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
-              p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-            }
-          }
-          if((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > static_cast<int64_t>(dims[1] - 1) || (xspot + xshifts[i]) < 0 || (xspot + xshifts[i]) > static_cast<int64_t>(dims[0]) - 1)
-          {
-            for(QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
-              EXECUTE_FUNCTION_TEMPLATE(this, initializeArrayValues, p, p, newPosition)
-            }
-          }
-        }
+        transfer.transferSlice(voxelArray, i);
       }
+      updateProgress(voxelArrays.size());
     }
-#endif
   }
 
   // If there is an error set this to something negative and also set a message
@@ -36,6 +36,7 @@
 #include "AlignSectionsMisorientation.h"
 
 #include <fstream>
+#include <vector>
 
 #include <QtCore/QDateTime>
 
@@ -248,10 +249,6 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
   int64_t oldyshift = 0;
   float count = 0.0f;
   int64_t slice = 0;
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   int64_t refposition = 0;
   int64_t curposition = 0;
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
@@ -268,6 +265,13 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
   int64_t xIdx = 0;
   int64_t yIdx = 0;
 
+  // The orientation pairs of each trial shift are sorted by crystal structure
+  // and their misorientations are computed in one batch per structure
+  size_t numOps = m_OrientationOps.size();
+  std::vector<std::vector<QuatF>> q1Batches(numOps);
+  std::vector<std::vector<QuatF>> q2Batches(numOps);
+  std::vector<float> angles;
+
   const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
   const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
 
@@ -302,6 +306,11 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
         {
           disorientation = 0.0f;
           count = 0.0f;
+          for(size_t b = 0; b < numOps; b++)
+          {
+            q1Batches[b].clear();
+            q2Batches[b].clear();
+          }
           xIdx = k + oldxshift + halfDim0;
           yIdx = j + oldyshift + halfDim1;
           idx = (dims[0] * yIdx) + xIdx;
@@ -318,19 +327,20 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
                   curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
                   if(m_UseGoodVoxels == false || (m_GoodVoxels[refposition] == true && m_GoodVoxels[curposition] == true))
                   {
-                    w = std::numeric_limits<float>::max();
+                    bool batched = false;
                     if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
                     {
-                      QuaternionMathF::Copy(quats[refposition], q1);
                       phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      QuaternionMathF::Copy(quats[curposition], q2);
                       phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
+                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(numOps))
                       {
-                        w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+                        q1Batches[phase1].push_back(quats[refposition]);
+                        q2Batches[phase1].push_back(quats[curposition]);
+                        batched = true;
                       }
                     }
-                    if(w > misorientationTolerance)
+                    // Pairs that can not be compared always count as misoriented
+                    if(!batched)
                     {
                       disorientation++;
                     }
@@ -352,6 +362,23 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
                 }
               }
             }
+            for(size_t b = 0; b < numOps; b++)
+            {
+              size_t numPairs = q2Batches[b].size();
+              if(numPairs == 0)
+              {
+                continue;
+              }
+              angles.resize(numPairs);
+              m_OrientationOps[b]->getMisoQuatBatch(q1Batches[b].data(), q2Batches[b].data(), numPairs, angles.data(), nullptr);
+              for(size_t p = 0; p < numPairs; p++)
+              {
+                if(angles[p] > misorientationTolerance)
+                {
+                  disorientation++;
+                }
+              }
+            }
             disorientation = disorientation / count;
             xIdx = k + oldxshift + halfDim0;
             yIdx = j + oldyshift + halfDim1;
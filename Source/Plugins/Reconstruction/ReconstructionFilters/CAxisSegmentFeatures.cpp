@@ -40,6 +40,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -99,6 +100,7 @@ void CAxisSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("C-Axis Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, CAxisSegmentFeatures));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, CAxisSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, CAxisSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -141,6 +143,7 @@ void CAxisSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -323,8 +326,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -333,7 +334,7 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true) && m_CellPhases[randpoint] > 0)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -350,9 +351,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -362,7 +360,29 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && canGroup(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
+  {
+    return false;
+  }
+
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint])
+  {
+    return false;
+  }
+
   float w = std::numeric_limits<float>::max();
   QuatF q1 = QuaternionMathF::New();
   QuatF q2 = QuaternionMathF::New();
@@ -375,41 +395,57 @@ bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t nei
   float c1[3] = {0.0f, 0.0f, 0.0f};
   float c2[3] = {0.0f, 0.0f, 0.0f};
 
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
-  {
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
+  QuaternionMathF::Copy(quats[referencepoint], q1);
+  QuaternionMathF::Copy(quats[neighborpoint], q2);
+
+  FOrientArrayType om(9);
+  FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
+  om.toGMatrix(g1);
+  FOrientTransformsType::qu2om(FOrientArrayType(q2), om);
+  om.toGMatrix(g2);
+
+  // transpose the g matricies so when caxis is multiplied by it
+  // it will give the sample direction that the caxis is along
+  MatrixMath::Transpose3x3(g1, g1t);
+  MatrixMath::Transpose3x3(g2, g2t);
+  MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
+  MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
+
+  // normalize so that the dot product can be taken below without
+  // dividing by the magnitudes (they would be 1)
+  MatrixMath::Normalize3x1(c1);
+  MatrixMath::Normalize3x1(c2);
+
+  w = ((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2]));
+  w = acosf(w);
+  return (w <= m_MisoTolerance || (SIMPLib::Constants::k_Pi - w) <= m_MisoTolerance);
+}
 
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      FOrientArrayType om(9);
-      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-      om.toGMatrix(g1);
-      FOrientTransformsType::qu2om(FOrientArrayType(q2), om);
-      om.toGMatrix(g2);
-
-      // transpose the g matricies so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Transpose3x3(g2, g2t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
-      MatrixMath::Normalize3x1(c2);
-
-      w = ((c1[0] * c2[0]) + (c1[1] * c2[1]) + (c1[2] * c2[2]));
-      w = acosf(w);
-      if(w <= m_MisoTolerance || (SIMPLib::Constants::k_Pi - w) <= m_MisoTolerance)
-      {
-        group = true;
-        m_FeatureIds[neighborpoint] = gnum;
-      }
-    }
-  }
-  return group;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* CAxisSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return (m_UseGoodVoxels == false || m_GoodVoxels[index] == true) && m_CellPhases[index] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CAxisSegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -35,12 +35,14 @@
 
 #include "EBSDSegmentFeatures.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QDateTime>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -93,6 +95,7 @@ void EBSDSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Parameter, EBSDSegmentFeatures));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, EBSDSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, EBSDSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -135,6 +138,7 @@ void EBSDSegmentFeatures::readFilterParameters(AbstractFilterParametersReader* r
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
   reader->closeFilterGroup();
 }
@@ -316,8 +320,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -326,7 +328,7 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if((m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true) && m_CellPhases[randpoint] > 0)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -343,9 +345,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -355,39 +354,76 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && canGroup(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
   // Get the phases for each voxel
   int32_t phase1 = m_CrystalStructures[m_CellPhases[referencepoint]];
   int32_t phase2 = m_CrystalStructures[m_CellPhases[neighborpoint]];
   // If either of the phases is 999 then we bail out now.
   if(phase1 >= m_OrientationOps.size() || phase2 >= m_OrientationOps.size())
   {
-    return group;
+    return false;
   }
 
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  if(m_UseGoodVoxels == true && (m_GoodVoxels[referencepoint] == false || m_GoodVoxels[neighborpoint] == false))
   {
-    float w = std::numeric_limits<float>::max();
-    QuatF q1 = QuaternionMathF::New();
-    QuatF q2 = QuaternionMathF::New();
-    QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-    float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-
-    QuaternionMathF::Copy(quats[referencepoint], q1);
-    QuaternionMathF::Copy(quats[neighborpoint], q2);
+    return false;
+  }
 
-    if(m_CellPhases[referencepoint] == m_CellPhases[neighborpoint])
-    {
-      w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
-    }
-    if(w < m_MisoTolerance)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+  if(m_CellPhases[referencepoint] != m_CellPhases[neighborpoint])
+  {
+    return false;
   }
-  return group;
+
+  // The misorientation is not exactly symmetric in floating point, so always measure it from
+  // the lower index to the higher one. This way a pair right at the tolerance is grouped the
+  // same way no matter which of the two points the serial burn or the block merge starts from.
+  int64_t first = std::min(referencepoint, neighborpoint);
+  int64_t second = std::max(referencepoint, neighborpoint);
+
+  // Only the angle is needed here, so the misorientation axis is not computed
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  float w = 0.0f;
+  m_OrientationOps[phase1]->getMisoQuatBatch(quats + first, quats + second, 1, &w, nullptr);
+  return w < m_MisoTolerance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* EBSDSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return (m_UseGoodVoxels == false || m_GoodVoxels[index] == true) && m_CellPhases[index] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EBSDSegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -57,6 +57,7 @@ class Reconstruction_EXPORT EBSDSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(QString CellFeatureAttributeMatrixName READ getCellFeatureAttributeMatrixName WRITE setCellFeatureAttributeMatrixName)
     PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
     PYB11_PROPERTY(DataArrayPath CrystalStructuresArrayPath READ getCrystalStructuresArrayPath WRITE setCrystalStructuresArrayPath)
@@ -187,6 +188,26 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedCandidate(int64_t index) const override;
+
+  /**
+   * @brief canGroup Reimplemented from @see SegmentFeatures class
+   */
+  bool canGroup(int64_t referencepoint, int64_t neighborpoint) const override;
+
+  /**
+   * @brief setNumberOfFeatures Reimplemented from @see SegmentFeatures class
+   */
+  void setNumberOfFeatures(size_t numTuples) override;
+
 private:
   DEFINE_DATAARRAY_VARIABLE(float, Quats)
   DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
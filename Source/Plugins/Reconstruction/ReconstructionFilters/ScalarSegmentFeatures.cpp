@@ -41,6 +41,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -61,7 +62,7 @@ class CompareFunctor
 public:
   ~CompareFunctor() = default;
 
-  virtual bool operator()(int64_t index, int64_t neighIndex, int32_t gnum) // call using () operator
+  virtual bool operator()(int64_t index, int64_t neighIndex) const // call using () operator
   {
     return false;
   }
@@ -73,15 +74,14 @@ public:
 class TSpecificCompareFunctorBool : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance, int32_t* featureIds)
+  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance)
   : m_Length(length)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<bool*>(data);
   }
   ~TSpecificCompareFunctorBool() = default;
 
-  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint) const
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -91,7 +91,6 @@ public:
 
     if(m_Data[neighborpoint] == m_Data[referencepoint])
     {
-      m_FeatureIds[neighborpoint] = gnum;
       return true;
     }
     return false;
@@ -105,7 +104,6 @@ protected:
 private:
   bool* m_Data = nullptr;          // The data that is being compared
   int64_t m_Length = 0;      // Length of the Data Array
-  int32_t* m_FeatureIds = nullptr; // The Feature Ids
 };
 
 /**
@@ -114,16 +112,15 @@ private:
 template <class T> class TSpecificCompareFunctor : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctor(void* data, int64_t length, T tolerance, int32_t* featureIds)
+  TSpecificCompareFunctor(void* data, int64_t length, T tolerance)
   : m_Length(length)
   , m_Tolerance(tolerance)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<T*>(data);
   }
    ~TSpecificCompareFunctor() = default;
 
-  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+  virtual bool operator()(int64_t referencepoint, int64_t neighborpoint) const
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -135,7 +132,6 @@ public:
     {
       if((m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance)
       {
-        m_FeatureIds[neighborpoint] = gnum;
         return true;
       }
     }
@@ -143,7 +139,6 @@ public:
     {
       if((m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance)
       {
-        m_FeatureIds[neighborpoint] = gnum;
         return true;
       }
     }
@@ -159,7 +154,6 @@ private:
   T* m_Data = nullptr;             // The data that is being compared
   int64_t m_Length = 0;      // Length of the Data Array
   T m_Tolerance = static_cast<T>(0);         // The tolerance of the comparison
-  int32_t* m_FeatureIds = nullptr; // The Feature Ids
 };
 
 // -----------------------------------------------------------------------------
@@ -196,6 +190,7 @@ void ScalarSegmentFeatures::setupFilterParameters()
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Scalar Tolerance", ScalarTolerance, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, ScalarSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, ScalarSegmentFeatures));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Any);
@@ -228,6 +223,7 @@ void ScalarSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setScalarArrayPath(reader->readDataArrayPath("ScalarArrayPath", getScalarArrayPath()));
   setScalarTolerance(reader->readValue("ScalarTolerance", getScalarTolerance()));
   reader->closeFilterGroup();
@@ -398,8 +394,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -408,7 +402,7 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -425,9 +419,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -437,16 +428,53 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool ScalarSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  if(m_FeatureIds[neighborpoint] == 0 && canGroup(referencepoint, neighborpoint))
   {
-    CompareFunctor* func = m_Compare.get();
-    return (*func)((size_t)(referencepoint), (size_t)(neighborpoint), gnum);
-    //     | Functor  ||calling the operator() method of the CompareFunctor Class |
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
   }
-  else
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
   {
     return false;
   }
+  const CompareFunctor* func = m_Compare.get();
+  return (*func)(referencepoint, neighborpoint);
+  //     | Functor  ||calling the operator() method of the CompareFunctor Class |
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* ScalarSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return m_UseGoodVoxels == false || m_GoodVoxels[index] == true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScalarSegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
@@ -490,47 +518,47 @@ void ScalarSegmentFeatures::execute()
   }
   else if(dType.compare("int8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, static_cast<int8_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, static_cast<int8_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, static_cast<uint8_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, static_cast<uint8_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("bool") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, static_cast<bool>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, static_cast<bool>(m_ScalarTolerance)));
   }
   else if(dType.compare("int16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, static_cast<int16_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, static_cast<int16_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, static_cast<uint16_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, static_cast<uint16_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("int32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, static_cast<int32_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, static_cast<int32_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, static_cast<uint32_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, static_cast<uint32_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("int64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, static_cast<int64_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, static_cast<int64_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, static_cast<uint64_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, static_cast<uint64_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("float") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("double") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, static_cast<double>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, static_cast<double>(m_ScalarTolerance)));
   }
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
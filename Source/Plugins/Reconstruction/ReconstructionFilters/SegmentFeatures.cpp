@@ -35,6 +35,16 @@
 
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <thread>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
@@ -42,11 +52,193 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The SegmentFeaturesBlockLabelImpl class burns the Features of each block of points independently of the
+ * other blocks. Each block numbers its Features starting at 1, in the order their seeds are found.
+ */
+class SegmentFeaturesBlockLabelImpl
+{
+public:
+  SegmentFeaturesBlockLabelImpl(SegmentFeatures* filter, int32_t* featureIds, int64_t* dims, int64_t pointsPerBlock, std::vector<int32_t>& blockFeatureCounts)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_PointsPerBlock(pointsPerBlock)
+  , m_BlockFeatureCounts(blockFeatureCounts)
+  {
+  }
+  virtual ~SegmentFeaturesBlockLabelImpl() = default;
+
+  void labelBlocks(size_t start, size_t end) const
+  {
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    int64_t neighpoints[6] = {-(m_Dims[0] * m_Dims[1]), -m_Dims[0], -1, 1, m_Dims[0], (m_Dims[0] * m_Dims[1])};
+    std::vector<int64_t> voxelslist;
+
+    for(size_t block = start; block < end; block++)
+    {
+      int64_t blockStart = static_cast<int64_t>(block) * m_PointsPerBlock;
+      int64_t blockEnd = std::min(blockStart + m_PointsPerBlock, totalPoints);
+      int32_t gnum = 0;
+      for(int64_t seed = blockStart; seed < blockEnd; seed++)
+      {
+        if(m_FeatureIds[seed] != 0 || !m_Filter->isSeedCandidate(seed))
+        {
+          continue;
+        }
+        gnum++;
+        m_FeatureIds[seed] = gnum;
+        voxelslist.push_back(seed);
+        while(!voxelslist.empty())
+        {
+          int64_t currentpoint = voxelslist.back();
+          voxelslist.pop_back();
+          int64_t col = currentpoint % m_Dims[0];
+          int64_t row = (currentpoint / m_Dims[0]) % m_Dims[1];
+          int64_t plane = currentpoint / (m_Dims[0] * m_Dims[1]);
+          for(int32_t i = 0; i < 6; i++)
+          {
+            if((i == 0 && plane == 0) || (i == 5 && plane == (m_Dims[2] - 1)) || (i == 1 && row == 0) || (i == 4 && row == (m_Dims[1] - 1)) || (i == 2 && col == 0) ||
+               (i == 3 && col == (m_Dims[0] - 1)))
+            {
+              continue;
+            }
+            int64_t neighbor = currentpoint + neighpoints[i];
+            // Points outside of this block are joined later by the merge pass
+            if(neighbor < blockStart || neighbor >= blockEnd)
+            {
+              continue;
+            }
+            if(m_FeatureIds[neighbor] == 0 && m_Filter->canGroup(currentpoint, neighbor))
+            {
+              m_FeatureIds[neighbor] = gnum;
+              voxelslist.push_back(neighbor);
+            }
+          }
+        }
+      }
+      m_BlockFeatureCounts[block] = gnum;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    labelBlocks(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SegmentFeatures* m_Filter;
+  int32_t* m_FeatureIds;
+  int64_t* m_Dims;
+  int64_t m_PointsPerBlock;
+  std::vector<int32_t>& m_BlockFeatureCounts;
+};
+
+/**
+ * @brief The SegmentFeaturesBlockMergeImpl class collects the pairs of block local Features that touch across the
+ * upper boundary of each block and belong together. Consecutive duplicate pairs are dropped so that the serial
+ * union-find only sees a small fraction of the boundary faces.
+ */
+class SegmentFeaturesBlockMergeImpl
+{
+public:
+  SegmentFeaturesBlockMergeImpl(SegmentFeatures* filter, int32_t* featureIds, int64_t* dims, int64_t pointsPerBlock, const std::vector<int32_t>& blockOffsets,
+                                std::vector<std::vector<std::pair<int32_t, int32_t>>>& blockPairs)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_PointsPerBlock(pointsPerBlock)
+  , m_BlockOffsets(blockOffsets)
+  , m_BlockPairs(blockPairs)
+  {
+  }
+  virtual ~SegmentFeaturesBlockMergeImpl() = default;
+
+  /**
+   * @brief provisionalLabel Returns the volume wide, zero based provisional label of a labeled point
+   */
+  int32_t provisionalLabel(int64_t index) const
+  {
+    return m_BlockOffsets[static_cast<size_t>(index / m_PointsPerBlock)] + m_FeatureIds[index] - 1;
+  }
+
+  void mergeBlocks(size_t start, size_t end) const
+  {
+    int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+    int64_t planeSize = m_Dims[0] * m_Dims[1];
+
+    for(size_t block = start; block < end; block++)
+    {
+      std::vector<std::pair<int32_t, int32_t>>& pairs = m_BlockPairs[block];
+      int64_t blockStart = static_cast<int64_t>(block) * m_PointsPerBlock;
+      int64_t blockEnd = std::min(blockStart + m_PointsPerBlock, totalPoints);
+      if(blockEnd >= totalPoints)
+      {
+        continue;
+      }
+      // Only the +Y and +Z neighbors can leave the block, since blocks are made of whole rows
+      int64_t first = std::max(blockStart, blockEnd - planeSize);
+      for(int64_t point = first; point < blockEnd; point++)
+      {
+        if(m_FeatureIds[point] == 0)
+        {
+          continue;
+        }
+        int64_t row = (point / m_Dims[0]) % m_Dims[1];
+        int64_t plane = point / planeSize;
+        if(row < (m_Dims[1] - 1) && point + m_Dims[0] >= blockEnd)
+        {
+          addPair(pairs, point, point + m_Dims[0]);
+        }
+        if(plane < (m_Dims[2] - 1))
+        {
+          addPair(pairs, point, point + planeSize);
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    mergeBlocks(r.begin(), r.end());
+  }
+#endif
+
+private:
+  SegmentFeatures* m_Filter;
+  int32_t* m_FeatureIds;
+  int64_t* m_Dims;
+  int64_t m_PointsPerBlock;
+  const std::vector<int32_t>& m_BlockOffsets;
+  std::vector<std::vector<std::pair<int32_t, int32_t>>>& m_BlockPairs;
+
+  void addPair(std::vector<std::pair<int32_t, int32_t>>& pairs, int64_t point, int64_t neighbor) const
+  {
+    if(m_FeatureIds[neighbor] == 0)
+    {
+      return;
+    }
+    std::pair<int32_t, int32_t> pair(provisionalLabel(point), provisionalLabel(neighbor));
+    if(!pairs.empty() && pairs.back() == pair)
+    {
+      return;
+    }
+    if(m_Filter->canGroup(point, neighbor))
+    {
+      pairs.push_back(pair);
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 SegmentFeatures::SegmentFeatures()
 : m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_UseParallelLabeling(true)
 {
 }
 
@@ -111,6 +303,175 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SegmentFeatures::getFeatureIdsPointer()
+{
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SegmentFeatures::executeBlockLabeling(int32_t* featureIds, int64_t dims[3])
+{
+  int64_t totalPoints = dims[0] * dims[1] * dims[2];
+  int64_t totalRows = dims[1] * dims[2];
+
+  // Aim for several blocks per core so the burn is load balanced. Blocks hold whole rows, and whole
+  // planes when there are enough of them, which keeps the boundary between two blocks to a single plane
+  int64_t numThreads = static_cast<int64_t>(std::max(std::thread::hardware_concurrency(), 1u));
+  int64_t rowsPerBlock = std::max(totalRows / (numThreads * 8), static_cast<int64_t>(1));
+  if(rowsPerBlock > dims[1])
+  {
+    rowsPerBlock = (rowsPerBlock / dims[1]) * dims[1];
+  }
+  int64_t pointsPerBlock = rowsPerBlock * dims[0];
+  size_t numBlocks = static_cast<size_t>((totalPoints + pointsPerBlock - 1) / pointsPerBlock);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  std::vector<int32_t> blockFeatureCounts(numBlocks, 0);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), SegmentFeaturesBlockLabelImpl(this, featureIds, dims, pointsPerBlock, blockFeatureCounts), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SegmentFeaturesBlockLabelImpl serial(this, featureIds, dims, pointsPerBlock, blockFeatureCounts);
+    serial.labelBlocks(0, numBlocks);
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  // Block local labels become volume wide provisional labels by offsetting them with the running total.
+  // Since blocks are ordered by point index and each block numbers its Features by seed index, the
+  // provisional labels are ordered by the lowest point index of each block local Feature
+  std::vector<int32_t> blockOffsets(numBlocks, 0);
+  int32_t numProvisional = 0;
+  for(size_t b = 0; b < numBlocks; b++)
+  {
+    blockOffsets[b] = numProvisional;
+    numProvisional += blockFeatureCounts[b];
+  }
+
+  std::vector<std::vector<std::pair<int32_t, int32_t>>> blockPairs(numBlocks);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), SegmentFeaturesBlockMergeImpl(this, featureIds, dims, pointsPerBlock, blockOffsets, blockPairs), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    SegmentFeaturesBlockMergeImpl serial(this, featureIds, dims, pointsPerBlock, blockOffsets, blockPairs);
+    serial.mergeBlocks(0, numBlocks);
+  }
+
+  // Union-find over the provisional labels, always keeping the lower label as the root so that each
+  // root is the provisional label that holds the lowest point index of the whole Feature
+  std::vector<int32_t> parent(static_cast<size_t>(numProvisional), 0);
+  for(int32_t i = 0; i < numProvisional; i++)
+  {
+    parent[i] = i;
+  }
+  auto findRoot = [&parent](int32_t label) {
+    while(parent[label] != label)
+    {
+      parent[label] = parent[parent[label]];
+      label = parent[label];
+    }
+    return label;
+  };
+  for(const std::vector<std::pair<int32_t, int32_t>>& pairs : blockPairs)
+  {
+    for(const std::pair<int32_t, int32_t>& pair : pairs)
+    {
+      int32_t root1 = findRoot(pair.first);
+      int32_t root2 = findRoot(pair.second);
+      if(root1 < root2)
+      {
+        parent[root2] = root1;
+      }
+      else if(root2 < root1)
+      {
+        parent[root1] = root2;
+      }
+    }
+  }
+
+  // Number the roots in ascending order, which is the order the serial burn would have found them in
+  std::vector<int32_t> finalIds(static_cast<size_t>(numProvisional), 0);
+  int32_t gnum = 0;
+  for(int32_t i = 0; i < numProvisional; i++)
+  {
+    int32_t root = findRoot(i);
+    finalIds[i] = (root == i) ? ++gnum : finalIds[root];
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, totalPoints), [&](const tbb::blocked_range<int64_t>& r) {
+      for(int64_t i = r.begin(); i < r.end(); i++)
+      {
+        if(featureIds[i] > 0)
+        {
+          featureIds[i] = finalIds[blockOffsets[static_cast<size_t>(i / pointsPerBlock)] + featureIds[i] - 1];
+        }
+      }
+    });
+  }
+  else
+#endif
+  {
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      if(featureIds[i] > 0)
+      {
+        featureIds[i] = finalIds[blockOffsets[static_cast<size_t>(i / pointsPerBlock)] + featureIds[i] - 1];
+      }
+    }
+  }
+
+  setNumberOfFeatures(static_cast<size_t>(gnum) + 1);
+
+  QString ss = QObject::tr("Total Features: %1").arg(gnum);
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -133,6 +494,14 @@ void SegmentFeatures::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
+  int32_t* featureIds = getFeatureIdsPointer();
+  if(getUseParallelLabeling() && nullptr != featureIds)
+  {
+    executeBlockLabeling(featureIds, dims);
+    notifyStatusMessage(getHumanLabel(), "Complete");
+    return;
+  }
+
   int32_t gnum = 1;
   int64_t seed = 0;
   int64_t neighbor = 0;
@@ -217,8 +586,7 @@ void SegmentFeatures::execute()
           }
         }
       }
-      
-      voxelslist.assign(initialVoxelsListSize, -1);
+
       gnum++;
       QString ss = QObject::tr("Total Features: %1").arg(gnum);
       if(gnum % 100 == 0)
@@ -232,6 +600,10 @@ void SegmentFeatures::execute()
     }
   }
 
+  // The Feature Attribute Matrix is only sized once all the Features are known, instead of
+  // growing it (and copying every Feature array) each time a new seed is found
+  setNumberOfFeatures(static_cast<size_t>(gnum));
+
   // If there is an error set this to something negative and also set a message
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -60,6 +60,9 @@ public:
 
   SIMPL_INSTANCE_STRING_PROPERTY(DataContainerName)
 
+  SIMPL_FILTER_PARAMETER(bool, UseParallelLabeling)
+  Q_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -157,7 +160,8 @@ protected:
   void initialize();
 
   /**
-   * @brief getSeed Initializes a new seed from which to start the burn algorithm
+   * @brief getSeed Initializes a new seed from which to start the burn algorithm. The Feature Attribute Matrix
+   * does not need to be resized here; setNumberOfFeatures is called once the burn is complete
    * @param gnum Feature Id to initialize seed
    * @return Integer Seed index
    */
@@ -172,7 +176,51 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Returns the raw Feature Ids that the block labeling algorithm writes into. The
+   * default implementation returns nullptr, which forces the serial burn algorithm.
+   * @return Raw Feature Ids pointer
+   */
+  virtual int32_t* getFeatureIdsPointer();
+
+  /**
+   * @brief isSeedCandidate Determines if a point may start (and therefore belong to) a Feature. Must not
+   * modify any state, since it is called concurrently by the block labeling algorithm
+   * @param index Point to check
+   * @return Boolean check for whether the point may be segmented
+   */
+  virtual bool isSeedCandidate(int64_t index) const;
+
+  /**
+   * @brief canGroup Side effect free version of determineGrouping that ignores the current Feature Ids. Must
+   * be safe to call concurrently and symmetric in its two points, since the block labeling algorithm only
+   * tests each pair of neighbors in one direction
+   * @param referencepoint Point of growing seed
+   * @param neighborpoint Point to be compared for adding
+   * @return Boolean check for whether the two points belong to the same Feature
+   */
+  virtual bool canGroup(int64_t referencepoint, int64_t neighborpoint) const;
+
+  /**
+   * @brief setNumberOfFeatures Resizes the Feature Attribute Matrix to hold the given number of tuples
+   * and updates any cached Feature pointers
+   * @param numTuples Number of Features, including the zero Feature
+   */
+  virtual void setNumberOfFeatures(size_t numTuples);
+
 private:
+  friend class SegmentFeaturesBlockLabelImpl;
+  friend class SegmentFeaturesBlockMergeImpl;
+
+  /**
+   * @brief executeBlockLabeling Labels the connected Features by splitting the volume into blocks of rows,
+   * burning each block independently and then merging the labels across block boundaries with a
+   * union-find. The Feature Ids are numbered in the same order as the serial burn algorithm.
+   * @param featureIds Raw Feature Ids pointer
+   * @param dims Grid dimensions
+   */
+  void executeBlockLabeling(int32_t* featureIds, int64_t dims[3]);
+
 public:
   SegmentFeatures(const SegmentFeatures&) = delete; // Copy Constructor Not Implemented
   SegmentFeatures(SegmentFeatures&&) = delete;      // Move Constructor
@@ -39,6 +39,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -85,6 +86,7 @@ void SineParamsSegmentFeatures::setupFilterParameters()
 
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Good Voxels Array", UseGoodVoxels, FilterParameter::Parameter, SineParamsSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, SineParamsSegmentFeatures));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -113,6 +115,7 @@ void SineParamsSegmentFeatures::readFilterParameters(AbstractFilterParametersRea
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setSineParamsArrayPath(reader->readDataArrayPath("SineParamsArrayPath", getSineParamsArrayPath()));
   // setAngleTolerance( reader->readValue("AngleTolerance", getAngleTolerance()) );
   reader->closeFilterGroup();
@@ -329,8 +332,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -339,7 +340,7 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -356,9 +357,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -368,30 +366,65 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool SineParamsSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && canGroup(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SineParamsSegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
+  {
+    return false;
+  }
+
   float v1;
   float v2;
   float shift;
   float step = 45.0f * SIMPLib::Constants::k_PiOver180;
   float avgDiff = 0;
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  for(int i = 0; i < 8; i++)
   {
-    for(int i = 0; i < 8; i++)
-    {
-      shift = float(i) * step;
-      v1 = m_SineParams[3 * referencepoint] * sin(2.0 * (shift + m_SineParams[3 * referencepoint + 2])) + m_SineParams[3 * referencepoint + 1];
-      v2 = m_SineParams[3 * neighborpoint] * sin(2.0 * (shift + m_SineParams[3 * neighborpoint + 2])) + m_SineParams[3 * neighborpoint + 1];
-      avgDiff += fabs(v1 - v2);
-    }
-    avgDiff /= 8.0;
-    if(avgDiff < 7)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+    shift = float(i) * step;
+    v1 = m_SineParams[3 * referencepoint] * sin(2.0 * (shift + m_SineParams[3 * referencepoint + 2])) + m_SineParams[3 * referencepoint + 1];
+    v2 = m_SineParams[3 * neighborpoint] * sin(2.0 * (shift + m_SineParams[3 * neighborpoint + 2])) + m_SineParams[3 * neighborpoint + 1];
+    avgDiff += fabs(v1 - v2);
   }
+  avgDiff /= 8.0;
+  return avgDiff < 7;
+}
 
-  return group;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* SineParamsSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SineParamsSegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return m_UseGoodVoxels == false || m_GoodVoxels[index] == true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SineParamsSegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
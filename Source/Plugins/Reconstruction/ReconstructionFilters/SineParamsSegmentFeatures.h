@@ -67,6 +67,7 @@ class Reconstruction_EXPORT SineParamsSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(QString CellFeatureAttributeMatrixName READ getCellFeatureAttributeMatrixName WRITE setCellFeatureAttributeMatrixName)
     PYB11_PROPERTY(DataArrayPath SineParamsArrayPath READ getSineParamsArrayPath WRITE setSineParamsArrayPath)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
     PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
@@ -176,6 +177,26 @@ protected:
   virtual int64_t getSeed(int32_t gnum, int64_t nextSeed);
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedCandidate(int64_t index) const override;
+
+  /**
+   * @brief canGroup Reimplemented from @see SegmentFeatures class
+   */
+  bool canGroup(int64_t referencepoint, int64_t neighborpoint) const override;
+
+  /**
+   * @brief setNumberOfFeatures Reimplemented from @see SegmentFeatures class
+   */
+  void setNumberOfFeatures(size_t numTuples) override;
+
 private:
   IDataArray::Pointer m_InputData;
 
@@ -41,6 +41,7 @@
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -90,6 +91,7 @@ void VectorSegmentFeatures::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Angle Tolerance", AngleTolerance, FilterParameter::Parameter, VectorSegmentFeatures));
   QStringList linkedProps("GoodVoxelsArrayPath");
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Parameter, VectorSegmentFeatures, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Parallel Labeling", UseParallelLabeling, FilterParameter::Parameter, VectorSegmentFeatures));
 
   {
     DataArraySelectionFilterParameter::RequirementType req;
@@ -118,6 +120,7 @@ void VectorSegmentFeatures::readFilterParameters(AbstractFilterParametersReader*
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseParallelLabeling(reader->readValue("UseParallelLabeling", getUseParallelLabeling()));
   setSelectedVectorArrayPath(reader->readDataArrayPath("SelectedVectorArrayPath", getSelectedVectorArrayPath()));
   setAngleTolerance(reader->readValue("AngleTolerance", getAngleTolerance()));
   reader->closeFilterGroup();
@@ -285,8 +288,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   setErrorCondition(0);
   setWarningCondition(0);
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
-
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
   // start with the next voxel after the last seed
@@ -295,7 +296,7 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   {
     if(m_FeatureIds[randpoint] == 0) // If the GrainId of the voxel is ZERO then we can use this as a seed point
     {
-      if(m_UseGoodVoxels == false || m_GoodVoxels[randpoint] == true)
+      if(isSeedCandidate(randpoint))
       {
         seed = randpoint;
       }
@@ -312,9 +313,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    QVector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -324,38 +322,74 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool VectorSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  bool group = false;
+  if(m_FeatureIds[neighborpoint] == 0 && canGroup(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::canGroup(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(m_UseGoodVoxels == true && m_GoodVoxels[neighborpoint] == false)
+  {
+    return false;
+  }
+
   float v1[3] = {0.0f, 0.0f, 0.0f};
   float v2[3] = {0.0f, 0.0f, 0.0f};
-  if(m_FeatureIds[neighborpoint] == 0 && (m_UseGoodVoxels == false || m_GoodVoxels[neighborpoint] == true))
+  v1[0] = m_Vectors[3 * referencepoint + 0];
+  v1[1] = m_Vectors[3 * referencepoint + 1];
+  v1[2] = m_Vectors[3 * referencepoint + 2];
+  v2[0] = m_Vectors[3 * neighborpoint + 0];
+  v2[1] = m_Vectors[3 * neighborpoint + 1];
+  v2[2] = m_Vectors[3 * neighborpoint + 2];
+  if(v1[2] < 0)
   {
-    v1[0] = m_Vectors[3 * referencepoint + 0];
-    v1[1] = m_Vectors[3 * referencepoint + 1];
-    v1[2] = m_Vectors[3 * referencepoint + 2];
-    v2[0] = m_Vectors[3 * neighborpoint + 0];
-    v2[1] = m_Vectors[3 * neighborpoint + 1];
-    v2[2] = m_Vectors[3 * neighborpoint + 2];
-    if(v1[2] < 0)
-    {
-      MatrixMath::Multiply3x1withConstant(v1, -1);
-    }
-    if(v2[2] < 0)
-    {
-      MatrixMath::Multiply3x1withConstant(v2, -1);
-    }
-    float w = GeometryMath::CosThetaBetweenVectors(v1, v2);
-    w = acosf(w);
-    if(w > SIMPLib::Constants::k_PiOver2)
-    {
-      w = SIMPLib::Constants::k_Pi - w;
-    }
-    if(w < m_AngleToleranceRad)
-    {
-      group = true;
-      m_FeatureIds[neighborpoint] = gnum;
-    }
+    MatrixMath::Multiply3x1withConstant(v1, -1);
+  }
+  if(v2[2] < 0)
+  {
+    MatrixMath::Multiply3x1withConstant(v2, -1);
   }
-  return group;
+  float w = GeometryMath::CosThetaBetweenVectors(v1, v2);
+  w = acosf(w);
+  if(w > SIMPLib::Constants::k_PiOver2)
+  {
+    w = SIMPLib::Constants::k_Pi - w;
+  }
+  return w < m_AngleToleranceRad;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t* VectorSegmentFeatures::getFeatureIdsPointer()
+{
+  return m_FeatureIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::isSeedCandidate(int64_t index) const
+{
+  return m_UseGoodVoxels == false || m_GoodVoxels[index] == true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VectorSegmentFeatures::setNumberOfFeatures(size_t numTuples)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  QVector<size_t> tDims(1, numTuples);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 }
 
 // -----------------------------------------------------------------------------
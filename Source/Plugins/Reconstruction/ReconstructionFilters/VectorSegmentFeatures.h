@@ -55,6 +55,7 @@ class Reconstruction_EXPORT VectorSegmentFeatures : public SegmentFeatures
     PYB11_PROPERTY(DataArrayPath SelectedVectorArrayPath READ getSelectedVectorArrayPath WRITE setSelectedVectorArrayPath)
     PYB11_PROPERTY(float AngleTolerance READ getAngleTolerance WRITE setAngleTolerance)
     PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+    PYB11_PROPERTY(bool UseParallelLabeling READ getUseParallelLabeling WRITE setUseParallelLabeling)
     PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
     PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
     PYB11_PROPERTY(QString ActiveArrayName READ getActiveArrayName WRITE setActiveArrayName)
@@ -175,6 +176,26 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief getFeatureIdsPointer Reimplemented from @see SegmentFeatures class
+   */
+  int32_t* getFeatureIdsPointer() override;
+
+  /**
+   * @brief isSeedCandidate Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedCandidate(int64_t index) const override;
+
+  /**
+   * @brief canGroup Reimplemented from @see SegmentFeatures class
+   */
+  bool canGroup(int64_t referencepoint, int64_t neighborpoint) const override;
+
+  /**
+   * @brief setNumberOfFeatures Reimplemented from @see SegmentFeatures class
+   */
+  void setNumberOfFeatures(size_t numTuples) override;
+
 private:
   DEFINE_DATAARRAY_VARIABLE(float, Vectors)
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
@@ -0,0 +1,254 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <fstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+class AlignSectionsListTest
+{
+
+public:
+  AlignSectionsListTest()
+  {
+  }
+  virtual ~AlignSectionsListTest()
+  {
+  }
+
+  const size_t k_Dims[3] = {9, 7, 6};
+  // Relative shift of each section against the previous one, like the lines of an alignment file
+  const int64_t k_XShifts[5] = {2, -3, 0, 12, -1};
+  const int64_t k_YShifts[5] = {0, 1, -2, 0, 3};
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::AlignSectionsListTest::ShiftsFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QString filtName = "AlignSectionsList";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Reconstruction Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::New();
+    size_t dims[3] = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    igeom->setDimensions(dims);
+    dc->setGeometry(igeom);
+
+    QVector<size_t> tDims(3, 0);
+    tDims[0] = k_Dims[0];
+    tDims[1] = k_Dims[1];
+    tDims[2] = k_Dims[2];
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    size_t totalPoints = k_Dims[0] * k_Dims[1] * k_Dims[2];
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, "FeatureIds", true);
+    QVector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(totalPoints, cDims, "EulerAngles", true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, "Mask", true);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i + 1));
+      eulers->setComponent(i, 0, static_cast<float>(i));
+      eulers->setComponent(i, 1, static_cast<float>(i) + 0.25f);
+      eulers->setComponent(i, 2, static_cast<float>(i) + 0.5f);
+      mask->setValue(i, (i % 3) != 0);
+    }
+    cellAM->addAttributeArray(featureIds->getName(), featureIds);
+    cellAM->addAttributeArray(eulers->getName(), eulers);
+    cellAM->addAttributeArray(mask->getName(), mask);
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Per voxel transfer exactly as AlignSections did it before the rows were block moved
+  // -----------------------------------------------------------------------------
+  template <typename T> void ReferenceTransfer(typename DataArray<T>::Pointer array, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts)
+  {
+    int64_t dims[3] = {static_cast<int64_t>(k_Dims[0]), static_cast<int64_t>(k_Dims[1]), static_cast<int64_t>(k_Dims[2])};
+    int32_t numComps = array->getNumberOfComponents();
+    for(int64_t i = 1; i < dims[2]; i++)
+    {
+      int64_t slice = (dims[2] - 1) - i;
+      for(int64_t l = 0; l < dims[1]; l++)
+      {
+        for(int64_t n = 0; n < dims[0]; n++)
+        {
+          int64_t yspot = (yshifts[i] >= 0) ? l : dims[1] - 1 - l;
+          int64_t xspot = (xshifts[i] >= 0) ? n : dims[0] - 1 - n;
+          int64_t newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
+          int64_t currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
+          if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) < dims[1] && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) < dims[0])
+          {
+            array->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
+          }
+          else
+          {
+            for(int32_t c = 0; c < numComps; c++)
+            {
+              array->setComponent(static_cast<size_t>(newPosition), c, static_cast<T>(0));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T> void CompareArrays(typename DataArray<T>::Pointer expected, typename DataArray<T>::Pointer actual)
+  {
+    DREAM3D_REQUIRED(expected->getSize(), ==, actual->getSize())
+    for(size_t i = 0; i < expected->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(expected->getValue(i), actual->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestBlockTransfer()
+  {
+    std::ofstream outFile(UnitTest::AlignSectionsListTest::ShiftsFile.toLatin1().data());
+    for(size_t i = 0; i < k_Dims[2] - 1; i++)
+    {
+      outFile << i << " " << k_XShifts[i] << " " << k_YShifts[i] << "\n";
+    }
+    outFile.close();
+
+    // Cumulative shifts, the same way AlignSectionsList reads them
+    std::vector<int64_t> xshifts(k_Dims[2], 0);
+    std::vector<int64_t> yshifts(k_Dims[2], 0);
+    for(size_t i = 1; i < k_Dims[2]; i++)
+    {
+      xshifts[i] = xshifts[i - 1] + k_XShifts[i - 1];
+      yshifts[i] = yshifts[i - 1] + k_YShifts[i - 1];
+    }
+
+    DataContainerArray::Pointer expected = CreateTestData();
+    AttributeMatrix::Pointer expectedAM = expected->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    ReferenceTransfer<int32_t>(expectedAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds"), xshifts, yshifts);
+    ReferenceTransfer<float>(expectedAM->getAttributeArrayAs<FloatArrayType>("EulerAngles"), xshifts, yshifts);
+    ReferenceTransfer<bool>(expectedAM->getAttributeArrayAs<BoolArrayType>("Mask"), xshifts, yshifts);
+
+    DataContainerArray::Pointer dca = CreateTestData();
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName("AlignSectionsList");
+    AbstractFilter::Pointer filter = filterFactory->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet = false;
+    var.setValue(UnitTest::AlignSectionsListTest::ShiftsFile);
+    propWasSet = filter->setProperty("InputFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("DREAM3DAlignmentFile", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    CompareArrays<int32_t>(expectedAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds"), cellAM->getAttributeArrayAs<Int32ArrayType>("FeatureIds"));
+    CompareArrays<float>(expectedAM->getAttributeArrayAs<FloatArrayType>("EulerAngles"), cellAM->getAttributeArrayAs<FloatArrayType>("EulerAngles"));
+    CompareArrays<bool>(expectedAM->getAttributeArrayAs<BoolArrayType>("Mask"), cellAM->getAttributeArrayAs<BoolArrayType>("Mask"));
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestBlockTransfer())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  AlignSectionsListTest(const AlignSectionsListTest&); // Copy Constructor Not Implemented
+  void operator=(const AlignSectionsListTest&);        // Move assignment Not Implemented
+};
@@ -0,0 +1,505 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+#include <chrono>
+#include <iostream>
+#endif
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "ReconstructionTestFileLocations.h"
+
+class SegmentFeaturesTest
+{
+
+public:
+  SegmentFeaturesTest()
+  {
+  }
+  virtual ~SegmentFeaturesTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  QStringList SegmentFilterNames()
+  {
+    return {"EBSDSegmentFeatures", "ScalarSegmentFeatures", "VectorSegmentFeatures", "CAxisSegmentFeatures", "SineParamsSegmentFeatures"};
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    QStringList filtNames = SegmentFilterNames();
+    FilterManager* fm = FilterManager::Instance();
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The SegmentFeaturesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a Voronoi like microstructure where every grain has a random orientation, a
+  // random vector, random sine parameters and a unique scalar value. Roughly one cell in
+  // fifty is masked out.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(size_t xDim, size_t yDim, size_t zDim, size_t numGrains)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New("Test");
+    dca->addDataContainer(dc);
+
+    ImageGeom::Pointer igeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {xDim, yDim, zDim};
+    igeom->setDimensions(dims);
+    dc->setGeometry(igeom);
+
+    size_t totalPoints = xDim * yDim * zDim;
+    QVector<size_t> tDims = {xDim, yDim, zDim};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, "CellData", AttributeMatrix::Type::Cell);
+    dc->addAttributeMatrix(cellAM->getName(), cellAM);
+
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, cDims, "Quats", true);
+    cDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, cDims, "Phases", true);
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(totalPoints, cDims, "Scalars", true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, cDims, "Mask", true);
+    cDims[0] = 3;
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(totalPoints, cDims, "Vectors", true);
+    FloatArrayType::Pointer sineParams = FloatArrayType::CreateArray(totalPoints, cDims, "SineParams", true);
+    cDims[0] = 1;
+    cellAM->addAttributeArray(quats->getName(), quats);
+    cellAM->addAttributeArray(phases->getName(), phases);
+    cellAM->addAttributeArray(scalars->getName(), scalars);
+    cellAM->addAttributeArray(mask->getName(), mask);
+    cellAM->addAttributeArray(vectors->getName(), vectors);
+    cellAM->addAttributeArray(sineParams->getName(), sineParams);
+
+    std::mt19937_64 generator(5489u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> centers(3 * numGrains, 0.0f);
+    std::vector<float> grainQuats(4 * numGrains, 0.0f);
+    for(size_t g = 0; g < numGrains; g++)
+    {
+      centers[3 * g + 0] = unit(generator) * xDim;
+      centers[3 * g + 1] = unit(generator) * yDim;
+      centers[3 * g + 2] = unit(generator) * zDim;
+      float norm = 0.0f;
+      for(size_t c = 0; c < 4; c++)
+      {
+        grainQuats[4 * g + c] = unit(generator) - 0.5f;
+        norm += grainQuats[4 * g + c] * grainQuats[4 * g + c];
+      }
+      norm = std::sqrt(norm);
+      for(size_t c = 0; c < 4; c++)
+      {
+        grainQuats[4 * g + c] /= norm;
+      }
+    }
+
+    // The vectors and sine parameters come from their own generator so the other arrays do not change
+    std::mt19937_64 grainGenerator(3141u);
+    std::vector<float> grainVectors(3 * numGrains, 0.0f);
+    std::vector<float> grainSineParams(3 * numGrains, 0.0f);
+    for(size_t g = 0; g < numGrains; g++)
+    {
+      float norm = 0.0f;
+      for(size_t c = 0; c < 3; c++)
+      {
+        grainVectors[3 * g + c] = unit(grainGenerator) - 0.5f;
+        norm += grainVectors[3 * g + c] * grainVectors[3 * g + c];
+      }
+      norm = std::sqrt(norm);
+      for(size_t c = 0; c < 3; c++)
+      {
+        grainVectors[3 * g + c] /= norm;
+      }
+      grainSineParams[3 * g + 0] = 100.0f * unit(grainGenerator);
+      grainSineParams[3 * g + 1] = 200.0f * unit(grainGenerator);
+      grainSineParams[3 * g + 2] = static_cast<float>(SIMPLib::Constants::k_Pi) * unit(grainGenerator);
+    }
+
+    for(size_t z = 0; z < zDim; z++)
+    {
+      for(size_t y = 0; y < yDim; y++)
+      {
+        for(size_t x = 0; x < xDim; x++)
+        {
+          size_t index = (z * yDim + y) * xDim + x;
+          size_t closest = 0;
+          float minDist = std::numeric_limits<float>::max();
+          for(size_t g = 0; g < numGrains; g++)
+          {
+            float dx = centers[3 * g + 0] - x;
+            float dy = centers[3 * g + 1] - y;
+            float dz = centers[3 * g + 2] - z;
+            float dist = dx * dx + dy * dy + dz * dz;
+            if(dist < minDist)
+            {
+              minDist = dist;
+              closest = g;
+            }
+          }
+          for(size_t c = 0; c < 4; c++)
+          {
+            quats->setComponent(index, c, grainQuats[4 * closest + c]);
+          }
+          for(size_t c = 0; c < 3; c++)
+          {
+            vectors->setComponent(index, c, grainVectors[3 * closest + c]);
+            sineParams->setComponent(index, c, grainSineParams[3 * closest + c]);
+          }
+          phases->setValue(index, 1);
+          scalars->setValue(index, static_cast<int32_t>(closest * 10));
+          mask->setValue(index, unit(generator) > 0.02f);
+        }
+      }
+    }
+
+    QVector<size_t> ensembleDims(1, 2);
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(ensembleDims, "EnsembleData", AttributeMatrix::Type::CellEnsemble);
+    dc->addAttributeMatrix(ensembleAM->getName(), ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, "CrystalStructures", true);
+    crystalStructures->setValue(0, 999); // Unknown
+    crystalStructures->setValue(1, 1);   // Cubic_High
+    ensembleAM->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateSegmentFilter(const QString& filtName, bool useParallelLabeling)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    AbstractFilter::Pointer filter = filterFactory->create();
+
+    QVariant var;
+    bool propWasSet = false;
+    var.setValue(useParallelLabeling);
+    propWasSet = filter->setProperty("UseParallelLabeling", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("UseGoodVoxels", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(DataArrayPath("Test", "CellData", "Mask"));
+    propWasSet = filter->setProperty("GoodVoxelsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    if(filtName == "EBSDSegmentFeatures" || filtName == "CAxisSegmentFeatures")
+    {
+      var.setValue(5.0f);
+      propWasSet = filter->setProperty("MisorientationTolerance", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("Test", "CellData", "Quats"));
+      propWasSet = filter->setProperty("QuatsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("Test", "CellData", "Phases"));
+      propWasSet = filter->setProperty("CellPhasesArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("Test", "EnsembleData", "CrystalStructures"));
+      propWasSet = filter->setProperty("CrystalStructuresArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+    else if(filtName == "VectorSegmentFeatures")
+    {
+      var.setValue(5.0f);
+      propWasSet = filter->setProperty("AngleTolerance", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("Test", "CellData", "Vectors"));
+      propWasSet = filter->setProperty("SelectedVectorArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+    else if(filtName == "SineParamsSegmentFeatures")
+    {
+      var.setValue(DataArrayPath("Test", "CellData", "SineParams"));
+      propWasSet = filter->setProperty("SineParamsArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+    else
+    {
+      var.setValue(0.0f);
+      propWasSet = filter->setProperty("ScalarTolerance", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+      var.setValue(DataArrayPath("Test", "CellData", "Scalars"));
+      propWasSet = filter->setProperty("ScalarArrayPath", var);
+      DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    }
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer RunSegmentFilter(const QString& filtName, bool useParallelLabeling, DataContainerArray::Pointer dca)
+  {
+    AbstractFilter::Pointer filter = CreateSegmentFilter(filtName, useParallelLabeling);
+    filter->setDataContainerArray(dca);
+
+    filter->execute();
+    int err = filter->getErrorCondition();
+    DREAM3D_REQUIRE(err >= 0)
+
+    return dca->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Feature Ids are randomized by the filters, so two labelings are compared by
+  // checking that they induce the same partition of the cells
+  // -----------------------------------------------------------------------------
+  void CompareLabelings(Int32ArrayType::Pointer serialIds, Int32ArrayType::Pointer parallelIds)
+  {
+    DREAM3D_REQUIRE_EQUAL(serialIds->getNumberOfTuples(), parallelIds->getNumberOfTuples())
+
+    std::map<int32_t, int32_t> serialToParallel;
+    std::map<int32_t, int32_t> parallelToSerial;
+    size_t numTuples = serialIds->getNumberOfTuples();
+    for(size_t i = 0; i < numTuples; i++)
+    {
+      int32_t s = serialIds->getValue(i);
+      int32_t p = parallelIds->getValue(i);
+      DREAM3D_REQUIRE_EQUAL((s == 0), (p == 0))
+
+      auto sIter = serialToParallel.find(s);
+      if(sIter == serialToParallel.end())
+      {
+        serialToParallel[s] = p;
+      }
+      else
+      {
+        DREAM3D_REQUIRE_EQUAL(sIter->second, p)
+      }
+      auto pIter = parallelToSerial.find(p);
+      if(pIter == parallelToSerial.end())
+      {
+        parallelToSerial[p] = s;
+      }
+      else
+      {
+        DREAM3D_REQUIRE_EQUAL(pIter->second, s)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestParallelLabeling()
+  {
+    QStringList filtNames = SegmentFilterNames();
+    for(const QString& filtName : filtNames)
+    {
+      DataContainerArray::Pointer serialDca = CreateTestData(37, 29, 23, 40);
+      Int32ArrayType::Pointer serialIds = RunSegmentFilter(filtName, false, serialDca);
+
+      DataContainerArray::Pointer parallelDca = CreateTestData(37, 29, 23, 40);
+      Int32ArrayType::Pointer parallelIds = RunSegmentFilter(filtName, true, parallelDca);
+
+      CompareLabelings(serialIds, parallelIds);
+
+      size_t serialFeatures = serialDca->getAttributeMatrix(DataArrayPath("Test", SIMPL::Defaults::CellFeatureAttributeMatrixName, ""))->getNumberOfTuples();
+      size_t parallelFeatures = parallelDca->getAttributeMatrix(DataArrayPath("Test", SIMPL::Defaults::CellFeatureAttributeMatrixName, ""))->getNumberOfTuples();
+      DREAM3D_REQUIRE_EQUAL(serialFeatures, parallelFeatures)
+    }
+
+    // A single slice exercises blocks that are smaller than a plane
+    {
+      DataContainerArray::Pointer serialDca = CreateTestData(211, 173, 1, 60);
+      Int32ArrayType::Pointer serialIds = RunSegmentFilter("EBSDSegmentFeatures", false, serialDca);
+
+      DataContainerArray::Pointer parallelDca = CreateTestData(211, 173, 1, 60);
+      Int32ArrayType::Pointer parallelIds = RunSegmentFilter("EBSDSegmentFeatures", true, parallelDca);
+
+      CompareLabelings(serialIds, parallelIds);
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The Feature Attribute Matrix must hold exactly one tuple per Feature plus the zero Feature,
+  // with every Feature marked Active, no matter how the filter grew it while segmenting
+  // -----------------------------------------------------------------------------
+  int TestFeatureAttributeMatrix()
+  {
+    QStringList filtNames = SegmentFilterNames();
+    for(const QString& filtName : filtNames)
+    {
+      for(bool useParallelLabeling : {false, true})
+      {
+        DataContainerArray::Pointer dca = CreateTestData(41, 31, 17, 250);
+        Int32ArrayType::Pointer featureIds = RunSegmentFilter(filtName, useParallelLabeling, dca);
+
+        int32_t maxFeatureId = 0;
+        for(size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+        {
+          maxFeatureId = std::max(maxFeatureId, featureIds->getValue(i));
+        }
+
+        AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath("Test", SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+        DREAM3D_REQUIRE_EQUAL(featureAM->getNumberOfTuples(), static_cast<size_t>(maxFeatureId) + 1)
+
+        BoolArrayType::Pointer active = featureAM->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::Active);
+        DREAM3D_REQUIRE_VALID_POINTER(active.get())
+        DREAM3D_REQUIRE_EQUAL(active->getNumberOfTuples(), static_cast<size_t>(maxFeatureId) + 1)
+        for(size_t i = 0; i < active->getNumberOfTuples(); i++)
+        {
+          DREAM3D_REQUIRE_EQUAL(active->getValue(i), true)
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rotates every cell about the Z axis by (y + z) times the misorientation tolerance plus a
+  // tiny random offset, so every +Y and +Z neighbor pair sits right at the tolerance. Whether
+  // such a pair is grouped depends only on rounding, which the serial burn and the block
+  // merge must resolve the same way regardless of which point they start from.
+  // -----------------------------------------------------------------------------
+  int TestMisorientationAtTolerance()
+  {
+    const float tolerance = static_cast<float>(5.0 * SIMPLib::Constants::k_PiOver180);
+    std::vector<DataContainerArray::Pointer> dcas(2);
+    for(size_t run = 0; run < dcas.size(); run++)
+    {
+      dcas[run] = CreateTestData(23, 31, 19, 1);
+      FloatArrayType::Pointer quats = dcas[run]->getAttributeMatrix(DataArrayPath("Test", "CellData", ""))->getAttributeArrayAs<FloatArrayType>("Quats");
+      std::mt19937_64 generator(5489u);
+      std::uniform_real_distribution<float> offset(-1.0E-6f, 1.0E-6f);
+      for(size_t z = 0; z < 19; z++)
+      {
+        for(size_t y = 0; y < 31; y++)
+        {
+          for(size_t x = 0; x < 23; x++)
+          {
+            size_t index = (z * 31 + y) * 23 + x;
+            float angle = static_cast<float>(y + z) * tolerance + offset(generator);
+            quats->setComponent(index, 0, 0.0f);
+            quats->setComponent(index, 1, 0.0f);
+            quats->setComponent(index, 2, sinf(0.5f * angle));
+            quats->setComponent(index, 3, cosf(0.5f * angle));
+          }
+        }
+      }
+    }
+
+    Int32ArrayType::Pointer serialIds = RunSegmentFilter("EBSDSegmentFeatures", false, dcas[0]);
+    Int32ArrayType::Pointer parallelIds = RunSegmentFilter("EBSDSegmentFeatures", true, dcas[1]);
+    CompareLabelings(serialIds, parallelIds);
+
+    return EXIT_SUCCESS;
+  }
+
+#ifdef DREAM3D_BUILD_BENCHMARKS
+  // -----------------------------------------------------------------------------
+  // Times the serial burn against the block labeling for every segmentation filter
+  // -----------------------------------------------------------------------------
+  int BenchmarkParallelLabeling()
+  {
+    for(const QString& filtName : SegmentFilterNames())
+    {
+      double millis[2] = {0.0, 0.0};
+      for(bool useParallelLabeling : {false, true})
+      {
+        DataContainerArray::Pointer dca = CreateTestData(160, 160, 80, 400);
+        AbstractFilter::Pointer filter = CreateSegmentFilter(filtName, useParallelLabeling);
+        filter->setDataContainerArray(dca);
+
+        auto start = std::chrono::steady_clock::now();
+        filter->execute();
+        millis[useParallelLabeling ? 1 : 0] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        DREAM3D_REQUIRE(filter->getErrorCondition() >= 0)
+      }
+      std::cout << filtName.toStdString() << ": serial " << millis[0] << " ms, parallel " << millis[1] << " ms, speedup " << millis[0] / millis[1] << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestParallelLabeling())
+    DREAM3D_REGISTER_TEST(TestFeatureAttributeMatrix())
+    DREAM3D_REGISTER_TEST(TestMisorientationAtTolerance())
+#ifdef DREAM3D_BUILD_BENCHMARKS
+    DREAM3D_REGISTER_TEST(BenchmarkParallelLabeling())
+#endif
+  }
+
+private:
+  SegmentFeaturesTest(const SegmentFeaturesTest&); // Copy Constructor Not Implemented
+  void operator=(const SegmentFeaturesTest&);      // Move assignment Not Implemented
+};
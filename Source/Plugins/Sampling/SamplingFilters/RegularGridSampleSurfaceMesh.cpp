@@ -35,13 +35,21 @@
 
 #include "RegularGridSampleSurfaceMesh.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
 #include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
@@ -49,6 +57,195 @@
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief A crossing of a row of Cell centers by the boundary of a Feature: the Feature Id and
+ * the X position where the row pierces one of that Feature's Triangles
+ */
+using RowCrossing = std::pair<int32_t, double>;
+
+/**
+ * @brief The ScanlineTriangle class holds one Triangle projected onto the YZ plane (wound
+ * counter clockwise) and finds the rows of Cell centers that pierce it. A row lying exactly on an
+ * edge or vertex is given to the Triangles on one side only (a top-left fill rule applied to edges
+ * evaluated in a fixed vertex order), so Triangles sharing an edge never both count or both miss
+ * the row and the parity of each Feature's crossings stays consistent.
+ */
+class ScanlineTriangle
+{
+public:
+  ScanlineTriangle(const float* a, const float* b, const float* c)
+  : m_Area(0.0)
+  {
+    m_Vertex[0] = a;
+    m_Vertex[1] = b;
+    m_Vertex[2] = c;
+    m_Area = edgeFunction(a, b, c[1], c[2]);
+    if(m_Area < 0.0)
+    {
+      std::swap(m_Vertex[1], m_Vertex[2]);
+      m_Area = -m_Area;
+    }
+  }
+
+  /**
+   * @brief isDegenerate Returns true if the Triangle is parallel to the X axis, in which case no
+   * row crosses it
+   */
+  bool isDegenerate() const
+  {
+    return m_Area == 0.0;
+  }
+
+  /**
+   * @brief getBounds Returns the extent of the projected Triangle in Y and Z
+   */
+  void getBounds(float yz0[2], float yz1[2]) const
+  {
+    for(int32_t d = 0; d < 2; d++)
+    {
+      yz0[d] = std::min(std::min(m_Vertex[0][d + 1], m_Vertex[1][d + 1]), m_Vertex[2][d + 1]);
+      yz1[d] = std::max(std::max(m_Vertex[0][d + 1], m_Vertex[1][d + 1]), m_Vertex[2][d + 1]);
+    }
+  }
+
+  /**
+   * @brief crossesRow Returns true if the row at (y, z) pierces the Triangle and sets x to the
+   * position of the crossing
+   */
+  bool crossesRow(float y, float z, double& x) const
+  {
+    for(int32_t e = 0; e < 3; e++)
+    {
+      const float* p = m_Vertex[e];
+      const float* q = m_Vertex[(e + 1) % 3];
+      double side = edgeFunction(p, q, y, z);
+      if(side < 0.0)
+      {
+        return false;
+      }
+      if(side == 0.0)
+      {
+        double dy = double(q[1]) - double(p[1]);
+        double dz = double(q[2]) - double(p[2]);
+        if(dz < 0.0 || (dz == 0.0 && dy >= 0.0))
+        {
+          return false;
+        }
+      }
+    }
+
+    // The X component of the Triangle normal is the projected (doubled) area
+    const float* a = m_Vertex[0];
+    const float* b = m_Vertex[1];
+    const float* c = m_Vertex[2];
+    double ny = (double(b[2]) - double(a[2])) * (double(c[0]) - double(a[0])) - (double(b[0]) - double(a[0])) * (double(c[2]) - double(a[2]));
+    double nz = (double(b[0]) - double(a[0])) * (double(c[1]) - double(a[1])) - (double(b[1]) - double(a[1])) * (double(c[0]) - double(a[0]));
+    x = double(a[0]) - (ny * (double(y) - double(a[1])) + nz * (double(z) - double(a[2]))) / m_Area;
+    return true;
+  }
+
+private:
+  const float* m_Vertex[3];
+  double m_Area;
+
+  /**
+   * @brief edgeFunction Returns twice the signed area of (p, q, (y, z)) in the YZ plane. The
+   * edge is always evaluated from its lexicographically smaller end point so both Triangles that
+   * share it see exactly opposite values.
+   */
+  static double edgeFunction(const float* p, const float* q, float y, float z)
+  {
+    if(q[1] < p[1] || (q[1] == p[1] && q[2] < p[2]))
+    {
+      return -edgeFunction(q, p, y, z);
+    }
+    return (double(q[1]) - double(p[1])) * (double(z) - double(p[2])) - (double(q[2]) - double(p[2])) * (double(y) - double(p[1]));
+  }
+};
+
+class RegularGridScanlineImpl
+{
+public:
+  RegularGridScanlineImpl(const std::vector<size_t>& rowOffsets, RowCrossing* crossings, int64_t xPoints, float xRes, float xOrigin, int32_t* featureIds)
+  : m_RowOffsets(rowOffsets)
+  , m_Crossings(crossings)
+  , m_XPoints(xPoints)
+  , m_XRes(xRes)
+  , m_XOrigin(xOrigin)
+  , m_FeatureIds(featureIds)
+  {
+  }
+  virtual ~RegularGridScanlineImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t row = start; row < end; row++)
+    {
+      RowCrossing* first = m_Crossings + m_RowOffsets[row];
+      RowCrossing* last = m_Crossings + m_RowOffsets[row + 1];
+      std::sort(first, last);
+
+      int32_t* rowIds = m_FeatureIds + row * m_XPoints;
+      while(first != last)
+      {
+        RowCrossing* featureEnd = first;
+        while(featureEnd != last && featureEnd->first == first->first)
+        {
+          ++featureEnd;
+        }
+        // Cells between successive pairs of crossings lie inside the Feature; an unpaired
+        // crossing left over from an open surface is ignored
+        for(; featureEnd - first >= 2; first += 2)
+        {
+          fillRun(rowIds, first->first, first->second, (first + 1)->second);
+        }
+        first = featureEnd;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const std::vector<size_t>& m_RowOffsets;
+  RowCrossing* m_Crossings;
+  int64_t m_XPoints;
+  float m_XRes;
+  float m_XOrigin;
+  int32_t* m_FeatureIds;
+
+  void fillRun(int32_t* rowIds, int32_t featureId, double x0, double x1) const
+  {
+    double first = std::floor((x0 - m_XOrigin) / m_XRes - 0.5);
+    int64_t i = first > 0.0 ? static_cast<int64_t>(first) : 0;
+    for(; i < m_XPoints; i++)
+    {
+      float x = (float(i) + 0.5f) * m_XRes + m_XOrigin;
+      if(x > x1)
+      {
+        break;
+      }
+      // Where non-conformal Features overlap, the lowest Feature Id owns the Cell
+      if(x >= x0 && rowIds[i] == 0)
+      {
+        rowIds[i] = featureId;
+      }
+    }
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -58,6 +255,7 @@ RegularGridSampleSurfaceMesh::RegularGridSampleSurfaceMesh()
 , m_XPoints(0)
 , m_YPoints(0)
 , m_ZPoints(0)
+, m_UseScanlineVoxelization(false)
 , m_FeatureIdsArrayName(SIMPL::CellData::FeatureIds)
 , m_FeatureIds(nullptr)
 {
@@ -89,6 +287,7 @@ void RegularGridSampleSurfaceMesh::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Resolution", Resolution, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_FLOAT_VEC3_FP("Origin", Origin, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Scanline Voxelization", UseScanlineVoxelization, FilterParameter::Parameter, RegularGridSampleSurfaceMesh));
 
   parameters.push_back(SIMPL_NEW_STRING_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, RegularGridSampleSurfaceMesh));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
@@ -109,6 +308,7 @@ void RegularGridSampleSurfaceMesh::readFilterParameters(AbstractFilterParameters
   setZPoints(reader->readValue("ZPoints", getZPoints()));
   setResolution(reader->readFloatVec3("Resolution", getResolution()));
   setOrigin(reader->readFloatVec3("Origin", getOrigin()));
+  setUseScanlineVoxelization(reader->readValue("UseScanlineVoxelization", getUseScanlineVoxelization()));
   setDataContainerName(reader->readString("DataContainerName", getDataContainerName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setFeatureIdsArrayName(reader->readString("FeatureIdsArrayName", getFeatureIdsArrayName()));
@@ -131,6 +331,14 @@ void RegularGridSampleSurfaceMesh::dataCheck()
   setWarningCondition(0);
   DataArrayPath tempPath;
 
+  if(getUseScanlineVoxelization() && (m_Resolution.x <= 0.0f || m_Resolution.y <= 0.0f || m_Resolution.z <= 0.0f))
+  {
+    QString ss = QObject::tr("Scanline voxelization requires a positive resolution along X, Y and Z");
+    setErrorCondition(-5558);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
   DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName());
   if(getErrorCondition() < 0)
   {
@@ -218,6 +426,133 @@ void RegularGridSampleSurfaceMesh::assign_points(Int32ArrayType::Pointer iArray)
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RegularGridSampleSurfaceMesh::voxelize_by_scanline()
+{
+  SampleSurfaceMesh::dataCheck();
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+
+  QVector<size_t> cDims(1, 2);
+  Int32ArrayType::Pointer faceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath(), cDims);
+  if(getErrorCondition() < 0 || nullptr == faceLabelsPtr.get())
+  {
+    return;
+  }
+  int32_t* faceLabels = faceLabelsPtr->getPointer(0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  TriangleGeom::Pointer triangleGeom = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName())->getGeometryAs<TriangleGeom>();
+  float* vertices = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  int64_t numFaces = faceLabelsPtr->getNumberOfTuples();
+
+  int64_t xPoints = m_XPoints;
+  int64_t yPoints = m_YPoints;
+  int64_t zPoints = m_ZPoints;
+  size_t numRows = static_cast<size_t>(yPoints * zPoints);
+
+  int64_t totalPoints = xPoints * yPoints * zPoints;
+  for(int64_t i = 0; i < totalPoints; i++)
+  {
+    m_FeatureIds[i] = 0;
+  }
+
+  // Visits every row of Cell centers that pierces a labeled Triangle. The index range of rows is
+  // padded by one on each side and the exact crossing test decides on the float Cell centers.
+  auto forEachCrossing = [&](int64_t face, const std::function<void(size_t, double)>& func) {
+    int64_t* tri = triangles + 3 * face;
+    ScanlineTriangle triangle(vertices + 3 * tri[0], vertices + 3 * tri[1], vertices + 3 * tri[2]);
+    if(triangle.isDegenerate())
+    {
+      return;
+    }
+    float yz0[2] = {0.0f, 0.0f};
+    float yz1[2] = {0.0f, 0.0f};
+    triangle.getBounds(yz0, yz1);
+    int64_t jMin = std::max<int64_t>(0, static_cast<int64_t>(std::floor((yz0[0] - m_Origin.y) / m_Resolution.y - 0.5f)));
+    int64_t jMax = std::min<int64_t>(yPoints - 1, static_cast<int64_t>(std::ceil((yz1[0] - m_Origin.y) / m_Resolution.y - 0.5f)));
+    int64_t kMin = std::max<int64_t>(0, static_cast<int64_t>(std::floor((yz0[1] - m_Origin.z) / m_Resolution.z - 0.5f)));
+    int64_t kMax = std::min<int64_t>(zPoints - 1, static_cast<int64_t>(std::ceil((yz1[1] - m_Origin.z) / m_Resolution.z - 0.5f)));
+    double x = 0.0;
+    for(int64_t k = kMin; k <= kMax; k++)
+    {
+      float z = (float(k) + 0.5f) * m_Resolution.z + m_Origin.z;
+      for(int64_t j = jMin; j <= jMax; j++)
+      {
+        float y = (float(j) + 0.5f) * m_Resolution.y + m_Origin.y;
+        if(triangle.crossesRow(y, z, x))
+        {
+          func(static_cast<size_t>(k * yPoints + j), x);
+        }
+      }
+    }
+  };
+
+  // Count the crossings in each row, then bucket them by row
+  std::vector<size_t> rowOffsets(numRows + 1, 0);
+  for(int64_t i = 0; i < numFaces; i++)
+  {
+    size_t labels = (faceLabels[2 * i] > 0 ? 1 : 0) + (faceLabels[2 * i + 1] > 0 ? 1 : 0);
+    if(labels > 0)
+    {
+      forEachCrossing(i, [&](size_t row, double) { rowOffsets[row + 1] += labels; });
+    }
+  }
+  for(size_t row = 0; row < numRows; row++)
+  {
+    rowOffsets[row + 1] += rowOffsets[row];
+  }
+
+  std::vector<RowCrossing> crossings(rowOffsets[numRows]);
+  std::vector<size_t> fill(rowOffsets.begin(), rowOffsets.end() - 1);
+  for(int64_t i = 0; i < numFaces; i++)
+  {
+    int32_t g1 = faceLabels[2 * i];
+    int32_t g2 = faceLabels[2 * i + 1];
+    if(g1 <= 0 && g2 <= 0)
+    {
+      continue;
+    }
+    forEachCrossing(i, [&](size_t row, double x) {
+      if(g1 > 0)
+      {
+        crossings[fill[row]++] = RowCrossing(g1, x);
+      }
+      if(g2 > 0)
+      {
+        crossings[fill[row]++] = RowCrossing(g2, x);
+      }
+    });
+  }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numRows), RegularGridScanlineImpl(rowOffsets, crossings.data(), xPoints, m_Resolution.x, m_Origin.x, m_FeatureIds),
+                      tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    RegularGridScanlineImpl serial(rowOffsets, crossings.data(), xPoints, m_Resolution.x, m_Origin.x, m_FeatureIds);
+    serial.convert(0, numRows);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -240,7 +575,14 @@ void RegularGridSampleSurfaceMesh::execute()
   m->getGeometryAs<ImageGeom>()->setResolution(std::make_tuple(m_Resolution.x, m_Resolution.y, m_Resolution.z));
   m->getGeometryAs<ImageGeom>()->setOrigin(std::make_tuple(m_Origin.x, m_Origin.y, m_Origin.z));
 
-  SampleSurfaceMesh::execute();
+  if(getUseScanlineVoxelization())
+  {
+    voxelize_by_scanline();
+  }
+  else
+  {
+    SampleSurfaceMesh::execute();
+  }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -59,6 +59,7 @@ class Sampling_EXPORT RegularGridSampleSurfaceMesh : public SampleSurfaceMesh
     PYB11_PROPERTY(int ZPoints READ getZPoints WRITE setZPoints)
     PYB11_PROPERTY(FloatVec3_t Resolution READ getResolution WRITE setResolution)
     PYB11_PROPERTY(FloatVec3_t Origin READ getOrigin WRITE setOrigin)
+    PYB11_PROPERTY(bool UseScanlineVoxelization READ getUseScanlineVoxelization WRITE setUseScanlineVoxelization)
     PYB11_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 public:
   SIMPL_SHARED_POINTERS(RegularGridSampleSurfaceMesh)
@@ -88,6 +89,9 @@ public:
   SIMPL_FILTER_PARAMETER(FloatVec3_t, Origin)
   Q_PROPERTY(FloatVec3_t Origin READ getOrigin WRITE setOrigin)
 
+  SIMPL_FILTER_PARAMETER(bool, UseScanlineVoxelization)
+  Q_PROPERTY(bool UseScanlineVoxelization READ getUseScanlineVoxelization WRITE setUseScanlineVoxelization)
+
   SIMPL_FILTER_PARAMETER(QString, FeatureIdsArrayName)
   Q_PROPERTY(QString FeatureIdsArrayName READ getFeatureIdsArrayName WRITE setFeatureIdsArrayName)
 
@@ -180,6 +184,12 @@ protected:
    */
   virtual void assign_points(Int32ArrayType::Pointer iArray);
 
+  /**
+   * @brief voxelize_by_scanline Labels the grid by casting one ray along X for each (Y, Z) row of
+   * Cell centers and filling the runs of Cells between each Feature's sorted crossings by parity
+   */
+  void voxelize_by_scanline();
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
@@ -52,6 +52,9 @@
 #include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
 
+#include "OrientationLib/Utilities/SamplePointGrid.hpp"
+#include "OrientationLib/Utilities/TriangleBVH.hpp"
+
 #include "Sampling/SamplingConstants.h"
 #include "Sampling/SamplingVersion.h"
 
@@ -62,16 +65,16 @@ class SampleSurfaceMeshImpl
 {
   TriangleGeom::Pointer m_Faces;
   Int32Int32DynamicListArray::Pointer m_FaceIds;
-  VertexGeom::Pointer m_FaceBBs;
   VertexGeom::Pointer m_Points;
+  const SamplePointGrid& m_PointGrid;
   int32_t* m_PolyIds;
 
 public:
-  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, VertexGeom::Pointer points, int32_t* polyIds)
+  SampleSurfaceMeshImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer points, const SamplePointGrid& pointGrid, int32_t* polyIds)
   : m_Faces(faces)
   , m_FaceIds(faceIds)
-  , m_FaceBBs(faceBBs)
   , m_Points(points)
+  , m_PointGrid(pointGrid)
   , m_PolyIds(polyIds)
   {
   }
@@ -81,35 +84,35 @@ public:
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
-    float distToBoundary = 0.0f;
-    int64_t numPoints = m_Points->getNumberOfVertices();
-    FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower");
-    FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right");
-    float* ll = llPtr->getPointer(0);
-    float* ur = urPtr->getPointer(0);
-    float* point = nullptr;
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
     char code = ' ';
 
     for(size_t iter = start; iter < end; iter++)
     {
-      // find bounding box for current feature
-      GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), m_FaceIds->getElementList(iter), ll, ur);
-      GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
-
-      // check points in vertex array to see if they are in the bounding box of the feature
-      for(int64_t i = 0; i < numPoints; i++)
+      Int32Int32DynamicListArray::ElementList& faceIds = m_FaceIds->getElementList(iter);
+      if(faceIds.ncells == 0)
       {
-        point = m_Points->getVertexPointer(i);
+        continue;
+      }
+
+      // build the hierarchy over the faces of the current feature, which also gives its bounding box
+      TriangleBVH faceTree(m_Faces.get(), faceIds.cells, static_cast<size_t>(faceIds.ncells));
+      faceTree.getBounds(ll, ur);
+
+      // only check the points bucketed near the bounding box of the feature
+      m_PointGrid.forEachPointNearBox(ll, ur, [&](int64_t i) {
+        float* point = m_Points->getVertexPointer(i);
         if(m_PolyIds[i] == 0 && GeometryMath::PointInBox(point, ll, ur) == true)
         {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), m_FaceIds->getElementList(iter), m_FaceBBs.get(), point, ll, ur, radius, distToBoundary);
+          code = faceTree.pointInPolyhedron(point);
+          // Points that can not be classified ('?') are left unassigned
           if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
           {
             m_PolyIds[i] = iter;
           }
         }
-      }
+      });
     }
   }
 
@@ -255,13 +258,6 @@ void SampleSurfaceMesh::execute()
   // pull down faces
   int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  // create array to hold bounding vertices for each face
-  FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower_Left");
-  FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right");
-  float* ll = llPtr->getPointer(0);
-  float* ur = urPtr->getPointer(0);
-  VertexGeom::Pointer faceBBs = VertexGeom::CreateGeometry(2 * numFaces, "_INTERNAL_USE_ONLY_faceBBs");
-
   // walk through faces to see how many features there are
   int32_t g1 = 0, g2 = 0;
   int32_t maxFeatureId = 0;
@@ -321,10 +317,6 @@ void SampleSurfaceMesh::execute()
     {
       faceLists->insertCellReference(g2, (linkLoc[g2])++, i);
     }
-    // find bounding box for each face
-    GeometryMath::FindBoundingBoxOfFace(triangleGeom.get(), i, ll, ur);
-    faceBBs->setCoords(2 * i, ll);
-    faceBBs->setCoords(2 * i + 1, ur);
   }
 
   // generate the list of sampling points from subclass
@@ -341,15 +333,18 @@ void SampleSurfaceMesh::execute()
   iArray->initializeWithZeros();
   int32_t* polyIds = iArray->getPointer(0);
 
+  // bucket the points so each feature only visits the points near its bounding box
+  SamplePointGrid pointGrid(points.get());
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(triangleGeom, faceLists, faceBBs, points, polyIds), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), SampleSurfaceMeshImpl(triangleGeom, faceLists, points, pointGrid, polyIds), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, faceBBs, points, polyIds);
+    SampleSurfaceMeshImpl serial(triangleGeom, faceLists, points, pointGrid, polyIds);
     serial.checkPoints(0, numFeatures);
   }
 
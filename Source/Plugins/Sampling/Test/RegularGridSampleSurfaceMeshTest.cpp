@@ -0,0 +1,329 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SamplingTestFileLocations.h"
+
+class RegularGridSampleSurfaceMeshTest
+{
+public:
+  RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  virtual ~RegularGridSampleSurfaceMeshTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(RegularGridSampleSurfaceMeshTest)
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the RegularGridSampleSurfaceMesh Filter from the FilterManager
+    QString filtName = "RegularGridSampleSurfaceMesh";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The RegularGridSampleSurfaceMeshTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Sampling Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fills a unit voxel volume with random blocks of Features, leaving some voxels
+  // empty (0) so the Features have both shared and free surfaces
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> CreateLabels(const int32_t dims[3], int32_t numFeatures, uint32_t seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int32_t> featureDist(0, numFeatures);
+    std::vector<int32_t> labels(static_cast<size_t>(dims[0] * dims[1] * dims[2]), 0);
+    for(int32_t z = 0; z < dims[2]; z++)
+    {
+      for(int32_t y = 0; y < dims[1]; y++)
+      {
+        for(int32_t x = 0; x < dims[0]; x++)
+        {
+          std::mt19937 blockGenerator(seed + static_cast<uint32_t>(((z / 2) * dims[1] + (y / 3)) * dims[0] + (x / 2)));
+          int32_t feature = featureDist(blockGenerator);
+          if(generator() % 11 == 0)
+          {
+            feature = featureDist(generator);
+          }
+          labels[(z * dims[1] + y) * dims[0] + x] = feature;
+        }
+      }
+    }
+    return labels;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds the conformal surface mesh of the labeled voxels, splitting every voxel
+  // face between two different labels into two triangles
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateSurfaceMesh(const std::vector<int32_t>& labels, const int32_t dims[3])
+  {
+    auto label = [&](int32_t x, int32_t y, int32_t z) {
+      if(x < 0 || y < 0 || z < 0 || x >= dims[0] || y >= dims[1] || z >= dims[2])
+      {
+        return 0;
+      }
+      return labels[(z * dims[1] + y) * dims[0] + x];
+    };
+
+    std::map<std::vector<int32_t>, int64_t> vertexIds;
+    std::vector<float> coords;
+    std::vector<int64_t> tris;
+    std::vector<int32_t> faceLabels;
+    auto vertex = [&](int32_t x, int32_t y, int32_t z) {
+      std::vector<int32_t> key = {x, y, z};
+      auto iter = vertexIds.find(key);
+      if(iter != vertexIds.end())
+      {
+        return iter->second;
+      }
+      int64_t id = static_cast<int64_t>(coords.size() / 3);
+      coords.push_back(static_cast<float>(x));
+      coords.push_back(static_cast<float>(y));
+      coords.push_back(static_cast<float>(z));
+      vertexIds[key] = id;
+      return id;
+    };
+    auto quad = [&](int64_t v0, int64_t v1, int64_t v2, int64_t v3, int32_t g1, int32_t g2) {
+      int64_t verts[6] = {v0, v1, v2, v0, v2, v3};
+      tris.insert(tris.end(), verts, verts + 6);
+      int32_t pair[4] = {g1, g2, g1, g2};
+      faceLabels.insert(faceLabels.end(), pair, pair + 4);
+    };
+
+    for(int32_t z = 0; z <= dims[2]; z++)
+    {
+      for(int32_t y = 0; y <= dims[1]; y++)
+      {
+        for(int32_t x = 0; x <= dims[0]; x++)
+        {
+          int32_t g1 = label(x, y, z);
+          int32_t g2 = label(x - 1, y, z);
+          if(g1 != g2 && y < dims[1] && z < dims[2])
+          {
+            quad(vertex(x, y, z), vertex(x, y + 1, z), vertex(x, y + 1, z + 1), vertex(x, y, z + 1), g1, g2);
+          }
+          g2 = label(x, y - 1, z);
+          if(g1 != g2 && x < dims[0] && z < dims[2])
+          {
+            quad(vertex(x, y, z), vertex(x + 1, y, z), vertex(x + 1, y, z + 1), vertex(x, y, z + 1), g1, g2);
+          }
+          g2 = label(x, y, z - 1);
+          if(g1 != g2 && x < dims[0] && y < dims[1])
+          {
+            quad(vertex(x, y, z), vertex(x + 1, y, z), vertex(x + 1, y + 1, z), vertex(x, y + 1, z), g1, g2);
+          }
+        }
+      }
+    }
+
+    size_t numVerts = coords.size() / 3;
+    size_t numTris = tris.size() / 3;
+    SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), vertices, SIMPL::Geometry::TriangleGeometry);
+    for(size_t v = 0; v < numVerts; v++)
+    {
+      triangles->setCoords(static_cast<int64_t>(v), &coords[3 * v]);
+    }
+    for(size_t t = 0; t < numTris; t++)
+    {
+      triangles->setVertsAtTri(static_cast<int64_t>(t), &tris[3 * t]);
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer sm = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    sm->setGeometry(triangles);
+    dca->addDataContainer(sm);
+
+    QVector<size_t> tDims(1, numTris);
+    AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    sm->addAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName, faceAttrMat);
+    QVector<size_t> cDims(1, 2);
+    Int32ArrayType::Pointer faceLabelsPtr = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels);
+    for(size_t i = 0; i < faceLabels.size(); i++)
+    {
+      faceLabelsPtr->setValue(i, faceLabels[i]);
+    }
+    faceAttrMat->addAttributeArray(SIMPL::FaceData::SurfaceMeshFaceLabels, faceLabelsPtr);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Samples the surface mesh onto a new grid and returns the sampled Feature Ids
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer RunSampling(DataContainerArray::Pointer dca, const QString& dcName, const int32_t dims[3], FloatVec3_t resolution, FloatVec3_t origin, bool useScanline)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("RegularGridSampleSurfaceMesh");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(dcName);
+    bool propWasSet = filter->setProperty("DataContainerName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(dims[0]);
+    propWasSet = filter->setProperty("XPoints", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(dims[1]);
+    propWasSet = filter->setProperty("YPoints", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(dims[2]);
+    propWasSet = filter->setProperty("ZPoints", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(resolution);
+    propWasSet = filter->setProperty("Resolution", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(origin);
+    propWasSet = filter->setProperty("Origin", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    var.setValue(useScanline);
+    propWasSet = filter->setProperty("UseScanlineVoxelization", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0);
+
+    AttributeMatrix::Pointer attrMat = dca->getDataContainer(dcName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    DREAM3D_REQUIRE_VALID_POINTER(attrMat.get());
+    Int32ArrayType::Pointer featureIds = attrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get());
+    return featureIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sampling the mesh on the grid it was built from must give back the labels
+  // -----------------------------------------------------------------------------
+  int TestScanlineRoundTrip()
+  {
+    int32_t dims[3] = {17, 13, 11};
+    std::vector<int32_t> labels = CreateLabels(dims, 6, 5489u);
+    DataContainerArray::Pointer dca = CreateSurfaceMesh(labels, dims);
+
+    FloatVec3_t resolution;
+    resolution.x = resolution.y = resolution.z = 1.0f;
+    FloatVec3_t origin;
+    origin.x = origin.y = origin.z = 0.0f;
+    Int32ArrayType::Pointer featureIds = RunSampling(dca, "Scanline", dims, resolution, origin, true);
+    DREAM3D_REQUIRE_EQUAL(featureIds->getNumberOfTuples(), labels.size());
+    for(size_t i = 0; i < labels.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), labels[i]);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // On a grid that does not line up with the mesh the scanline and point sampling
+  // must agree on every Cell. The resolutions and origins keep every Cell center off
+  // the (integer) mesh planes so no Cell lies on a Triangle.
+  // -----------------------------------------------------------------------------
+  int TestScanlineMatchesPointSampling()
+  {
+    int32_t dims[3] = {14, 19, 9};
+    std::vector<int32_t> labels = CreateLabels(dims, 9, 12345u);
+    DataContainerArray::Pointer dca = CreateSurfaceMesh(labels, dims);
+
+    int32_t gridDims[3] = {38, 35, 30};
+    FloatVec3_t resolution;
+    resolution.x = 0.4f;
+    resolution.y = 0.6f;
+    resolution.z = 0.35f;
+    FloatVec3_t origin;
+    origin.x = -0.9f;
+    origin.y = -1.45f;
+    origin.z = -0.7f;
+
+    Int32ArrayType::Pointer scanlineIds = RunSampling(dca, "Scanline", gridDims, resolution, origin, true);
+    Int32ArrayType::Pointer pointIds = RunSampling(dca, "PointSampled", gridDims, resolution, origin, false);
+
+    DREAM3D_REQUIRE_EQUAL(scanlineIds->getNumberOfTuples(), pointIds->getNumberOfTuples());
+    size_t numInside = 0;
+    for(size_t i = 0; i < scanlineIds->getNumberOfTuples(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(scanlineIds->getValue(i), pointIds->getValue(i));
+      if(scanlineIds->getValue(i) > 0)
+      {
+        numInside++;
+      }
+    }
+    DREAM3D_REQUIRE(numInside > 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestScanlineRoundTrip())
+    DREAM3D_REGISTER_TEST(TestScanlineMatchesPointSampling())
+  }
+
+private:
+  RegularGridSampleSurfaceMeshTest(const RegularGridSampleSurfaceMeshTest&); // Copy Constructor Not Implemented
+  void operator=(const RegularGridSampleSurfaceMeshTest&);                   // Move assignment Not Implemented
+};
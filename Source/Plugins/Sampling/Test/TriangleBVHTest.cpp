@@ -0,0 +1,293 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "OrientationLib/Utilities/SamplePointGrid.hpp"
+#include "OrientationLib/Utilities/TriangleBVH.hpp"
+
+#include "SamplingTestFileLocations.h"
+
+class TriangleBVHTest
+{
+public:
+  TriangleBVHTest()
+  {
+  }
+  virtual ~TriangleBVHTest()
+  {
+  }
+  SIMPL_TYPE_MACRO(TriangleBVHTest)
+
+  // -----------------------------------------------------------------------------
+  // Occupancy of a concave test shape made of unit voxels: a 4x4x4 block with a
+  // notch cut out of one corner and a tunnel bored through along Z
+  // -----------------------------------------------------------------------------
+  bool IsSolid(int32_t x, int32_t y, int32_t z)
+  {
+    if(x < 0 || y < 0 || z < 0 || x > 3 || y > 3 || z > 3)
+    {
+      return false;
+    }
+    if(x >= 2 && y >= 2 && z >= 2)
+    {
+      return false;
+    }
+    if(x == 1 && y == 1)
+    {
+      return false;
+    }
+    return true;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds the boundary of the voxel shape, splitting every exposed voxel face into two triangles
+  // -----------------------------------------------------------------------------
+  TriangleGeom::Pointer CreateVoxelSurface()
+  {
+    std::map<std::vector<int32_t>, int64_t> vertexIds;
+    std::vector<float> coords;
+    std::vector<int64_t> tris;
+    auto vertex = [&](int32_t x, int32_t y, int32_t z) {
+      std::vector<int32_t> key = {x, y, z};
+      auto iter = vertexIds.find(key);
+      if(iter != vertexIds.end())
+      {
+        return iter->second;
+      }
+      int64_t id = static_cast<int64_t>(coords.size() / 3);
+      coords.push_back(static_cast<float>(x));
+      coords.push_back(static_cast<float>(y));
+      coords.push_back(static_cast<float>(z));
+      vertexIds[key] = id;
+      return id;
+    };
+    auto quad = [&](int64_t v0, int64_t v1, int64_t v2, int64_t v3) {
+      int64_t verts[6] = {v0, v1, v2, v0, v2, v3};
+      tris.insert(tris.end(), verts, verts + 6);
+    };
+
+    for(int32_t z = 0; z < 4; z++)
+    {
+      for(int32_t y = 0; y < 4; y++)
+      {
+        for(int32_t x = 0; x < 4; x++)
+        {
+          if(!IsSolid(x, y, z))
+          {
+            continue;
+          }
+          if(!IsSolid(x - 1, y, z))
+          {
+            quad(vertex(x, y, z), vertex(x, y, z + 1), vertex(x, y + 1, z + 1), vertex(x, y + 1, z));
+          }
+          if(!IsSolid(x + 1, y, z))
+          {
+            quad(vertex(x + 1, y, z), vertex(x + 1, y + 1, z), vertex(x + 1, y + 1, z + 1), vertex(x + 1, y, z + 1));
+          }
+          if(!IsSolid(x, y - 1, z))
+          {
+            quad(vertex(x, y, z), vertex(x + 1, y, z), vertex(x + 1, y, z + 1), vertex(x, y, z + 1));
+          }
+          if(!IsSolid(x, y + 1, z))
+          {
+            quad(vertex(x, y + 1, z), vertex(x, y + 1, z + 1), vertex(x + 1, y + 1, z + 1), vertex(x + 1, y + 1, z));
+          }
+          if(!IsSolid(x, y, z - 1))
+          {
+            quad(vertex(x, y, z), vertex(x, y + 1, z), vertex(x + 1, y + 1, z), vertex(x + 1, y, z));
+          }
+          if(!IsSolid(x, y, z + 1))
+          {
+            quad(vertex(x, y, z + 1), vertex(x + 1, y, z + 1), vertex(x + 1, y + 1, z + 1), vertex(x, y + 1, z + 1));
+          }
+        }
+      }
+    }
+
+    size_t numVerts = coords.size() / 3;
+    size_t numTris = tris.size() / 3;
+    SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts));
+    TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), vertices, SIMPL::Geometry::TriangleGeometry);
+    for(size_t v = 0; v < numVerts; v++)
+    {
+      triangles->setCoords(static_cast<int64_t>(v), &coords[3 * v]);
+    }
+    for(size_t t = 0; t < numTris; t++)
+    {
+      triangles->setVertsAtTri(static_cast<int64_t>(t), &tris[3 * t]);
+    }
+    return triangles;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPointInPolyhedron()
+  {
+    TriangleGeom::Pointer triangles = CreateVoxelSurface();
+    int64_t numTris = triangles->getNumberOfTris();
+    std::vector<int32_t> faceIds(static_cast<size_t>(numTris));
+    for(int64_t t = 0; t < numTris; t++)
+    {
+      faceIds[t] = static_cast<int32_t>(t);
+    }
+    TriangleBVH faceTree(triangles.get(), faceIds.data(), faceIds.size());
+    DREAM3D_REQUIRE_EQUAL(faceTree.getNumberOfTriangles(), faceIds.size());
+
+    float ll[3] = {0.0f, 0.0f, 0.0f};
+    float ur[3] = {0.0f, 0.0f, 0.0f};
+    faceTree.getBounds(ll, ur);
+    for(size_t d = 0; d < 3; d++)
+    {
+      DREAM3D_REQUIRE_EQUAL(ll[d], 0.0f);
+      DREAM3D_REQUIRE_EQUAL(ur[d], 4.0f);
+    }
+
+    // Voxel centers are strictly inside or outside
+    for(int32_t z = -1; z < 5; z++)
+    {
+      for(int32_t y = -1; y < 5; y++)
+      {
+        for(int32_t x = -1; x < 5; x++)
+        {
+          float point[3] = {x + 0.5f, y + 0.5f, z + 0.5f};
+          char code = faceTree.pointInPolyhedron(point);
+          DREAM3D_REQUIRE_EQUAL(code, IsSolid(x, y, z) ? 'i' : 'o');
+        }
+      }
+    }
+
+    // Points on the voxel faces, edges and corners make many rays graze the mesh; points on
+    // the surface must be reported on it and the rest classified by their neighbor voxels
+    for(int32_t z = 0; z <= 8; z++)
+    {
+      for(int32_t y = 0; y <= 8; y++)
+      {
+        for(int32_t x = 0; x <= 8; x++)
+        {
+          bool anySolid = false;
+          bool allSolid = true;
+          for(int32_t k = (z % 2 == 0) ? -1 : 0; k <= 0; k++)
+          {
+            for(int32_t j = (y % 2 == 0) ? -1 : 0; j <= 0; j++)
+            {
+              for(int32_t i = (x % 2 == 0) ? -1 : 0; i <= 0; i++)
+              {
+                bool solid = IsSolid(x / 2 + i, y / 2 + j, z / 2 + k);
+                anySolid = anySolid || solid;
+                allSolid = allSolid && solid;
+              }
+            }
+          }
+          float point[3] = {x * 0.5f, y * 0.5f, z * 0.5f};
+          char code = faceTree.pointInPolyhedron(point);
+          char expected = allSolid ? 'i' : (anySolid ? 'F' : 'o');
+          DREAM3D_REQUIRE_EQUAL(code, expected);
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSamplePointGrid()
+  {
+    std::mt19937 generator(5489u);
+    std::uniform_real_distribution<float> dist(-2.0f, 6.0f);
+    const int64_t numPoints = 5000;
+    VertexGeom::Pointer points = VertexGeom::CreateGeometry(numPoints, SIMPL::Geometry::VertexGeometry);
+    for(int64_t i = 0; i < numPoints; i++)
+    {
+      float coords[3] = {dist(generator), dist(generator), (i % 2 == 0) ? 1.0f : dist(generator)};
+      points->setCoords(i, coords);
+    }
+    SamplePointGrid grid(points.get());
+
+    for(int32_t q = 0; q < 100; q++)
+    {
+      float ll[3] = {0.0f, 0.0f, 0.0f};
+      float ur[3] = {0.0f, 0.0f, 0.0f};
+      for(size_t d = 0; d < 3; d++)
+      {
+        float a = dist(generator);
+        float b = dist(generator);
+        ll[d] = std::min(a, b);
+        ur[d] = std::max(a, b);
+      }
+      std::set<int64_t> visited;
+      grid.forEachPointNearBox(ll, ur, [&](int64_t i) { visited.insert(i); });
+      for(int64_t i = 0; i < numPoints; i++)
+      {
+        float* p = points->getVertexPointer(i);
+        bool inBox = p[0] >= ll[0] && p[0] <= ur[0] && p[1] >= ll[1] && p[1] <= ur[1] && p[2] >= ll[2] && p[2] <= ur[2];
+        if(inBox)
+        {
+          DREAM3D_REQUIRE(visited.find(i) != visited.end());
+        }
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestPointInPolyhedron())
+    DREAM3D_REGISTER_TEST(TestSamplePointGrid())
+  }
+
+private:
+  TriangleBVHTest(const TriangleBVHTest&); // Copy Constructor Not Implemented
+  void operator=(const TriangleBVHTest&);  // Move assignment Not Implemented
+};
@@ -35,6 +35,9 @@
 
 #include "FindEuclideanDistMap.h"
 
+#include <cmath>
+#include <limits>
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
 #include <tbb/atomic.h>
 #include <tbb/blocked_range.h>
@@ -93,8 +96,6 @@ class ComputeDistanceMapImpl
       ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
       size_t totalPoints = imageGeom->getNumberOfElements();
       double Distance = 0.0;
-      size_t count = 1;
-      size_t changed = 1;
       size_t neighpoint = 0;
       int64_t nearestneighbor;
       int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
@@ -145,83 +146,111 @@ class ComputeDistanceMapImpl
       }
 
       // ------------- Calculate the Manhattan Distance ----------------
-      count = 1;
-      changed = 1;
-      int64_t i = 0;
+      // The distances grow one wave at a time outward from the boundary voxels. Each wave only visits the voxels
+      // next to the ones assigned by the previous wave: first every voxel of the front picks the last face neighbor
+      // that already has a distance, then all of the picks are committed with the distance of the wave. Nothing is
+      // written while picking, so both steps of a wave run in parallel and give the same result as a serial sweep.
       int64_t zBlock = xpoints * ypoints;
       int64_t zStride = 0, yStride = 0;
-      char mask[6] = {0, 0, 0, 0, 0, 0};
-      while(count > 0 && changed > 0)
+      std::vector<int64_t> front;
+      for(size_t a = 0; a < totalPoints; ++a)
       {
-        count = 0;
-        changed = 0;
-        Distance++;
-
-        for(int64_t z = 0; z < zpoints; ++z)
+        if(m_FeatureIds[a] > 0 && (voxel_NearestNeighbor[a] == -1 || voxel_Distance[a] == -1.0))
         {
-          zStride = z * zBlock;
-          mask[0] = mask[5] = 1;
-          if(z == 0)
+          front.push_back(static_cast<int64_t>(a));
+        }
+      }
+      std::vector<int64_t> sources;
+      std::vector<int64_t> nextFront;
+      std::vector<uint8_t> inNextFront(totalPoints, 0);
+      auto findMask = [&](int64_t i, char mask[6]) {
+        int64_t x = i % xpoints;
+        int64_t y = (i / xpoints) % ypoints;
+        int64_t z = i / zBlock;
+        mask[0] = (z != 0);
+        mask[1] = (y != 0);
+        mask[2] = (x != 0);
+        mask[3] = (x != xpoints - 1);
+        mask[4] = (y != ypoints - 1);
+        mask[5] = (z != zpoints - 1);
+      };
+      auto chooseSources = [&](size_t start, size_t end) {
+        char mask[6] = {0, 0, 0, 0, 0, 0};
+        for(size_t f = start; f < end; f++)
+        {
+          int64_t i = front[f];
+          if(voxel_NearestNeighbor[i] != -1)
           {
-            mask[0] = 0;
+            // Already has a nearest boundary voxel but no distance yet
+            sources[f] = i;
+            continue;
           }
-          if(z == zpoints - 1)
+          findMask(i, mask);
+          for(int32_t j = 0; j < 6; j++)
           {
-            mask[5] = 0;
-          }
-
-          for(int64_t y = 0; y < ypoints; ++y)
-          {
-            yStride = y * xpoints;
-            mask[1] = mask[4] = 1;
-            if(y == 0)
-            {
-              mask[1] = 0;
-            }
-            if(y == ypoints - 1)
+            int64_t neighbor = i + neighbors[j];
+            if(mask[j] == 1 && voxel_Distance[neighbor] != -1.0)
             {
-              mask[4] = 0;
+              sources[f] = neighbor;
             }
+          }
+        }
+      };
+      auto applySources = [&](size_t start, size_t end) {
+        for(size_t f = start; f < end; f++)
+        {
+          if(sources[f] != -1)
+          {
+            voxel_NearestNeighbor[front[f]] = voxel_NearestNeighbor[sources[f]];
+            voxel_Distance[front[f]] = Distance;
+          }
+        }
+      };
 
-            for(int64_t x = 0; x < xpoints; ++x)
-            {
-              mask[2] = mask[3] = 1;
-              if(x == 0)
-              {
-                mask[2] = 0;
-              }
-              if(x == xpoints - 1)
-              {
-                mask[3] = 0;
-              }
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      bool doParallel = true;
+#endif
+      char mask[6] = {0, 0, 0, 0, 0, 0};
+      while(!front.empty())
+      {
+        Distance++;
+        sources.assign(front.size(), -1);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+        if(doParallel == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, front.size()), [&](const tbb::blocked_range<size_t>& r) { chooseSources(r.begin(), r.end()); }, tbb::auto_partitioner());
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, front.size()), [&](const tbb::blocked_range<size_t>& r) { applySources(r.begin(), r.end()); }, tbb::auto_partitioner());
+        }
+        else
+#endif
+        {
+          chooseSources(0, front.size());
+          applySources(0, front.size());
+        }
 
-              i = zStride + yStride + x;
-              if(voxel_NearestNeighbor[i] == -1 && m_FeatureIds[i] > 0)
-              {
-                count++;
-                for(int32_t j = 0; j < 6; j++)
-                {
-                  neighpoint = i + neighbors[j];
-                  if(mask[j] == 1)
-                  {
-                    if(voxel_Distance[neighpoint] != -1.0)
-                    {
-                      voxel_NearestNeighbor[i] = voxel_NearestNeighbor[neighpoint];
-                    }
-                  }
-                }
-              }
+        nextFront.clear();
+        for(size_t f = 0; f < front.size(); f++)
+        {
+          if(sources[f] == -1)
+          {
+            continue;
+          }
+          findMask(front[f], mask);
+          for(int32_t j = 0; j < 6; j++)
+          {
+            neighpoint = front[f] + neighbors[j];
+            if(mask[j] == 1 && inNextFront[neighpoint] == 0 && voxel_NearestNeighbor[neighpoint] == -1 && m_FeatureIds[neighpoint] > 0)
+            {
+              inNextFront[neighpoint] = 1;
+              nextFront.push_back(static_cast<int64_t>(neighpoint));
             }
           }
         }
-        for(size_t j = 0; j < totalPoints; ++j)
+        for(size_t f = 0; f < nextFront.size(); f++)
         {
-          if(voxel_NearestNeighbor[j] != -1 && voxel_Distance[j] == -1.0 && m_FeatureIds[j] > 0)
-          {
-            changed++;
-            voxel_Distance[j] = Distance;
-          }
+          inNextFront[nextFront[f]] = 0;
         }
+        front.swap(nextFront);
       }
 
       // ------------- Calculate the Euclidian Distance ----------------
@@ -276,6 +305,194 @@ class ComputeDistanceMapImpl
     }
 };
 
+/**
+ * @brief The ComputeExactDistanceMapImpl class computes the exact Euclidean distance of every Feature cell to the
+ * closest seed cell (the cells whose distance was set to 0) together with that seed cell. The squared distance is
+ * separable, so it is found with one pass of 1D lower envelopes of parabolas along each axis (Felzenszwalb &
+ * Huttenlocher) which takes linear time and uses the resolution of each axis as the spacing of its lines.
+ */
+class ComputeExactDistanceMapImpl
+{
+    DataContainer::Pointer m_DataContainer;
+    int32_t* m_FeatureIds;
+    int32_t* m_NearestNeighbors;
+    float* m_Distances;
+    FindEuclideanDistMap::MapType m_MapType;
+
+  public:
+    ComputeExactDistanceMapImpl(DataContainer::Pointer datacontainer, int32_t* fIds, int32_t* nearNeighs, float* dists, FindEuclideanDistMap::MapType mapType)
+      : m_DataContainer(datacontainer)
+      , m_FeatureIds(fIds)
+      , m_NearestNeighbors(nearNeighs)
+      , m_Distances(dists)
+      , m_MapType(mapType)
+    {
+    }
+
+    virtual ~ComputeExactDistanceMapImpl() = default;
+
+    /**
+     * @brief Replaces the squared distances of one line with the minimum over the line of the squared distance plus the
+     * squared spacing to that element. Elements without a seed so far have an infinite distance and a nearest of -1.
+     */
+    static void transformLine(double* sqDist, int64_t* nearest, int64_t length, double spacing, std::vector<int64_t>& v, std::vector<double>& z, std::vector<double>& lineDist,
+                              std::vector<int64_t>& lineNearest)
+    {
+      int64_t k = -1;
+      for(int64_t q = 0; q < length; q++)
+      {
+        if(nearest[q] == -1)
+        {
+          continue;
+        }
+        double pos = static_cast<double>(q) * spacing;
+        double height = sqDist[q] + pos * pos;
+        double intersection = -std::numeric_limits<double>::infinity();
+        while(k >= 0)
+        {
+          double vPos = static_cast<double>(v[k]) * spacing;
+          intersection = (height - (sqDist[v[k]] + vPos * vPos)) / (2.0 * (pos - vPos));
+          if(intersection > z[k])
+          {
+            break;
+          }
+          k--;
+        }
+        if(k < 0)
+        {
+          intersection = -std::numeric_limits<double>::infinity();
+        }
+        k++;
+        v[k] = q;
+        z[k] = intersection;
+        z[k + 1] = std::numeric_limits<double>::infinity();
+      }
+      if(k < 0)
+      {
+        return;
+      }
+
+      int64_t j = 0;
+      for(int64_t q = 0; q < length; q++)
+      {
+        double pos = static_cast<double>(q) * spacing;
+        while(z[j + 1] < pos)
+        {
+          j++;
+        }
+        double delta = pos - static_cast<double>(v[j]) * spacing;
+        lineDist[q] = delta * delta + sqDist[v[j]];
+        lineNearest[q] = nearest[v[j]];
+      }
+      for(int64_t q = 0; q < length; q++)
+      {
+        sqDist[q] = lineDist[q];
+        nearest[q] = lineNearest[q];
+      }
+    }
+
+    /**
+     * @brief Runs transformLine over every line of the volume along axis
+     */
+    void transformAxis(int32_t axis, const int64_t dims[3], double spacing, double* sqDist, int64_t* nearest) const
+    {
+      int64_t length = dims[axis];
+      int64_t stride = 1;
+      if(axis == 1)
+      {
+        stride = dims[0];
+      }
+      else if(axis == 2)
+      {
+        stride = dims[0] * dims[1];
+      }
+      int64_t numLines = (dims[0] * dims[1] * dims[2]) / length;
+
+      auto transformLines = [=](int64_t start, int64_t end) {
+        std::vector<double> lineSqDist(length);
+        std::vector<int64_t> lineNearest(length);
+        std::vector<int64_t> v(length);
+        std::vector<double> z(length + 1);
+        std::vector<double> outDist(length);
+        std::vector<int64_t> outNearest(length);
+        for(int64_t line = start; line < end; line++)
+        {
+          int64_t first = line * length;
+          if(axis == 1)
+          {
+            first = (line / dims[0]) * stride * length + (line % dims[0]);
+          }
+          else if(axis == 2)
+          {
+            first = line;
+          }
+          for(int64_t q = 0; q < length; q++)
+          {
+            lineSqDist[q] = sqDist[first + q * stride];
+            lineNearest[q] = nearest[first + q * stride];
+          }
+          transformLine(lineSqDist.data(), lineNearest.data(), length, spacing, v, z, outDist, outNearest);
+          for(int64_t q = 0; q < length; q++)
+          {
+            sqDist[first + q * stride] = lineSqDist[q];
+            nearest[first + q * stride] = lineNearest[q];
+          }
+        }
+      };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      bool doParallel = true;
+      if(doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, numLines), [&](const tbb::blocked_range<int64_t>& r) { transformLines(r.begin(), r.end()); });
+      }
+      else
+#endif
+      {
+        transformLines(0, numLines);
+      }
+    }
+
+    void operator()() const
+    {
+      ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
+      size_t totalPoints = imageGeom->getNumberOfElements();
+      int64_t dims[3] = {static_cast<int64_t>(imageGeom->getXPoints()), static_cast<int64_t>(imageGeom->getYPoints()), static_cast<int64_t>(imageGeom->getZPoints())};
+      float res[3] = {0.0f, 0.0f, 0.0f};
+      std::tie(res[0], res[1], res[2]) = imageGeom->getResolution();
+
+      std::vector<double> sqDist(totalPoints, std::numeric_limits<double>::infinity());
+      std::vector<int64_t> nearest(totalPoints, -1);
+      for(size_t a = 0; a < totalPoints; ++a)
+      {
+        if(m_FeatureIds[a] > 0 && m_Distances[a] == 0.0f)
+        {
+          sqDist[a] = 0.0;
+          nearest[a] = static_cast<int64_t>(a);
+        }
+      }
+
+      for(int32_t axis = 0; axis < 3; axis++)
+      {
+        transformAxis(axis, dims, static_cast<double>(res[axis]), sqDist.data(), nearest.data());
+      }
+
+      for(size_t a = 0; a < totalPoints; ++a)
+      {
+        if(m_FeatureIds[a] > 0 && nearest[a] >= 0)
+        {
+          m_Distances[a] = static_cast<float>(std::sqrt(sqDist[a]));
+          m_NearestNeighbors[a * 3 + static_cast<uint32_t>(m_MapType)] = static_cast<int32_t>(nearest[a]);
+        }
+        else
+        {
+          m_Distances[a] = -1.0f;
+          m_NearestNeighbors[a * 3 + static_cast<uint32_t>(m_MapType)] = -1;
+        }
+      }
+    }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -290,6 +507,7 @@ FindEuclideanDistMap::FindEuclideanDistMap()
 , m_DoQuadPoints(false)
 , m_SaveNearestNeighbors(false)
 , m_CalcManhattanDist(true)
+, m_ExactEuclideanDist(false)
 , m_FeatureIds(nullptr)
 , m_NearestNeighbors(nullptr)
 , m_GBEuclideanDistances(nullptr)
@@ -313,6 +531,7 @@ void FindEuclideanDistMap::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(SIMPL_NEW_BOOL_FP("Calculate Manhattan Distance", CalcManhattanDist, FilterParameter::Parameter, FindEuclideanDistMap));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Exact Euclidean Distance Transform", ExactEuclideanDist, FilterParameter::Parameter, FindEuclideanDistMap));
   QStringList linkedProps("GBDistancesArrayName");
 
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Calculate Distance to Boundaries", DoBoundaries, FilterParameter::Parameter, FindEuclideanDistMap, linkedProps));
@@ -358,6 +577,7 @@ void FindEuclideanDistMap::readFilterParameters(AbstractFilterParametersReader*
   setDoQuadPoints(reader->readValue("DoQuadPoints", getDoQuadPoints()));
   setSaveNearestNeighbors(reader->readValue("SaveNearestNeighbors", getSaveNearestNeighbors()));
   setCalcManhattanDist(reader->readValue("CalcOnlyManhattanDist", getCalcManhattanDist()));
+  setExactEuclideanDist(reader->readValue("ExactEuclideanDist", getExactEuclideanDist()));
   reader->closeFilterGroup();
 }
 
@@ -678,6 +898,10 @@ void FindEuclideanDistMap::findDistanceMap()
       {
         g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::FeatureBoundary));
       }
+      else if(m_ExactEuclideanDist == true)
+      {
+        g->run(ComputeExactDistanceMapImpl(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, MapType::FeatureBoundary));
+      }
       else
       {
         g->run(ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::FeatureBoundary));
@@ -689,6 +913,10 @@ void FindEuclideanDistMap::findDistanceMap()
       {
         g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::TripleJunction));
       }
+      else if(m_ExactEuclideanDist == true)
+      {
+        g->run(ComputeExactDistanceMapImpl(m, m_FeatureIds, m_NearestNeighbors, m_TJEuclideanDistances, MapType::TripleJunction));
+      }
       else
       {
         g->run(ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::TripleJunction));
@@ -700,6 +928,10 @@ void FindEuclideanDistMap::findDistanceMap()
       {
         g->run(ComputeDistanceMapImpl<int32_t>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, MapType::QuadPoint));
       }
+      else if(m_ExactEuclideanDist == true)
+      {
+        g->run(ComputeExactDistanceMapImpl(m, m_FeatureIds, m_NearestNeighbors, m_QPEuclideanDistances, MapType::QuadPoint));
+      }
       else
       {
         g->run(ComputeDistanceMapImpl<float>(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, MapType::QuadPoint));
@@ -730,6 +962,20 @@ void FindEuclideanDistMap::findDistanceMap()
           ComputeDistanceMapImpl<int32_t> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBManhattanDistances, m_TJManhattanDistances, m_QPManhattanDistances, mapType);
           f();
         }
+        else if(m_ExactEuclideanDist == true)
+        {
+          float* distances = m_GBEuclideanDistances;
+          if(i == 1)
+          {
+            distances = m_TJEuclideanDistances;
+          }
+          else if(i == 2)
+          {
+            distances = m_QPEuclideanDistances;
+          }
+          ComputeExactDistanceMapImpl f(m, m_FeatureIds, m_NearestNeighbors, distances, mapType);
+          f();
+        }
         else
         {
           ComputeDistanceMapImpl<float> f(m, m_FeatureIds, m_NearestNeighbors, m_CalcManhattanDist, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, mapType);
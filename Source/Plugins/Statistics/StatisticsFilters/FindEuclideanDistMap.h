@@ -58,6 +58,7 @@ class Statistics_EXPORT FindEuclideanDistMap : public AbstractFilter
     PYB11_PROPERTY(bool DoQuadPoints READ getDoQuadPoints WRITE setDoQuadPoints)
     PYB11_PROPERTY(bool SaveNearestNeighbors READ getSaveNearestNeighbors WRITE setSaveNearestNeighbors)
     PYB11_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
+    PYB11_PROPERTY(bool ExactEuclideanDist READ getExactEuclideanDist WRITE setExactEuclideanDist)
 public:
   SIMPL_SHARED_POINTERS(FindEuclideanDistMap)
   SIMPL_FILTER_NEW_MACRO(FindEuclideanDistMap)
@@ -104,6 +105,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, CalcManhattanDist)
   Q_PROPERTY(bool CalcManhattanDist READ getCalcManhattanDist WRITE setCalcManhattanDist)
 
+  SIMPL_FILTER_PARAMETER(bool, ExactEuclideanDist)
+  Q_PROPERTY(bool ExactEuclideanDist READ getExactEuclideanDist WRITE setExactEuclideanDist)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -0,0 +1,555 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FindFeatureStatistics.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/FilterParameters/StringFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+#include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/FeatureStatisticsEngine.h"
+#include "Statistics/StatisticsVersion.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureStatistics::FindFeatureStatistics()
+: m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
+, m_CellFeatureAttributeMatrixName(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "")
+, m_ComputeAvgOrientations(false)
+, m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
+, m_QuatsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats)
+, m_CrystalStructuresArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures)
+, m_NumElementsArrayName(SIMPL::FeatureData::NumElements)
+, m_VolumesArrayName(SIMPL::FeatureData::Volumes)
+, m_EquivalentDiametersArrayName(SIMPL::FeatureData::EquivalentDiameters)
+, m_CentroidsArrayName(SIMPL::FeatureData::Centroids)
+, m_BoundingBoxesArrayName("BoundingBoxes")
+, m_SurfaceFeaturesArrayName(SIMPL::FeatureData::SurfaceFeatures)
+, m_Omega3sArrayName(SIMPL::FeatureData::Omega3s)
+, m_AxisLengthsArrayName(SIMPL::FeatureData::AxisLengths)
+, m_AxisEulerAnglesArrayName(SIMPL::FeatureData::AxisEulerAngles)
+, m_AspectRatiosArrayName(SIMPL::FeatureData::AspectRatios)
+, m_AvgQuatsArrayName(SIMPL::FeatureData::AvgQuats)
+, m_AvgEulerAnglesArrayName(SIMPL::FeatureData::AvgEulerAngles)
+, m_FeatureIds(nullptr)
+, m_CellPhases(nullptr)
+, m_Quats(nullptr)
+, m_CrystalStructures(nullptr)
+, m_NumElements(nullptr)
+, m_Volumes(nullptr)
+, m_EquivalentDiameters(nullptr)
+, m_Centroids(nullptr)
+, m_BoundingBoxes(nullptr)
+, m_SurfaceFeatures(nullptr)
+, m_Omega3s(nullptr)
+, m_AxisLengths(nullptr)
+, m_AxisEulerAngles(nullptr)
+, m_AspectRatios(nullptr)
+, m_AvgQuats(nullptr)
+, m_AvgEulerAngles(nullptr)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindFeatureStatistics::~FindFeatureStatistics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  QStringList linkedProps;
+  linkedProps << "CellPhasesArrayPath"
+              << "QuatsArrayPath"
+              << "CrystalStructuresArrayPath"
+              << "AvgQuatsArrayName"
+              << "AvgEulerAnglesArrayName";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Average Orientations", ComputeAvgOrientations, FilterParameter::Parameter, FindFeatureStatistics, linkedProps));
+
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Ids", FeatureIdsArrayPath, FilterParameter::RequiredArray, FindFeatureStatistics, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Phases", CellPhasesArrayPath, FilterParameter::RequiredArray, FindFeatureStatistics, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Quaternions", QuatsArrayPath, FilterParameter::RequiredArray, FindFeatureStatistics, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::UInt32, 1, AttributeMatrix::Type::CellEnsemble, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Crystal Structures", CrystalStructuresArrayPath, FilterParameter::RequiredArray, FindFeatureStatistics, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req =
+        AttributeMatrixSelectionFilterParameter::CreateRequirement(AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_AM_SELECTION_FP("Cell Feature Attribute Matrix", CellFeatureAttributeMatrixName, FilterParameter::RequiredArray, FindFeatureStatistics, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Cell Feature Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Number of Elements", NumElementsArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Volumes", VolumesArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Equivalent Diameters", EquivalentDiametersArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Centroids", CentroidsArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Bounding Boxes", BoundingBoxesArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Surface Features", SurfaceFeaturesArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Omega3s", Omega3sArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Axis Lengths", AxisLengthsArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Axis Euler Angles", AxisEulerAnglesArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Aspect Ratios", AspectRatiosArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Average Quaternions", AvgQuatsArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Average Euler Angles", AvgEulerAnglesArrayName, FilterParameter::CreatedArray, FindFeatureStatistics));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
+  setCellFeatureAttributeMatrixName(reader->readDataArrayPath("CellFeatureAttributeMatrixName", getCellFeatureAttributeMatrixName()));
+  setComputeAvgOrientations(reader->readValue("ComputeAvgOrientations", getComputeAvgOrientations()));
+  setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
+  setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
+  setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
+  setNumElementsArrayName(reader->readString("NumElementsArrayName", getNumElementsArrayName()));
+  setVolumesArrayName(reader->readString("VolumesArrayName", getVolumesArrayName()));
+  setEquivalentDiametersArrayName(reader->readString("EquivalentDiametersArrayName", getEquivalentDiametersArrayName()));
+  setCentroidsArrayName(reader->readString("CentroidsArrayName", getCentroidsArrayName()));
+  setBoundingBoxesArrayName(reader->readString("BoundingBoxesArrayName", getBoundingBoxesArrayName()));
+  setSurfaceFeaturesArrayName(reader->readString("SurfaceFeaturesArrayName", getSurfaceFeaturesArrayName()));
+  setOmega3sArrayName(reader->readString("Omega3sArrayName", getOmega3sArrayName()));
+  setAxisLengthsArrayName(reader->readString("AxisLengthsArrayName", getAxisLengthsArrayName()));
+  setAxisEulerAnglesArrayName(reader->readString("AxisEulerAnglesArrayName", getAxisEulerAnglesArrayName()));
+  setAspectRatiosArrayName(reader->readString("AspectRatiosArrayName", getAspectRatiosArrayName()));
+  setAvgQuatsArrayName(reader->readString("AvgQuatsArrayName", getAvgQuatsArrayName()));
+  setAvgEulerAnglesArrayName(reader->readString("AvgEulerAnglesArrayName", getAvgEulerAnglesArrayName()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::initialize()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::dataCheck()
+{
+  setErrorCondition(0);
+  setWarningCondition(0);
+  initialize();
+  DataArrayPath tempPath;
+
+  ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, getFeatureIdsArrayPath().getDataContainerName());
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+  if(image->getXPoints() <= 1 || image->getYPoints() <= 1 || image->getZPoints() <= 1)
+  {
+    QString ss = QObject::tr("The Image Geometry is not 3D and cannot be used with this Filter. Use the individual 2D capable statistics Filters instead");
+    setErrorCondition(-11000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QVector<DataArrayPath> dataArrayPaths;
+
+  QVector<size_t> cDims(1, 1);
+  m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getFeatureIdsArrayPath(),
+                                                                                                        cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_FeatureIdsPtr.lock())                                                                         /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCondition() >= 0)
+  {
+    dataArrayPaths.push_back(getFeatureIdsArrayPath());
+  }
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getNumElementsArrayName());
+  m_NumElementsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(this, tempPath, 0,
+                                                                                                                        cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_NumElementsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_NumElements = m_NumElementsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getVolumesArrayName());
+  m_VolumesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_VolumesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_Volumes = m_VolumesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getEquivalentDiametersArrayName());
+  m_EquivalentDiametersPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                            cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_EquivalentDiametersPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_EquivalentDiameters = m_EquivalentDiametersPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getSurfaceFeaturesArrayName());
+  m_SurfaceFeaturesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>, AbstractFilter, bool>(this, tempPath, false,
+                                                                                                                      cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_SurfaceFeaturesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_SurfaceFeatures = m_SurfaceFeaturesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getOmega3sArrayName());
+  m_Omega3sPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_Omega3sPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_Omega3s = m_Omega3sPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  cDims[0] = 2;
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getAspectRatiosArrayName());
+  m_AspectRatiosPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                     cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_AspectRatiosPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_AspectRatios = m_AspectRatiosPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  cDims[0] = 3;
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getCentroidsArrayName());
+  m_CentroidsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                  cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_CentroidsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_Centroids = m_CentroidsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getAxisLengthsArrayName());
+  m_AxisLengthsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                    cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_AxisLengthsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_AxisLengths = m_AxisLengthsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getAxisEulerAnglesArrayName());
+  m_AxisEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+      this, tempPath, 0, cDims);                   /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_AxisEulerAnglesPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_AxisEulerAngles = m_AxisEulerAnglesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  cDims[0] = 6;
+  tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getBoundingBoxesArrayName());
+  m_BoundingBoxesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                      cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_BoundingBoxesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_BoundingBoxes = m_BoundingBoxesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  if(m_ComputeAvgOrientations)
+  {
+    cDims[0] = 1;
+    m_CellPhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getCellPhasesArrayPath(),
+                                                                                                          cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CellPhasesPtr.lock())                                                                         /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCondition() >= 0)
+    {
+      dataArrayPaths.push_back(getCellPhasesArrayPath());
+    }
+
+    m_CrystalStructuresPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter>(this, getCrystalStructuresArrayPath(),
+                                                                                                                  cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CrystalStructuresPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    cDims[0] = 4;
+    m_QuatsPtr =
+        getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getQuatsArrayPath(), cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_QuatsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_Quats = m_QuatsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCondition() >= 0)
+    {
+      dataArrayPaths.push_back(getQuatsArrayPath());
+    }
+
+    tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getAvgQuatsArrayName());
+    m_AvgQuatsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                   cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_AvgQuatsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_AvgQuats = m_AvgQuatsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+    cDims[0] = 3;
+    tempPath.update(getCellFeatureAttributeMatrixName().getDataContainerName(), getCellFeatureAttributeMatrixName().getAttributeMatrixName(), getAvgEulerAnglesArrayName());
+    m_AvgEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0,
+                                                                                                                         cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_AvgEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_AvgEulerAngles = m_AvgEulerAnglesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrayPaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureStatistics::execute()
+{
+  setErrorCondition(0);
+  setWarningCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
+  ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
+
+  size_t dims[3] = {imageGeom->getXPoints(), imageGeom->getYPoints(), imageGeom->getZPoints()};
+  float res[3] = {0.0f, 0.0f, 0.0f};
+  std::tie(res[0], res[1], res[2]) = imageGeom->getResolution();
+  float origin[3] = {0.0f, 0.0f, 0.0f};
+  imageGeom->getOrigin(origin);
+
+  size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
+
+  // A single sweep over the Feature Ids gathers everything that FindSizes, FindFeatureCentroids,
+  // FindSurfaceFeatures, FindShapes and FindAvgOrientations would each compute in their own sweep
+  FeatureStatisticsEngine engine(m_FeatureIds, dims, numfeatures);
+  if(m_ComputeAvgOrientations)
+  {
+    engine.setOrientationData(m_Quats, m_CellPhases, m_CrystalStructures);
+  }
+  engine.execute();
+
+  // Same scaling as FindShapes
+  double scaleFactor = static_cast<double>(1.0f / res[0]);
+  if(res[1] > res[0] && res[1] > res[2])
+  {
+    scaleFactor = static_cast<double>(1.0f / res[1]);
+  }
+  if(res[2] > res[0] && res[2] > res[1])
+  {
+    scaleFactor = static_cast<double>(1.0f / res[2]);
+  }
+  double modRes[3] = {0.0, 0.0, 0.0};
+  double modOrigin[3] = {0.0, 0.0, 0.0};
+  for(int32_t d = 0; d < 3; d++)
+  {
+    modRes[d] = static_cast<double>(res[d] * static_cast<float>(scaleFactor));
+    modOrigin[d] = static_cast<double>(origin[d] * static_cast<float>(scaleFactor));
+  }
+  double konst3 = static_cast<double>(static_cast<float>(modRes[0]) * static_cast<float>(modRes[1]) * static_cast<float>(modRes[2]));
+
+  float res_scalar = res[0] * res[1] * res[2];
+  float vol_term = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
+
+  double center[3] = {0.0, 0.0, 0.0};
+  double moments[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  double eigenVals[3] = {0.0, 0.0, 0.0};
+  QuatF avgQuat = QuaternionMathF::New();
+
+  for(size_t i = 0; i < numfeatures; i++)
+  {
+    const FeatureStatisticsEngine::FeatureAccumulator& feature = engine.getFeature(i);
+
+    engine.getCentroid(i, res, origin, m_Centroids + 3 * i);
+    m_SurfaceFeatures[i] = feature.surface;
+    if(feature.count > 0)
+    {
+      for(int32_t d = 0; d < 3; d++)
+      {
+        m_BoundingBoxes[6 * i + d] = origin[d] + static_cast<float>(feature.minIndex[d]) * res[d];
+        m_BoundingBoxes[6 * i + 3 + d] = origin[d] + static_cast<float>(feature.maxIndex[d] + 1) * res[d];
+      }
+    }
+    if(i == 0)
+    {
+      continue;
+    }
+
+    m_NumElements[i] = static_cast<int32_t>(feature.count);
+    m_Volumes[i] = static_cast<float>(static_cast<double>(feature.count) * static_cast<double>(res_scalar));
+    m_EquivalentDiameters[i] = 2.0f * powf(m_Volumes[i] / vol_term, 0.3333333333f);
+
+    for(int32_t d = 0; d < 3; d++)
+    {
+      center[d] = static_cast<double>(m_Centroids[3 * i + d] * static_cast<float>(scaleFactor));
+    }
+    engine.getMoments(i, modRes, modOrigin, center, moments);
+    m_Omega3s[i] = FeatureStatisticsEngine::ComputeOmega3(moments, static_cast<double>(feature.count) * konst3);
+    FeatureStatisticsEngine::ComputeAxes(moments, scaleFactor, eigenVals, m_AxisLengths + 3 * i, m_AspectRatios + 2 * i);
+    FeatureStatisticsEngine::ComputeAxisEulers(moments, eigenVals, m_AxisEulerAngles + 3 * i);
+
+    if(m_ComputeAvgOrientations)
+    {
+      engine.getAverageQuat(i, avgQuat);
+      m_AvgQuats[4 * i + 0] = avgQuat.x;
+      m_AvgQuats[4 * i + 1] = avgQuat.y;
+      m_AvgQuats[4 * i + 2] = avgQuat.z;
+      m_AvgQuats[4 * i + 3] = avgQuat.w;
+
+      FOrientArrayType eu(m_AvgEulerAngles + (3 * i), 3);
+      FOrientTransformsType::qu2eu(FOrientArrayType(avgQuat), eu);
+    }
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindFeatureStatistics::newFilterInstance(bool copyFilterParameters) const
+{
+  FindFeatureStatistics::Pointer filter = FindFeatureStatistics::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getCompiledLibraryName() const
+{
+  return StatisticsConstants::StatisticsBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getBrandingString() const
+{
+  return "Statistics";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << Statistics::Version::Major() << "." << Statistics::Version::Minor() << "." << Statistics::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getGroupName() const
+{
+  return SIMPL::FilterGroups::StatisticsFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid FindFeatureStatistics::getUuid()
+{
+  return QUuid("{dd517f1e-5867-454f-80fc-67cba4390b5f}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::MorphologicalFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FindFeatureStatistics::getHumanLabel() const
+{
+  return "Find Feature Statistics (Single Pass)";
+}
@@ -35,6 +35,7 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
 #include <mutex>
 
 #include <QtCore/QDateTime>
@@ -61,21 +62,53 @@
 class FindNeighborhoodsImpl
 {
 public:
-  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, float* centroids, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance)
+  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance,
+                        const std::vector<int32_t>& sortedFeatures, const int64_t binMin[3], const int64_t binMax[3], std::vector<std::vector<int32_t>>& neighborhoodLists,
+                        int32_t* neighborhoods)
   : m_Filter(filter)
   , m_TotalFeatures(totalFeatures)
-  , m_Centroids(centroids)
   , m_Bins(bins)
   , m_CriticalDistance(criticalDistance)
+  , m_SortedFeatures(sortedFeatures)
+  , m_NeighborhoodLists(neighborhoodLists)
+  , m_Neighborhoods(neighborhoods)
   {
+    for(size_t d = 0; d < 3; d++)
+    {
+      m_BinMin[d] = binMin[d];
+      m_BinMax[d] = binMax[d];
+    }
+  }
+
+  /**
+   * @brief Orders Features by their (z, y, x) bin so that all Features sharing a
+   * row of bins are contiguous in the sorted list
+   */
+  static bool BinLess(const int64_t* lhs, const int64_t* rhs)
+  {
+    if(lhs[2] != rhs[2])
+    {
+      return lhs[2] < rhs[2];
+    }
+    if(lhs[1] != rhs[1])
+    {
+      return lhs[1] < rhs[1];
+    }
+    return lhs[0] < rhs[0];
   }
 
   void convert(size_t start, size_t end) const
   {
-    float x = 0.0f, y = 0.0f, z = 0.0f;
     int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
     float dBinX = 0, dBinY = 0, dBinZ = 0;
-    float criticalDistance1 = 0, criticalDistance2 = 0;
+    float criticalDistance1 = 0;
+    int64_t searchMin[3] = {0, 0, 0};
+    int64_t searchMax[3] = {0, 0, 0};
+    int64_t key[3] = {0, 0, 0};
+
+    const int64_t* bins = m_Bins.data();
+    auto featureLessKey = [bins](int32_t feature, const int64_t* k) { return BinLess(bins + 3 * feature, k); };
+    auto keyLessFeature = [bins](const int64_t* k, int32_t feature) { return BinLess(k, bins + 3 * feature); };
 
     size_t increment = (end - start) / 100;
     size_t incCount = 0;
@@ -96,36 +129,71 @@ public:
       {
         break;
       }
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
+      std::vector<int32_t>& neighborhood = m_NeighborhoodLists[i];
+      neighborhood.clear();
+
       bin1x = m_Bins[3 * i];
       bin1y = m_Bins[3 * i + 1];
       bin1z = m_Bins[3 * i + 2];
       criticalDistance1 = m_CriticalDistance[i];
+      // Also rejects a NaN critical distance, which can never satisfy the test below
+      if(!(criticalDistance1 > 0.0f))
+      {
+        m_Neighborhoods[i] = 0;
+        continue;
+      }
 
-      for(size_t j = i + 1; j < m_TotalFeatures; j++)
+      // Only bins closer than the critical distance can hold a neighbor, so clamp the search
+      // window to that radius and to the extent of the occupied bins
+      const int64_t bin1[3] = {bin1x, bin1y, bin1z};
+      for(size_t d = 0; d < 3; d++)
       {
-        bin2x = m_Bins[3 * j];
-        bin2y = m_Bins[3 * j + 1];
-        bin2z = m_Bins[3 * j + 2];
-        criticalDistance2 = m_CriticalDistance[j];
-        // Use the llabs version of the "C" abs function because we are using int64_t
-        // do NOT try to use the std::abs() function as this is C++11 ONLY
-        dBinX = llabs(bin2x - bin1x);
-        dBinY = llabs(bin2y - bin1y);
-        dBinZ = llabs(bin2z - bin1z);
-
-        if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
+        int64_t radius = m_BinMax[d] - m_BinMin[d];
+        if(criticalDistance1 < static_cast<float>(radius))
         {
-          m_Filter->updateNeighborHood(i, j);
+          radius = static_cast<int64_t>(criticalDistance1);
         }
+        searchMin[d] = std::max(bin1[d] - radius, m_BinMin[d]);
+        searchMax[d] = std::min(bin1[d] + radius, m_BinMax[d]);
+      }
 
-        if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
+      for(int64_t bz = searchMin[2]; bz <= searchMax[2]; bz++)
+      {
+        for(int64_t by = searchMin[1]; by <= searchMax[1]; by++)
         {
-          m_Filter->updateNeighborHood(j, i);
+          key[0] = searchMin[0];
+          key[1] = by;
+          key[2] = bz;
+          auto first = std::lower_bound(m_SortedFeatures.begin(), m_SortedFeatures.end(), key, featureLessKey);
+          key[0] = searchMax[0];
+          auto last = std::upper_bound(first, m_SortedFeatures.end(), key, keyLessFeature);
+          for(auto iter = first; iter != last; ++iter)
+          {
+            size_t j = static_cast<size_t>(*iter);
+            if(j == i)
+            {
+              continue;
+            }
+            bin2x = m_Bins[3 * j];
+            bin2y = m_Bins[3 * j + 1];
+            bin2z = m_Bins[3 * j + 2];
+            // Use the llabs version of the "C" abs function because we are using int64_t
+            // do NOT try to use the std::abs() function as this is C++11 ONLY
+            dBinX = llabs(bin2x - bin1x);
+            dBinY = llabs(bin2y - bin1y);
+            dBinZ = llabs(bin2z - bin1z);
+
+            if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
+            {
+              neighborhood.push_back(static_cast<int32_t>(j));
+            }
+          }
         }
       }
+      // Each Feature only ever writes its own list, so no locking is needed. Sorting gives the
+      // same ascending order the original serial all pairs loop produced.
+      std::sort(neighborhood.begin(), neighborhood.end());
+      m_Neighborhoods[i] = static_cast<int32_t>(neighborhood.size());
     }
   }
 
@@ -139,9 +207,13 @@ public:
 private:
   FindNeighborhoods* m_Filter = nullptr;
   size_t m_TotalFeatures = 0;
-  float* m_Centroids = nullptr;
   const std::vector<int64_t>& m_Bins;
   const std::vector<float>& m_CriticalDistance;
+  const std::vector<int32_t>& m_SortedFeatures;
+  int64_t m_BinMin[3] = {0, 0, 0};
+  int64_t m_BinMax[3] = {0, 0, 0};
+  std::vector<std::vector<int32_t>>& m_NeighborhoodLists;
+  int32_t* m_Neighborhoods = nullptr;
 };
 
 // -----------------------------------------------------------------------------
@@ -328,6 +400,7 @@ void FindNeighborhoods::execute()
 
   m_ProgIncrement = totalFeatures / 100;
 
+  m_LocalNeighborhoodList.clear();
   m_LocalNeighborhoodList.resize(totalFeatures);
   criticalDistance.resize(totalFeatures);
 
@@ -364,6 +437,31 @@ void FindNeighborhoods::execute()
     bins[3 * i + 2] = static_cast<int64_t>(zbin);
   }
 
+  // Index the Features by bin so each Feature only visits the bins within its critical
+  // distance instead of comparing against every other Feature
+  std::vector<int32_t> sortedFeatures;
+  sortedFeatures.reserve(totalFeatures);
+  int64_t binMin[3] = {0, 0, 0};
+  int64_t binMax[3] = {0, 0, 0};
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    sortedFeatures.push_back(static_cast<int32_t>(i));
+    for(size_t d = 0; d < 3; d++)
+    {
+      if(i == 1 || bins[3 * i + d] < binMin[d])
+      {
+        binMin[d] = bins[3 * i + d];
+      }
+      if(i == 1 || bins[3 * i + d] > binMax[d])
+      {
+        binMax[d] = bins[3 * i + d];
+      }
+    }
+  }
+  const int64_t* binPtr = bins.data();
+  std::stable_sort(sortedFeatures.begin(), sortedFeatures.end(),
+                   [binPtr](int32_t lhs, int32_t rhs) { return FindNeighborhoodsImpl::BinLess(binPtr + 3 * lhs, binPtr + 3 * rhs); });
+
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   tbb::task_scheduler_init init;
   bool doParallel = true;
@@ -372,12 +470,13 @@ void FindNeighborhoods::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalFeatures), FindNeighborhoodsImpl(this, totalFeatures, bins, criticalDistance, sortedFeatures, binMin, binMax, m_LocalNeighborhoodList, m_Neighborhoods),
+                      tbb::auto_partitioner());
   }
   else
 #endif
   {
-    FindNeighborhoodsImpl serial(this, totalFeatures, m_Centroids, bins, criticalDistance);
+    FindNeighborhoodsImpl serial(this, totalFeatures, bins, criticalDistance, sortedFeatures, binMin, binMax, m_LocalNeighborhoodList, m_Neighborhoods);
     serial.convert(0, totalFeatures);
   }
 
@@ -392,17 +491,6 @@ void FindNeighborhoods::execute()
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateNeighborHood(size_t sourceIndex, size_t destIndex)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_Neighborhoods[sourceIndex]++;
-  m_LocalNeighborhoodList[sourceIndex].push_back(static_cast<int32_t>(destIndex));
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
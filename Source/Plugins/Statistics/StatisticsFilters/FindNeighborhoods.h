@@ -80,7 +80,6 @@ public:
   SIMPL_FILTER_PARAMETER(QString, NeighborhoodsArrayName)
   Q_PROPERTY(QString NeighborhoodsArrayName READ getNeighborhoodsArrayName WRITE setNeighborhoodsArrayName)
 
-  void updateNeighborHood(size_t sourceIndex, size_t targetIndex);
   void updateProgress(size_t numCompleted, size_t totalFeatures);
 
   /**
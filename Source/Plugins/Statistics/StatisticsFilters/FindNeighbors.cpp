@@ -35,7 +35,9 @@
 
 #include "FindNeighbors.h"
 
-#include <QtCore/QDateTime>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -49,6 +51,130 @@
 #include "Statistics/StatisticsConstants.h"
 #include "Statistics/StatisticsVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief A shared face between two Features, stored as the Feature pair packed into
+ * one key (smaller Id in the high word) and the number of voxel faces they share
+ */
+using FeatureContact = std::pair<uint64_t, uint32_t>;
+
+class FindNeighborsImpl
+{
+public:
+  FindNeighborsImpl(FindNeighbors* filter, int32_t* featureIds, const int64_t dims[3], size_t rowsPerChunk, int8_t* boundaryCells, std::vector<std::vector<FeatureContact>>& chunkContacts)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_RowsPerChunk(rowsPerChunk)
+  , m_BoundaryCells(boundaryCells)
+  , m_ChunkContacts(chunkContacts)
+  {
+    m_Dims[0] = dims[0];
+    m_Dims[1] = dims[1];
+    m_Dims[2] = dims[2];
+  }
+
+  /**
+   * @brief Sorts the packed keys and collapses runs of equal keys into contacts
+   */
+  static void ReduceContacts(std::vector<uint64_t>& keys, std::vector<FeatureContact>& contacts)
+  {
+    std::sort(keys.begin(), keys.end());
+    for(size_t k = 0; k < keys.size();)
+    {
+      size_t run = k + 1;
+      while(run < keys.size() && keys[run] == keys[k])
+      {
+        run++;
+      }
+      contacts.push_back(FeatureContact(keys[k], static_cast<uint32_t>(run - k)));
+      k = run;
+    }
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    int64_t totalRows = m_Dims[1] * m_Dims[2];
+    int64_t sliceSize = m_Dims[0] * m_Dims[1];
+    std::vector<uint64_t> keys;
+    for(size_t chunk = start; chunk < end; chunk++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      keys.clear();
+      int64_t rowStart = static_cast<int64_t>(chunk * m_RowsPerChunk);
+      int64_t rowEnd = std::min(rowStart + static_cast<int64_t>(m_RowsPerChunk), totalRows);
+      for(int64_t r = rowStart; r < rowEnd; r++)
+      {
+        int64_t row = r % m_Dims[1];
+        int64_t plane = r / m_Dims[1];
+        for(int64_t column = 0; column < m_Dims[0]; column++)
+        {
+          int64_t j = r * m_Dims[0] + column;
+          int32_t feature = m_FeatureIds[j];
+          int8_t onsurf = 0;
+          if(feature > 0)
+          {
+            // Each face is visited from both of its voxels for the boundary cell count, but
+            // only the voxel on the low side records the contact so every face is kept once
+            int64_t neighbors[6] = {plane > 0 ? j - sliceSize : -1,
+                                    row > 0 ? j - m_Dims[0] : -1,
+                                    column > 0 ? j - 1 : -1,
+                                    column < m_Dims[0] - 1 ? j + 1 : -1,
+                                    row < m_Dims[1] - 1 ? j + m_Dims[0] : -1,
+                                    plane < m_Dims[2] - 1 ? j + sliceSize : -1};
+            for(int32_t k = 0; k < 6; k++)
+            {
+              if(neighbors[k] < 0)
+              {
+                continue;
+              }
+              int32_t neighborFeature = m_FeatureIds[neighbors[k]];
+              if(neighborFeature != feature && neighborFeature > 0)
+              {
+                onsurf++;
+                if(k >= 3)
+                {
+                  uint32_t low = static_cast<uint32_t>(std::min(feature, neighborFeature));
+                  uint32_t high = static_cast<uint32_t>(std::max(feature, neighborFeature));
+                  keys.push_back((static_cast<uint64_t>(low) << 32) | high);
+                }
+              }
+            }
+          }
+          if(nullptr != m_BoundaryCells)
+          {
+            m_BoundaryCells[j] = onsurf;
+          }
+        }
+      }
+      ReduceContacts(keys, m_ChunkContacts[chunk]);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  FindNeighbors* m_Filter = nullptr;
+  int32_t* m_FeatureIds = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  size_t m_RowsPerChunk = 1;
+  int8_t* m_BoundaryCells = nullptr;
+  std::vector<std::vector<FeatureContact>>& m_ChunkContacts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -230,7 +356,6 @@ void FindNeighbors::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
 
   size_t udims[3] = {0, 0, 0};
@@ -240,135 +365,97 @@ void FindNeighbors::execute()
       static_cast<int64_t>(udims[0]), static_cast<int64_t>(udims[1]), static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  // Each chunk of rows emits its Feature contacts into its own list, already sorted and reduced
+  size_t totalRows = udims[1] * udims[2];
+  size_t rowsPerChunk = std::max<size_t>(1, totalRows / 1024);
+  size_t numChunks = (totalRows + rowsPerChunk - 1) / rowsPerChunk;
+  std::vector<std::vector<FeatureContact>> chunkContacts(numChunks);
+  int8_t* boundaryCells = m_StoreBoundaryCells ? m_BoundaryCells : nullptr;
 
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Determining Neighbor Lists");
 
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
 
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), FindNeighborsImpl(this, m_FeatureIds, dims, rowsPerChunk, boundaryCells, chunkContacts), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    FindNeighborsImpl serial(this, m_FeatureIds, dims, rowsPerChunk, boundaryCells, chunkContacts);
+    serial.convert(0, numChunks);
+  }
 
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
+  if(getCancel())
+  {
+    return;
+  }
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  if(m_StoreSurfaceFeatures == true)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
+    find_surface_features(dims);
+  }
 
-    if(getCancel())
-    {
-      return;
-    }
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Neighbors || Calculating Surface Areas");
 
-    m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
-    if(m_StoreSurfaceFeatures == true)
-    {
-      m_SurfaceFeatures[i] = false;
-    }
+  // Merge the chunk lists into one list of unique Feature pairs
+  size_t totalContacts = 0;
+  for(const std::vector<FeatureContact>& contacts : chunkContacts)
+  {
+    totalContacts += contacts.size();
   }
-
-  for(size_t j = 0; j < totalPoints; j++)
+  std::vector<FeatureContact> contacts;
+  contacts.reserve(totalContacts);
+  for(std::vector<FeatureContact>& chunk : chunkContacts)
+  {
+    contacts.insert(contacts.end(), chunk.begin(), chunk.end());
+    std::vector<FeatureContact>().swap(chunk);
+  }
+  std::sort(contacts.begin(), contacts.end());
+  size_t numPairs = 0;
+  for(size_t k = 0; k < contacts.size(); k++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
+    if(numPairs > 0 && contacts[numPairs - 1].first == contacts[k].first)
     {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
+      contacts[numPairs - 1].second += contacts[k].second;
     }
-
-    if(getCancel())
+    else
     {
-      return;
+      contacts[numPairs++] = contacts[k];
     }
+  }
+  contacts.resize(numPairs);
 
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0)
-    {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures == true)
-      {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
-      {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good == true && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
-        }
-      }
-    }
-    if(m_StoreBoundaryCells == true)
-    {
-      m_BoundaryCells[j] = onsurf;
-    }
+  // Build the compressed sparse row adjacency. Walking the pairs in key order fills every
+  // row in ascending neighbor order, which is the order the lists have always been written in.
+  std::vector<size_t> rowOffsets(totalFeatures + 1, 0);
+  for(const FeatureContact& contact : contacts)
+  {
+    rowOffsets[(contact.first >> 32) + 1]++;
+    rowOffsets[(contact.first & 0xFFFFFFFF) + 1]++;
   }
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    rowOffsets[i + 1] += rowOffsets[i];
+  }
+  std::vector<int32_t> adjacency(rowOffsets[totalFeatures]);
+  std::vector<uint32_t> sharedFaces(rowOffsets[totalFeatures]);
+  std::vector<size_t> rowFill(rowOffsets.begin(), rowOffsets.end() - 1);
+  for(const FeatureContact& contact : contacts)
+  {
+    int32_t low = static_cast<int32_t>(contact.first >> 32);
+    int32_t high = static_cast<int32_t>(contact.first & 0xFFFFFFFF);
+    adjacency[rowFill[low]] = high;
+    sharedFaces[rowFill[low]++] = contact.second;
+    adjacency[rowFill[high]] = low;
+    sharedFaces[rowFill[high]++] = contact.second;
+  }
+  std::vector<FeatureContact>().swap(contacts);
 
   float xRes = 0.0f;
   float yRes = 0.0f;
@@ -378,61 +465,60 @@ void FindNeighbors::execute()
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
     if(getCancel())
     {
       return;
     }
 
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
-
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
-    {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * xRes * yRes;
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
-    }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
+    m_NumNeighbors[i] = static_cast<int32_t>(rowOffsets[i + 1] - rowOffsets[i]);
 
     // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(adjacency.begin() + rowOffsets[i], adjacency.begin() + rowOffsets[i + 1]));
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
 
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(rowOffsets[i + 1] - rowOffsets[i]));
+    for(size_t k = rowOffsets[i]; k < rowOffsets[i + 1]; k++)
+    {
+      (*sharedSAL)[k - rowOffsets[i]] = float(sharedFaces[k]) * xRes * yRes;
+    }
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNeighbors::find_surface_features(const int64_t dims[3])
+{
+  size_t totalFeatures = m_NumNeighborsPtr.lock()->getNumberOfTuples();
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    m_SurfaceFeatures[i] = false;
+  }
+
+  // Only voxels on the outside of the volume can mark a Feature; a single slice has
+  // no top or bottom surface, so only its edges count
+  for(int64_t plane = 0; plane < dims[2]; plane++)
+  {
+    bool surfacePlane = dims[2] != 1 && (plane == 0 || plane == dims[2] - 1);
+    for(int64_t row = 0; row < dims[1]; row++)
+    {
+      bool surfaceRow = surfacePlane || row == 0 || row == dims[1] - 1;
+      int64_t columnStep = (surfaceRow || dims[0] < 2) ? 1 : dims[0] - 1;
+      for(int64_t column = 0; column < dims[0]; column += columnStep)
+      {
+        int32_t feature = m_FeatureIds[(plane * dims[1] + row) * dims[0] + column];
+        if(feature > 0)
+        {
+          m_SurfaceFeatures[feature] = true;
+        }
+      }
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
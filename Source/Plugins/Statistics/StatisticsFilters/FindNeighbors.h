@@ -192,6 +192,12 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief find_surface_features Flags the Features that touch the outside of the volume
+   * @param dims Dimensions of the Image Geometry
+   */
+  void find_surface_features(const int64_t dims[3]);
+
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeatureIds)
 
@@ -43,9 +43,8 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
-#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
-
 #include "Statistics/StatisticsConstants.h"
+#include "Statistics/StatisticsFilters/util/FeatureStatisticsEngine.h"
 #include "Statistics/StatisticsVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -230,12 +229,6 @@ void FindShapes::find_moments()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  float u200 = 0.0f;
-  float u020 = 0.0f;
-  float u002 = 0.0f;
-  float u110 = 0.0f;
-  float u011 = 0.0f;
-  float u101 = 0.0f;
   float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
@@ -343,13 +336,12 @@ void FindShapes::find_moments()
       }
     }
   }
-  double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
   double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
   // constant for volumes because voxels are counted as one
   double konst2 = static_cast<double>((xRes) * (yRes) * (zRes));
   double konst3 = static_cast<double>((modXRes) * (modYRes) * (modZRes));
-  double o3 = 0.0, vol5 = 0.0, omega3 = 0.0;
+  double vol5 = 0.0;
   for(size_t i = 1; i < numfeatures; i++)
   {
     // calculating the modified volume for the omega3 value
@@ -361,25 +353,7 @@ void FindShapes::find_moments()
     m_FeatureMoments[i * 6 + 3] = -m_FeatureMoments[i * 6 + 3] * konst1;
     m_FeatureMoments[i * 6 + 4] = -m_FeatureMoments[i * 6 + 4] * konst1;
     m_FeatureMoments[i * 6 + 5] = -m_FeatureMoments[i * 6 + 5] * konst1;
-    u200 = static_cast<float>((m_FeatureMoments[i * 6 + 1] + m_FeatureMoments[i * 6 + 2] - m_FeatureMoments[i * 6 + 0]) / 2.0f);
-    u020 = static_cast<float>((m_FeatureMoments[i * 6 + 0] + m_FeatureMoments[i * 6 + 2] - m_FeatureMoments[i * 6 + 1]) / 2.0f);
-    u002 = static_cast<float>((m_FeatureMoments[i * 6 + 0] + m_FeatureMoments[i * 6 + 1] - m_FeatureMoments[i * 6 + 2]) / 2.0f);
-    u110 = static_cast<float>(-m_FeatureMoments[i * 6 + 3]);
-    u011 = static_cast<float>(-m_FeatureMoments[i * 6 + 4]);
-    u101 = static_cast<float>(-m_FeatureMoments[i * 6 + 5]);
-    o3 = static_cast<double>((u200 * u020 * u002) + (2.0f * u110 * u101 * u011) - (u200 * u011 * u011) - (u020 * u101 * u101) - (u002 * u110 * u110));
-    vol5 = pow(vol5, 5.0);
-    omega3 = vol5 / o3;
-    omega3 = omega3 / sphere;
-    if(omega3 > 1)
-    {
-      omega3 = 1.0;
-    }
-    if(vol5 == 0.0)
-    {
-      omega3 = 0.0;
-    }
-    m_Omega3s[i] = static_cast<float>(omega3);
+    m_Omega3s[i] = FeatureStatisticsEngine::ComputeOmega3(m_FeatureMoments + i * 6, vol5);
   }
 }
 
@@ -485,97 +459,11 @@ void FindShapes::find_moments2D()
 // -----------------------------------------------------------------------------
 void FindShapes::find_axes()
 {
-  double I1 = 0.0, I2 = 0.0, I3 = 0.0;
-  double Ixx = 0.0, Iyy = 0.0, Izz = 0.0, Ixy = 0.0, Ixz = 0.0, Iyz = 0.0;
-  double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
-  double rsquare = 0.0, r = 0.0, theta = 0.0;
-  double A = 0.0, B = 0.0, C = 0.0;
-  double r1 = 0.0, r2 = 0.0, r3 = 0.0;
-  float bovera = 0.0f, covera = 0.0f;
-  double value = 0.0;
-
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-
   for(size_t i = 1; i < numfeatures; i++)
   {
-    Ixx = m_FeatureMoments[i * 6 + 0];
-    Iyy = m_FeatureMoments[i * 6 + 1];
-    Izz = m_FeatureMoments[i * 6 + 2];
-
-    Ixy = m_FeatureMoments[i * 6 + 3];
-    Iyz = m_FeatureMoments[i * 6 + 4];
-    Ixz = m_FeatureMoments[i * 6 + 5];
-
-    a = 1.0;
-    b = (-Ixx - Iyy - Izz);
-    c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
-    d = 0.0;
-    d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
-    // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
-    f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
-    g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
-    h = (g * g / 4.0) + (f * f * f / 27.0);
-    rsquare = (g * g / 4.0) - h;
-    r = sqrt(rsquare);
-    if(rsquare < 0.0)
-    {
-      r = 0.0;
-    }
-    theta = 0;
-    if(r == 0)
-    {
-      theta = 0;
-    }
-    if(r != 0)
-    {
-      value = -g / (2.0 * r);
-      if(value > 1)
-      {
-        value = 1.0;
-      }
-      if(value < -1)
-      {
-        value = -1.0;
-      }
-      theta = acos(value);
-    }
-    double const1 = pow(r, 0.33333333333);
-    double const2 = cos(theta / 3.0);
-    double const3 = b / (3.0 * a);
-    double const4 = 1.7320508 * sin(theta / 3.0);
-
-    r1 = 2 * const1 * const2 - (const3);
-    r2 = -const1 * (const2 - (const4)) - const3;
-    r3 = -const1 * (const2 + (const4)) - const3;
-    m_FeatureEigenVals[3 * i] = r1;
-    m_FeatureEigenVals[3 * i + 1] = r2;
-    m_FeatureEigenVals[3 * i + 2] = r3;
-
-    I1 = (15.0 * r1) / (4.0 * M_PI);
-    I2 = (15.0 * r2) / (4.0 * M_PI);
-    I3 = (15.0 * r3) / (4.0 * M_PI);
-    A = (I1 + I2 - I3) / 2.0;
-    B = (I1 + I3 - I2) / 2.0;
-    C = (I2 + I3 - I1) / 2.0;
-    a = (A * A * A * A) / (B * C);
-    a = pow(a, 0.1);
-    b = B / A;
-    b = sqrt(b) * a;
-    c = A / (a * a * a * b);
-
-    m_AxisLengths[3 * i] = static_cast<float>(a / m_ScaleFactor);
-    m_AxisLengths[3 * i + 1] = static_cast<float>(b / m_ScaleFactor);
-    m_AxisLengths[3 * i + 2] = static_cast<float>(c / m_ScaleFactor);
-    bovera = static_cast<float>(b / a);
-    covera = static_cast<float>(c / a);
-    if(A == 0.0 || B == 0.0 || C == 0.0)
-    {
-      bovera = 0.0f;
-      covera = 0.0f;
-    }
-    m_AspectRatios[2 * i] = bovera;
-    m_AspectRatios[2 * i + 1] = covera;
+    FeatureStatisticsEngine::ComputeAxes(m_FeatureMoments + i * 6, m_ScaleFactor, m_FeatureEigenVals + i * 3, m_AxisLengths + i * 3, m_AspectRatios + i * 2);
   }
 }
 
@@ -667,151 +555,7 @@ void FindShapes::find_axiseulers()
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   for(size_t i = 1; i < numfeatures; i++)
   {
-    double Ixx = m_FeatureMoments[i * 6 + 0];
-    double Iyy = m_FeatureMoments[i * 6 + 1];
-    double Izz = m_FeatureMoments[i * 6 + 2];
-    double Ixy = m_FeatureMoments[i * 6 + 3];
-    double Iyz = m_FeatureMoments[i * 6 + 4];
-    double Ixz = m_FeatureMoments[i * 6 + 5];
-    double radius1 = m_FeatureEigenVals[3 * i];
-    double radius2 = m_FeatureEigenVals[3 * i + 1];
-    double radius3 = m_FeatureEigenVals[3 * i + 2];
-
-    double e[3][1];
-    double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    e[0][0] = radius1;
-    e[1][0] = radius2;
-    e[2][0] = radius3;
-    double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
-    double bmat[3][1];
-    bmat[0][0] = 0.0000001;
-    bmat[1][0] = 0.0000001;
-    bmat[2][0] = 0.0000001;
-
-    for(int32_t j = 0; j < 3; j++)
-    {
-      uber[0][0] = Ixx - e[j][0];
-      uber[0][1] = Ixy;
-      uber[0][2] = Ixz;
-      uber[1][0] = Ixy;
-      uber[1][1] = Iyy - e[j][0];
-      uber[1][2] = Iyz;
-      uber[2][0] = Ixz;
-      uber[2][1] = Iyz;
-      uber[2][2] = Izz - e[j][0];
-      double** uberelim;
-      double** uberbelim;
-      uberelim = new double*[3];
-      uberbelim = new double*[3];
-      for(int32_t d = 0; d < 3; d++)
-      {
-        uberelim[d] = new double[3];
-        uberbelim[d] = new double[1];
-      }
-      int32_t elimcount = 0;
-      int32_t elimcount1 = 0;
-      double q = 0.0;
-      double sum = 0.0;
-      double c = 0.0;
-      for(int32_t a = 0; a < 3; a++)
-      {
-        elimcount1 = 0;
-        for(int32_t b = 0; b < 3; b++)
-        {
-          uberelim[elimcount][elimcount1] = uber[a][b];
-          elimcount1++;
-        }
-        uberbelim[elimcount][0] = bmat[a][0];
-        elimcount++;
-      }
-      for(int32_t k = 0; k < elimcount - 1; k++)
-      {
-        for(int32_t l = k + 1; l < elimcount; l++)
-        {
-          c = uberelim[l][k] / uberelim[k][k];
-          for(int32_t r = k + 1; r < elimcount; r++)
-          {
-            uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
-          }
-          uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
-        }
-      }
-      uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
-      for(int32_t l = 1; l < elimcount; l++)
-      {
-        int32_t r = (elimcount - 1) - l;
-        sum = 0.0;
-        for(int32_t n = r + 1; n < elimcount; n++)
-        {
-          sum = sum + (uberelim[r][n] * uberbelim[n][0]);
-        }
-        uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
-      }
-      for(int32_t p = 0; p < elimcount; p++)
-      {
-        q = uberbelim[p][0];
-        vect[j][p] = q;
-      }
-      for(int32_t d = 0; d < 3; d++)
-      {
-        delete uberelim[d];
-        delete uberbelim[d];
-      }
-      delete uberelim;
-      delete uberbelim;
-    }
-
-    double n1x = vect[0][0];
-    double n1y = vect[0][1];
-    double n1z = vect[0][2];
-    double n2x = vect[1][0];
-    double n2y = vect[1][1];
-    double n2z = vect[1][2];
-    double n3x = vect[2][0];
-    double n3y = vect[2][1];
-    double n3z = vect[2][2];
-    double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
-    double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
-    double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
-    n1x = n1x / norm1;
-    n1y = n1y / norm1;
-    n1z = n1z / norm1;
-    n2x = n2x / norm2;
-    n2y = n2y / norm2;
-    n2z = n2z / norm2;
-    n3x = n3x / norm3;
-    n3y = n3y / norm3;
-    n3z = n3z / norm3;
-
-    // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
-    //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
-    float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
-    g[0][0] = n3x;
-    g[0][1] = n3y;
-    g[0][2] = n3z;
-    g[1][0] = n2x;
-    g[1][1] = n2y;
-    g[1][2] = n2z;
-    g[2][0] = n1x;
-    g[2][1] = n1y;
-    g[2][2] = n1z;
-
-    // check for right-handedness
-    typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
-    OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
-    if(result.result == 0)
-    {
-      g[2][0] *= -1.0f;
-      g[2][1] *= -1.0f;
-      g[2][2] *= -1.0f;
-    }
-
-    FOrientArrayType eu(3, 0.0f);
-    FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
-
-    m_AxisEulerAngles[3 * i] = eu[0];
-    m_AxisEulerAngles[3 * i + 1] = eu[1];
-    m_AxisEulerAngles[3 * i + 2] = eu[2];
+    FeatureStatisticsEngine::ComputeAxisEulers(m_FeatureMoments + i * 6, m_FeatureEigenVals + i * 3, m_AxisEulerAngles + i * 3);
   }
 }
 
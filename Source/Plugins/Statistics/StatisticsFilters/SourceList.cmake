@@ -23,6 +23,7 @@ set(_PublicFilters
   FindDifferenceMap
   FindEuclideanDistMap
   FindFeatureClustering
+  FindFeatureStatistics
   FindLargestCrossSections
   FindNeighborhoods
   FindNeighbors
@@ -71,6 +72,8 @@ endforeach()
 
 ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.h)
 ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/FeatureStatisticsEngine.h)
+ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/FeatureStatisticsEngine.cpp)
 
 
 SIMPL_END_FILTER_GROUP(${Statistics_BINARY_DIR} "${_filterGroupName}" "Statistics Filters")
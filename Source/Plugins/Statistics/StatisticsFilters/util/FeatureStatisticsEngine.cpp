@@ -0,0 +1,691 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "FeatureStatisticsEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The AccumulateSlabsImpl class sweeps a range of z slabs, each into its own partial accumulators
+ */
+class AccumulateSlabsImpl
+{
+    const FeatureStatisticsEngine* m_Engine;
+    std::vector<std::vector<FeatureStatisticsEngine::FeatureAccumulator>>* m_Partials;
+    size_t m_ZPoints;
+
+  public:
+    AccumulateSlabsImpl(const FeatureStatisticsEngine* engine, std::vector<std::vector<FeatureStatisticsEngine::FeatureAccumulator>>* partials, size_t zPoints)
+      : m_Engine(engine)
+      , m_Partials(partials)
+      , m_ZPoints(zPoints)
+    {
+    }
+
+    virtual ~AccumulateSlabsImpl() = default;
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t numSlabs = m_Partials->size();
+      for(size_t s = start; s < end; s++)
+      {
+        size_t zStart = (s * m_ZPoints) / numSlabs;
+        size_t zEnd = ((s + 1) * m_ZPoints) / numSlabs;
+        m_Engine->accumulateSlab(zStart, zEnd, (*m_Partials)[s]);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureStatisticsEngine::FeatureStatisticsEngine(int32_t* featureIds, const size_t dims[3], size_t numFeatures)
+: m_FeatureIds(featureIds)
+, m_NumFeatures(numFeatures)
+, m_NumSlabs(0)
+, m_Quats(nullptr)
+, m_CellPhases(nullptr)
+, m_CrystalStructures(nullptr)
+{
+  m_Dims[0] = dims[0];
+  m_Dims[1] = dims[1];
+  m_Dims[2] = dims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureStatisticsEngine::~FeatureStatisticsEngine() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::setOrientationData(float* quats, int32_t* cellPhases, uint32_t* crystalStructures)
+{
+  m_Quats = quats;
+  m_CellPhases = cellPhases;
+  m_CrystalStructures = crystalStructures;
+  if(m_OrientationOps.isEmpty())
+  {
+    m_OrientationOps = LaueOps::getOrientationOpsQVector();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::setNumberOfSlabs(size_t numSlabs)
+{
+  m_NumSlabs = numSlabs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t FeatureStatisticsEngine::getNumberOfFeatures() const
+{
+  return m_NumFeatures;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const FeatureStatisticsEngine::FeatureAccumulator& FeatureStatisticsEngine::getFeature(size_t featureId) const
+{
+  return m_Features[featureId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::accumulateSlab(size_t zStart, size_t zEnd, std::vector<FeatureAccumulator>& partial) const
+{
+  partial.assign(m_NumFeatures, FeatureAccumulator());
+  for(size_t i = 0; i < m_NumFeatures; i++)
+  {
+    QuaternionMathF::ElementWiseAssign(partial[i].quatSum, 0.0f);
+  }
+
+  int64_t xPoints = static_cast<int64_t>(m_Dims[0]);
+  int64_t yPoints = static_cast<int64_t>(m_Dims[1]);
+  int64_t zPoints = static_cast<int64_t>(m_Dims[2]);
+  int64_t sliceStride = xPoints * yPoints;
+
+  QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  QuatF voxquat = QuaternionMathF::New();
+  QuatF curavgquat = QuaternionMathF::New();
+
+  int64_t index[3] = {0, 0, 0};
+  for(int64_t i = static_cast<int64_t>(zStart); i < static_cast<int64_t>(zEnd); i++)
+  {
+    int64_t zStride = i * sliceStride;
+    for(int64_t j = 0; j < yPoints; j++)
+    {
+      int64_t yStride = j * xPoints;
+      for(int64_t k = 0; k < xPoints; k++)
+      {
+        int64_t voxel = zStride + yStride + k;
+        int32_t gnum = m_FeatureIds[voxel];
+        FeatureAccumulator& feature = partial[gnum];
+
+        index[0] = k;
+        index[1] = j;
+        index[2] = i;
+        if(feature.count == 0)
+        {
+          for(int32_t d = 0; d < 3; d++)
+          {
+            feature.minIndex[d] = index[d];
+            feature.maxIndex[d] = index[d];
+          }
+        }
+        else
+        {
+          for(int32_t d = 0; d < 3; d++)
+          {
+            feature.minIndex[d] = std::min(feature.minIndex[d], index[d]);
+            feature.maxIndex[d] = std::max(feature.maxIndex[d], index[d]);
+          }
+        }
+        feature.count++;
+        feature.sum[0] += k;
+        feature.sum[1] += j;
+        feature.sum[2] += i;
+        feature.sumSquares[0] += k * k;
+        feature.sumSquares[1] += j * j;
+        feature.sumSquares[2] += i * i;
+        feature.sumSquares[3] += k * j;
+        feature.sumSquares[4] += j * i;
+        feature.sumSquares[5] += k * i;
+
+        // Same test as FindSurfaceFeatures: the Feature touches the volume boundary or Feature 0
+        if(!feature.surface)
+        {
+          if(k <= 0 || k >= xPoints - 1 || j <= 0 || j >= yPoints - 1 || i <= 0 || i >= zPoints - 1)
+          {
+            feature.surface = true;
+          }
+          else if(m_FeatureIds[voxel - 1] == 0 || m_FeatureIds[voxel + 1] == 0 || m_FeatureIds[voxel - xPoints] == 0 || m_FeatureIds[voxel + xPoints] == 0 ||
+                  m_FeatureIds[voxel - sliceStride] == 0 || m_FeatureIds[voxel + sliceStride] == 0)
+          {
+            feature.surface = true;
+          }
+        }
+
+        // Same running average as FindAvgOrientations, started over at the first Cell of the slab
+        if(nullptr != quats && gnum > 0 && m_CellPhases[voxel] > 0)
+        {
+          feature.quatCount += 1.0f;
+          feature.phase = m_CellPhases[voxel];
+          QuaternionMathF::Copy(quats[voxel], voxquat);
+          QuaternionMathF::Copy(feature.quatSum, curavgquat);
+          QuaternionMathF::ScalarDivide(curavgquat, feature.quatCount);
+          if(feature.quatCount == 1.0f)
+          {
+            QuaternionMathF::Identity(curavgquat);
+          }
+          m_OrientationOps[m_CrystalStructures[feature.phase]]->getNearestQuat(curavgquat, voxquat);
+          QuaternionMathF::Add(feature.quatSum, voxquat, feature.quatSum);
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::mergeSlab(std::vector<FeatureAccumulator>& partial)
+{
+  QuatF curavgquat = QuaternionMathF::New();
+  QuatF symquat = QuaternionMathF::New();
+  QuatF slabquat = QuaternionMathF::New();
+  QuatF bestquat = QuaternionMathF::New();
+
+  for(size_t i = 0; i < m_NumFeatures; i++)
+  {
+    FeatureAccumulator& src = partial[i];
+    FeatureAccumulator& dst = m_Features[i];
+    if(src.count == 0)
+    {
+      continue;
+    }
+    if(dst.count == 0)
+    {
+      dst = src;
+      continue;
+    }
+
+    dst.count += src.count;
+    for(int32_t d = 0; d < 3; d++)
+    {
+      dst.sum[d] += src.sum[d];
+      dst.minIndex[d] = std::min(dst.minIndex[d], src.minIndex[d]);
+      dst.maxIndex[d] = std::max(dst.maxIndex[d], src.maxIndex[d]);
+    }
+    for(int32_t d = 0; d < 6; d++)
+    {
+      dst.sumSquares[d] += src.sumSquares[d];
+    }
+    dst.surface = dst.surface || src.surface;
+
+    if(src.quatCount == 0.0f)
+    {
+      continue;
+    }
+    if(dst.quatCount == 0.0f)
+    {
+      dst.quatCount = src.quatCount;
+      dst.phase = src.phase;
+      QuaternionMathF::Copy(src.quatSum, dst.quatSum);
+      continue;
+    }
+
+    // The Cells of the slab were all moved next to the slab's own running average, so the slab sum
+    // is moved as a whole by the one symmetry operator that brings it nearest the running average
+    // of the earlier slabs, the same choice getNearestQuat makes for a single Cell
+    QuaternionMathF::Copy(dst.quatSum, curavgquat);
+    QuaternionMathF::ScalarDivide(curavgquat, dst.quatCount);
+    LaueOps::Pointer ops = m_OrientationOps[m_CrystalStructures[src.phase]];
+    int32_t numSymOps = ops->getNumSymOps();
+    float bestDot = -std::numeric_limits<float>::max();
+    for(int32_t j = 0; j < numSymOps; j++)
+    {
+      ops->getQuatSymOp(j, symquat);
+      QuaternionMathF::Multiply(symquat, src.quatSum, slabquat);
+      if(slabquat.w < 0)
+      {
+        QuaternionMathF::Negate(slabquat);
+      }
+      float dot = slabquat.w * curavgquat.w + slabquat.x * curavgquat.x + slabquat.y * curavgquat.y + slabquat.z * curavgquat.z;
+      if(dot > bestDot)
+      {
+        bestDot = dot;
+        QuaternionMathF::Copy(slabquat, bestquat);
+      }
+    }
+    QuaternionMathF::Add(dst.quatSum, bestquat, dst.quatSum);
+    dst.quatCount += src.quatCount;
+    dst.phase = src.phase;
+  }
+
+  partial.clear();
+  partial.shrink_to_fit();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::execute()
+{
+  size_t numSlabs = m_NumSlabs;
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(numSlabs == 0)
+  {
+    numSlabs = static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+  }
+#endif
+
+  numSlabs = std::min(std::max(numSlabs, static_cast<size_t>(1)), std::max(m_Dims[2], static_cast<size_t>(1)));
+
+  std::vector<std::vector<FeatureAccumulator>> partials(numSlabs);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(doParallel == true)
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSlabs, 1), AccumulateSlabsImpl(this, &partials, m_Dims[2]), tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    AccumulateSlabsImpl serial(this, &partials, m_Dims[2]);
+    serial.convert(0, numSlabs);
+  }
+
+  m_Features.assign(m_NumFeatures, FeatureAccumulator());
+  for(size_t s = 0; s < numSlabs; s++)
+  {
+    mergeSlab(partials[s]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::getCentroid(size_t featureId, const float res[3], const float origin[3], float centroid[3]) const
+{
+  const FeatureAccumulator& feature = m_Features[featureId];
+  for(int32_t d = 0; d < 3; d++)
+  {
+    centroid[d] = 0.0f;
+    if(feature.count > 0)
+    {
+      centroid[d] = static_cast<float>(static_cast<double>(feature.sum[d]) / static_cast<double>(feature.count) * static_cast<double>(res[d])) + origin[d];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::getMoments(size_t featureId, const double modRes[3], const double modOrigin[3], const double center[3], double moments[6]) const
+{
+  const FeatureAccumulator& feature = m_Features[featureId];
+  double n = static_cast<double>(feature.count);
+
+  // Sums of (x - cx)^2 and (x - cx)(y - cy) over the voxel centers, expanded in terms of the exact index sums
+  double delta[3] = {0.0, 0.0, 0.0};
+  double sum[3] = {0.0, 0.0, 0.0};
+  double sq[3] = {0.0, 0.0, 0.0};
+  for(int32_t d = 0; d < 3; d++)
+  {
+    delta[d] = modOrigin[d] - center[d];
+    sum[d] = static_cast<double>(feature.sum[d]);
+    sq[d] = modRes[d] * modRes[d] * static_cast<double>(feature.sumSquares[d]) + 2.0 * modRes[d] * delta[d] * sum[d] + n * delta[d] * delta[d];
+  }
+  // xy, yz, xz
+  const int32_t pairs[3][2] = {{0, 1}, {1, 2}, {0, 2}};
+  double cross[3] = {0.0, 0.0, 0.0};
+  for(int32_t p = 0; p < 3; p++)
+  {
+    int32_t a = pairs[p][0];
+    int32_t b = pairs[p][1];
+    cross[p] = modRes[a] * modRes[b] * static_cast<double>(feature.sumSquares[3 + p]) + modRes[a] * delta[b] * sum[a] + modRes[b] * delta[a] * sum[b] + n * delta[a] * delta[b];
+  }
+
+  // Each voxel is split into 8 sub voxels offset by +/- res/4; the offsets cancel in the cross
+  // terms and add 8 * (res/4)^2 per voxel to the squared terms
+  double sub[3] = {0.0, 0.0, 0.0};
+  for(int32_t d = 0; d < 3; d++)
+  {
+    sub[d] = 8.0 * n * (modRes[d] / 4.0) * (modRes[d] / 4.0);
+    sq[d] = 8.0 * sq[d] + sub[d];
+  }
+
+  // constant for moments because voxels are broken into smaller voxels
+  double konst1 = (modRes[0] / 2.0) * (modRes[1] / 2.0) * (modRes[2] / 2.0);
+  moments[0] = (sq[1] + sq[2]) * konst1;
+  moments[1] = (sq[0] + sq[2]) * konst1;
+  moments[2] = (sq[0] + sq[1]) * konst1;
+  moments[3] = -8.0 * cross[0] * konst1;
+  moments[4] = -8.0 * cross[1] * konst1;
+  moments[5] = -8.0 * cross[2] * konst1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::getAverageQuat(size_t featureId, QuatF& avgQuat) const
+{
+  const FeatureAccumulator& feature = m_Features[featureId];
+  if(feature.quatCount == 0.0f)
+  {
+    QuaternionMathF::Identity(avgQuat);
+    return;
+  }
+  QuaternionMathF::Copy(feature.quatSum, avgQuat);
+  QuaternionMathF::ScalarDivide(avgQuat, feature.quatCount);
+  QuaternionMathF::UnitQuaternion(avgQuat);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float FeatureStatisticsEngine::ComputeOmega3(const double moments[6], double modVolume)
+{
+  double sphere = (2000.0 * M_PI * M_PI) / 9.0;
+  float u200 = static_cast<float>((moments[1] + moments[2] - moments[0]) / 2.0f);
+  float u020 = static_cast<float>((moments[0] + moments[2] - moments[1]) / 2.0f);
+  float u002 = static_cast<float>((moments[0] + moments[1] - moments[2]) / 2.0f);
+  float u110 = static_cast<float>(-moments[3]);
+  float u011 = static_cast<float>(-moments[4]);
+  float u101 = static_cast<float>(-moments[5]);
+  double o3 = static_cast<double>((u200 * u020 * u002) + (2.0f * u110 * u101 * u011) - (u200 * u011 * u011) - (u020 * u101 * u101) - (u002 * u110 * u110));
+  double vol5 = pow(modVolume, 5.0);
+  double omega3 = vol5 / o3;
+  omega3 = omega3 / sphere;
+  if(omega3 > 1)
+  {
+    omega3 = 1.0;
+  }
+  if(vol5 == 0.0)
+  {
+    omega3 = 0.0;
+  }
+  return static_cast<float>(omega3);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::ComputeAxes(const double moments[6], double scaleFactor, double eigenVals[3], float axisLengths[3], float aspectRatios[2])
+{
+  double I1 = 0.0, I2 = 0.0, I3 = 0.0;
+  double a = 0.0, b = 0.0, c = 0.0, d = 0.0, f = 0.0, g = 0.0, h = 0.0;
+  double rsquare = 0.0, r = 0.0, theta = 0.0;
+  double A = 0.0, B = 0.0, C = 0.0;
+  double r1 = 0.0, r2 = 0.0, r3 = 0.0;
+  float bovera = 0.0f, covera = 0.0f;
+  double value = 0.0;
+
+  double Ixx = moments[0];
+  double Iyy = moments[1];
+  double Izz = moments[2];
+
+  double Ixy = moments[3];
+  double Iyz = moments[4];
+  double Ixz = moments[5];
+
+  a = 1.0;
+  b = (-Ixx - Iyy - Izz);
+  c = ((Ixx * Izz) + (Ixx * Iyy) + (Iyy * Izz) - (Ixz * Ixz) - (Ixy * Ixy) - (Iyz * Iyz));
+  d = ((Ixz * Iyy * Ixz) + (Ixy * Izz * Ixy) + (Iyz * Ixx * Iyz) - (Ixx * Iyy * Izz) - (Ixy * Iyz * Ixz) - (Ixy * Iyz * Ixz));
+  // f and g are the p and q values when reducing the cubic equation to t^3 + pt + q = 0
+  f = ((3.0 * c / a) - ((b / a) * (b / a))) / 3.0;
+  g = ((2.0 * (b / a) * (b / a) * (b / a)) - (9.0 * b * c / (a * a)) + (27.0 * (d / a))) / 27.0;
+  h = (g * g / 4.0) + (f * f * f / 27.0);
+  rsquare = (g * g / 4.0) - h;
+  r = sqrt(rsquare);
+  if(rsquare < 0.0)
+  {
+    r = 0.0;
+  }
+  theta = 0;
+  if(r != 0)
+  {
+    value = -g / (2.0 * r);
+    if(value > 1)
+    {
+      value = 1.0;
+    }
+    if(value < -1)
+    {
+      value = -1.0;
+    }
+    theta = acos(value);
+  }
+  double const1 = pow(r, 0.33333333333);
+  double const2 = cos(theta / 3.0);
+  double const3 = b / (3.0 * a);
+  double const4 = 1.7320508 * sin(theta / 3.0);
+
+  r1 = 2 * const1 * const2 - (const3);
+  r2 = -const1 * (const2 - (const4)) - const3;
+  r3 = -const1 * (const2 + (const4)) - const3;
+  eigenVals[0] = r1;
+  eigenVals[1] = r2;
+  eigenVals[2] = r3;
+
+  I1 = (15.0 * r1) / (4.0 * M_PI);
+  I2 = (15.0 * r2) / (4.0 * M_PI);
+  I3 = (15.0 * r3) / (4.0 * M_PI);
+  A = (I1 + I2 - I3) / 2.0;
+  B = (I1 + I3 - I2) / 2.0;
+  C = (I2 + I3 - I1) / 2.0;
+  a = (A * A * A * A) / (B * C);
+  a = pow(a, 0.1);
+  b = B / A;
+  b = sqrt(b) * a;
+  c = A / (a * a * a * b);
+
+  axisLengths[0] = static_cast<float>(a / scaleFactor);
+  axisLengths[1] = static_cast<float>(b / scaleFactor);
+  axisLengths[2] = static_cast<float>(c / scaleFactor);
+  bovera = static_cast<float>(b / a);
+  covera = static_cast<float>(c / a);
+  if(A == 0.0 || B == 0.0 || C == 0.0)
+  {
+    bovera = 0.0f;
+    covera = 0.0f;
+  }
+  aspectRatios[0] = bovera;
+  aspectRatios[1] = covera;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureStatisticsEngine::ComputeAxisEulers(const double moments[6], const double eigenVals[3], float axisEulerAngles[3])
+{
+  double Ixx = moments[0];
+  double Iyy = moments[1];
+  double Izz = moments[2];
+  double Ixy = moments[3];
+  double Iyz = moments[4];
+  double Ixz = moments[5];
+
+  double e[3][1];
+  double vect[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  e[0][0] = eigenVals[0];
+  e[1][0] = eigenVals[1];
+  e[2][0] = eigenVals[2];
+  double uber[3][3] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}};
+  double bmat[3][1];
+  bmat[0][0] = 0.0000001;
+  bmat[1][0] = 0.0000001;
+  bmat[2][0] = 0.0000001;
+
+  for(int32_t j = 0; j < 3; j++)
+  {
+    uber[0][0] = Ixx - e[j][0];
+    uber[0][1] = Ixy;
+    uber[0][2] = Ixz;
+    uber[1][0] = Ixy;
+    uber[1][1] = Iyy - e[j][0];
+    uber[1][2] = Iyz;
+    uber[2][0] = Ixz;
+    uber[2][1] = Iyz;
+    uber[2][2] = Izz - e[j][0];
+    double uberelim[3][3];
+    double uberbelim[3][1];
+    int32_t elimcount = 0;
+    int32_t elimcount1 = 0;
+    double q = 0.0;
+    double sum = 0.0;
+    double c = 0.0;
+    for(int32_t a = 0; a < 3; a++)
+    {
+      elimcount1 = 0;
+      for(int32_t b = 0; b < 3; b++)
+      {
+        uberelim[elimcount][elimcount1] = uber[a][b];
+        elimcount1++;
+      }
+      uberbelim[elimcount][0] = bmat[a][0];
+      elimcount++;
+    }
+    for(int32_t k = 0; k < elimcount - 1; k++)
+    {
+      for(int32_t l = k + 1; l < elimcount; l++)
+      {
+        c = uberelim[l][k] / uberelim[k][k];
+        for(int32_t r = k + 1; r < elimcount; r++)
+        {
+          uberelim[l][r] = uberelim[l][r] - c * uberelim[k][r];
+        }
+        uberbelim[l][0] = uberbelim[l][0] - c * uberbelim[k][0];
+      }
+    }
+    uberbelim[elimcount - 1][0] = uberbelim[elimcount - 1][0] / uberelim[elimcount - 1][elimcount - 1];
+    for(int32_t l = 1; l < elimcount; l++)
+    {
+      int32_t r = (elimcount - 1) - l;
+      sum = 0.0;
+      for(int32_t n = r + 1; n < elimcount; n++)
+      {
+        sum = sum + (uberelim[r][n] * uberbelim[n][0]);
+      }
+      uberbelim[r][0] = (uberbelim[r][0] - sum) / uberelim[r][r];
+    }
+    for(int32_t p = 0; p < elimcount; p++)
+    {
+      q = uberbelim[p][0];
+      vect[j][p] = q;
+    }
+  }
+
+  double n1x = vect[0][0];
+  double n1y = vect[0][1];
+  double n1z = vect[0][2];
+  double n2x = vect[1][0];
+  double n2y = vect[1][1];
+  double n2z = vect[1][2];
+  double n3x = vect[2][0];
+  double n3y = vect[2][1];
+  double n3z = vect[2][2];
+  double norm1 = sqrt(((n1x * n1x) + (n1y * n1y) + (n1z * n1z)));
+  double norm2 = sqrt(((n2x * n2x) + (n2y * n2y) + (n2z * n2z)));
+  double norm3 = sqrt(((n3x * n3x) + (n3y * n3y) + (n3z * n3z)));
+  n1x = n1x / norm1;
+  n1y = n1y / norm1;
+  n1z = n1z / norm1;
+  n2x = n2x / norm2;
+  n2y = n2y / norm2;
+  n2z = n2z / norm2;
+  n3x = n3x / norm3;
+  n3y = n3y / norm3;
+  n3z = n3z / norm3;
+
+  // insert principal unit vectors into rotation matrix representing Feature reference frame within the sample reference frame
+  //(Note that the 3 direction is actually the long axis and the 1 direction is actually the short axis)
+  float g[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+  g[0][0] = n3x;
+  g[0][1] = n3y;
+  g[0][2] = n3z;
+  g[1][0] = n2x;
+  g[1][1] = n2y;
+  g[1][2] = n2z;
+  g[2][0] = n1x;
+  g[2][1] = n1y;
+  g[2][2] = n1z;
+
+  // check for right-handedness
+  typedef OrientationTransforms<FOrientArrayType, float> OrientationTransformType;
+  OrientationTransformType::ResultType result = FOrientTransformsType::om_check(FOrientArrayType(g));
+  if(result.result == 0)
+  {
+    g[2][0] *= -1.0f;
+    g[2][1] *= -1.0f;
+    g[2][2] *= -1.0f;
+  }
+
+  FOrientArrayType eu(3, 0.0f);
+  FOrientTransformsType::om2eu(FOrientArrayType(g), eu);
+
+  axisEulerAngles[0] = eu[0];
+  axisEulerAngles[1] = eu[1];
+  axisEulerAngles[2] = eu[2];
+}
@@ -0,0 +1,204 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "OrientationLib/LaueOps/LaueOps.h"
+
+/**
+ * @brief The FeatureStatisticsEngine class gathers the per Feature sums that the morphological statistics
+ * filters need (element counts, first and second order index sums, index bounding boxes and surface flags)
+ * in a single sweep over a 3D FeatureIds array. The sweep is split into z slabs that are processed in
+ * parallel, each slab filling its own partial accumulators; the partials are then merged in slab order. All
+ * of the index based sums are integers, so they are exact and do not depend on how many slabs were used.
+ * The optional quaternion sums follow FindAvgOrientations within each slab and are moved by a single
+ * symmetry operator when the slabs are merged, so they only match FindAvgOrientations to within rounding
+ * when a Feature spans more than one slab.
+ */
+class FeatureStatisticsEngine
+{
+  public:
+    /**
+     * @brief The FeatureAccumulator struct holds the sums for a single Feature. Index sums are in voxel units.
+     * The second order sums are stored as xx, yy, zz, xy, yz, xz. The quaternion sum is only filled in when
+     * orientation data has been supplied.
+     */
+    struct FeatureAccumulator
+    {
+      int64_t count = 0;
+      int64_t sum[3] = {0, 0, 0};
+      int64_t sumSquares[6] = {0, 0, 0, 0, 0, 0};
+      int64_t minIndex[3] = {0, 0, 0};
+      int64_t maxIndex[3] = {-1, -1, -1};
+      bool surface = false;
+      int32_t phase = 0;
+      float quatCount = 0.0f;
+      QuatF quatSum = QuaternionMathF::New();
+    };
+
+    /**
+     * @brief FeatureStatisticsEngine
+     * @param featureIds The FeatureIds array (dims[0] * dims[1] * dims[2] values)
+     * @param dims The x, y and z dimensions of the Image Geometry
+     * @param numFeatures The number of Feature tuples, including Feature 0
+     */
+    FeatureStatisticsEngine(int32_t* featureIds, const size_t dims[3], size_t numFeatures);
+    virtual ~FeatureStatisticsEngine();
+
+    /**
+     * @brief Enables the average orientation sums. The averaging matches FindAvgOrientations: only voxels with
+     * FeatureId > 0 and phase > 0 contribute and each voxel quaternion is moved to the symmetric equivalent
+     * nearest the running average of its Feature.
+     * @param quats Cell quaternions (4 components)
+     * @param cellPhases Cell phases
+     * @param crystalStructures Ensemble crystal structures
+     */
+    void setOrientationData(float* quats, int32_t* cellPhases, uint32_t* crystalStructures);
+
+    /**
+     * @brief Sets the number of z slabs the sweep is split into. A value of 0 (the default) uses one slab per
+     * available thread.
+     * @param numSlabs
+     */
+    void setNumberOfSlabs(size_t numSlabs);
+
+    /**
+     * @brief Performs the sweep and merges the slab partials. Afterwards the per Feature results are available
+     * through getFeature().
+     */
+    void execute();
+
+    /**
+     * @brief Sweeps the z slices [zStart, zEnd) into the supplied partial accumulators
+     * @param zStart
+     * @param zEnd
+     * @param partial
+     */
+    void accumulateSlab(size_t zStart, size_t zEnd, std::vector<FeatureAccumulator>& partial) const;
+
+    /**
+     * @brief getFeature
+     * @param featureId
+     * @return The merged sums for the Feature
+     */
+    const FeatureAccumulator& getFeature(size_t featureId) const;
+
+    /**
+     * @brief getNumberOfFeatures
+     * @return
+     */
+    size_t getNumberOfFeatures() const;
+
+    /**
+     * @brief Computes the centroid of a Feature in physical coordinates
+     * @param featureId
+     * @param res The Image Geometry resolution
+     * @param origin The Image Geometry origin
+     * @param centroid Output centroid
+     */
+    void getCentroid(size_t featureId, const float res[3], const float origin[3], float centroid[3]) const;
+
+    /**
+     * @brief Computes the second moments of a Feature in the convention used by FindShapes: each voxel is split
+     * into 8 sub voxels, the moments are taken about the supplied (scaled) center, multiplied by the sub voxel
+     * volume and the products of inertia are negated.
+     * @param featureId
+     * @param modRes The scaled resolution
+     * @param modOrigin The scaled origin
+     * @param center The scaled center the moments are taken about
+     * @param moments Output moments (Ixx, Iyy, Izz, Ixy, Iyz, Ixz)
+     */
+    void getMoments(size_t featureId, const double modRes[3], const double modOrigin[3], const double center[3], double moments[6]) const;
+
+    /**
+     * @brief Computes the average quaternion of a Feature. Features without any orientation data get the
+     * identity quaternion.
+     * @param featureId
+     * @param avgQuat Output quaternion
+     */
+    void getAverageQuat(size_t featureId, QuatF& avgQuat) const;
+
+    /**
+     * @brief Computes the Omega3 value from the moments returned by getMoments()
+     * @param moments
+     * @param modVolume The Feature volume in scaled units
+     * @return
+     */
+    static float ComputeOmega3(const double moments[6], double modVolume);
+
+    /**
+     * @brief Computes the principal moments, axis lengths and aspect ratios from the moments returned by getMoments()
+     * @param moments
+     * @param scaleFactor The factor used to scale the resolution
+     * @param eigenVals Output principal moments
+     * @param axisLengths Output axis lengths
+     * @param aspectRatios Output b/a and c/a
+     */
+    static void ComputeAxes(const double moments[6], double scaleFactor, double eigenVals[3], float axisLengths[3], float aspectRatios[2]);
+
+    /**
+     * @brief Computes the Euler angles of the principal axes from the moments and principal moments
+     * @param moments
+     * @param eigenVals
+     * @param axisEulerAngles Output Euler angles
+     */
+    static void ComputeAxisEulers(const double moments[6], const double eigenVals[3], float axisEulerAngles[3]);
+
+  protected:
+    /**
+     * @brief Merges a slab partial into the running result
+     * @param partial
+     */
+    void mergeSlab(std::vector<FeatureAccumulator>& partial);
+
+  private:
+    int32_t* m_FeatureIds;
+    size_t m_Dims[3];
+    size_t m_NumFeatures;
+    size_t m_NumSlabs;
+    float* m_Quats;
+    int32_t* m_CellPhases;
+    uint32_t* m_CrystalStructures;
+    QVector<LaueOps::Pointer> m_OrientationOps;
+    std::vector<FeatureAccumulator> m_Features;
+
+    FeatureStatisticsEngine(const FeatureStatisticsEngine&) = delete; // Copy Constructor Not Implemented
+    void operator=(const FeatureStatisticsEngine&) = delete;          // Move assignment Not Implemented
+};
@@ -33,6 +33,10 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -306,6 +310,158 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateBlockyVolume(QVector<size_t> tDims, float res[3])
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(k_FeatureIdsArrayPath.getDataContainerName());
+    ImageGeom::Pointer geom = ImageGeom::CreateGeometry("ImageGeometry");
+    m->setGeometry(geom);
+    geom->setDimensions(tDims.data());
+    geom->setResolution(res);
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, k_FeatureIdsArrayPath.getAttributeMatrixName(), AttributeMatrix::Type::Cell);
+    m->addAttributeMatrix(k_FeatureIdsArrayPath.getAttributeMatrixName(), attrMat);
+    dca->addDataContainer(m);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, k_FeatureIdsArrayPath.getDataArrayName());
+    attrMat->addAttributeArray(k_FeatureIdsArrayPath.getDataArrayName(), featureIds);
+    size_t index = 0;
+    for(size_t z = 0; z < tDims[2]; z++)
+    {
+      for(size_t y = 0; y < tDims[1]; y++)
+      {
+        for(size_t x = 0; x < tDims[0]; x++)
+        {
+          int32_t feature = 1 + static_cast<int32_t>(((x / 5) + 5 * (y / 4) + 11 * (z / 6)) % 7);
+          if((x * 3 + y * 5 + z * 7) % 23 == 0)
+          {
+            feature = 0;
+          }
+          featureIds->setValue(index++, feature);
+        }
+      }
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateExactFilter(DataContainerArray::Pointer dca, bool exact)
+  {
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindEuclideanDistMap")->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    bool propWasSet = false;
+    var.setValue(k_FeatureIdsArrayPath);
+    propWasSet = filter->setProperty("FeatureIdsArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(false);
+    propWasSet = filter->setProperty("CalcManhattanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(exact);
+    propWasSet = filter->setProperty("ExactEuclideanDist", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(true);
+    propWasSet = filter->setProperty("DoTripleLines", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    propWasSet = filter->setProperty("SaveNearestNeighbors", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("GBEuclideanDistance"));
+    propWasSet = filter->setProperty("GBDistancesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    var.setValue(QString("TJEuclideanDistance"));
+    propWasSet = filter->setProperty("TJDistancesArrayName", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares the exact transform with a brute force search over all boundary and triple line cells
+  // -----------------------------------------------------------------------------
+  int TestExactEuclidean()
+  {
+    QVector<size_t> tDims = {17, 13, 9};
+    float res[3] = {0.5f, 2.0f, 1.25f};
+    DataContainerArray::Pointer dca = CreateBlockyVolume(tDims, res);
+    AbstractFilter::Pointer filter = CreateExactFilter(dca, true);
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCondition() >= 0);
+
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix(k_FeatureIdsArrayPath);
+    Int32ArrayType::Pointer featureIds = am->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsArrayPath.getDataArrayName());
+    Int32ArrayType::Pointer nearestNeighbors = am->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::NearestNeighbors);
+    FloatArrayType::Pointer distances[2] = {am->getAttributeArrayAs<FloatArrayType>("GBEuclideanDistance"), am->getAttributeArrayAs<FloatArrayType>("TJEuclideanDistance")};
+
+    int64_t dims[3] = {static_cast<int64_t>(tDims[0]), static_cast<int64_t>(tDims[1]), static_cast<int64_t>(tDims[2])};
+    int64_t totalPoints = dims[0] * dims[1] * dims[2];
+    int64_t offsets[6] = {-dims[0] * dims[1], -dims[0], -1, 1, dims[0], dims[0] * dims[1]};
+
+    // A Feature cell with one other neighboring Feature is on a boundary, with two it is on a triple line
+    std::vector<int64_t> seeds[2];
+    for(int64_t i = 0; i < totalPoints; i++)
+    {
+      int32_t feature = featureIds->getValue(i);
+      if(feature <= 0)
+      {
+        continue;
+      }
+      int64_t column = i % dims[0], row = (i / dims[0]) % dims[1], plane = i / (dims[0] * dims[1]);
+      bool valid[6] = {plane > 0, row > 0, column > 0, column < dims[0] - 1, row < dims[1] - 1, plane < dims[2] - 1};
+      std::vector<int32_t> others;
+      for(int32_t j = 0; j < 6; j++)
+      {
+        int32_t neighbor = valid[j] ? featureIds->getValue(i + offsets[j]) : feature;
+        if(neighbor != feature && neighbor >= 0 && std::find(others.begin(), others.end(), neighbor) == others.end())
+        {
+          others.push_back(neighbor);
+        }
+      }
+      for(size_t m = 0; m < 2; m++)
+      {
+        if(others.size() > m)
+        {
+          seeds[m].push_back(i);
+        }
+      }
+    }
+
+    auto distanceBetween = [&](int64_t a, int64_t b) {
+      double dx = static_cast<double>(a % dims[0] - b % dims[0]) * res[0];
+      double dy = static_cast<double>((a / dims[0]) % dims[1] - (b / dims[0]) % dims[1]) * res[1];
+      double dz = static_cast<double>(a / (dims[0] * dims[1]) - b / (dims[0] * dims[1])) * res[2];
+      return std::sqrt(dx * dx + dy * dy + dz * dz);
+    };
+
+    for(size_t m = 0; m < 2; m++)
+    {
+      DREAM3D_REQUIRE(seeds[m].empty() == false)
+      for(int64_t i = 0; i < totalPoints; i++)
+      {
+        float computed = distances[m]->getValue(i);
+        int32_t nearest = nearestNeighbors->getComponent(i, m);
+        if(featureIds->getValue(i) <= 0)
+        {
+          DREAM3D_REQUIRE_EQUAL(computed, -1.0f)
+          DREAM3D_REQUIRE_EQUAL(nearest, -1)
+          continue;
+        }
+        double best = std::numeric_limits<double>::max();
+        for(int64_t seed : seeds[m])
+        {
+          best = std::min(best, distanceBetween(i, seed));
+        }
+        DREAM3D_REQUIRE(std::fabs(best - computed) < 1.0E-4)
+        DREAM3D_REQUIRE(std::fabs(distanceBetween(i, nearest) - computed) < 1.0E-4)
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -317,6 +473,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(TestExactEuclidean())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
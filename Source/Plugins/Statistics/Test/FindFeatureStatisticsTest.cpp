@@ -0,0 +1,493 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindFeatureStatisticsTest
+{
+
+public:
+  FindFeatureStatisticsTest()
+  {
+  }
+  virtual ~FindFeatureStatisticsTest()
+  {
+  }
+
+#define DREAM3D_CLOSE_ENOUGH(L, R, eps)                                                                                                                                                                \
+  if(false == SIMPLibMath::closeEnough<>(L, R, eps))                                                                                                                                                   \
+  {                                                                                                                                                                                                    \
+    QString buf;                                                                                                                                                                                       \
+    QTextStream ss(&buf);                                                                                                                                                                              \
+    ss << "Your test required the following\n            '";                                                                                                                                           \
+    ss << "SIMPLibMath::closeEnough<>(" << #L << ", " << #R << ", " << #eps << "'\n             but this condition was not met with eps=" << eps << "\n";                                              \
+    ss << "             " << L << "==" << R;                                                                                                                                                           \
+    DREAM3D_TEST_THROW_EXCEPTION(buf.toStdString())                                                                                                                                                    \
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindFeatureStatistics Filter from the FilterManager
+    // Also test for other filters that will be needed for the test
+    FilterManager* fm = FilterManager::Instance();
+    QStringList filtNames;
+    filtNames << "FindFeatureStatistics"
+              << "FindSizes"
+              << "FindShapes";
+    QStringList otherFiltNames;
+    otherFiltNames << "FindFeatureCentroids"
+                   << "FindSurfaceFeatures"
+                   << "FindAvgOrientations";
+    filtNames << otherFiltNames;
+    for(const QString& filtName : filtNames)
+    {
+      IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+      if(nullptr == filterFactory.get())
+      {
+        std::stringstream ss;
+        ss << "The FindFeatureStatisticsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the "
+           << (otherFiltNames.contains(filtName) ? "Generic or OrientationAnalysis" : "Statistics") << " Plugin";
+        DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestVolume(size_t dims[3], int32_t& numFeatures)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer idc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(idc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    float res[3] = {0.75f, 0.5f, 0.25f};
+    float origin[3] = {1.0f, -2.0f, 0.5f};
+    image->setDimensions(dims);
+    image->setResolution(res);
+    image->setOrigin(origin);
+    idc->setGeometry(image);
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, attrMat);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIdsPtr = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::FeatureIds);
+    Int32ArrayType::Pointer phasesPtr = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Phases);
+    cDims[0] = 4;
+    FloatArrayType::Pointer quatsPtr = FloatArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::Quats);
+    attrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIdsPtr);
+    attrMat->addAttributeArray(SIMPL::CellData::Phases, phasesPtr);
+    attrMat->addAttributeArray(SIMPL::CellData::Quats, quatsPtr);
+    int32_t* featureIds = featureIdsPtr->getPointer(0);
+    int32_t* phases = phasesPtr->getPointer(0);
+    float* quats = quatsPtr->getPointer(0);
+
+    // Sheared blocks give Features of different sizes and orientations, a few of the
+    // possible ids are never used and a sprinkling of Feature 0 voxels marks internal surfaces
+    numFeatures = 0;
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          int32_t a = static_cast<int32_t>((x + y / 3) / 10);
+          int32_t b = static_cast<int32_t>((y + z / 2) / 12);
+          int32_t c = static_cast<int32_t>(z / 10);
+          int32_t featureId = 1 + a + 8 * b + 64 * c;
+          if((x * 7 + y * 3 + z * 5) % 97 == 0)
+          {
+            featureId = 0;
+          }
+          featureIds[index] = featureId;
+          numFeatures = std::max(numFeatures, featureId + 1);
+
+          // Orientation scattered about a per Feature rotation around z, with random sign flips
+          float angle = 0.05f * static_cast<float>(featureId % 17) + 0.002f * static_cast<float>((x * 13 + y * 7 + z * 3) % 11);
+          float tilt = 0.003f * static_cast<float>((x + 2 * y + 3 * z) % 7);
+          float sign = ((x + y + z) % 3 == 0) ? -1.0f : 1.0f;
+          float norm = sqrtf(1.0f + tilt * tilt);
+          quats[4 * index + 0] = sign * tilt * cosf(angle) / norm;
+          quats[4 * index + 1] = sign * tilt * sinf(angle) / norm;
+          quats[4 * index + 2] = sign * sinf(angle) / norm;
+          quats[4 * index + 3] = sign * cosf(angle) / norm;
+          phases[index] = ((x + y * 5 + z * 11) % 41 == 0) ? 0 : 1;
+        }
+      }
+    }
+
+    tDims.resize(1);
+    tDims[0] = static_cast<size_t>(numFeatures);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featAttrMat);
+
+    tDims[0] = 2;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName, ensembleAttrMat);
+    cDims[0] = 1;
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, cDims, SIMPL::EnsembleData::CrystalStructures);
+    crystalStructures->setValue(0, 999); // Unknown
+    crystalStructures->setValue(1, 1);   // Cubic_High
+    ensembleAttrMat->addAttributeArray(SIMPL::EnsembleData::CrystalStructures, crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  AbstractFilter::Pointer CreateFilter(const QString& filtName, DataContainerArray::Pointer dca)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    filter->setDataContainerArray(dca);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SetPath(AbstractFilter::Pointer filter, const char* property, const QString& amName, const QString& arrayName)
+  {
+    QVariant var;
+    DataArrayPath path(SIMPL::Defaults::ImageDataContainerName, amName, arrayName);
+    var.setValue(path);
+    bool propWasSet = filter->setProperty(property, var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void SetName(AbstractFilter::Pointer filter, const char* property, const QString& arrayName)
+  {
+    QVariant var;
+    var.setValue(arrayName);
+    bool propWasSet = filter->setProperty(property, var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RunIndividualFilters(DataContainerArray::Pointer dca)
+  {
+    const QString cellAM = SIMPL::Defaults::CellAttributeMatrixName;
+    const QString featAM = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    const QString ensembleAM = SIMPL::Defaults::CellEnsembleAttributeMatrixName;
+
+    AbstractFilter::Pointer filter = CreateFilter("FindFeatureCentroids", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "CentroidsArrayPath", featAM, SIMPL::FeatureData::Centroids);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+    filter = CreateFilter("FindSizes", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "FeatureAttributeMatrixName", featAM, "");
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+    filter = CreateFilter("FindShapes", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "CellFeatureAttributeMatrixName", featAM, "");
+    SetPath(filter, "CentroidsArrayPath", featAM, SIMPL::FeatureData::Centroids);
+    SetName(filter, "VolumesArrayName", "ShapeVolumes");
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+    filter = CreateFilter("FindSurfaceFeatures", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "SurfaceFeaturesArrayPath", featAM, SIMPL::FeatureData::SurfaceFeatures);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+    filter = CreateFilter("FindAvgOrientations", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "CellPhasesArrayPath", cellAM, SIMPL::CellData::Phases);
+    SetPath(filter, "QuatsArrayPath", cellAM, SIMPL::CellData::Quats);
+    SetPath(filter, "CrystalStructuresArrayPath", ensembleAM, SIMPL::EnsembleData::CrystalStructures);
+    SetPath(filter, "AvgQuatsArrayPath", featAM, SIMPL::FeatureData::AvgQuats);
+    SetPath(filter, "AvgEulerAnglesArrayPath", featAM, SIMPL::FeatureData::AvgEulerAngles);
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int32_t RunFusedFilter(DataContainerArray::Pointer dca, bool avgOrientations)
+  {
+    const QString cellAM = SIMPL::Defaults::CellAttributeMatrixName;
+    const QString featAM = SIMPL::Defaults::CellFeatureAttributeMatrixName;
+    const QString ensembleAM = SIMPL::Defaults::CellEnsembleAttributeMatrixName;
+
+    AbstractFilter::Pointer filter = CreateFilter("FindFeatureStatistics", dca);
+    SetPath(filter, "FeatureIdsArrayPath", cellAM, SIMPL::CellData::FeatureIds);
+    SetPath(filter, "CellFeatureAttributeMatrixName", featAM, "");
+    SetPath(filter, "CellPhasesArrayPath", cellAM, SIMPL::CellData::Phases);
+    SetPath(filter, "QuatsArrayPath", cellAM, SIMPL::CellData::Quats);
+    SetPath(filter, "CrystalStructuresArrayPath", ensembleAM, SIMPL::EnsembleData::CrystalStructures);
+    QVariant var;
+    var.setValue(avgOrientations);
+    bool propWasSet = filter->setProperty("ComputeAvgOrientations", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    const char* names[] = {"NumElementsArrayName",  "VolumesArrayName",   "EquivalentDiametersArrayName", "CentroidsArrayName",       "BoundingBoxesArrayName",
+                           "SurfaceFeaturesArrayName", "Omega3sArrayName", "AxisLengthsArrayName",         "AxisEulerAnglesArrayName", "AspectRatiosArrayName",
+                           "AvgQuatsArrayName",     "AvgEulerAnglesArrayName"};
+    for(const char* name : names)
+    {
+      QString arrayName = QString("Fused") + QString(name).remove("ArrayName");
+      SetName(filter, name, arrayName);
+    }
+    filter->execute();
+    return filter->getErrorCondition();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  typename DataArray<T>::Pointer GetFeatureArray(DataContainerArray::Pointer dca, const QString& name)
+  {
+    AttributeMatrix::Pointer featAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    typename DataArray<T>::Pointer array = featAttrMat->getAttributeArrayAs<DataArray<T>>(name);
+    DREAM3D_REQUIRE(array.get() != nullptr);
+    return array;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  float AngleDifference(float a, float b)
+  {
+    float diff = std::fabs(a - b);
+    return std::min(diff, static_cast<float>(SIMPLib::Constants::k_2Pi) - diff);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesIndividualFilters()
+  {
+    size_t dims[3] = {64, 48, 40};
+    int32_t numFeatures = 0;
+    DataContainerArray::Pointer dca = CreateTestVolume(dims, numFeatures);
+
+    RunIndividualFilters(dca);
+    int32_t err = RunFusedFilter(dca, true);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+
+    Int32ArrayType::Pointer numElements = GetFeatureArray<int32_t>(dca, SIMPL::FeatureData::NumElements);
+    FloatArrayType::Pointer volumes = GetFeatureArray<float>(dca, SIMPL::FeatureData::Volumes);
+    FloatArrayType::Pointer eqDiameters = GetFeatureArray<float>(dca, SIMPL::FeatureData::EquivalentDiameters);
+    FloatArrayType::Pointer centroids = GetFeatureArray<float>(dca, SIMPL::FeatureData::Centroids);
+    BoolArrayType::Pointer surfaceFeatures = GetFeatureArray<bool>(dca, SIMPL::FeatureData::SurfaceFeatures);
+    FloatArrayType::Pointer omega3s = GetFeatureArray<float>(dca, SIMPL::FeatureData::Omega3s);
+    FloatArrayType::Pointer axisLengths = GetFeatureArray<float>(dca, SIMPL::FeatureData::AxisLengths);
+    FloatArrayType::Pointer axisEulerAngles = GetFeatureArray<float>(dca, SIMPL::FeatureData::AxisEulerAngles);
+    FloatArrayType::Pointer aspectRatios = GetFeatureArray<float>(dca, SIMPL::FeatureData::AspectRatios);
+    FloatArrayType::Pointer avgQuats = GetFeatureArray<float>(dca, SIMPL::FeatureData::AvgQuats);
+    FloatArrayType::Pointer avgEulerAngles = GetFeatureArray<float>(dca, SIMPL::FeatureData::AvgEulerAngles);
+
+    Int32ArrayType::Pointer fusedNumElements = GetFeatureArray<int32_t>(dca, "FusedNumElements");
+    FloatArrayType::Pointer fusedVolumes = GetFeatureArray<float>(dca, "FusedVolumes");
+    FloatArrayType::Pointer fusedEqDiameters = GetFeatureArray<float>(dca, "FusedEquivalentDiameters");
+    FloatArrayType::Pointer fusedCentroids = GetFeatureArray<float>(dca, "FusedCentroids");
+    FloatArrayType::Pointer fusedBoundingBoxes = GetFeatureArray<float>(dca, "FusedBoundingBoxes");
+    BoolArrayType::Pointer fusedSurfaceFeatures = GetFeatureArray<bool>(dca, "FusedSurfaceFeatures");
+    FloatArrayType::Pointer fusedOmega3s = GetFeatureArray<float>(dca, "FusedOmega3s");
+    FloatArrayType::Pointer fusedAxisLengths = GetFeatureArray<float>(dca, "FusedAxisLengths");
+    FloatArrayType::Pointer fusedAxisEulerAngles = GetFeatureArray<float>(dca, "FusedAxisEulerAngles");
+    FloatArrayType::Pointer fusedAspectRatios = GetFeatureArray<float>(dca, "FusedAspectRatios");
+    FloatArrayType::Pointer fusedAvgQuats = GetFeatureArray<float>(dca, "FusedAvgQuats");
+    FloatArrayType::Pointer fusedAvgEulerAngles = GetFeatureArray<float>(dca, "FusedAvgEulerAngles");
+
+    // Brute force bounding boxes
+    std::vector<int64_t> bounds(6 * numFeatures, -1);
+    Int32ArrayType::Pointer featureIdsPtr = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)
+                                                ->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)
+                                                ->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    int32_t* featureIds = featureIdsPtr->getPointer(0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          int32_t featureId = featureIds[(z * dims[1] + y) * dims[0] + x];
+          int64_t index[3] = {static_cast<int64_t>(x), static_cast<int64_t>(y), static_cast<int64_t>(z)};
+          for(size_t d = 0; d < 3; d++)
+          {
+            if(bounds[6 * featureId + d] < 0 || index[d] < bounds[6 * featureId + d])
+            {
+              bounds[6 * featureId + d] = index[d];
+            }
+            bounds[6 * featureId + 3 + d] = std::max(bounds[6 * featureId + 3 + d], index[d]);
+          }
+        }
+      }
+    }
+
+    float res[3] = {0.75f, 0.5f, 0.25f};
+    float origin[3] = {1.0f, -2.0f, 0.5f};
+    int32_t numEmpty = 0;
+    for(int32_t i = 0; i < numFeatures; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fusedSurfaceFeatures->getValue(i), surfaceFeatures->getValue(i));
+      // The resolutions are multiples of 0.25, so the single precision sums of FindFeatureCentroids are exact here
+      for(size_t d = 0; d < 3; d++)
+      {
+        DREAM3D_REQUIRE_EQUAL(fusedCentroids->getValue(3 * i + d), centroids->getValue(3 * i + d));
+      }
+      if(bounds[6 * i] >= 0)
+      {
+        for(size_t d = 0; d < 3; d++)
+        {
+          DREAM3D_REQUIRE_EQUAL(fusedBoundingBoxes->getValue(6 * i + d), origin[d] + static_cast<float>(bounds[6 * i + d]) * res[d]);
+          DREAM3D_REQUIRE_EQUAL(fusedBoundingBoxes->getValue(6 * i + 3 + d), origin[d] + static_cast<float>(bounds[6 * i + 3 + d] + 1) * res[d]);
+        }
+      }
+      if(i == 0)
+      {
+        continue;
+      }
+
+      DREAM3D_REQUIRE_EQUAL(fusedNumElements->getValue(i), numElements->getValue(i));
+      DREAM3D_REQUIRE_EQUAL(fusedVolumes->getValue(i), volumes->getValue(i));
+      DREAM3D_REQUIRE_EQUAL(fusedEqDiameters->getValue(i), eqDiameters->getValue(i));
+      if(numElements->getValue(i) == 0)
+      {
+        numEmpty++;
+        continue;
+      }
+
+      // FindShapes sums single precision sub voxel distances about the single precision centroid, while the
+      // fused filter expands the moments from exact integer sums. On this volume the two differ by at most
+      // 3e-6 in Omega3, the relative axis lengths, the aspect ratios and the axis Euler angles.
+      DREAM3D_CLOSE_ENOUGH(fusedOmega3s->getValue(i), omega3s->getValue(i), 0.00005f);
+      for(size_t d = 0; d < 3; d++)
+      {
+        DREAM3D_CLOSE_ENOUGH(fusedAxisLengths->getValue(3 * i + d), axisLengths->getValue(3 * i + d), 0.00005f * axisLengths->getValue(3 * i + d));
+      }
+      for(size_t d = 0; d < 2; d++)
+      {
+        DREAM3D_CLOSE_ENOUGH(fusedAspectRatios->getValue(2 * i + d), aspectRatios->getValue(2 * i + d), 0.00005f);
+      }
+      for(size_t d = 0; d < 3; d++)
+      {
+        DREAM3D_CLOSE_ENOUGH(AngleDifference(fusedAxisEulerAngles->getValue(3 * i + d), axisEulerAngles->getValue(3 * i + d)), 0.0f, 0.00005f);
+      }
+
+      // With one slab the average orientations are summed in the same Cell order as FindAvgOrientations.
+      // With several slabs a Feature that spans a slab boundary adds its slab sums in a different order,
+      // which moves the quaternions by at most 8e-7 on this volume. The smallest average Phi here is 0.0165,
+      // which can magnify that by up to 1 / sin(Phi / 2) = 120 in phi1 and phi2.
+      for(size_t d = 0; d < 4; d++)
+      {
+        DREAM3D_CLOSE_ENOUGH(fusedAvgQuats->getValue(4 * i + d), avgQuats->getValue(4 * i + d), 0.00001f);
+      }
+      for(size_t d = 0; d < 3; d++)
+      {
+        DREAM3D_CLOSE_ENOUGH(AngleDifference(fusedAvgEulerAngles->getValue(3 * i + d), avgEulerAngles->getValue(3 * i + d)), 0.0f, 0.0001f);
+      }
+    }
+    DREAM3D_REQUIRED(numEmpty, >, 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestRequires3D()
+  {
+    size_t dims[3] = {32, 24, 1};
+    int32_t numFeatures = 0;
+    DataContainerArray::Pointer dca = CreateTestVolume(dims, numFeatures);
+    int32_t err = RunFusedFilter(dca, false);
+    DREAM3D_REQUIRE_EQUAL(err, -11000);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesIndividualFilters())
+    DREAM3D_REGISTER_TEST(TestRequires3D())
+  }
+
+private:
+  FindFeatureStatisticsTest(const FindFeatureStatisticsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindFeatureStatisticsTest&);            // Move assignment Not Implemented
+};
@@ -0,0 +1,273 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindNeighborhoodsTest
+{
+
+public:
+  FindNeighborhoodsTest()
+  {
+  }
+  virtual ~FindNeighborhoodsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighborhoods Filter from the FilterManager
+    QString filtName = "FindNeighborhoods";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborhoodsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Scatters Features of varying size through the volume, including a few large
+  // Features whose critical distance covers most of it
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestData(size_t numFeatures, uint32_t seed)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer idc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(idc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    size_t dims[3] = {200, 150, 100};
+    float res[3] = {0.5f, 0.5f, 1.0f};
+    float origin[3] = {-10.0f, 5.0f, 2.5f};
+    image->setDimensions(dims);
+    image->setResolution(res);
+    image->setOrigin(origin);
+    idc->setGeometry(image);
+
+    QVector<size_t> tDims(1, numFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featureAttrMat);
+
+    QVector<size_t> cDims(1, 1);
+    FloatArrayType::Pointer eqDiamsPtr = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::EquivalentDiameters);
+    Int32ArrayType::Pointer phasesPtr = Int32ArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::Phases);
+    cDims[0] = 3;
+    FloatArrayType::Pointer centroidsPtr = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::Centroids);
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::EquivalentDiameters, eqDiamsPtr);
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::Phases, phasesPtr);
+    featureAttrMat->addAttributeArray(SIMPL::FeatureData::Centroids, centroidsPtr);
+
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    eqDiamsPtr->setValue(0, 0.0f);
+    phasesPtr->setValue(0, 0);
+    for(size_t d = 0; d < 3; d++)
+    {
+      centroidsPtr->setComponent(0, d, 0.0f);
+    }
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      float diameter = 1.0f + 6.0f * unit(generator);
+      if(i % 97 == 0)
+      {
+        diameter = 60.0f;
+      }
+      eqDiamsPtr->setValue(i, diameter);
+      phasesPtr->setValue(i, 1);
+      for(size_t d = 0; d < 3; d++)
+      {
+        centroidsPtr->setComponent(i, d, origin[d] + unit(generator) * dims[d] * res[d]);
+      }
+    }
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The original all pairs search, kept here as the reference the filter must match
+  // -----------------------------------------------------------------------------
+  void FindReferenceNeighborhoods(DataContainerArray::Pointer dca, float multiplesOfAverage, std::vector<std::vector<int32_t>>& neighborhoods)
+  {
+    DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    FloatArrayType::Pointer eqDiamsPtr = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EquivalentDiameters);
+    FloatArrayType::Pointer centroidsPtr = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Centroids);
+    float* eqDiams = eqDiamsPtr->getPointer(0);
+    float* centroids = centroidsPtr->getPointer(0);
+    size_t totalFeatures = eqDiamsPtr->getNumberOfTuples();
+
+    float origin[3] = {0.0f, 0.0f, 0.0f};
+    m->getGeometryAs<ImageGeom>()->getOrigin(origin);
+
+    std::vector<float> criticalDistance(totalFeatures, 0.0f);
+    float aveDiam = 0.0f;
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      aveDiam += eqDiams[i];
+      criticalDistance[i] = eqDiams[i] * multiplesOfAverage;
+    }
+    aveDiam /= totalFeatures;
+    std::vector<int64_t> bins(3 * totalFeatures, 0);
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      criticalDistance[i] /= aveDiam;
+      for(size_t d = 0; d < 3; d++)
+      {
+        bins[3 * i + d] = static_cast<int64_t>(static_cast<size_t>((centroids[3 * i + d] - origin[d]) / aveDiam));
+      }
+    }
+
+    neighborhoods.assign(totalFeatures, std::vector<int32_t>());
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      for(size_t j = i + 1; j < totalFeatures; j++)
+      {
+        float dBinX = llabs(bins[3 * j] - bins[3 * i]);
+        float dBinY = llabs(bins[3 * j + 1] - bins[3 * i + 1]);
+        float dBinZ = llabs(bins[3 * j + 2] - bins[3 * i + 2]);
+        if(dBinX < criticalDistance[i] && dBinY < criticalDistance[i] && dBinZ < criticalDistance[i])
+        {
+          neighborhoods[i].push_back(static_cast<int32_t>(j));
+        }
+        if(dBinX < criticalDistance[j] && dBinY < criticalDistance[j] && dBinZ < criticalDistance[j])
+        {
+          neighborhoods[j].push_back(static_cast<int32_t>(i));
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunFindNeighborhoods(DataContainerArray::Pointer dca, float multiplesOfAverage)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindNeighborhoods");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(multiplesOfAverage);
+    bool propWasSet = filter->setProperty("MultiplesOfAverage", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    filter->execute();
+    return filter->getErrorCondition();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMatchesAllPairsSearch()
+  {
+    const float multiples[3] = {0.5f, 1.0f, 2.5f};
+    for(size_t t = 0; t < 3; t++)
+    {
+      DataContainerArray::Pointer dca = CreateTestData(1500, 5489u + static_cast<uint32_t>(t));
+      int err = RunFindNeighborhoods(dca, multiples[t]);
+      DREAM3D_REQUIRE_EQUAL(err, 0);
+
+      std::vector<std::vector<int32_t>> reference;
+      FindReferenceNeighborhoods(dca, multiples[t], reference);
+
+      AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      NeighborList<int32_t>::Pointer neighborhoodList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborhoodList);
+      Int32ArrayType::Pointer neighborhoodsPtr = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Neighborhoods);
+      DREAM3D_REQUIRE_VALID_POINTER(neighborhoodList.get());
+      DREAM3D_REQUIRE_VALID_POINTER(neighborhoodsPtr.get());
+
+      size_t totalFeatures = reference.size();
+      size_t totalNeighbors = 0;
+      for(size_t i = 1; i < totalFeatures; i++)
+      {
+        NeighborList<int32_t>::SharedVectorType list = neighborhoodList->getList(static_cast<int32_t>(i));
+        DREAM3D_REQUIRE_VALID_POINTER(list.get());
+        DREAM3D_REQUIRE_EQUAL(list->size(), reference[i].size());
+        DREAM3D_REQUIRE_EQUAL(neighborhoodsPtr->getValue(i), static_cast<int32_t>(reference[i].size()));
+        for(size_t n = 0; n < reference[i].size(); n++)
+        {
+          DREAM3D_REQUIRE_EQUAL(list->at(n), reference[i][n]);
+        }
+        totalNeighbors += reference[i].size();
+      }
+      DREAM3D_REQUIRE(totalNeighbors > 0);
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestMatchesAllPairsSearch())
+  }
+
+private:
+  FindNeighborhoodsTest(const FindNeighborhoodsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborhoodsTest&);        // Move assignment Not Implemented
+};
@@ -0,0 +1,295 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "StatisticsTestFileLocations.h"
+
+class FindNeighborsTest
+{
+
+public:
+  FindNeighborsTest()
+  {
+  }
+  virtual ~FindNeighborsTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighbors Filter from the FilterManager
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Fills the volume with small random blocks of Features, leaving some voxels
+  // unassigned (0) so the background handling is exercised as well
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateTestVolume(size_t dims[3], int32_t numFeatures, uint32_t seed)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer idc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addDataContainer(idc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    float res[3] = {0.5f, 0.75f, 2.0f};
+    image->setDimensions(dims);
+    image->setResolution(res);
+    idc->setGeometry(image);
+
+    size_t totalPoints = dims[0] * dims[1] * dims[2];
+    QVector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName, attrMat);
+
+    QVector<size_t> cDims(1, 1);
+    Int32ArrayType::Pointer featureIdsPtr = Int32ArrayType::CreateArray(totalPoints, cDims, SIMPL::CellData::FeatureIds);
+    attrMat->addAttributeArray(SIMPL::CellData::FeatureIds, featureIdsPtr);
+
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int32_t> featureDist(0, numFeatures - 1);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          // Blocks of 3x2x2 voxels share a random Feature so the Features have real shared faces
+          std::mt19937 blockGenerator(seed + static_cast<uint32_t>(((z / 2) * dims[1] + (y / 2)) * dims[0] + (x / 3)));
+          int32_t feature = featureDist(blockGenerator);
+          if(generator() % 17 == 0)
+          {
+            feature = 0;
+          }
+          featureIdsPtr->setValue((z * dims[1] + y) * dims[0] + x, feature);
+        }
+      }
+    }
+
+    tDims.resize(1);
+    tDims[0] = static_cast<size_t>(numFeatures);
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    idc->addAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName, featureAttrMat);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int RunFindNeighbors(DataContainerArray::Pointer dca)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindNeighbors");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr);
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(true);
+    bool propWasSet = filter->setProperty("StoreBoundaryCells", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+    propWasSet = filter->setProperty("StoreSurfaceFeatures", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true);
+
+    filter->execute();
+    return filter->getErrorCondition();
+  }
+
+  // -----------------------------------------------------------------------------
+  // Compares the filter against a direct voxel by voxel count of the shared faces
+  // -----------------------------------------------------------------------------
+  void ValidateNeighbors(DataContainerArray::Pointer dca)
+  {
+    DataContainer::Pointer m = dca->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+    AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+
+    Int32ArrayType::Pointer featureIdsPtr = attrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    Int8ArrayType::Pointer boundaryCellsPtr = attrMat->getAttributeArrayAs<Int8ArrayType>(SIMPL::CellData::BoundaryCells);
+    Int32ArrayType::Pointer numNeighborsPtr = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumNeighbors);
+    BoolArrayType::Pointer surfaceFeaturesPtr = featureAttrMat->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+    NeighborList<int32_t>::Pointer neighborList = featureAttrMat->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = featureAttrMat->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCellsPtr.get());
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighborsPtr.get());
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeaturesPtr.get());
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get());
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaList.get());
+
+    int64_t dims[3] = {static_cast<int64_t>(image->getXPoints()), static_cast<int64_t>(image->getYPoints()), static_cast<int64_t>(image->getZPoints())};
+    float xRes = 0.0f, yRes = 0.0f, zRes = 0.0f;
+    std::tie(xRes, yRes, zRes) = image->getResolution();
+    size_t totalFeatures = featureAttrMat->getNumberOfTuples();
+
+    std::vector<std::map<int32_t, int32_t>> sharedFaces(totalFeatures);
+    std::vector<bool> surfaceFeatures(totalFeatures, false);
+    int64_t offsets[3] = {1, dims[0], dims[0] * dims[1]};
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          int64_t index = (z * dims[1] + y) * dims[0] + x;
+          int32_t feature = featureIdsPtr->getValue(index);
+          int8_t onsurf = 0;
+          if(feature > 0)
+          {
+            bool onEdge = x == 0 || x == dims[0] - 1 || y == 0 || y == dims[1] - 1;
+            bool onFace = dims[2] != 1 && (z == 0 || z == dims[2] - 1);
+            if(onEdge || onFace)
+            {
+              surfaceFeatures[feature] = true;
+            }
+            int64_t coords[3] = {x, y, z};
+            for(size_t d = 0; d < 3; d++)
+            {
+              for(int64_t step = -1; step <= 1; step += 2)
+              {
+                int64_t c = coords[d] + step;
+                if(c < 0 || c >= dims[d])
+                {
+                  continue;
+                }
+                int32_t neighbor = featureIdsPtr->getValue(index + step * offsets[d]);
+                if(neighbor != feature && neighbor > 0)
+                {
+                  onsurf++;
+                  sharedFaces[feature][neighbor]++;
+                }
+              }
+            }
+          }
+          DREAM3D_REQUIRE_EQUAL(boundaryCellsPtr->getValue(index), onsurf);
+        }
+      }
+    }
+
+    for(size_t i = 1; i < totalFeatures; i++)
+    {
+      NeighborList<int32_t>::SharedVectorType neighbors = neighborList->getList(static_cast<int32_t>(i));
+      NeighborList<float>::SharedVectorType areas = sharedSurfaceAreaList->getList(static_cast<int32_t>(i));
+      DREAM3D_REQUIRE_VALID_POINTER(neighbors.get());
+      DREAM3D_REQUIRE_VALID_POINTER(areas.get());
+      DREAM3D_REQUIRE_EQUAL(neighbors->size(), sharedFaces[i].size());
+      DREAM3D_REQUIRE_EQUAL(areas->size(), sharedFaces[i].size());
+      DREAM3D_REQUIRE_EQUAL(numNeighborsPtr->getValue(i), static_cast<int32_t>(sharedFaces[i].size()));
+      DREAM3D_REQUIRE_EQUAL(surfaceFeaturesPtr->getValue(i), surfaceFeatures[i]);
+      size_t n = 0;
+      for(const auto& face : sharedFaces[i])
+      {
+        DREAM3D_REQUIRE_EQUAL(neighbors->at(n), face.first);
+        DREAM3D_REQUIRE_EQUAL(areas->at(n), float(face.second) * xRes * yRes);
+        n++;
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindNeighbors()
+  {
+    size_t dims[3] = {37, 29, 23};
+    DataContainerArray::Pointer dca = CreateTestVolume(dims, 400, 5489u);
+    int err = RunFindNeighbors(dca);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    ValidateNeighbors(dca);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFindNeighbors2D()
+  {
+    size_t dims[3] = {64, 48, 1};
+    DataContainerArray::Pointer dca = CreateTestVolume(dims, 150, 97u);
+    int err = RunFindNeighbors(dca);
+    DREAM3D_REQUIRE_EQUAL(err, 0);
+    ValidateNeighbors(dca);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestFindNeighbors())
+    DREAM3D_REGISTER_TEST(TestFindNeighbors2D())
+  }
+
+private:
+  FindNeighborsTest(const FindNeighborsTest&); // Copy Constructor Not Implemented
+  void operator=(const FindNeighborsTest&);    // Move assignment Not Implemented
+};
@@ -35,8 +35,17 @@
 
 #include "LaplacianSmoothing.h"
 
+#include <algorithm>
 #include <sstream>
 #include <stdio.h>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -50,6 +59,76 @@
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 #include "SurfaceMeshing/SurfaceMeshingVersion.h"
 
+/**
+ * @brief The LaplacianGatherImpl class moves each vertex of a range by its lambda times the
+ * mean offset to its neighbors. Positions are read from one buffer and written to another so
+ * that every vertex sees the positions of the previous step, just like the edge based version.
+ */
+class LaplacianGatherImpl
+{
+  const float* m_Source;
+  float* m_Destination;
+  const int64_t* m_Offsets;
+  const int64_t* m_Neighbors;
+  const float* m_Lambda;
+  float m_Factor;
+
+public:
+  LaplacianGatherImpl(const float* source, float* destination, const int64_t* offsets, const int64_t* neighbors, const float* lambda, float factor)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_Offsets(offsets)
+  , m_Neighbors(neighbors)
+  , m_Lambda(lambda)
+  , m_Factor(factor)
+  {
+  }
+  virtual ~LaplacianGatherImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      const float* vert = m_Source + 3 * i;
+      float* out = m_Destination + 3 * i;
+      int64_t first = m_Offsets[i];
+      int64_t last = m_Offsets[i + 1];
+      if(first == last)
+      {
+        // vertices that are not part of any edge stay where they are
+        out[0] = vert[0];
+        out[1] = vert[1];
+        out[2] = vert[2];
+        continue;
+      }
+
+      // neighbors are stored in edge order so the sums match the edge based version
+      double delta[3] = {0.0, 0.0, 0.0};
+      for(int64_t n = first; n < last; n++)
+      {
+        const float* neighbor = m_Source + 3 * m_Neighbors[n];
+        delta[0] += neighbor[0] - vert[0];
+        delta[1] += neighbor[1] - vert[1];
+        delta[2] += neighbor[2] - vert[2];
+      }
+
+      int32_t ncon = static_cast<int32_t>(last - first);
+      float ll = m_Lambda[i] * m_Factor;
+      for(int32_t j = 0; j < 3; j++)
+      {
+        out[j] = vert[j] + ll * (delta[j] / ncon);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -66,6 +145,7 @@ LaplacianSmoothing::LaplacianSmoothing()
 , m_SurfaceQuadPointLambda(0.0f)
 , m_UseTaubinSmoothing(false)
 , m_MuFactor(-1.03f)
+, m_UseEdgeBasedSmoothing(false)
 , m_SurfaceMeshNodeType(nullptr)
 , m_SurfaceMeshFaceLabels(nullptr)
 {
@@ -210,7 +290,14 @@ void LaplacianSmoothing::execute()
     return;
   }
 
-  err = edgeBasedSmoothing();
+  if(m_UseEdgeBasedSmoothing)
+  {
+    err = edgeBasedSmoothing();
+  }
+  else
+  {
+    err = vertexBasedSmoothing();
+  }
 
   if(err < 0)
   {
@@ -406,6 +493,131 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t LaplacianSmoothing::vertexBasedSmoothing()
+{
+  int32_t err = 0;
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceDataContainerName());
+  IGeometry2D::Pointer surfaceMesh = sm->getGeometryAs<IGeometry2D>();
+  float* verts = surfaceMesh->getVertexPointer(0);
+  int64_t nvert = surfaceMesh->getNumberOfVertices();
+
+  // Generate the Lambda Array
+  err = generateLambdaArray();
+  if(err < 0)
+  {
+    setErrorCondition(-557);
+    notifyErrorMessage(getHumanLabel(), "Error generating the lambda array", getErrorCondition());
+    return err;
+  }
+
+  // Get a Pointer to the Lambda array for conveneince
+  DataArray<float>::Pointer lambdas = getLambdaArray();
+  float* lambda = lambdas->getPointer(0);
+
+  //  Generate the Unique Edges
+  if(nullptr == surfaceMesh->getEdges().get())
+  {
+    err = surfaceMesh->findEdges();
+  }
+  if(err < 0)
+  {
+    setErrorCondition(-560);
+    notifyErrorMessage(getHumanLabel(), "Error retrieving the shared edge list", getErrorCondition());
+    return getErrorCondition();
+  }
+
+  int64_t* uedges = surfaceMesh->getEdgePointer(0);
+  int64_t nedges = surfaceMesh->getNumberOfEdges();
+
+  // Build the Vertex->Vertex connectivity once. The neighbors of each vertex are
+  // listed in the order of the unique edges that touch it.
+  DataArray<int64_t>::Pointer offsetsArray = DataArray<int64_t>::CreateArray(nvert + 1, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Offsets_Array");
+  offsetsArray->initializeWithZeros();
+  int64_t* offsets = offsetsArray->getPointer(0);
+  for(int64_t i = 0; i < nedges; i++)
+  {
+    Q_ASSERT(uedges[2 * i] < nvert && uedges[2 * i + 1] < nvert);
+    offsets[uedges[2 * i] + 1]++;
+    offsets[uedges[2 * i + 1] + 1]++;
+  }
+  for(int64_t i = 0; i < nvert; i++)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+
+  DataArray<int64_t>::Pointer neighborsArray = DataArray<int64_t>::CreateArray(2 * nedges, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Neighbors_Array");
+  int64_t* neighbors = neighborsArray->getPointer(0);
+  std::vector<int64_t> cursor(offsets, offsets + nvert);
+  for(int64_t i = 0; i < nedges; i++)
+  {
+    int64_t in1 = uedges[2 * i];     // row of the first vertex
+    int64_t in2 = uedges[2 * i + 1]; // row the second vertex
+    neighbors[cursor[in1]++] = in2;
+    neighbors[cursor[in2]++] = in1;
+  }
+
+  QVector<size_t> cDims(1, 3);
+  DataArray<float>::Pointer bufferArray = DataArray<float>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Vertex_Buffer");
+  float* source = verts;
+  float* destination = bufferArray->getPointer(0);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+#endif
+
+  // Move every vertex from source into destination, then swap the two buffers
+  auto smoothVertices = [&](float factor) {
+    LaplacianGatherImpl impl(source, destination, offsets, neighbors, lambda, factor);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, static_cast<size_t>(nvert)), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(0, static_cast<size_t>(nvert));
+    }
+    std::swap(source, destination);
+  };
+
+  for(int32_t q = 0; q < m_IterationSteps; q++)
+  {
+    if(getCancel())
+    {
+      return -1;
+    }
+    QString ss = QObject::tr("Iteration %1 of %2").arg(q).arg(m_IterationSteps);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+    smoothVertices(1.0f);
+
+    // Now optionally apply a negative lambda based on the mu Factor value.
+    // This is from Taubin's paper on smoothing without shrinkage. This effectively
+    // runs a low pass filter on the data
+    if(m_UseTaubinSmoothing)
+    {
+      if(getCancel())
+      {
+        return -1;
+      }
+      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      smoothVertices(m_MuFactor);
+    }
+  }
+
+  // The latest positions may live in the scratch buffer
+  if(source != verts)
+  {
+    std::copy(source, source + 3 * nvert, verts);
+  }
+
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 // This is just here for some debugging issues.
 // -----------------------------------------------------------------------------
@@ -115,6 +115,13 @@ public:
     */
    SIMPL_VIRTUAL_INSTANCE_PROPERTY(DataArray<float>::Pointer, LambdaArray)
 
+   /* The default smoothing gathers the neighbors of every vertex from a vertex adjacency
+    * list and runs in parallel. Setting this to true runs the original serial edge based
+    * version instead; both produce the same vertex positions.
+    */
+   SIMPL_INSTANCE_PROPERTY(bool, UseEdgeBasedSmoothing)
+   Q_PROPERTY(bool UseEdgeBasedSmoothing READ getUseEdgeBasedSmoothing WRITE setUseEdgeBasedSmoothing)
+
    /**
     * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
     */
@@ -204,6 +211,14 @@ public:
     */
    virtual int32_t edgeBasedSmoothing();
 
+   /**
+    * @brief vertexBasedSmoothing Version of the smoothing algorithm that builds the Vertex->Vertex
+    * connectivity once and then updates every vertex from its neighbors, reading the positions of
+    * the previous step from one buffer and writing the new positions into another
+    * @return Integer error code
+    */
+   virtual int32_t vertexBasedSmoothing();
+
  private:
    DEFINE_DATAARRAY_VARIABLE(int8_t, SurfaceMeshNodeType)
    DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
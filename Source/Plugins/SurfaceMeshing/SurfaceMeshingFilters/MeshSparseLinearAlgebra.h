@@ -0,0 +1,376 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/MeshLinearAlgebra.h"
+
+// The sparse matrix and solver live apart from MeshLinearAlgebra.h so that only the code
+// that assembles and solves a sparse system pulls in TBB.
+
+namespace MFE
+{
+  /**
+   * @brief The CSRMatrix class stores a square or rectangular sparse matrix in
+   * compressed sparse row form. The matrix is assembled from one or more lists of
+   * (row, column, value) triplets, typically one list per thread or block of work,
+   * and duplicate entries are summed. Once assembled the sparsity pattern is fixed;
+   * existing entries may still be modified through entry().
+   */
+  template<typename vtype = double, typename itype = unsigned int>
+  class CSRMatrix
+  {
+    public:
+      struct Triplet
+      {
+        itype row;
+        itype col;
+        vtype value;
+      };
+      typedef std::vector<Triplet> TripletList;
+
+      CSRMatrix(int m, int n)
+      {
+        rows = m;
+        cols = n;
+        rowStart.assign(m + 1, 0);
+      }
+      void setFromTriplets(const std::vector<TripletList>& lists);
+      vtype* entry(int i, int j);
+      vtype operator()(int i, int j) const;
+      vtype diagonal(int i) const
+      {
+        return (*this)(i, i);
+      }
+      void multiply(const Vector<vtype>& x, Vector<vtype>& y) const;
+      Vector<vtype> operator*(const Vector<vtype>& x) const
+      {
+        Vector<vtype> y(rows);
+        multiply(x, y);
+        return y;
+      }
+      int dimension1() const
+      {
+        return rows;
+      }
+      int dimension2() const
+      {
+        return cols;
+      }
+      int nonzero() const
+      {
+        return colIndex.size();
+      }
+    private:
+      std::vector<size_t> rowStart;
+      std::vector<itype> colIndex;
+      std::vector<vtype> values;
+      int rows;
+      int cols;
+  };
+
+  /**
+   * @brief The CSRCompressImpl class sorts each row of a freshly filled CSR matrix
+   * by column and sums duplicate entries in place. The number of unique entries
+   * left in each row is written to rowLength.
+   */
+  template<typename vtype, typename itype>
+  class CSRCompressImpl
+  {
+    public:
+      CSRCompressImpl(const size_t* rowStart, itype* colIndex, vtype* values, size_t* rowLength) :
+        m_RowStart(rowStart),
+        m_ColIndex(colIndex),
+        m_Values(values),
+        m_RowLength(rowLength)
+      {}
+      virtual ~CSRCompressImpl() {}
+
+      void compress(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          itype* c = m_ColIndex + m_RowStart[i];
+          vtype* v = m_Values + m_RowStart[i];
+          size_t n = m_RowStart[i + 1] - m_RowStart[i];
+          // Rows are short, so an insertion sort avoids any temporary storage
+          for (size_t k = 1; k < n; k++)
+          {
+            itype col = c[k];
+            vtype value = v[k];
+            size_t l = k;
+            for (; l > 0 && c[l - 1] > col; l--)
+            {
+              c[l] = c[l - 1];
+              v[l] = v[l - 1];
+            }
+            c[l] = col;
+            v[l] = value;
+          }
+          size_t unique = 0;
+          for (size_t k = 0; k < n; k++)
+          {
+            if(unique > 0 && c[unique - 1] == c[k]) { v[unique - 1] += v[k]; }
+            else
+            {
+              c[unique] = c[k];
+              v[unique] = v[k];
+              unique++;
+            }
+          }
+          m_RowLength[i] = unique;
+        }
+      }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        compress(r.begin(), r.end());
+      }
+#endif
+    private:
+      const size_t* m_RowStart;
+      itype* m_ColIndex;
+      vtype* m_Values;
+      size_t* m_RowLength;
+  };
+
+  /**
+   * @brief The CSRMultiplyImpl class computes y = A * x for a range of rows of a CSR matrix.
+   */
+  template<typename vtype, typename itype>
+  class CSRMultiplyImpl
+  {
+    public:
+      CSRMultiplyImpl(const size_t* rowStart, const itype* colIndex, const vtype* values, const Vector<vtype>& x, Vector<vtype>& y) :
+        m_RowStart(rowStart),
+        m_ColIndex(colIndex),
+        m_Values(values),
+        m_X(x),
+        m_Y(y)
+      {}
+      virtual ~CSRMultiplyImpl() {}
+
+      void multiply(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          vtype sum = 0.0;
+          for (size_t k = m_RowStart[i]; k < m_RowStart[i + 1]; k++)
+          { sum += m_Values[k] * m_X[m_ColIndex[k]]; }
+          m_Y[i] = sum;
+        }
+      }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        multiply(r.begin(), r.end());
+      }
+#endif
+    private:
+      const size_t* m_RowStart;
+      const itype* m_ColIndex;
+      const vtype* m_Values;
+      const Vector<vtype>& m_X;
+      Vector<vtype>& m_Y;
+  };
+
+  template<typename vtype, typename itype>
+  void CSRMatrix<vtype, itype>::setFromTriplets(const std::vector<TripletList>& lists)
+  {
+    // Count the entries of each row, then turn the counts into row offsets
+    rowStart.assign(rows + 1, 0);
+    for (size_t l = 0; l < lists.size(); l++)
+      for (size_t t = 0; t < lists[l].size(); t++)
+      { rowStart[lists[l][t].row + 1]++; }
+    for (int i = 0; i < rows; i++)
+    { rowStart[i + 1] += rowStart[i]; }
+
+    colIndex.resize(rowStart[rows]);
+    values.resize(rowStart[rows]);
+    std::vector<size_t> cursor(rowStart.begin(), rowStart.end() - 1);
+    for (size_t l = 0; l < lists.size(); l++)
+      for (size_t t = 0; t < lists[l].size(); t++)
+      {
+        const Triplet& triplet = lists[l][t];
+        size_t k = cursor[triplet.row]++;
+        colIndex[k] = triplet.col;
+        values[k] = triplet.value;
+      }
+
+    // Sort every row by column and merge the duplicates
+    std::vector<size_t> rowLength(rows, 0);
+    CSRCompressImpl<vtype, itype> impl(rowStart.data(), colIndex.data(), values.data(), rowLength.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, rows), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.compress(0, rows);
+    }
+
+    // Close the gaps left by the merged duplicates; rows only ever move towards the front
+    size_t next = 0;
+    for (int i = 0; i < rows; i++)
+    {
+      size_t start = rowStart[i];
+      rowStart[i] = next;
+      for (size_t k = 0; k < rowLength[i]; k++)
+      {
+        colIndex[next] = colIndex[start + k];
+        values[next] = values[start + k];
+        next++;
+      }
+    }
+    rowStart[rows] = next;
+    colIndex.resize(next);
+    values.resize(next);
+  }
+
+  template<typename vtype, typename itype>
+  vtype* CSRMatrix<vtype, itype>::entry(int i, int j)
+  {
+    typename std::vector<itype>::iterator first = colIndex.begin() + rowStart[i];
+    typename std::vector<itype>::iterator last = colIndex.begin() + rowStart[i + 1];
+    typename std::vector<itype>::iterator it = std::lower_bound(first, last, static_cast<itype>(j));
+    if(it == last || *it != static_cast<itype>(j)) { return nullptr; }
+    return &values[it - colIndex.begin()];
+  }
+
+  template<typename vtype, typename itype>
+  vtype CSRMatrix<vtype, itype>::operator()(int i, int j) const
+  {
+    typename std::vector<itype>::const_iterator first = colIndex.begin() + rowStart[i];
+    typename std::vector<itype>::const_iterator last = colIndex.begin() + rowStart[i + 1];
+    typename std::vector<itype>::const_iterator it = std::lower_bound(first, last, static_cast<itype>(j));
+    if(it == last || *it != static_cast<itype>(j)) { return 0.0; }
+    return values[it - colIndex.begin()];
+  }
+
+  template<typename vtype, typename itype>
+  void CSRMatrix<vtype, itype>::multiply(const Vector<vtype>& x, Vector<vtype>& y) const
+  {
+    // The scheduler is owned by the caller (PCG keeps one alive for the whole solve)
+    CSRMultiplyImpl<vtype, itype> impl(rowStart.data(), colIndex.data(), values.data(), x, y);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, rows), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.multiply(0, rows);
+    }
+  }
+
+  template<typename vtype, typename itype, typename type>
+  int PCG(const CSRMatrix<vtype, itype>& A, Vector<vtype>& x, const Vector<vtype>& b, int max, type tolerance)
+  {
+    // Jacobi preconditioned conjugate gradient (PCG) algorithm
+    // Use for solving symmetric positive definite linear systems. Scaling by the
+    // inverse diagonal keeps rows with very large (constraint) diagonals from
+    // stalling the iteration.
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    // One scheduler serves every matrix vector product of the solve
+    tbb::task_scheduler_init init;
+#endif
+    int n = x.dimension();
+    Vector<vtype> r(n), z(n), p(n), q(n), dinv(n);
+    for (int i = 0; i < n; i++)
+    {
+      vtype d = A.diagonal(i);
+      dinv[i] = (d != 0.0) ? 1.0 / d : 1.0;
+    }
+
+    A.multiply(x, q);
+    for (int i = 0; i < n; i++)
+    { r[i] = b[i] - q[i]; }
+    type bnorm = norm(b);
+    type rnorm = norm(r);
+    if(bnorm == 0.0)
+    {
+      x = 0.0;
+      return 0;
+    }
+    if((rnorm / bnorm) <= tolerance) { return 0; }
+
+    for (int i = 0; i < n; i++)
+    { z[i] = dinv[i] * r[i]; }
+    p = z;
+    type rho = inner(r, z);
+
+    for (int iteration = 1; iteration <= max; iteration++)
+    {
+      A.multiply(p, q);
+      type alpha = rho / inner(p, q);
+      for (int i = 0; i < n; i++)
+      {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * q[i];
+      }
+      rnorm = norm(r);
+      if((rnorm / bnorm) <= tolerance) { return iteration; }
+      for (int i = 0; i < n; i++)
+      { z[i] = dinv[i] * r[i]; }
+      type rho1 = rho;
+      rho = inner(r, z);
+      type beta = rho / rho1;
+      for (int i = 0; i < n; i++)
+      { p[i] = z[i] + beta * p[i]; }
+    }
+
+    return -1;
+  }
+}
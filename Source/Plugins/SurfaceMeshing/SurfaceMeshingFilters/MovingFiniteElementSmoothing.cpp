@@ -51,16 +51,30 @@
 // Michael A. Jackson as part of SAIC Prime contract N00173-07-C-2068
 #include "MovingFiniteElementSmoothing.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <utility>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include "SIMPLib/Common/Constants.h"
-#include "SIMPLib/DataArrays/StructArray.hpp"
-#include "SIMPLib/Geometry/MeshStructs.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "SurfaceMeshing/SurfaceMeshingFilters/MeshFunctions.h"
-#include "SurfaceMeshing/SurfaceMeshingFilters/MeshLinearAlgebra.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/MeshSparseLinearAlgebra.h"
 
 #define ENABLE_MFE_SMOOTHING_RESTART_FILE 0
 
@@ -79,6 +93,15 @@ typedef struct
   int triplenn2;
 } TripleNN;
 
+/**
+ * @brief The MFENode struct holds a double precision copy of a vertex so the
+ * finite element system is assembled and integrated in double precision.
+ */
+typedef struct
+{
+  double pos[3];
+} MFENode;
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -127,6 +150,182 @@ template <typename Node, typename T> double AngleLineCurvature(Node& n0, Node& n
   return 2. * angle / (d1 + d2);
 }
 
+/**
+ * @brief The MFEBlockStats struct holds the triangle quality statistics gathered
+ * over one block of triangles during assembly.
+ */
+typedef struct
+{
+  double Q_sum;
+  double Q_max;
+  double Dihedral_sum;
+  double Dihedral_min;
+  double Dihedral_max;
+} MFEBlockStats;
+
+typedef MFE::CSRMatrix<double> MFEStiffnessType;
+typedef std::vector<std::pair<int64_t, double>> MFEForceList;
+
+/**
+ * @brief The AssembleMFESystemImpl class computes the stiffness and force contributions
+ * of fixed size blocks of triangles. Each block writes to its own triplet list, force list
+ * and statistics so the blocks can be assembled concurrently and merged in block order,
+ * which keeps the assembled system identical regardless of the number of threads.
+ */
+class AssembleMFESystemImpl
+{
+  typedef NodeFunctions<MFENode, double> NodeFunctionsType;
+  typedef TriangleFunctions<MFENode, double> TriangleFunctionsType;
+
+public:
+  AssembleMFESystemImpl(const MFENode* nodes, const int64_t* triangles, int64_t ntri, size_t blockSize, const int8_t* nodeType, const TripleNN* triplenn, bool smoothTripleLines,
+                        double A_scale, double Q_scale, double TJ_scale, double small, std::vector<MFEStiffnessType::TripletList>& kTriplets, std::vector<MFEForceList>& forces,
+                        std::vector<MFEBlockStats>& stats)
+  : m_Nodes(nodes)
+  , m_Triangles(triangles)
+  , m_NumTriangles(ntri)
+  , m_BlockSize(blockSize)
+  , m_NodeType(nodeType)
+  , m_TripleNN(triplenn)
+  , m_SmoothTripleLines(smoothTripleLines)
+  , m_AScale(A_scale)
+  , m_QScale(Q_scale)
+  , m_TJScale(TJ_scale)
+  , m_Small(small)
+  , m_KTriplets(kTriplets)
+  , m_Forces(forces)
+  , m_Stats(stats)
+  {
+  }
+  virtual ~AssembleMFESystemImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    const double one12th = 1.0 / 12.0;
+    for(size_t b = start; b < end; b++)
+    {
+      MFEStiffnessType::TripletList& kList = m_KTriplets[b];
+      MFEForceList& fList = m_Forces[b];
+      MFEBlockStats& stats = m_Stats[b];
+      kList.clear();
+      fList.clear();
+      stats.Q_sum = 0.0;
+      stats.Q_max = 0.0;
+      stats.Dihedral_sum = 0.0;
+      stats.Dihedral_min = 180.0;
+      stats.Dihedral_max = -1.0;
+
+      size_t tEnd = std::min((b + 1) * m_BlockSize, static_cast<size_t>(m_NumTriangles));
+      for(size_t t = b * m_BlockSize; t < tEnd; t++)
+      {
+        const int64_t* rtri = m_Triangles + 3 * t;
+        // Work on copies of the triangle's nodes so perturbing a node never touches
+        // memory that another block may be reading at the same time
+        MFENode tnodes[3] = {m_Nodes[rtri[0]], m_Nodes[rtri[1]], m_Nodes[rtri[2]]};
+
+        MFE::Vector<double> n(3);
+        n = TriangleFunctionsType::normal(tnodes[0], tnodes[1], tnodes[2]);
+        double A = TriangleFunctionsType::area(tnodes[0], tnodes[1], tnodes[2]);           //  current Area
+        double Q = TriangleFunctionsType::circularity(tnodes[0], tnodes[1], tnodes[2], A); //  current quality
+        if(Q > 100.)
+        {
+          qDebug() << "Warning, tri no. " << t << " has Q= " << Q << "\n";
+        }
+        stats.Q_sum += Q;
+        if(Q > stats.Q_max)
+        {
+          stats.Q_max = Q;
+        }
+
+        double Dihedral = TriangleFunctionsType::MinDihedral(tnodes[0], tnodes[1], tnodes[2]);
+        stats.Dihedral_sum += Dihedral;
+        if(Dihedral < stats.Dihedral_min)
+        {
+          stats.Dihedral_min = Dihedral;
+        }
+        if(Dihedral > stats.Dihedral_max)
+        {
+          stats.Dihedral_max = Dihedral;
+        }
+
+        for(int n0 = 0; n0 < 3; n0++)
+        {
+          // for each of 3 nodes on the t^th triangle
+          int64_t i = rtri[n0];
+          MFENode& node_i = tnodes[n0];
+          bool tripleNode = (m_SmoothTripleLines == true && (m_NodeType[i] == 3 || m_NodeType[i] == 13));
+          MFENode tripleNN1 = node_i;
+          MFENode tripleNN2 = node_i;
+          if(tripleNode == true)
+          {
+            tripleNN1 = m_Nodes[m_TripleNN[i].triplenn1];
+            tripleNN2 = m_Nodes[m_TripleNN[i].triplenn2];
+          }
+          for(int j = 0; j < 3; j++)
+          {
+            //  for each of the three coordinates of the node
+            double LDistance = 0.0;
+            if(tripleNode == true)
+            {
+              //  if we are smoothing triple lines, and we have a TJ node
+              LDistance = NodeFunctionsType::Distance(node_i, tripleNN1) + NodeFunctionsType::Distance(tripleNN2, node_i);
+            }
+            node_i.pos[j] += m_Small;
+            double Anew = TriangleFunctionsType::area(tnodes[0], tnodes[1], tnodes[2]); //  current Area
+            double Qnew = TriangleFunctionsType::circularity(tnodes[0], tnodes[1], tnodes[2], Anew);
+            if(tripleNode == true)
+            {
+              double deltaLDistance = NodeFunctionsType::Distance(node_i, tripleNN1) + NodeFunctionsType::Distance(tripleNN2, node_i) - LDistance; // change in line length
+              fList.push_back(std::make_pair(3 * i + j, -m_TJScale * deltaLDistance));
+            }
+            node_i.pos[j] -= m_Small;
+            double arg = (m_AScale * (Anew - A) + m_QScale * (Qnew - Q) * A) / m_Small;
+            fList.push_back(std::make_pair(3 * i + j, -arg));
+          }
+          for(int n1 = 0; n1 < 3; n1++)
+          {
+            //  for each of 3 nodes
+            int64_t h = rtri[n1];
+            for(int k = 0; k < 3; k++)
+            {
+              for(int j = 0; j < 3; j++)
+              {
+                MFEStiffnessType::Triplet triplet;
+                triplet.row = static_cast<unsigned int>(3 * h + k);
+                triplet.col = static_cast<unsigned int>(3 * i + j);
+                triplet.value = one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
+                kList.push_back(triplet);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    generate(r.begin(), r.end());
+  }
+#endif
+private:
+  const MFENode* m_Nodes;
+  const int64_t* m_Triangles;
+  int64_t m_NumTriangles;
+  size_t m_BlockSize;
+  const int8_t* m_NodeType;
+  const TripleNN* m_TripleNN;
+  bool m_SmoothTripleLines;
+  double m_AScale;
+  double m_QScale;
+  double m_TJScale;
+  double m_Small;
+  std::vector<MFEStiffnessType::TripletList>& m_KTriplets;
+  std::vector<MFEForceList>& m_Forces;
+  std::vector<MFEBlockStats>& m_Stats;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -196,46 +395,34 @@ void MovingFiniteElementSmoothing::dataCheck()
   setErrorCondition(0);
   setWarningCondition(0);
 
-  DataContainer::Pointer sm = getDataContainerArray()->getPrereqDataContainer(this, getSurfaceMeshNodeTypeArrayPath().getDataContainerName(), false);
-  if(getErrorCondition() < 0)
-  {
-    return;
-  }
+  TriangleGeom::Pointer triangles = getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath().getDataContainerName());
 
-  // We MUST have Nodes
-  if(sm->getVertices().get() == nullptr)
-  {
-    setErrorCondition(-384);
-    notifyErrorMessage(getHumanLabel(), "SurfaceMesh DataContainer missing Nodes", getErrorCondition());
-  }
+  QVector<IDataArray::Pointer> dataArrays;
 
-  // We MUST have Triangles defined also.
-  if(sm->getFaces().get() == nullptr)
+  if(getErrorCondition() >= 0)
   {
-    setErrorCondition(-385);
-    notifyErrorMessage(getHumanLabel(), "SurfaceMesh DataContainer missing Triangles", getErrorCondition());
+    dataArrays.push_back(triangles->getVertices());
   }
 
+  QVector<size_t> cDims(1, 1);
+  m_SurfaceMeshNodeTypePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int8_t>, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath(),
+                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_SurfaceMeshNodeTypePtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_SurfaceMeshNodeType = m_SurfaceMeshNodeTypePtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
   if(getErrorCondition() >= 0)
   {
-    // Check for Node Type Array
-    // int size = sm->getVertices()->getNumberOfTuples();
-    QVector<size_t> dims(1, 1);
-    m_SurfaceMeshNodeTypePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int8_t>, AbstractFilter>(this, getSurfaceMeshNodeTypeArrayPath(),
-                                                                                                                  dims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_SurfaceMeshNodeTypePtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_SurfaceMeshNodeType = m_SurfaceMeshNodeTypePtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    dataArrays.push_back(m_SurfaceMeshNodeTypePtr.lock());
   }
 
-  if(getConstrainQuadPoints() == true || getSmoothTripleLines() == true)
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrays);
+
+  if(getSmoothTripleLines() == true)
   {
-    if(sm->getEdges().get() == nullptr)
-    {
-      setErrorCondition(-385);
-      notifyErrorMessage(getHumanLabel(), "Constraining Quad Points or Triples lines requires Edges array", getErrorCondition());
-    }
+    setWarningCondition(-386);
+    QString ss = QObject::tr("Smoothing of triple lines has not been updated for the triangle geometry and will be skipped");
+    notifyWarningMessage(getHumanLabel(), ss, getWarningCondition());
   }
 }
 
@@ -250,12 +437,6 @@ void MovingFiniteElementSmoothing::preflight()
   dataCheck();
   emit preflightExecuted();
   setInPreflight(false);
-
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
-  setErrorCondition(0xABABABAB);
-  QString ss = QObject::tr("Filter is NOT updated for IGeometry Redesign. A Programmer needs to check this filter. Please report this to the DREAM3D developers.");
-  notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-  /* *** THIS FILTER NEEDS TO BE CHECKED *** */
 }
 
 // -----------------------------------------------------------------------------
@@ -272,38 +453,32 @@ void MovingFiniteElementSmoothing::execute()
   }
 
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshNodeTypeArrayPath().getDataContainerName());
-
-  VertexArray::Pointer floatNodesPtr = sm->getVertices();
-  FaceArray::Pointer trianglesPtr = sm->getFaces();
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
 
   setErrorCondition(0);
   setWarningCondition(0);
   /* Place all your code to execute your filter here. */
-  VertexArray::Vert_t* nodesF = floatNodesPtr->getPointer(0); // Get the pointer to the from of the array so we can use [] notation
-  FaceArray::Face_t* triangles = trianglesPtr->getPointer(0); // Get the pointer to the from of the array so we can use [] notation
+  float* nodesF = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
 
   // Data variables
-  int numberNodes = floatNodesPtr->getNumberOfTuples();
-  int ntri = trianglesPtr->getNumberOfTuples();
+  int64_t numberNodes = triangleGeom->getNumberOfVertices();
+  int64_t ntri = triangleGeom->getNumberOfTris();
 
-  StructArray<VertexArray::VertD_t>::Pointer nodesDPtr = StructArray<VertexArray::VertD_t>::CreateArray(numberNodes, "MFE_Double_Nodes");
-  nodesDPtr->initializeWithZeros();
-  VertexArray::VertD_t* nodes = nodesDPtr->getPointer(0);
+  std::vector<MFENode> nodes(numberNodes);
 
   // Copy the nodes from the 32 bit floating point to the 64 bit floating point
-  for(int n = 0; n < numberNodes; ++n)
+  for(int64_t n = 0; n < numberNodes; ++n)
   {
-    nodes[n].pos[0] = nodesF[n].pos[0];
-    nodes[n].pos[1] = nodesF[n].pos[1];
-    nodes[n].pos[2] = nodesF[n].pos[2];
+    nodes[n].pos[0] = nodesF[3 * n + 0];
+    nodes[n].pos[1] = nodesF[3 * n + 1];
+    nodes[n].pos[2] = nodesF[3 * n + 2];
   }
 
   bool isVerbose = true;
 
   // We need a few more arrays to support the code from CMU:
-  StructArray<TripleNN>::Pointer triplennPtr = StructArray<TripleNN>::CreateArray(numberNodes, "TripleLine_Neighbors_Or_IDS");
-  triplennPtr->initializeWithZeros();
-  TripleNN* triplenn = triplennPtr->getPointer(0);
+  std::vector<TripleNN> triplenn(numberNodes, TripleNN{0, 0});
 
 //  QVector<QString> data;
 #if 0
@@ -606,7 +781,7 @@ void MovingFiniteElementSmoothing::execute()
   double min[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
   double max[3] = {std::numeric_limits<double>::min(), std::numeric_limits<double>::min(), std::numeric_limits<double>::min()};
 
-  for(int i = 0; i < numberNodes; i++)
+  for(int64_t i = 0; i < numberNodes; i++)
   {
     for(int j = 0; j < 3; j++)
     {
@@ -630,10 +805,16 @@ void MovingFiniteElementSmoothing::execute()
     qDebug() << "Y (1): " << min[1] << " " << max[1] << "\n";
     qDebug() << "Z (2): " << min[2] << " " << max[2] << "\n";
   }
-  // Allocate vectors and matricies
-  int n_size = 3 * numberNodes;
+  // Allocate vectors. The stiffness matrix is assembled fresh for every update
+  int n_size = static_cast<int>(3 * numberNodes);
   MFE::Vector<double> x(n_size), F(n_size);
-  MFE::SMatrix<double> K(n_size, n_size);
+
+  // Triangles are assembled in fixed size blocks, each with its own lists
+  const size_t blockSize = 1024;
+  size_t numBlocks = (static_cast<size_t>(ntri) + blockSize - 1) / blockSize;
+  std::vector<MFEStiffnessType::TripletList> kTriplets(numBlocks + 1);
+  std::vector<MFEForceList> forces(numBlocks);
+  std::vector<MFEBlockStats> blockStats(numBlocks);
 
   // Allocate constants for solving linear equations
   const double epsilon = 1.0; // change this if quality force too
@@ -642,11 +823,21 @@ void MovingFiniteElementSmoothing::execute()
   // time step, change if mesh moves too much, little
   const double small = 1.0e-12;
   const double large = 1.0e+50;
-  const double one12th = 1.0 / 12.0;
   const double tolerance = 1.0e-5;
   // Tolerance for nodes that are
   // near the RVE boundary
 
+  // The last triplet list holds the epsilon added to the diagonal, which also
+  // guarantees every diagonal entry exists for the boundary conditions below
+  MFEStiffnessType::TripletList& diagonal = kTriplets.back();
+  diagonal.resize(n_size);
+  for(int r = 0; r < n_size; r++)
+  {
+    diagonal[r].row = r;
+    diagonal[r].col = r;
+    diagonal[r].value = epsilon;
+  }
+
   double A_scale, Q_scale, TJ_scale;
   // Prefactors for quality, curvature and triple line forces
   //   don't make these two values too far different
@@ -654,7 +845,6 @@ void MovingFiniteElementSmoothing::execute()
 
   // Variables for logging of quality progress
   double Q_max, Q_sum, Q_ave, Q_max_ave;
-  double A, Q;
   int hist_count = 10;
 
   QVector<double> Q_max_hist(hist_count);
@@ -662,11 +852,11 @@ void MovingFiniteElementSmoothing::execute()
   Q_ave = 2.9;
   Q_max_ave = 10;
 
-  double Dihedral, Dihedral_min, Dihedral_max, Dihedral_sum, Dihedral_ave;
+  double Dihedral_min, Dihedral_max, Dihedral_sum, Dihedral_ave;
   //  for measuring dihedral angles, Mar 2010
 
   //  now we determine constraints
-  for(int r = 0; r < numberNodes; r++)
+  for(int64_t r = 0; r < numberNodes; r++)
   {
     nodeConstraint[r] = 0;
     if(m_NodeConstraints == true)
@@ -741,124 +931,68 @@ void MovingFiniteElementSmoothing::execute()
     //    leads to UNsmoothing of the mesh!
 
     // compute triangle contributions to K and F
-    ntri = trianglesPtr->getNumberOfTuples();
+    AssembleMFESystemImpl impl(nodes.data(), triangles, ntri, blockSize, m_SurfaceMeshNodeType, triplenn.data(), m_SmoothTripleLines, A_scale, Q_scale, TJ_scale, small, kTriplets,
+                               forces, blockStats);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::task_scheduler_init init;
+    bool doParallel = true;
+    if(doParallel == true)
+    {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks), impl, tbb::auto_partitioner());
+    }
+    else
+#endif
+    {
+      impl.generate(0, numBlocks);
+    }
+
+    // Reduce the per block results in block order
+    F = 0.0;
     Q_max = 0.;
     Q_sum = 0.;
     Dihedral_sum = 0.;
     Dihedral_min = 180.;
     Dihedral_max = -1.; //  added may 10, ADR
-    double LDistance, deltaLDistance;
-
-    typedef NodeFunctions<VertexArray::VertD_t, double> NodeFunctionsType;
-    typedef TriangleFunctions<VertexArray::VertD_t, double> TriangleFunctionsType;
-    // Loop through each of the triangles
-    for(int t = 0; t < ntri; t++)
+    for(size_t b = 0; b < numBlocks; b++)
     {
-      FaceArray::Face_t& rtri = triangles[t];
-      MFE::Vector<double> n(3);
-      n = TriangleFunctionsType::normal(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      A = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);           //  current Area
-      Q = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], A); //  current quality
-      if(Q > 100.)
-      {
-        if(isVerbose)
-        {
-          qDebug() << "Warning, tri no. " << t << " has Q= " << Q << "\n";
-        }
-      }
-      Q_sum += Q;
-      if(Q > Q_max)
+      for(const std::pair<int64_t, double>& force : forces[b])
       {
-        Q_max = Q;
-      }
-
-      Dihedral = TriangleFunctionsType::MinDihedral(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]);
-      // debug
-      //      qDebug() << "triangle, min dihedral: " << t << ", " << Dihedral*180/PI << "\n";
-      Dihedral_sum += Dihedral;
-      if(Dihedral < Dihedral_min)
-      {
-        Dihedral_min = Dihedral;
-      }
-      if(Dihedral > Dihedral_max)
-      {
-        Dihedral_max = Dihedral;
-      }
-
-      for(int n0 = 0; n0 < 3; n0++)
-      {
-        // for each of 3 nodes on the t^th triangle
-        int i = rtri.verts[n0];
-        VertexArray::VertD_t& node_i = nodes[i];
-        for(int j = 0; j < 3; j++)
-        {
-          //  for each of the three coordinates of the node
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            LDistance = NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]);
-          }
-          node_i.pos[j] += small;
-          double Anew = TriangleFunctionsType::area(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]]); //  current Area
-          double Qnew = TriangleFunctionsType::circularity(nodes[rtri.verts[0]], nodes[rtri.verts[1]], nodes[rtri.verts[2]], Anew);
-          if(m_SmoothTripleLines == true && (m_SurfaceMeshNodeType[i] == 3 || m_SurfaceMeshNodeType[i] == 13))
-          {
-            //  if we are smoothing triple lines, and we have a TJ node
-            deltaLDistance =
-                NodeFunctionsType::Distance(node_i, nodes[triplenn[i].triplenn1]) + NodeFunctionsType::Distance(nodes[triplenn[i].triplenn2], nodes[i]) - LDistance; // change in line length
-            F[3 * i + j] -= TJ_scale * deltaLDistance;
-          }
-          node_i.pos[j] -= small;
-          double arg = (A_scale * (Anew - A) + Q_scale * (Qnew - Q) * A) / small;
-          F[3 * i + j] -= arg;
-        }
-        for(int n1 = 0; n1 < 3; n1++)
-        {
-          //  for each of 3 nodes
-          int h = rtri.verts[n1];
-          for(int k = 0; k < 3; k++)
-          {
-            for(int j = 0; j < 3; j++)
-            {
-              K[3 * h + k][3 * i + j] += one12th * (1.0 + delta(i, h)) * n[j] * n[k] * A;
-            }
-          }
-        }
-      }
-    }
-    // add epsilon to the diagonal
-    for(int r = 0; r < numberNodes; r++)
-    {
-      for(int s = 0; s < 3; s++)
-      {
-        K[3 * r + s][3 * r + s] += epsilon;
+        F[force.first] += force.second;
       }
+      Q_sum += blockStats[b].Q_sum;
+      Q_max = std::max(Q_max, blockStats[b].Q_max);
+      Dihedral_sum += blockStats[b].Dihedral_sum;
+      Dihedral_min = std::min(Dihedral_min, blockStats[b].Dihedral_min);
+      Dihedral_max = std::max(Dihedral_max, blockStats[b].Dihedral_max);
     }
 
+    MFEStiffnessType K(n_size, n_size);
+    K.setFromTriplets(kTriplets);
+
     // apply boundary conditions
-    for(int r = 0; r < numberNodes; r++)
+    for(int64_t r = 0; r < numberNodes; r++)
     {
       if(m_NodeConstraints == true || m_ConstrainQuadPoints == true)
       {
         // only do this if we want the constraint
         if(nodeConstraint[r] % 2 != 0)
         {
-          K[3 * r][3 * r] = large;
+          *K.entry(3 * r, 3 * r) = large;
         } // X
         if((nodeConstraint[r] / 2) % 2 != 0)
         {
-          K[3 * r + 1][3 * r + 1] = large;
+          *K.entry(3 * r + 1, 3 * r + 1) = large;
         } // Y
         if(nodeConstraint[r] / 4 != 0)
         {
-          K[3 * r + 2][3 * r + 2] = large;
+          *K.entry(3 * r + 2, 3 * r + 2) = large;
         } // Z
         //  changed  12 v 10, ADR
       }
     }
 
     // solve for node velocities
-    int iterations = MFE::CR(K, x, F, 4000, 1.0e-5);
+    int iterations = MFE::PCG(K, x, F, 4000, 1.0e-5);
     if(isVerbose)
     {
       qDebug() << iterations << " iterations ... "
@@ -950,7 +1084,7 @@ void MovingFiniteElementSmoothing::execute()
 #endif
 
     // update node positions
-    for(int r = 0; r < numberNodes; r++)
+    for(int64_t r = 0; r < numberNodes; r++)
     {
       //    velocityfile << r << " ";
       for(int s = 0; s < 3; s++)
@@ -1074,11 +1208,11 @@ void MovingFiniteElementSmoothing::execute()
   }
 
   // Copy the nodes from the 64 bit floating point to the 32 bit floating point
-  for(int n = 0; n < numberNodes; ++n)
+  for(int64_t n = 0; n < numberNodes; ++n)
   {
-    nodesF[n].pos[0] = nodes[n].pos[0];
-    nodesF[n].pos[1] = nodes[n].pos[1];
-    nodesF[n].pos[2] = nodes[n].pos[2];
+    nodesF[3 * n + 0] = static_cast<float>(nodes[n].pos[0]);
+    nodesF[3 * n + 1] = static_cast<float>(nodes[n].pos[1]);
+    nodesF[3 * n + 2] = static_cast<float>(nodes[n].pos[2]);
   }
 
   /* Let the GUI know we are done with this filter */
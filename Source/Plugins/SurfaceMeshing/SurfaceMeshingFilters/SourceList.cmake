@@ -23,6 +23,7 @@ set(_PublicFilters
   FindTriangleGeomShapes
   FindTriangleGeomSizes
   LaplacianSmoothing
+  MovingFiniteElementSmoothing
   QuickSurfaceMesh
   ReverseTriangleWinding
   SharedFeatureFaceFilter
@@ -62,7 +63,6 @@ set(_PrivateFilters
   
   # These filters require extensive updates to comply with the IGeometry design
   #M3CSliceBySlice
-  #MovingFiniteElementSmoothing
   #VerifyTriangleWinding
 )
 
@@ -85,6 +85,7 @@ ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} Binary
 
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshFunctions.h)
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshLinearAlgebra.h)
+ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} MeshSparseLinearAlgebra.h)
 
 ADD_SIMPL_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.h)
 ADD_SIMPL_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} FindNRingNeighbors.cpp)
@@ -0,0 +1,228 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/MeshSparseLinearAlgebra.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class MeshLinearAlgebraTest
+{
+  typedef MFE::CSRMatrix<double> CSRMatrixType;
+
+public:
+  MeshLinearAlgebraTest()
+  {
+  }
+  virtual ~MeshLinearAlgebraTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+// QFile::remove();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Assembles the same symmetric positive definite system into a CSRMatrix, spread
+  // over several triplet lists with plenty of duplicate entries, and into an SMatrix.
+  // The system is a stiffness matrix of a chain of 3 dof nodes, which mimics the
+  // per triangle assembly of the moving finite element smoothing.
+  // -----------------------------------------------------------------------------
+  void CreateSystem(int numNodes, std::vector<CSRMatrixType::TripletList>& lists, MFE::SMatrix<double>& S)
+  {
+    int n = 3 * numNodes;
+    lists.assign(4, CSRMatrixType::TripletList());
+    for(int e = 0; e < numNodes - 1; e++)
+    {
+      int nids[2] = {e, e + 1};
+      double w[3] = {1.0 + 0.1 * (e % 3), 0.5 + 0.05 * (e % 5), 0.25};
+      CSRMatrixType::TripletList& list = lists[e % 3];
+      for(int a = 0; a < 2; a++)
+      {
+        for(int b = 0; b < 2; b++)
+        {
+          for(int k = 0; k < 3; k++)
+          {
+            for(int j = 0; j < 3; j++)
+            {
+              double value = (a == b ? 1.0 : -1.0) * w[j] * w[k] * 0.5;
+              CSRMatrixType::Triplet triplet;
+              triplet.row = 3 * nids[a] + k;
+              triplet.col = 3 * nids[b] + j;
+              triplet.value = value;
+              list.push_back(triplet);
+              S[triplet.row][triplet.col] += value;
+            }
+          }
+        }
+      }
+    }
+    // epsilon on the diagonal, in its own list
+    for(int r = 0; r < n; r++)
+    {
+      CSRMatrixType::Triplet triplet;
+      triplet.row = r;
+      triplet.col = r;
+      triplet.value = 1.0;
+      lists[3].push_back(triplet);
+      S[r][r] += 1.0;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestAssembleFromTriplets()
+  {
+    const int numNodes = 50;
+    const int n = 3 * numNodes;
+    std::vector<CSRMatrixType::TripletList> lists;
+    MFE::SMatrix<double> S(n, n);
+    CreateSystem(numNodes, lists, S);
+
+    CSRMatrixType A(n, n);
+    A.setFromTriplets(lists);
+    DREAM3D_REQUIRE_EQUAL(A.dimension1(), n)
+    DREAM3D_REQUIRE_EQUAL(A.dimension2(), n)
+
+    int nonzero = 0;
+    for(int i = 0; i < n; i++)
+    {
+      nonzero += S[i].nonzero();
+      for(int j = 0; j < n; j++)
+      {
+        DREAM3D_REQUIRE(fabs(A(i, j) - S[i][j]) < 1.0E-12)
+      }
+    }
+    // Duplicates must have been merged into a single entry
+    DREAM3D_REQUIRE_EQUAL(A.nonzero(), nonzero)
+    DREAM3D_REQUIRE(A.entry(0, n - 1) == nullptr)
+    DREAM3D_REQUIRE(A.entry(3, 3) != nullptr)
+
+    MFE::Vector<double> x(n);
+    for(int i = 0; i < n; i++)
+    {
+      x[i] = sin(0.1 * i);
+    }
+    MFE::Vector<double> y = A * x;
+    MFE::Vector<double> z = S * x;
+    for(int i = 0; i < n; i++)
+    {
+      DREAM3D_REQUIRE(fabs(y[i] - z[i]) < 1.0E-12)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestPreconditionedCG()
+  {
+    const int numNodes = 200;
+    const int n = 3 * numNodes;
+    std::vector<CSRMatrixType::TripletList> lists;
+    MFE::SMatrix<double> S(n, n);
+    CreateSystem(numNodes, lists, S);
+
+    CSRMatrixType A(n, n);
+    A.setFromTriplets(lists);
+
+    // Constrain a few of the dofs the same way the smoothing filter does
+    const double large = 1.0e+50;
+    *A.entry(0, 0) = large;
+    *A.entry(301, 301) = large;
+    S[0][0] = large;
+    S[301][301] = large;
+
+    MFE::Vector<double> b(n), x(n), xRef(n);
+    for(int i = 0; i < n; i++)
+    {
+      b[i] = cos(0.05 * i) + 0.25;
+    }
+
+    int iterations = MFE::PCG(A, x, b, 4000, 1.0e-10);
+    DREAM3D_REQUIRE(iterations > 0)
+
+    MFE::Vector<double> r = b - A * x;
+    DREAM3D_REQUIRE(MFE::norm(r) / MFE::norm(b) <= 1.0E-10)
+    DREAM3D_REQUIRE(fabs(x[0]) < 1.0E-40)
+    DREAM3D_REQUIRE(fabs(x[301]) < 1.0E-40)
+
+    // The unpreconditioned solver on the SMatrix has to find the same solution
+    iterations = MFE::CR(S, xRef, b, 4000, 1.0e-10);
+    DREAM3D_REQUIRE(iterations > 0)
+    for(int i = 0; i < n; i++)
+    {
+      DREAM3D_REQUIRE(fabs(x[i] - xRef[i]) <= 1.0E-6 * (1.0 + fabs(xRef[i])))
+    }
+
+    // A zero right hand side has the trivial solution
+    MFE::Vector<double> zero(n);
+    iterations = MFE::PCG(A, x, zero, 4000, 1.0e-10);
+    DREAM3D_REQUIRE_EQUAL(iterations, 0)
+    DREAM3D_REQUIRE(MFE::norm(x) == 0.0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestAssembleFromTriplets())
+    DREAM3D_REGISTER_TEST(TestPreconditionedCG())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  MeshLinearAlgebraTest(const MeshLinearAlgebraTest&); // Copy Constructor Not Implemented
+  void operator=(const MeshLinearAlgebraTest&);        // Move assignment Not Implemented
+};
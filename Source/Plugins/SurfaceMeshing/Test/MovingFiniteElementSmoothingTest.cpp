@@ -0,0 +1,256 @@
+/* ============================================================================
+* Copyright (c) 2009-2016 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include <algorithm>
+#include <cmath>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/SIMPLib.h"
+#include "UnitTestSupport.hpp"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+class MovingFiniteElementSmoothingTest
+{
+
+public:
+  MovingFiniteElementSmoothingTest()
+  {
+  }
+  virtual ~MovingFiniteElementSmoothingTest()
+  {
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+// QFile::remove();
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the MovingFiniteElementSmoothing Filter from the FilterManager
+    QString filtName = "MovingFiniteElementSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The SurfaceMeshing Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Creates a wavy, triangulated dim x dim sheet with a triple line and two
+  // quadruple points running across the middle.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer CreateSurfaceMesh(int64_t dim)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer tdc = DataContainer::New(SIMPL::Defaults::TriangleDataContainerName);
+    dca->addDataContainer(tdc);
+
+    int64_t numVerts = dim * dim;
+    int64_t numTris = 2 * (dim - 1) * (dim - 1);
+    SharedVertexList::Pointer vertex = TriangleGeom::CreateSharedVertexList(numVerts);
+    TriangleGeom::Pointer triangle = TriangleGeom::CreateGeometry(numTris, vertex, SIMPL::Geometry::TriangleGeometry);
+    tdc->setGeometry(triangle);
+    float* vertices = triangle->getVertexPointer(0);
+    int64_t* tris = triangle->getTriPointer(0);
+
+    QVector<size_t> tDims(1, numVerts);
+    AttributeMatrix::Pointer vertAttrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::VertexAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    tdc->addAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName, vertAttrMat);
+    QVector<size_t> cDims(1, 1);
+    Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(numVerts, cDims, SIMPL::VertexData::SurfaceMeshNodeType);
+    vertAttrMat->addAttributeArray(SIMPL::VertexData::SurfaceMeshNodeType, nodeTypes);
+    int8_t* nodeType = nodeTypes->getPointer(0);
+
+    for(int64_t y = 0; y < dim; y++)
+    {
+      for(int64_t x = 0; x < dim; x++)
+      {
+        int64_t v = y * dim + x;
+        vertices[3 * v + 0] = static_cast<float>(x) + 0.25f * sinf(static_cast<float>(3 * y + x));
+        vertices[3 * v + 1] = static_cast<float>(y) + 0.25f * cosf(static_cast<float>(x * y));
+        vertices[3 * v + 2] = 0.5f * sinf(0.7f * static_cast<float>(x)) * cosf(0.3f * static_cast<float>(y));
+
+        bool rim = (x == 0 || y == 0 || x == dim - 1 || y == dim - 1);
+        if(x == dim / 2 && (y == dim / 3 || y == 2 * dim / 3))
+        {
+          nodeType[v] = rim ? SIMPL::SurfaceMesh::NodeType::SurfaceQuadPoint : SIMPL::SurfaceMesh::NodeType::QuadPoint;
+        }
+        else if(x == dim / 2)
+        {
+          nodeType[v] = rim ? SIMPL::SurfaceMesh::NodeType::SurfaceTriplePoint : SIMPL::SurfaceMesh::NodeType::TriplePoint;
+        }
+        else
+        {
+          nodeType[v] = rim ? SIMPL::SurfaceMesh::NodeType::SurfaceDefault : SIMPL::SurfaceMesh::NodeType::Default;
+        }
+      }
+    }
+
+    int64_t t = 0;
+    for(int64_t y = 0; y < dim - 1; y++)
+    {
+      for(int64_t x = 0; x < dim - 1; x++)
+      {
+        int64_t v = y * dim + x;
+        tris[3 * t + 0] = v;
+        tris[3 * t + 1] = v + 1;
+        tris[3 * t + 2] = v + dim;
+        t++;
+        tris[3 * t + 0] = v + 1;
+        tris[3 * t + 1] = v + dim + 1;
+        tris[3 * t + 2] = v + dim;
+        t++;
+      }
+    }
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSmoothingConstrainsQuadPoints()
+  {
+    const int64_t dim = 40;
+    DataContainerArray::Pointer original = CreateSurfaceMesh(dim);
+    DataContainerArray::Pointer smoothed = CreateSurfaceMesh(dim);
+
+    QString filtName = "MovingFiniteElementSmoothing";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName(filtName);
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+
+    filter->setDataContainerArray(smoothed);
+
+    bool propWasSet = true;
+    QVariant var;
+
+    DataArrayPath path(SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::SurfaceMeshNodeType);
+    var.setValue(path);
+    propWasSet = filter->setProperty("SurfaceMeshNodeTypeArrayPath", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(10);
+    propWasSet = filter->setProperty("IterationSteps", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(true);
+    propWasSet = filter->setProperty("NodeConstraints", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    propWasSet = filter->setProperty("ConstrainSurfaceNodes", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    propWasSet = filter->setProperty("ConstrainQuadPoints", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    var.setValue(false);
+    propWasSet = filter->setProperty("SmoothTripleLines", var);
+    DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0);
+
+    DataContainer::Pointer dc = smoothed->getDataContainer(SIMPL::Defaults::TriangleDataContainerName);
+    float* start = original->getDataContainer(SIMPL::Defaults::TriangleDataContainerName)->getGeometryAs<TriangleGeom>()->getVertexPointer(0);
+    float* result = dc->getGeometryAs<TriangleGeom>()->getVertexPointer(0);
+    Int8ArrayType::Pointer nodeTypes = dc->getAttributeMatrix(SIMPL::Defaults::VertexAttributeMatrixName)->getAttributeArrayAs<Int8ArrayType>(SIMPL::VertexData::SurfaceMeshNodeType);
+    int8_t* nodeType = nodeTypes->getPointer(0);
+
+    float maxMoved = 0.0f;
+    for(int64_t v = 0; v < dim * dim; v++)
+    {
+      for(int64_t j = 0; j < 3; j++)
+      {
+        DREAM3D_REQUIRE(std::isfinite(result[3 * v + j]))
+        if(nodeType[v] == SIMPL::SurfaceMesh::NodeType::QuadPoint)
+        {
+          DREAM3D_REQUIRE_EQUAL(result[3 * v + j], start[3 * v + j])
+        }
+        maxMoved = std::max(maxMoved, fabsf(result[3 * v + j] - start[3 * v + j]));
+      }
+    }
+    // make sure the smoothing actually moved the mesh
+    DREAM3D_REQUIRE(maxMoved > 0.01f)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSmoothingConstrainsQuadPoints())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+  MovingFiniteElementSmoothingTest(const MovingFiniteElementSmoothingTest&); // Copy Constructor Not Implemented
+  void operator=(const MovingFiniteElementSmoothingTest&);                   // Move assignment Not Implemented
+};
@@ -44,6 +44,7 @@
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/Utilities/TriangleBVH.hpp"
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/DataArrays/DynamicListArray.hpp"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -68,7 +69,6 @@ class InsertAtomsImpl
 {
   TriangleGeom::Pointer m_Faces;
   Int32Int32DynamicListArray::Pointer m_FaceIds;
-  VertexGeom::Pointer m_FaceBBs;
   QuatF* m_AvgQuats;
   FloatVec3_t m_LatticeConstants;
   uint32_t m_Basis;
@@ -76,11 +76,10 @@ class InsertAtomsImpl
   QVector<BoolArrayType::Pointer> m_InFeature;
 
 public:
-  InsertAtomsImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, VertexGeom::Pointer faceBBs, QuatF* avgQuats, FloatVec3_t latticeConstants, uint32_t basis,
-                  QVector<VertexGeom::Pointer> points, QVector<BoolArrayType::Pointer> inFeature)
+  InsertAtomsImpl(TriangleGeom::Pointer faces, Int32Int32DynamicListArray::Pointer faceIds, QuatF* avgQuats, FloatVec3_t latticeConstants, uint32_t basis, QVector<VertexGeom::Pointer> points,
+                  QVector<BoolArrayType::Pointer> inFeature)
   : m_Faces(faces)
   , m_FaceIds(faceIds)
-  , m_FaceBBs(faceBBs)
   , m_AvgQuats(avgQuats)
   , m_LatticeConstants(latticeConstants)
   , m_Basis(basis)
@@ -94,13 +93,8 @@ public:
 
   void checkPoints(size_t start, size_t end) const
   {
-    float radius = 0.0f;
-    FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower_Left");
-    FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right");
     FloatArrayType::Pointer ll_rotPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Lower_Left_Rotated");
     FloatArrayType::Pointer ur_rotPtr = FloatArrayType::CreateArray(3, "_INTERNAL_USE_ONLY_Upper_Right_Rotated");
-    float* ll = llPtr->getPointer(0);
-    float* ur = urPtr->getPointer(0);
     float* ll_rot = ll_rotPtr->getPointer(0);
     float* ur_rot = ur_rotPtr->getPointer(0);
     float* point = nullptr;
@@ -116,9 +110,10 @@ public:
       om.toGMatrix(g);
 
       // find bounding box for current feature
-      GeometryMath::FindBoundingBoxOfFaces(m_Faces.get(), faceIds, ll, ur);
       GeometryMath::FindBoundingBoxOfRotatedFaces(m_Faces.get(), faceIds, g, ll_rot, ur_rot);
-      GeometryMath::FindDistanceBetweenPoints(ll, ur, radius);
+
+      // build the hierarchy over the faces of the current feature
+      TriangleBVH faceTree(m_Faces.get(), faceIds.cells, static_cast<size_t>(faceIds.ncells));
 
       generatePoints(iter, m_Points, m_InFeature, m_AvgQuats, m_LatticeConstants, m_Basis, ll_rot, ur_rot);
 
@@ -131,10 +126,11 @@ public:
         point = vertArray->getVertexPointer(i);
         if(boolArray->getValue(i) == false)
         {
-          code = GeometryMath::PointInPolyhedron(m_Faces.get(), faceIds, m_FaceBBs.get(), point, ll, ur, radius);
+          code = faceTree.pointInPolyhedron(point);
+          // Points that can not be classified ('?') are left unassigned
           if(code == 'i' || code == 'V' || code == 'E' || code == 'F')
           {
-            m_InFeature[start]->setValue(i, true);
+            boolArray->setValue(i, true);
           }
         }
       }
@@ -550,13 +546,6 @@ void InsertAtoms::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t numFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-  // create array to hold bounding vertices for each face
-  FloatArrayType::Pointer llPtr = FloatArrayType::CreateArray(3, "Lower_Left_Internal_Use_Only");
-  FloatArrayType::Pointer urPtr = FloatArrayType::CreateArray(3, "Upper_Right_Internal_Use_Only");
-  float* ll = llPtr->getPointer(0);
-  float* ur = urPtr->getPointer(0);
-  VertexGeom::Pointer faceBBs = VertexGeom::CreateGeometry(2 * numFaces, "faceBBs");
-
   // walk through faces to see how many features there are
   int32_t g1 = 0, g2 = 0;
   int32_t maxFeatureId = 0;
@@ -617,10 +606,6 @@ void InsertAtoms::execute()
     {
       faceLists->insertCellReference(g2, (linkLoc[g2])++, i);
     }
-    // find bounding box for each face
-    GeometryMath::FindBoundingBoxOfFace(triangleGeom.get(), i, ll, ur);
-    faceBBs->setCoords(2 * i, ll);
-    faceBBs->setCoords(2 * i + 1, ur);
   }
 
   // generate the list of sampling points fom subclass
@@ -637,12 +622,12 @@ void InsertAtoms::execute()
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
   if(doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), InsertAtomsImpl(triangleGeom, faceLists, faceBBs, avgQuats, latticeConstants, m_Basis, points, inFeature), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures), InsertAtomsImpl(triangleGeom, faceLists, avgQuats, latticeConstants, m_Basis, points, inFeature), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    InsertAtomsImpl serial(triangleGeom, faceLists, faceBBs, avgQuats, latticeConstants, m_Basis, points, inFeature);
+    InsertAtomsImpl serial(triangleGeom, faceLists, avgQuats, latticeConstants, m_Basis, points, inFeature);
     serial.checkPoints(0, numFeatures);
   }
 